@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/asset_index.h"
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr size_t kHeaderSize = 3 * sizeof(uint32_t);
+
+uint32_t ReadUint32(const uint8_t* bytes) {
+  return static_cast<uint32_t>(bytes[0]) |
+         static_cast<uint32_t>(bytes[1]) << 8 |
+         static_cast<uint32_t>(bytes[2]) << 16 |
+         static_cast<uint32_t>(bytes[3]) << 24;
+}
+
+void AppendUint32(std::vector<uint8_t>& bytes, uint32_t value) {
+  bytes.push_back(value & 0xff);
+  bytes.push_back((value >> 8) & 0xff);
+  bytes.push_back((value >> 16) & 0xff);
+  bytes.push_back((value >> 24) & 0xff);
+}
+
+}  // namespace
+
+std::unique_ptr<AssetIndex> AssetIndex::Create(
+    std::unique_ptr<fml::Mapping> mapping) {
+  TRACE_EVENT0("flutter", "AssetIndex::Create");
+  if (mapping == nullptr) {
+    return nullptr;
+  }
+  auto index = std::unique_ptr<AssetIndex>(new AssetIndex(std::move(mapping)));
+  if (!index->Parse()) {
+    FML_LOG(ERROR) << "The asset index is not valid. It will be ignored.";
+    return nullptr;
+  }
+  return index;
+}
+
+std::vector<uint8_t> AssetIndex::Serialize(
+    const std::vector<std::string>& asset_names) {
+  std::vector<uint8_t> bytes;
+  AppendUint32(bytes, kMagic);
+  AppendUint32(bytes, kVersion);
+  AppendUint32(bytes, asset_names.size());
+  for (const auto& name : asset_names) {
+    AppendUint32(bytes, name.size());
+    bytes.insert(bytes.end(), name.begin(), name.end());
+  }
+  return bytes;
+}
+
+AssetIndex::AssetIndex(std::unique_ptr<fml::Mapping> mapping)
+    : mapping_(std::move(mapping)) {}
+
+AssetIndex::~AssetIndex() = default;
+
+bool AssetIndex::Parse() {
+  const uint8_t* bytes = mapping_->GetMapping();
+  const size_t size = mapping_->GetSize();
+  if (bytes == nullptr || size < kHeaderSize || ReadUint32(bytes) != kMagic ||
+      ReadUint32(bytes + sizeof(uint32_t)) != kVersion) {
+    return false;
+  }
+  const size_t count = ReadUint32(bytes + 2 * sizeof(uint32_t));
+  // Each name takes at least its size, which bounds a plausible count.
+  if (count > (size - kHeaderSize) / sizeof(uint32_t)) {
+    return false;
+  }
+  names_.reserve(count);
+  name_set_.reserve(count);
+  size_t offset = kHeaderSize;
+  for (size_t i = 0; i < count; i++) {
+    if (size - offset < sizeof(uint32_t)) {
+      return false;
+    }
+    const size_t name_size = ReadUint32(bytes + offset);
+    offset += sizeof(uint32_t);
+    if (size - offset < name_size) {
+      return false;
+    }
+    std::string_view name(reinterpret_cast<const char*>(bytes + offset),
+                          name_size);
+    offset += name_size;
+    if (name_set_.insert(name).second) {
+      names_.push_back(name);
+    }
+  }
+  return offset == size;
+}
+
+bool AssetIndex::Contains(std::string_view asset_name) const {
+  return name_set_.count(asset_name) != 0;
+}
+
+}  // namespace flutter
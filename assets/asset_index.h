@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_ASSET_INDEX_H_
+#define FLUTTER_ASSETS_ASSET_INDEX_H_
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// The list of assets in an asset bundle, generated when the bundle is built,
+/// so that looking up an asset needs no file system calls unless it exists.
+///
+/// The index file starts with a magic number, a format version and the number
+/// of assets, followed by each asset's name as a 32-bit size and the name's
+/// bytes. All numbers are little-endian. Names are relative to the bundle and
+/// use '/' as the separator. The index is read from a mapping without copying
+/// the names.
+///
+class AssetIndex {
+ public:
+  static constexpr char kFileName[] = "io.flutter.assets.index";
+  static constexpr uint32_t kMagic = 0x58494146;  // "FAIX"
+  static constexpr uint32_t kVersion = 1;
+
+  //----------------------------------------------------------------------------
+  /// @return     The index in |mapping|, or nullptr if it isn't a valid index.
+  ///
+  static std::unique_ptr<AssetIndex> Create(
+      std::unique_ptr<fml::Mapping> mapping);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Serializes an index of |asset_names|.
+  ///
+  static std::vector<uint8_t> Serialize(
+      const std::vector<std::string>& asset_names);
+
+  ~AssetIndex();
+
+  bool Contains(std::string_view asset_name) const;
+
+  const std::vector<std::string_view>& GetAssetNames() const { return names_; }
+
+ private:
+  const std::unique_ptr<fml::Mapping> mapping_;
+  // Views into |mapping_|.
+  std::vector<std::string_view> names_;
+  std::unordered_set<std::string_view> name_set_;
+
+  explicit AssetIndex(std::unique_ptr<fml::Mapping> mapping);
+
+  bool Parse();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AssetIndex);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_ASSET_INDEX_H_
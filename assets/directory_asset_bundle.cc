@@ -4,7 +4,10 @@
 
 #include "flutter/assets/directory_asset_bundle.h"
 
+#include <map>
+#include <mutex>
 #include <regex>
+#include <unordered_map>
 #include <utility>
 
 #include "flutter/fml/eintr_wrapper.h"
@@ -13,6 +16,50 @@
 
 namespace flutter {
 
+struct DirectoryAssetBundle::IndexedDirectory {
+  std::unique_ptr<AssetIndex> index;
+  std::mutex mappings_mutex;
+  // The mappings of the assets that are in use, so that concurrent lookups
+  // share them. Bounded by the number of assets in the index.
+  std::unordered_map<std::string, std::weak_ptr<fml::FileMapping>> mappings;
+};
+
+std::shared_ptr<DirectoryAssetBundle::IndexedDirectory>
+DirectoryAssetBundle::LoadIndexedDirectory(const fml::UniqueFD& directory) {
+  fml::FileIdentity identity;
+  if (!fml::GetFileIdentity(directory, &identity)) {
+    return nullptr;
+  }
+
+  // Indexes are shared by the bundles open on a directory, and released with
+  // the last of them.
+  static std::mutex directories_mutex;
+  static auto* directories =
+      new std::map<fml::FileIdentity, std::weak_ptr<IndexedDirectory>>();
+
+  std::scoped_lock lock(directories_mutex);
+  for (auto it = directories->begin(); it != directories->end();) {
+    if (it->second.expired()) {
+      it = directories->erase(it);
+    } else {
+      ++it;
+    }
+  }
+  auto found = directories->find(identity);
+  if (found != directories->end()) {
+    return found->second.lock();
+  }
+  auto index = AssetIndex::Create(
+      fml::FileMapping::CreateReadOnly(directory, AssetIndex::kFileName));
+  if (!index) {
+    return nullptr;
+  }
+  auto indexed_directory = std::make_shared<IndexedDirectory>();
+  indexed_directory->index = std::move(index);
+  (*directories)[identity] = indexed_directory;
+  return indexed_directory;
+}
+
 DirectoryAssetBundle::DirectoryAssetBundle(
     fml::UniqueFD descriptor,
     bool is_valid_after_asset_manager_change)
@@ -22,6 +69,7 @@ DirectoryAssetBundle::DirectoryAssetBundle(
   }
   is_valid_after_asset_manager_change_ = is_valid_after_asset_manager_change;
   is_valid_ = true;
+  indexed_directory_ = LoadIndexedDirectory(descriptor_);
 }
 
 DirectoryAssetBundle::~DirectoryAssetBundle() = default;
@@ -49,6 +97,10 @@ std::unique_ptr<fml::Mapping> DirectoryAssetBundle::GetAsMapping(
     return nullptr;
   }
 
+  if (indexed_directory_) {
+    return GetIndexedMapping(asset_name);
+  }
+
   auto mapping = std::make_unique<fml::FileMapping>(fml::OpenFile(
       descriptor_, asset_name.c_str(), false, fml::FilePermission::kRead));
 
@@ -59,6 +111,35 @@ std::unique_ptr<fml::Mapping> DirectoryAssetBundle::GetAsMapping(
   return mapping;
 }
 
+std::unique_ptr<fml::Mapping> DirectoryAssetBundle::GetIndexedMapping(
+    const std::string& asset_name) const {
+  if (!indexed_directory_->index->Contains(asset_name)) {
+    return nullptr;
+  }
+
+  std::shared_ptr<fml::FileMapping> file_mapping;
+  {
+    std::scoped_lock lock(indexed_directory_->mappings_mutex);
+    auto& cached = indexed_directory_->mappings[asset_name];
+    file_mapping = cached.lock();
+    if (!file_mapping) {
+      file_mapping = std::make_shared<fml::FileMapping>(fml::OpenFile(
+          descriptor_, asset_name.c_str(), false, fml::FilePermission::kRead));
+      if (!file_mapping->IsValid()) {
+        indexed_directory_->mappings.erase(asset_name);
+        return nullptr;
+      }
+      cached = file_mapping;
+    }
+  }
+
+  // The view keeps the shared mapping alive for as long as it is used.
+  return std::make_unique<fml::NonOwnedMapping>(
+      file_mapping->GetMapping(), file_mapping->GetSize(),
+      [file_mapping](const uint8_t*, size_t) {});
+}
+
+// |AssetResolver|
 std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
     const std::string& asset_pattern) const {
   std::vector<std::unique_ptr<fml::Mapping>> mappings;
@@ -68,6 +149,27 @@ std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
   }
 
   std::regex asset_regex(asset_pattern);
+
+  if (indexed_directory_) {
+    for (std::string_view name :
+         indexed_directory_->index->GetAssetNames()) {
+      const size_t separator = name.rfind('/');
+      std::string_view filename =
+          separator == std::string_view::npos ? name
+                                              : name.substr(separator + 1);
+      if (!std::regex_match(filename.begin(), filename.end(), asset_regex)) {
+        continue;
+      }
+      auto mapping = GetIndexedMapping(std::string(name));
+      if (mapping) {
+        mappings.push_back(std::move(mapping));
+      } else {
+        FML_LOG(ERROR) << "Mapping " << name << " failed";
+      }
+    }
+    return mappings;
+  }
+
   fml::FileVisitor visitor = [&](const fml::UniqueFD& directory,
                                  const std::string& filename) {
     if (std::regex_match(filename, asset_regex)) {
@@ -5,6 +5,9 @@
 #ifndef FLUTTER_ASSETS_DIRECTORY_ASSET_BUNDLE_H_
 #define FLUTTER_ASSETS_DIRECTORY_ASSET_BUNDLE_H_
 
+#include <memory>
+
+#include "flutter/assets/asset_index.h"
 #include "flutter/assets/asset_resolver.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
@@ -12,6 +15,21 @@
 
 namespace flutter {
 
+//------------------------------------------------------------------------------
+/// Resolves assets to files in a directory.
+///
+/// If the directory has an |AssetIndex|, assets missing from it are not looked
+/// for on disk, and the index is matched instead of walking the directory for
+/// |GetAsMappings|. The index must then list every asset, so bundles that are
+/// updated in place, like those of applications being hot reloaded, should
+/// not have one.
+///
+/// The index of a directory is read once and shared by all the bundles open
+/// on it, and an asset it lists is mapped once for as long as it is in use,
+/// with concurrent lookups sharing that mapping. A directory is recognized by
+/// its identity and modification time, so adding or removing entries causes
+/// its index to be read again.
+///
 class DirectoryAssetBundle : public AssetResolver {
  public:
   DirectoryAssetBundle(fml::UniqueFD descriptor,
@@ -23,6 +41,14 @@ class DirectoryAssetBundle : public AssetResolver {
   const fml::UniqueFD descriptor_;
   bool is_valid_ = false;
   bool is_valid_after_asset_manager_change_ = false;
+  struct IndexedDirectory;
+  std::shared_ptr<IndexedDirectory> indexed_directory_;
+
+  static std::shared_ptr<IndexedDirectory> LoadIndexedDirectory(
+      const fml::UniqueFD& directory);
+
+  std::unique_ptr<fml::Mapping> GetIndexedMapping(
+      const std::string& asset_name) const;
 
   // |AssetResolver|
   bool IsValid() const override;
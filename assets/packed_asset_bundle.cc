@@ -0,0 +1,237 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_bundle.h"
+
+#include <algorithm>
+#include <regex>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr size_t kHeaderSize = 4 * sizeof(uint32_t);
+constexpr size_t kEntrySize = 2 * sizeof(uint64_t) + 4 * sizeof(uint32_t);
+
+uint64_t ReadLittleEndian(const uint8_t* bytes, size_t size) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < size; i++) {
+    value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+  }
+  return value;
+}
+
+uint32_t ReadUint32(const uint8_t* bytes) {
+  return ReadLittleEndian(bytes, sizeof(uint32_t));
+}
+
+uint64_t ReadUint64(const uint8_t* bytes) {
+  return ReadLittleEndian(bytes, sizeof(uint64_t));
+}
+
+void AppendLittleEndian(std::vector<uint8_t>& bytes,
+                        uint64_t value,
+                        size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    bytes.push_back((value >> (8 * i)) & 0xff);
+  }
+}
+
+size_t AlignUp(size_t offset) {
+  return (offset + PackedAssetBundle::kAlignment - 1) /
+         PackedAssetBundle::kAlignment * PackedAssetBundle::kAlignment;
+}
+
+}  // namespace
+
+std::vector<uint8_t> PackedAssetBundle::Pack(std::vector<Asset> assets) {
+  std::sort(assets.begin(), assets.end(),
+            [](const Asset& a, const Asset& b) { return a.name < b.name; });
+  assets.erase(std::unique(assets.begin(), assets.end(),
+                           [](const Asset& a, const Asset& b) {
+                             return a.name == b.name;
+                           }),
+               assets.end());
+
+  size_t names_size = 0;
+  for (const auto& asset : assets) {
+    names_size += asset.name.size();
+  }
+
+  std::vector<uint8_t> bytes;
+  AppendLittleEndian(bytes, kMagic, sizeof(uint32_t));
+  AppendLittleEndian(bytes, kVersion, sizeof(uint32_t));
+  AppendLittleEndian(bytes, assets.size(), sizeof(uint32_t));
+  AppendLittleEndian(bytes, names_size, sizeof(uint32_t));
+
+  size_t offset =
+      AlignUp(kHeaderSize + assets.size() * kEntrySize + names_size);
+  size_t name_offset = 0;
+  for (const auto& asset : assets) {
+    AppendLittleEndian(bytes, offset, sizeof(uint64_t));
+    AppendLittleEndian(bytes, asset.data.size(), sizeof(uint64_t));
+    AppendLittleEndian(bytes, name_offset, sizeof(uint32_t));
+    AppendLittleEndian(bytes, asset.name.size(), sizeof(uint32_t));
+    AppendLittleEndian(bytes, asset.flags, sizeof(uint32_t));
+    AppendLittleEndian(bytes, 0, sizeof(uint32_t));
+    offset = AlignUp(offset + asset.data.size());
+    name_offset += asset.name.size();
+  }
+
+  for (const auto& asset : assets) {
+    bytes.insert(bytes.end(), asset.name.begin(), asset.name.end());
+  }
+
+  for (const auto& asset : assets) {
+    bytes.resize(AlignUp(bytes.size()), 0);
+    bytes.insert(bytes.end(), asset.data.begin(), asset.data.end());
+  }
+
+  return bytes;
+}
+
+PackedAssetBundle::PackedAssetBundle(
+    std::unique_ptr<fml::FileMapping> archive,
+    bool is_valid_after_asset_manager_change)
+    : archive_(std::move(archive)),
+      is_valid_after_asset_manager_change_(
+          is_valid_after_asset_manager_change) {
+  if (!archive_) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "PackedAssetBundle::Parse");
+  if (!Parse()) {
+    FML_LOG(ERROR) << "The asset archive is not valid. It will be ignored.";
+    entries_.clear();
+    return;
+  }
+  is_valid_ = true;
+  for (const auto& entry : entries_) {
+    if (entry.flags & kPrefetch) {
+      archive_->WillNeed(entry.offset, entry.size);
+    }
+  }
+}
+
+PackedAssetBundle::~PackedAssetBundle() = default;
+
+bool PackedAssetBundle::Parse() {
+  const uint8_t* bytes = archive_->GetMapping();
+  const size_t size = archive_->GetSize();
+  if (bytes == nullptr || size < kHeaderSize || ReadUint32(bytes) != kMagic ||
+      ReadUint32(bytes + sizeof(uint32_t)) != kVersion) {
+    return false;
+  }
+  const size_t count = ReadUint32(bytes + 2 * sizeof(uint32_t));
+  const size_t names_size = ReadUint32(bytes + 3 * sizeof(uint32_t));
+  if (count > (size - kHeaderSize) / kEntrySize ||
+      names_size > size - kHeaderSize - count * kEntrySize) {
+    return false;
+  }
+
+  const uint8_t* names = bytes + kHeaderSize + count * kEntrySize;
+  entries_.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    const uint8_t* entry_bytes = bytes + kHeaderSize + i * kEntrySize;
+    Entry entry;
+    const uint64_t offset = ReadUint64(entry_bytes);
+    const uint64_t entry_size = ReadUint64(entry_bytes + 8);
+    const size_t name_offset = ReadUint32(entry_bytes + 16);
+    const size_t name_size = ReadUint32(entry_bytes + 20);
+    entry.flags = ReadUint32(entry_bytes + 24);
+    if (offset > size || entry_size > size - offset ||
+        name_offset > names_size || name_size > names_size - name_offset) {
+      return false;
+    }
+    entry.offset = offset;
+    entry.size = entry_size;
+    entry.name = std::string_view(
+        reinterpret_cast<const char*>(names + name_offset), name_size);
+    // Lookups rely on the names being sorted and unique.
+    if (!entries_.empty() && entries_.back().name >= entry.name) {
+      return false;
+    }
+    entries_.push_back(entry);
+  }
+  return true;
+}
+
+const PackedAssetBundle::Entry* PackedAssetBundle::Find(
+    std::string_view asset_name) const {
+  auto found = std::lower_bound(
+      entries_.begin(), entries_.end(), asset_name,
+      [](const Entry& entry, std::string_view name) {
+        return entry.name < name;
+      });
+  if (found == entries_.end() || found->name != asset_name) {
+    return nullptr;
+  }
+  return &*found;
+}
+
+std::unique_ptr<fml::Mapping> PackedAssetBundle::GetSlice(
+    const Entry& entry) const {
+  // The slice holds a reference to the archive to keep it mapped.
+  return std::make_unique<fml::NonOwnedMapping>(
+      archive_->GetMapping() + entry.offset, entry.size,
+      [archive = archive_](const uint8_t* data, size_t size) {});
+}
+
+bool PackedAssetBundle::Prefetch(const std::string& asset_name) const {
+  const Entry* entry = Find(asset_name);
+  if (entry == nullptr) {
+    return false;
+  }
+  archive_->WillNeed(entry->offset, entry->size);
+  return true;
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValid() const {
+  return is_valid_;
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValidAfterAssetManagerChange() const {
+  return is_valid_after_asset_manager_change_;
+}
+
+// |AssetResolver|
+AssetResolver::AssetResolverType PackedAssetBundle::GetType() const {
+  return AssetResolver::AssetResolverType::kPackedAssetBundle;
+}
+
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> PackedAssetBundle::GetAsMapping(
+    const std::string& asset_name) const {
+  const Entry* entry = Find(asset_name);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  return GetSlice(*entry);
+}
+
+// |AssetResolver|
+std::vector<std::unique_ptr<fml::Mapping>> PackedAssetBundle::GetAsMappings(
+    const std::string& asset_pattern) const {
+  std::vector<std::unique_ptr<fml::Mapping>> mappings;
+  std::regex asset_regex(asset_pattern);
+  for (const auto& entry : entries_) {
+    // Match the file name, as |DirectoryAssetBundle| does.
+    const size_t separator = entry.name.rfind('/');
+    std::string_view filename = separator == std::string_view::npos
+                                    ? entry.name
+                                    : entry.name.substr(separator + 1);
+    if (std::regex_match(filename.begin(), filename.end(), asset_regex)) {
+      mappings.push_back(GetSlice(entry));
+    }
+  }
+  return mappings;
+}
+
+}  // namespace flutter
@@ -0,0 +1,117 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+#define FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Resolves assets to slices of a single archive that is mapped once, so that
+/// resolving an asset needs no file system calls and copies nothing.
+///
+/// The archive starts with a header of a magic number, a format version, the
+/// number of assets and the size of the name table. It is followed by a table
+/// with an entry per asset, sorted by name, then the name table, then the
+/// contents of the assets, each starting at a multiple of |kAlignment|. An
+/// entry is the 64-bit offset and size of the asset's contents, the 32-bit
+/// offset and size of its name in the name table, its |EntryFlags|, and 32
+/// reserved bits. All numbers are little-endian. Names are relative to the
+/// bundle and use '/' as the separator.
+///
+/// The mappings returned keep the archive mapped, so they may outlive the
+/// bundle.
+///
+class PackedAssetBundle : public AssetResolver {
+ public:
+  static constexpr char kFileName[] = "io.flutter.assets.pack";
+  static constexpr uint32_t kMagic = 0x4B415046;  // "FPAK"
+  static constexpr uint32_t kVersion = 1;
+  static constexpr size_t kAlignment = 4096;
+
+  enum EntryFlags : uint32_t {
+    // The asset is paged in ahead of its first use.
+    kPrefetch = 1 << 0,
+  };
+
+  struct Asset {
+    std::string name;
+    std::vector<uint8_t> data;
+    uint32_t flags = 0;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Serializes an archive of |assets|.
+  ///
+  static std::vector<uint8_t> Pack(std::vector<Asset> assets);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a bundle of the assets in |archive|. The bundle is
+  ///             invalid if |archive| is null or not a valid archive.
+  ///
+  PackedAssetBundle(std::unique_ptr<fml::FileMapping> archive,
+                    bool is_valid_after_asset_manager_change);
+
+  ~PackedAssetBundle() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Hints that the asset will be used soon, so that its contents
+  ///             start being paged in.
+  ///
+  /// @return     Whether the archive has the asset.
+  ///
+  bool Prefetch(const std::string& asset_name) const;
+
+ private:
+  struct Entry {
+    std::string_view name;
+    size_t offset = 0;
+    size_t size = 0;
+    uint32_t flags = 0;
+  };
+
+  const std::shared_ptr<fml::FileMapping> archive_;
+  const bool is_valid_after_asset_manager_change_;
+  bool is_valid_ = false;
+  // Sorted by name, which are views into |archive_|.
+  std::vector<Entry> entries_;
+
+  bool Parse();
+
+  const Entry* Find(std::string_view asset_name) const;
+
+  std::unique_ptr<fml::Mapping> GetSlice(const Entry& entry) const;
+
+  // |AssetResolver|
+  bool IsValid() const override;
+
+  // |AssetResolver|
+  bool IsValidAfterAssetManagerChange() const override;
+
+  // |AssetResolver|
+  AssetResolver::AssetResolverType GetType() const override;
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override;
+
+  // |AssetResolver|
+  std::vector<std::unique_ptr<fml::Mapping>> GetAsMappings(
+      const std::string& asset_pattern) const override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedAssetBundle);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
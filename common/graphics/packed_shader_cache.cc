@@ -0,0 +1,544 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/graphics/packed_shader_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <tuple>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/make_copyable.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr size_t kHeaderSize = 2 * sizeof(uint32_t);
+constexpr size_t kRecordHeaderSize = 2 * sizeof(uint32_t);
+constexpr size_t kUsageRecordHeaderSize =
+    2 * sizeof(uint32_t) + sizeof(uint64_t);
+
+// Compacting the file isn't worth it for less superseded data than this.
+constexpr size_t kMinCompactionBytes = 64 * 1024;
+
+// How long to wait before writing the usage file, so that the shaders
+// compiled or first loaded together, such as when a screen is first shown,
+// are written at once.
+constexpr fml::TimeDelta kUsageWriteDelay = fml::TimeDelta::FromSeconds(2);
+
+uint32_t ReadUint32(const uint8_t* bytes) {
+  return static_cast<uint32_t>(bytes[0]) |
+         static_cast<uint32_t>(bytes[1]) << 8 |
+         static_cast<uint32_t>(bytes[2]) << 16 |
+         static_cast<uint32_t>(bytes[3]) << 24;
+}
+
+uint64_t ReadUint64(const uint8_t* bytes) {
+  return static_cast<uint64_t>(ReadUint32(bytes)) |
+         static_cast<uint64_t>(ReadUint32(bytes + sizeof(uint32_t))) << 32;
+}
+
+void AppendUint32(std::vector<uint8_t>& bytes, uint32_t value) {
+  bytes.push_back(value & 0xff);
+  bytes.push_back((value >> 8) & 0xff);
+  bytes.push_back((value >> 16) & 0xff);
+  bytes.push_back((value >> 24) & 0xff);
+}
+
+void AppendUint64(std::vector<uint8_t>& bytes, uint64_t value) {
+  AppendUint32(bytes, value & 0xffffffff);
+  AppendUint32(bytes, value >> 32);
+}
+
+size_t RecordSize(const SkData& key, const SkData& value) {
+  return kRecordHeaderSize + key.size() + value.size();
+}
+
+void AppendRecord(std::vector<uint8_t>& bytes,
+                  const SkData& key,
+                  const SkData& value) {
+  AppendUint32(bytes, key.size());
+  AppendUint32(bytes, value.size());
+  bytes.insert(bytes.end(), key.bytes(), key.bytes() + key.size());
+  bytes.insert(bytes.end(), value.bytes(), value.bytes() + value.size());
+}
+
+std::string KeyString(const SkData& key) {
+  return std::string(static_cast<const char*>(key.data()), key.size());
+}
+
+int64_t SecondsSinceEpoch() {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+void RunOnWorker(const fml::RefPtr<fml::TaskRunner>& worker,
+                 fml::closure task) {
+  if (!worker) {
+    FML_LOG(WARNING)
+        << "The persistent cache has no available workers. Performing the task "
+           "on the current thread. This slow operation is going to occur on a "
+           "frame workload.";
+    task();
+  } else {
+    worker->PostTask(std::move(task));
+  }
+}
+
+// Wraps part of |mapping| in an |SkData| that keeps the mapping alive.
+sk_sp<SkData> MakeView(const std::shared_ptr<fml::Mapping>& mapping,
+                       size_t offset,
+                       size_t size) {
+  return SkData::MakeWithProc(
+      mapping->GetMapping() + offset, size,
+      [](const void* ptr, void* context) {
+        delete static_cast<std::shared_ptr<fml::Mapping>*>(context);
+      },
+      new std::shared_ptr<fml::Mapping>(mapping));
+}
+
+// Calls |visitor| with the key and value of each complete record in
+// |mapping|, and returns the offset just past the last of them, or zero if
+// the mapping does not start with a valid header.
+template <typename Visitor>
+size_t VisitRecords(const std::shared_ptr<fml::Mapping>& mapping,
+                    const Visitor& visitor) {
+  const uint8_t* bytes = mapping->GetMapping();
+  const size_t size = mapping->GetSize();
+  if (bytes == nullptr || size < kHeaderSize ||
+      ReadUint32(bytes) != PackedShaderCache::kMagic ||
+      ReadUint32(bytes + sizeof(uint32_t)) != PackedShaderCache::kVersion) {
+    return 0;
+  }
+  size_t offset = kHeaderSize;
+  while (size - offset >= kRecordHeaderSize) {
+    const size_t key_size = ReadUint32(bytes + offset);
+    const size_t value_size = ReadUint32(bytes + offset + sizeof(uint32_t));
+    const size_t key_offset = offset + kRecordHeaderSize;
+    if (key_size == 0 || size - key_offset < key_size ||
+        size - key_offset - key_size < value_size) {
+      break;
+    }
+    visitor(MakeView(mapping, key_offset, key_size),
+            MakeView(mapping, key_offset + key_size, value_size));
+    offset = key_offset + key_size + value_size;
+  }
+  return offset;
+}
+
+}  // namespace
+
+PackedShaderCache::PackedShaderCache(std::shared_ptr<fml::UniqueFD> directory,
+                                     std::string file_name,
+                                     bool read_only)
+    : directory_(std::move(directory)),
+      file_name_(std::move(file_name)),
+      usage_file_name_(file_name_ + ".usage"),
+      read_only_(read_only),
+      write_state_(std::make_shared<WriteState>()),
+      usage_writer_(std::make_shared<UsageWriter>()),
+      clock_(&SecondsSinceEpoch) {
+  usage_writer_->cache = this;
+  Open();
+}
+
+PackedShaderCache::~PackedShaderCache() {
+  std::vector<uint8_t> bytes;
+  {
+    std::scoped_lock writer_lock(usage_writer_->mutex);
+    usage_writer_->cache = nullptr;
+    if (!usage_writer_->scheduled) {
+      return;
+    }
+    // Write the changes the posted task would have, rather than lose them.
+    std::scoped_lock lock(mutex_);
+    bytes = SerializeUsage();
+  }
+  WriteUsage(*directory_, usage_file_name_, std::move(bytes));
+}
+
+void PackedShaderCache::Open() {
+  TRACE_EVENT0("flutter", "PackedShaderCache::Open");
+  if (!directory_ || !directory_->is_valid() ||
+      !fml::FileExists(*directory_, file_name_.c_str())) {
+    return;
+  }
+  std::shared_ptr<fml::Mapping> mapping =
+      fml::FileMapping::CreateReadOnly(*directory_, file_name_);
+  if (mapping == nullptr || mapping->GetSize() == 0) {
+    return;
+  }
+#if OS_WIN
+  // Windows can't replace a file while it is mapped, and the views handed out
+  // for the records would keep the mapping alive, so compacting the file
+  // would fail for as long as any of them is in use. Read it into memory
+  // instead, and let the mapping go.
+  mapping = std::make_shared<fml::DataMapping>(std::vector<uint8_t>(
+      mapping->GetMapping(), mapping->GetMapping() + mapping->GetSize()));
+#endif  // OS_WIN
+
+  std::scoped_lock lock(mutex_);
+  const size_t valid_size = VisitRecords(mapping, [this](sk_sp<SkData> key,
+                                            sk_sp<SkData> value) {
+    auto found = index_.find(KeyString(*key));
+    if (found == index_.end()) {
+      index_[KeyString(*key)] = records_.size();
+      live_size_ += RecordSize(*key, *value);
+      records_.push_back({std::move(key), std::move(value)});
+    } else {
+      Record& record = records_[found->second];
+      live_size_ -= RecordSize(*record.key, *record.value);
+      live_size_ += RecordSize(*key, *value);
+      record.value = std::move(value);
+    }
+  });
+  if (valid_size < mapping->GetSize()) {
+    FML_LOG(WARNING) << "The shader cache file " << file_name_
+                     << " is damaged after " << valid_size << " of "
+                     << mapping->GetSize() << " bytes. It will be rewritten.";
+  } else {
+    pending_file_size_ = valid_size;
+  }
+  LoadUsage();
+}
+
+void PackedShaderCache::LoadUsage() {
+  if (records_.empty() ||
+      !fml::FileExists(*directory_, usage_file_name_.c_str())) {
+    return;
+  }
+  auto mapping =
+      fml::FileMapping::CreateReadOnly(*directory_, usage_file_name_);
+  if (mapping == nullptr) {
+    return;
+  }
+  const uint8_t* bytes = mapping->GetMapping();
+  const size_t size = mapping->GetSize();
+  if (bytes == nullptr || size < kHeaderSize ||
+      ReadUint32(bytes) != kUsageMagic ||
+      ReadUint32(bytes + sizeof(uint32_t)) != kUsageVersion) {
+    return;
+  }
+  size_t offset = kHeaderSize;
+  while (size - offset >= kUsageRecordHeaderSize) {
+    const size_t key_size = ReadUint32(bytes + offset);
+    const size_t key_offset = offset + kUsageRecordHeaderSize;
+    if (size - key_offset < key_size) {
+      break;
+    }
+    // The usage of entries that are no longer in the pack is dropped.
+    auto found = index_.find(std::string(
+        reinterpret_cast<const char*>(bytes + key_offset), key_size));
+    if (found != index_.end()) {
+      Record& record = records_[found->second];
+      record.hit_count = ReadUint32(bytes + offset + sizeof(uint32_t));
+      record.last_use = ReadUint64(bytes + offset + 2 * sizeof(uint32_t));
+    }
+    offset = key_offset + key_size;
+  }
+}
+
+std::vector<uint8_t> PackedShaderCache::Pack(
+    const std::vector<Entry>& entries) {
+  size_t size = kHeaderSize;
+  for (const auto& entry : entries) {
+    size += RecordSize(*entry.first, *entry.second);
+  }
+  std::vector<uint8_t> bytes;
+  bytes.reserve(size);
+  AppendUint32(bytes, kMagic);
+  AppendUint32(bytes, kVersion);
+  for (const auto& entry : entries) {
+    AppendRecord(bytes, *entry.first, *entry.second);
+  }
+  return bytes;
+}
+
+sk_sp<SkData> PackedShaderCache::Load(const SkData& key,
+                                      fml::RefPtr<fml::TaskRunner> worker) {
+  sk_sp<SkData> value;
+  bool first_hit = false;
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = index_.find(KeyString(key));
+    if (found == index_.end()) {
+      return nullptr;
+    }
+    Record& record = records_[found->second];
+    record.hit_count++;
+    record.last_use = clock_();
+    first_hit = !record.loaded;
+    record.loaded = true;
+    value = record.value;
+  }
+  if (first_hit && !read_only_) {
+    ScheduleUsageWrite(std::move(worker));
+  }
+  return value;
+}
+
+std::vector<PackedShaderCache::Entry> PackedShaderCache::LoadAll() const {
+  std::scoped_lock lock(mutex_);
+  std::vector<Entry> entries;
+  entries.reserve(records_.size());
+  for (const auto& record : records_) {
+    entries.push_back({record.key, record.value});
+  }
+  return entries;
+}
+
+void PackedShaderCache::Store(const SkData& key,
+                              const SkData& value,
+                              fml::RefPtr<fml::TaskRunner> worker) {
+  sk_sp<SkData> key_data = SkData::MakeWithCopy(key.data(), key.size());
+  sk_sp<SkData> value_data = SkData::MakeWithCopy(value.data(), value.size());
+
+  {
+    std::scoped_lock lock(mutex_);
+    StoreLocked(std::move(key_data), std::move(value_data), worker);
+  }
+  ScheduleUsageWrite(std::move(worker));
+}
+
+void PackedShaderCache::StoreLocked(
+    sk_sp<SkData> key_data,
+    sk_sp<SkData> value_data,
+    const fml::RefPtr<fml::TaskRunner>& worker) {
+  const std::string key_string = KeyString(*key_data);
+  auto found = index_.find(key_string);
+  if (found == index_.end()) {
+    found = index_.emplace(key_string, records_.size()).first;
+    records_.push_back({key_data, value_data});
+  } else {
+    Record& record = records_[found->second];
+    live_size_ -= RecordSize(*record.key, *record.value);
+    record.value = value_data;
+  }
+  // Compiling a shader counts as using it.
+  records_[found->second].last_use = clock_();
+  const size_t record_size = RecordSize(*key_data, *value_data);
+  live_size_ += record_size;
+
+  const bool pruned = max_size_ != 0 &&
+                      kHeaderSize + live_size_ > max_size_ &&
+                      Prune(key_string);
+
+  bool write_failed = false;
+  {
+    std::scoped_lock write_lock(write_state_->mutex);
+    write_failed = write_state_->failed;
+  }
+
+  // The space taken up by superseded records once this one is appended.
+  const size_t dead_size =
+      pending_file_size_ == 0
+          ? 0
+          : pending_file_size_ + record_size - kHeaderSize - live_size_;
+  const bool rewrite =
+      pruned || pending_file_size_ == 0 || write_failed ||
+      (dead_size >= kMinCompactionBytes && dead_size > live_size_);
+
+  // Tasks are posted while holding the lock, so that the files are written in
+  // the same order as the changes they reflect.
+  fml::closure task;
+  if (rewrite) {
+    std::vector<Entry> entries;
+    entries.reserve(records_.size());
+    for (const auto& record : records_) {
+      entries.push_back({record.key, record.value});
+    }
+    pending_file_size_ = kHeaderSize + live_size_;
+    task = fml::MakeCopyable([directory = directory_, file_name = file_name_,
+                              write_state = write_state_,
+                              entries = std::move(entries)]() {
+      TRACE_EVENT0("flutter", "PackedShaderCache::Compact");
+      const bool written = fml::WriteAtomically(
+          *directory, file_name.c_str(), fml::DataMapping(Pack(entries)));
+      if (!written) {
+        FML_LOG(WARNING) << "Could not write the shader cache file.";
+      }
+      std::scoped_lock write_lock(write_state->mutex);
+      write_state->failed = !written;
+    });
+  } else {
+    std::vector<uint8_t> bytes;
+    bytes.reserve(record_size);
+    AppendRecord(bytes, *key_data, *value_data);
+    pending_file_size_ += record_size;
+    task = fml::MakeCopyable([directory = directory_, file_name = file_name_,
+                              write_state = write_state_,
+                              bytes = std::move(bytes)]() mutable {
+      TRACE_EVENT0("flutter", "PackedShaderCache::Append");
+      std::scoped_lock write_lock(write_state->mutex);
+      if (write_state->failed) {
+        return;
+      }
+      if (!fml::AppendToFile(*directory, file_name.c_str(),
+                             fml::DataMapping(std::move(bytes)))) {
+        FML_LOG(WARNING) << "Could not append to the shader cache file.";
+        write_state->failed = true;
+      }
+    });
+  }
+  RunOnWorker(worker, std::move(task));
+}
+
+bool PackedShaderCache::Prune(const std::string& keep) {
+  TRACE_EVENT0("flutter", "PackedShaderCache::Prune");
+  std::vector<size_t> candidates;
+  candidates.reserve(records_.size());
+  for (size_t i = 0; i < records_.size(); i++) {
+    if (KeyString(*records_[i].key) != keep) {
+      candidates.push_back(i);
+    }
+  }
+  // Least recently used first, then least often used, then oldest.
+  std::sort(candidates.begin(), candidates.end(),
+            [this](const size_t& a, const size_t& b) {
+              const Record& record_a = records_[a];
+              const Record& record_b = records_[b];
+              return std::tie(record_a.last_use, record_a.hit_count, a) <
+                     std::tie(record_b.last_use, record_b.hit_count, b);
+            });
+
+  std::vector<bool> evicted(records_.size(), false);
+  size_t evicted_count = 0;
+  for (size_t i : candidates) {
+    if (kHeaderSize + live_size_ <= max_size_) {
+      break;
+    }
+    live_size_ -= RecordSize(*records_[i].key, *records_[i].value);
+    evicted[i] = true;
+    evicted_count++;
+  }
+  if (evicted_count == 0) {
+    return false;
+  }
+
+  std::vector<Record> kept;
+  kept.reserve(records_.size() - evicted_count);
+  index_.clear();
+  for (size_t i = 0; i < records_.size(); i++) {
+    if (!evicted[i]) {
+      index_[KeyString(*records_[i].key)] = kept.size();
+      kept.push_back(std::move(records_[i]));
+    }
+  }
+  records_ = std::move(kept);
+  FML_DLOG(INFO) << "Evicted " << evicted_count << " entries from the shader "
+                 << "cache file " << file_name_ << ".";
+  return true;
+}
+
+void PackedShaderCache::ScheduleUsageWrite(
+    fml::RefPtr<fml::TaskRunner> worker) {
+  // Without a worker, the files are written on the calling thread as
+  // entries are stored, and so is the usage.
+  if (!worker) {
+    std::vector<uint8_t> bytes;
+    {
+      std::scoped_lock lock(mutex_);
+      bytes = SerializeUsage();
+    }
+    WriteUsage(*directory_, usage_file_name_, std::move(bytes));
+    return;
+  }
+
+  {
+    std::scoped_lock writer_lock(usage_writer_->mutex);
+    if (usage_writer_->scheduled) {
+      return;
+    }
+    usage_writer_->scheduled = true;
+  }
+  worker->PostDelayedTask(
+      [writer = usage_writer_, directory = directory_,
+       file_name = usage_file_name_]() {
+        std::vector<uint8_t> bytes;
+        {
+          std::scoped_lock writer_lock(writer->mutex);
+          writer->scheduled = false;
+          // The cache wrote its usage itself when it was destroyed.
+          if (writer->cache == nullptr) {
+            return;
+          }
+          std::scoped_lock lock(writer->cache->mutex_);
+          bytes = writer->cache->SerializeUsage();
+        }
+        WriteUsage(*directory, file_name, std::move(bytes));
+      },
+      kUsageWriteDelay);
+}
+
+std::vector<uint8_t> PackedShaderCache::SerializeUsage() const {
+  std::vector<uint8_t> bytes;
+  AppendUint32(bytes, kUsageMagic);
+  AppendUint32(bytes, kUsageVersion);
+  for (const auto& record : records_) {
+    AppendUint32(bytes, record.key->size());
+    AppendUint32(bytes, record.hit_count);
+    AppendUint64(bytes, record.last_use);
+    bytes.insert(bytes.end(), record.key->bytes(),
+                 record.key->bytes() + record.key->size());
+  }
+  return bytes;
+}
+
+void PackedShaderCache::WriteUsage(const fml::UniqueFD& directory,
+                                   const std::string& file_name,
+                                   std::vector<uint8_t> bytes) {
+  TRACE_EVENT0("flutter", "PackedShaderCache::WriteUsage");
+  if (!fml::WriteAtomically(directory, file_name.c_str(),
+                            fml::DataMapping(std::move(bytes)))) {
+    FML_LOG(WARNING) << "Could not write the shader cache usage file.";
+  }
+}
+
+void PackedShaderCache::Clear() {
+  std::scoped_lock lock(mutex_);
+  index_.clear();
+  records_.clear();
+  pending_file_size_ = 0;
+  live_size_ = 0;
+}
+
+size_t PackedShaderCache::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return records_.size();
+}
+
+size_t PackedShaderCache::GetSize() const {
+  std::scoped_lock lock(mutex_);
+  return records_.empty() ? 0 : kHeaderSize + live_size_;
+}
+
+void PackedShaderCache::SetMaxSize(size_t max_size) {
+  std::scoped_lock lock(mutex_);
+  max_size_ = max_size;
+}
+
+std::vector<PackedShaderCache::EntryUsage> PackedShaderCache::GetUsage()
+    const {
+  std::scoped_lock lock(mutex_);
+  std::vector<EntryUsage> usage;
+  usage.reserve(records_.size());
+  for (const auto& record : records_) {
+    usage.push_back({record.key, RecordSize(*record.key, *record.value),
+                     record.hit_count, record.last_use});
+  }
+  return usage;
+}
+
+void PackedShaderCache::SetClockForTesting(Clock clock) {
+  std::scoped_lock lock(mutex_);
+  clock_ = std::move(clock);
+}
+
+}  // namespace flutter
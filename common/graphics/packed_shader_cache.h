@@ -0,0 +1,221 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_GRAPHICS_PACKED_SHADER_CACHE_H_
+#define FLUTTER_COMMON_GRAPHICS_PACKED_SHADER_CACHE_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/core/SkData.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A shader cache kept in a single file, rather than one file per key.
+///
+/// The file starts with a magic number and format version, followed by
+/// records of a 32-bit key size, a 32-bit value size, the key and the value.
+/// Sizes are little-endian. The file is memory mapped and indexed when the
+/// cache is opened, which reads only the record headers, and loaded entries are
+/// views into the mapping rather than copies. On Windows, where a mapped file
+/// can't be replaced, the file is read into memory instead.
+///
+/// New entries are appended to the file. Storing a key again appends a new
+/// record that supersedes the old one, and once superseded records take up
+/// more space than live ones, or the end of the file is found to be
+/// truncated, the file is compacted by rewriting it atomically with only the
+/// live records. All file writes are made in order on the worker task runner
+/// passed to |Store|. Appended records are not flushed to storage, since a
+/// record lost to a crash only shows up as a truncated file, which is rewritten
+/// the next time it is opened. If a write fails, the file is rewritten by the
+/// next |Store|.
+///
+/// How often and how recently each entry was loaded is kept in a second file
+/// next to the pack. When an entry is stored or first loaded in a session, the
+/// file is rewritten a short while later, along with any other changes made in
+/// the meantime. Hit counts from later loads are written along with the next
+/// such change. If a size limit is set, storing an entry that takes
+/// the cache over the limit first evicts the least recently used entries.
+///
+/// This class is thread-safe.
+///
+class PackedShaderCache {
+ public:
+  using Entry = std::pair<sk_sp<SkData>, sk_sp<SkData>>;
+
+  static constexpr uint32_t kMagic = 0x4b505346;  // "FSPK"
+  static constexpr uint32_t kVersion = 1;
+  static constexpr uint32_t kUsageMagic = 0x55505346;  // "FSPU"
+  static constexpr uint32_t kUsageVersion = 1;
+
+  /// How an entry has been used, for reporting and eviction.
+  struct EntryUsage {
+    sk_sp<SkData> key;
+    /// The size of the entry's record in the file.
+    size_t size = 0;
+    uint32_t hit_count = 0;
+    /// When the entry was last stored or loaded, in seconds since the epoch.
+    int64_t last_use = 0;
+  };
+
+  /// Returns the current time in seconds since the epoch.
+  using Clock = std::function<int64_t()>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Opens the cache file |file_name| in |directory|, which need
+  ///             not exist yet. A |read_only| cache does not record the
+  ///             entries' usage.
+  ///
+  PackedShaderCache(std::shared_ptr<fml::UniqueFD> directory,
+                    std::string file_name,
+                    bool read_only = false);
+
+  ~PackedShaderCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Serializes |entries| in the packed format.
+  ///
+  static std::vector<uint8_t> Pack(const std::vector<Entry>& entries);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Loads the value stored for |key| and counts the hit. The
+  ///             first hit of an entry is recorded on |worker|, or on the
+  ///             calling thread if there is no worker.
+  ///
+  /// @return     The value stored for |key|, or nullptr if there is none.
+  ///
+  sk_sp<SkData> Load(const SkData& key, fml::RefPtr<fml::TaskRunner> worker);
+
+  //----------------------------------------------------------------------------
+  /// @return     All entries, in the order their keys were first stored.
+  ///
+  std::vector<Entry> LoadAll() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stores |value| for |key|. The entry is available to |Load|
+  ///             right away, and written to the file on |worker|, or on the
+  ///             calling thread if there is no worker.
+  ///
+  void Store(const SkData& key,
+             const SkData& value,
+             fml::RefPtr<fml::TaskRunner> worker);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Forgets all entries, for use once the file has been removed.
+  ///
+  void Clear();
+
+  size_t GetEntryCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @return     The size of the file once all posted writes have been made,
+  ///             not counting superseded records.
+  ///
+  size_t GetSize() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Limits the size of the file to |max_size| bytes, or removes
+  ///             the limit if it is zero. The limit is enforced by the next
+  ///             call to |Store|.
+  ///
+  void SetMaxSize(size_t max_size);
+
+  //----------------------------------------------------------------------------
+  /// @return     The usage of all entries, in the order their keys were first
+  ///             stored.
+  ///
+  std::vector<EntryUsage> GetUsage() const;
+
+  void SetClockForTesting(Clock clock);
+
+ private:
+  struct Record {
+    sk_sp<SkData> key;
+    sk_sp<SkData> value;
+    uint32_t hit_count = 0;
+    int64_t last_use = 0;
+    // Whether this session has loaded the entry yet.
+    bool loaded = false;
+  };
+
+  // The outcome of the writes made on the worker, which may outlive the
+  // cache.
+  struct WriteState {
+    std::mutex mutex;
+    // Set when a write fails, until the file is next rewritten. The end of
+    // the file is not known meanwhile, so appends are skipped.
+    bool failed = false;
+  };
+
+  const std::shared_ptr<fml::UniqueFD> directory_;
+  const std::string file_name_;
+  const std::string usage_file_name_;
+  const bool read_only_;
+  const std::shared_ptr<WriteState> write_state_;
+
+  // Shared with the task that writes the usage file, which may outlive the
+  // cache.
+  struct UsageWriter {
+    std::mutex mutex;
+    // The cache whose usage is written, or null once it has been destroyed.
+    PackedShaderCache* cache = nullptr;
+    // Whether a write has been posted and has not started yet.
+    bool scheduled = false;
+  };
+  const std::shared_ptr<UsageWriter> usage_writer_;
+
+  mutable std::mutex mutex_;
+  // Indexed by the key's bytes, in the order the keys were first stored.
+  std::unordered_map<std::string, size_t> index_;
+  std::vector<Record> records_;
+  // The size the file will have once all posted writes have succeeded, or
+  // zero if it is to be rewritten, and how much of that is taken up by live
+  // records.
+  size_t pending_file_size_ = 0;
+  size_t live_size_ = 0;
+  size_t max_size_ = 0;
+  Clock clock_;
+
+  void Open();
+
+  void LoadUsage();
+
+  // Stores an entry and posts the write of the file to |worker|. Called with
+  // |mutex_| held.
+  void StoreLocked(sk_sp<SkData> key_data,
+                   sk_sp<SkData> value_data,
+                   const fml::RefPtr<fml::TaskRunner>& worker);
+
+  // Evicts the least recently used entries other than |keep| until the file
+  // fits in |max_size_|. Returns whether any entry was evicted.
+  bool Prune(const std::string& keep);
+
+  // Posts a write of the usage file to |worker|, unless one is already
+  // waiting to run. Must not be called with |mutex_| held.
+  void ScheduleUsageWrite(fml::RefPtr<fml::TaskRunner> worker);
+
+  // Serializes the usage of all entries. Called with |mutex_| held.
+  std::vector<uint8_t> SerializeUsage() const;
+
+  static void WriteUsage(const fml::UniqueFD& directory,
+                         const std::string& file_name,
+                         std::vector<uint8_t> bytes);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedShaderCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_COMMON_GRAPHICS_PACKED_SHADER_CACHE_H_
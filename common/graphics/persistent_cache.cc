@@ -85,7 +85,7 @@ bool PersistentCache::Purge() {
   FML_CHECK(GetWorkerTaskRunner());
 
   std::promise<bool> removed;
-  GetWorkerTaskRunner()->PostTask([&removed,
+  GetWorkerTaskRunner()->PostTask([this, &removed,
                                    cache_directory = cache_directory_]() {
     if (cache_directory->is_valid()) {
       // Only remove files but not directories.
@@ -98,7 +98,11 @@ bool PersistentCache::Purge() {
         }
         return fml::UnlinkFile(directory, filename.c_str());
       };
-      removed.set_value(VisitFilesRecursively(*cache_directory, delete_file));
+      const bool result = VisitFilesRecursively(*cache_directory, delete_file);
+      // The packs were deleted with everything else.
+      pack_->Clear();
+      sksl_pack_->Clear();
+      removed.set_value(result);
     } else {
       removed.set_value(false);
     }
@@ -210,6 +214,7 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() {
   // However, we'd like to continue visit the asset dir even if this persistent
   // cache is invalid.
   if (IsValid()) {
+    result = sksl_pack_->LoadAll();
     // In case `rewinddir` doesn't work reliably, load SkSLs from a freshly
     // opened directory (https://github.com/flutter/flutter/issues/65258).
     fml::UniqueFD fresh_dir =
@@ -257,7 +262,12 @@ PersistentCache::PersistentCache(bool read_only)
   if (!IsValid()) {
     FML_LOG(WARNING) << "Could not acquire the persistent cache directory. "
                         "Caching of GPU resources on disk is disabled.";
+    return;
   }
+  pack_ = std::make_unique<PackedShaderCache>(cache_directory_, kPackFileName,
+                                              is_read_only_);
+  sksl_pack_ = std::make_unique<PackedShaderCache>(
+      cache_directory_, kSkSLPackFileName, is_read_only_);
 }
 
 PersistentCache::~PersistentCache() = default;
@@ -285,11 +295,14 @@ sk_sp<SkData> PersistentCache::load(const SkData& key) {
   if (!IsValid()) {
     return nullptr;
   }
-  auto file_name = SkKeyToFilePath(key);
-  if (file_name.size() == 0) {
-    return nullptr;
+  auto result = pack_->Load(key, GetWorkerTaskRunner());
+  if (result == nullptr) {
+    auto file_name = SkKeyToFilePath(key);
+    if (file_name.size() == 0) {
+      return nullptr;
+    }
+    result = PersistentCache::LoadFile(*cache_directory_, file_name);
   }
-  auto result = PersistentCache::LoadFile(*cache_directory_, file_name);
   if (result != nullptr) {
     TRACE_EVENT0("flutter", "PersistentCacheLoadHit");
   }
@@ -327,6 +340,7 @@ static void PersistentCacheStore(fml::RefPtr<fml::TaskRunner> worker,
 // |GrContextOptions::PersistentCache|
 void PersistentCache::store(const SkData& key, const SkData& data) {
   stored_new_shaders_ = true;
+  RecordStoredShader(key);
 
   if (is_read_only_) {
     return;
@@ -336,22 +350,55 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
     return;
   }
 
-  auto file_name = SkKeyToFilePath(key);
-
-  if (file_name.size() == 0) {
+  if (key.size() == 0 || data.size() == 0) {
     return;
   }
 
-  auto mapping = std::make_unique<fml::DataMapping>(
-      std::vector<uint8_t>{data.bytes(), data.bytes() + data.size()});
+  PackedShaderCache* pack = cache_sksl_ ? sksl_pack_.get() : pack_.get();
+  pack->Store(key, data, GetWorkerTaskRunner());
+}
 
-  if (mapping == nullptr || mapping->GetSize() == 0) {
+void PersistentCache::RecordStoredShader(const SkData& key) {
+  std::string file_name = SkKeyToFilePath(key);
+  if (file_name.empty()) {
     return;
   }
+  std::scoped_lock lock(stored_shaders_mutex_);
+  if (stored_shader_set_.insert(file_name).second) {
+    stored_shaders_.push_back(std::move(file_name));
+  }
+}
 
-  PersistentCacheStore(GetWorkerTaskRunner(),
-                       cache_sksl_ ? sksl_cache_directory_ : cache_directory_,
-                       std::move(file_name), std::move(mapping));
+std::vector<std::string> PersistentCache::GetShadersStoredThisSession() const {
+  std::scoped_lock lock(stored_shaders_mutex_);
+  return stored_shaders_;
+}
+
+std::vector<PackedShaderCache::EntryUsage> PersistentCache::GetShaderUsage()
+    const {
+  if (!IsValid()) {
+    return {};
+  }
+  return cache_sksl_ ? sksl_pack_->GetUsage() : pack_->GetUsage();
+}
+
+size_t PersistentCache::GetSize() const {
+  return IsValid() ? pack_->GetSize() : 0;
+}
+
+void PersistentCache::SetSizeLimit(size_t size_limit) {
+  size_limit_ = size_limit;
+  if (IsValid()) {
+    pack_->SetMaxSize(size_limit);
+  }
+}
+
+void PersistentCache::RaiseSizeLimit(size_t size_limit) {
+  std::scoped_lock lock(size_limit_mutex_);
+  if (size_limit == 0 || size_limit_ >= size_limit) {
+    return;
+  }
+  SetSizeLimit(size_limit);
 }
 
 void PersistentCache::DumpSkp(const SkData& data) {
@@ -372,6 +419,17 @@ void PersistentCache::DumpSkp(const SkData& data) {
                        std::move(file_name), std::move(mapping));
 }
 
+void PersistentCache::DumpStartupReport(const std::string& report) {
+  if (is_read_only_ || !IsValid()) {
+    FML_LOG(ERROR) << "Could not dump the startup report to a read-only or "
+                      "invalid persistent cache.";
+    return;
+  }
+  PersistentCacheStore(GetWorkerTaskRunner(), cache_directory_,
+                       kStartupReportFileName,
+                       std::make_unique<fml::DataMapping>(report));
+}
+
 void PersistentCache::AddWorkerTaskRunner(
     fml::RefPtr<fml::TaskRunner> task_runner) {
   std::scoped_lock lock(worker_task_runners_mutex_);
@@ -8,8 +8,11 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <string>
+#include <vector>
 
 #include "flutter/assets/asset_manager.h"
+#include "flutter/common/graphics/packed_shader_cache.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
 #include "flutter/fml/unique_fd.h"
@@ -25,6 +28,11 @@ class ShellTest;
 ///
 /// This is mainly used for Shaders but is also written to by Dart.  It is
 /// thread-safe for reading and writing from multiple threads.
+///
+/// Entries are stored in a |PackedShaderCache| file, one for binary shaders
+/// and one for SkSLs. Entries in individual files named after their Base32
+/// encoded keys, as written by earlier versions or generated ahead of time
+/// for read-only caches, are still read.
 class PersistentCache : public GrContextOptions::PersistentCache {
  public:
   // Mutable static switch that can be set before GetCacheForProcess. If true,
@@ -58,10 +66,36 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   // frame so we can know if Skia tries to compile new shaders in that frame.
   bool StoredNewShaders() const { return stored_new_shaders_; }
   void ResetStoredNewShaders() { stored_new_shaders_ = false; }
+
+  // The Base32 encoded keys of the shaders Skia stored since this cache was
+  // created, in the order they were first stored. These are the shaders that
+  // had to be compiled while the application was running, including in a
+  // read-only cache, where they are not saved.
+  std::vector<std::string> GetShadersStoredThisSession() const;
+
+  // How the shaders in the cache for the current strategy have been used, for
+  // reporting. Only shaders in the packed caches are included.
+  std::vector<PackedShaderCache::EntryUsage> GetShaderUsage() const;
+
+  // The size of the binary shaders in the cache, and the limit past which the
+  // least recently used ones are evicted, or zero if there is none. SkSLs are
+  // only cached during development and are not limited.
+  size_t GetSize() const;
+  size_t GetSizeLimit() const { return size_limit_; }
+  void SetSizeLimit(size_t size_limit);
+  // Raises the size limit to |size_limit| if there is a lower one, or sets it
+  // if there is none. The cache is shared by all shells in the process, so the
+  // largest limit any of them asks for applies. Zero is ignored.
+  void RaiseSizeLimit(size_t size_limit);
+
   void DumpSkp(const SkData& data);
   bool IsDumpingSkp() const { return is_dumping_skp_; }
   void SetIsDumpingSkp(bool value) { is_dumping_skp_ = value; }
 
+  // Writes the JSON |report| of the engine startup to |kStartupReportFileName|
+  // in the cache directory, replacing that of the previous run.
+  void DumpStartupReport(const std::string& report);
+
   // Remove all files inside the persistent cache directory.
   // Return whether the purge is successful.
   bool Purge();
@@ -72,6 +106,10 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   using SkSLCache = std::pair<sk_sp<SkData>, sk_sp<SkData>>;
 
   /// Load all the SkSL shader caches in the right directory.
+  ///
+  /// Shaders captured on this device come first, in the order in which they
+  /// were first stored, followed by those in individual files, and then those
+  /// bundled in the assets, in the order they are listed there.
   std::vector<SkSLCache> LoadSkSLs();
 
   // Return mappings for all skp's accessible through the AssetManager
@@ -87,6 +125,9 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   static constexpr char kSkSLSubdirName[] = "sksl";
   static constexpr char kAssetFileName[] = "io.flutter.shaders.json";
+  static constexpr char kPackFileName[] = "shaders.pack";
+  static constexpr char kSkSLPackFileName[] = "sksl.pack";
+  static constexpr char kStartupReportFileName[] = "startup_report.json";
 
  private:
   static std::string cache_base_path_;
@@ -112,7 +153,17 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   mutable std::mutex worker_task_runners_mutex_;
   std::multiset<fml::RefPtr<fml::TaskRunner>> worker_task_runners_;
 
+  // Both packs live in |cache_directory_|, so that they are not mistaken for
+  // individual SkSL files.
+  std::unique_ptr<PackedShaderCache> pack_;
+  std::unique_ptr<PackedShaderCache> sksl_pack_;
+
   bool stored_new_shaders_ = false;
+  std::mutex size_limit_mutex_;
+  std::atomic<size_t> size_limit_ = 0;
+  mutable std::mutex stored_shaders_mutex_;
+  std::vector<std::string> stored_shaders_;
+  std::set<std::string> stored_shader_set_;
   bool is_dumping_skp_ = false;
 
   static sk_sp<SkData> LoadFile(const fml::UniqueFD& dir,
@@ -125,6 +176,8 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   // |GrContextOptions::PersistentCache|
   void store(const SkData& key, const SkData& data) override;
 
+  void RecordStoredShader(const SkData& key);
+
   fml::RefPtr<fml::TaskRunner> GetWorkerTaskRunner() const;
 
   friend class testing::ShellTest;
@@ -25,6 +25,8 @@ std::string Settings::ToString() const {
          << std::endl;
   stream << "isolate_snapshot_instr_path: " << isolate_snapshot_instr_path
          << std::endl;
+  stream << "prefetch_snapshots: " << prefetch_snapshots << std::endl;
+  stream << "snapshot_huge_pages: " << snapshot_huge_pages << std::endl;
   stream << "application_library_path:" << std::endl;
   for (const auto& path : application_library_path) {
     stream << "    " << path << std::endl;
@@ -53,10 +55,14 @@ std::string Settings::ToString() const {
   stream << "use_test_fonts: " << use_test_fonts << std::endl;
   stream << "enable_software_rendering: " << enable_software_rendering
          << std::endl;
+  stream << "enable_tiled_software_rendering: "
+         << enable_tiled_software_rendering << std::endl;
   stream << "log_tag: " << log_tag << std::endl;
   stream << "icu_initialization_required: " << icu_initialization_required
          << std::endl;
   stream << "icu_data_path: " << icu_data_path << std::endl;
+  stream << "icu_lazy_initialization: " << icu_lazy_initialization
+         << std::endl;
   stream << "assets_dir: " << assets_dir << std::endl;
   stream << "assets_path: " << assets_path << std::endl;
   stream << "frame_rasterized_callback set: " << !!frame_rasterized_callback
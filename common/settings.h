@@ -79,6 +79,15 @@ struct Settings {
   std::string isolate_snapshot_instr_path;  // deprecated
   MappingCallback isolate_snapshot_instr;
 
+  // Whether to read the snapshots ahead of their first use, in the background
+  // while the shell is being set up, so that running the application doesn't
+  // wait on page faults.
+  bool prefetch_snapshots = false;
+
+  // Whether to ask for the snapshot instructions to be backed by transparent
+  // huge pages, where the platform and file system allow it.
+  bool snapshot_huge_pages = false;
+
   // Returns the Mapping to a kernel buffer which contains sources for dart:*
   // libraries.
   MappingCallback dart_library_sources_kernel;
@@ -107,6 +116,10 @@ struct Settings {
   bool dump_skp_on_shader_compilation = false;
   bool cache_sksl = false;
   bool purge_persistent_cache = false;
+  // The size limit in bytes for the binary shaders in the persistent cache,
+  // beyond which the least recently used ones are evicted. Zero means no
+  // limit.
+  size_t persistent_cache_size_limit = 0;
   bool endless_trace_buffer = false;
   bool enable_dart_profiling = false;
   bool disable_dart_asserts = false;
@@ -155,6 +168,10 @@ struct Settings {
   // Selects the SkParagraph implementation of the text layout engine.
   bool enable_skparagraph = false;
 
+  // Records pictures into the engine's own display lists instead of
+  // SkPictures.
+  bool enable_display_list = false;
+
   // All shells in the process share the same VM. The last shell to shutdown
   // should typically shut down the VM as well. However, applications depend on
   // the behavior of "warming-up" the VM by creating a shell that does not do
@@ -202,6 +219,9 @@ struct Settings {
   // blocking calls in this callback will cause applications to jank.
   UnhandledExceptionCallback unhandled_exception_callback;
   bool enable_software_rendering = false;
+  // Splits frames that are rendered in software into tiles, which are painted
+  // in parallel on the concurrent worker threads.
+  bool enable_tiled_software_rendering = false;
   bool skia_deterministic_rendering_on_cpu = false;
   bool verbose_logging = false;
   std::string log_tag = "flutter";
@@ -213,6 +233,10 @@ struct Settings {
   bool icu_initialization_required = true;
   std::string icu_data_path;
   MappingCallback icu_mapper;
+  // Whether the ICU data is opened and mapped in the background once the
+  // shell is set up, or when ICU is first used if that is sooner, instead of
+  // while the shell is created.
+  bool icu_lazy_initialization = false;
 
   // Assets settings
   fml::UniqueFD::element_type assets_dir =
@@ -0,0 +1,196 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/startup_report.h"
+
+#include <algorithm>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/logging.h"
+
+#if !OS_WIN && !OS_FUCHSIA
+#include <sys/resource.h>
+#endif
+
+namespace flutter {
+
+static std::optional<StartupReport::PageFaults> GetProcessPageFaults() {
+#if !OS_WIN && !OS_FUCHSIA
+  struct rusage usage = {};
+  if (::getrusage(RUSAGE_SELF, &usage) != 0) {
+    return std::nullopt;
+  }
+  StartupReport::PageFaults faults;
+  faults.minor = usage.ru_minflt;
+  faults.major = usage.ru_majflt;
+  return faults;
+#else
+  return std::nullopt;
+#endif
+}
+
+const char* StartupReport::GetPhaseName(Phase phase) {
+  switch (phase) {
+    case Phase::kICUInitialization:
+      return "icuInitialization";
+    case Phase::kSnapshotMapping:
+      return "snapshotMapping";
+    case Phase::kVMInitialization:
+      return "vmInitialization";
+    case Phase::kAssetManagerCreation:
+      return "assetManagerCreation";
+    case Phase::kIsolateCreation:
+      return "isolateCreation";
+    case Phase::kRootIsolateMain:
+      return "rootIsolateMain";
+    case Phase::kFontLoading:
+      return "fontLoading";
+    case Phase::kBeginFrame:
+      return "beginFrame";
+    case Phase::kRasterizerDraw:
+      return "rasterizerDraw";
+    case Phase::kShaderCompilation:
+      return "shaderCompilation";
+  }
+  FML_UNREACHABLE();
+}
+
+StartupReport::ScopedPhase::ScopedPhase(Phase phase)
+    : phase_(phase),
+      start_(GetReportForProcess()->IsComplete()
+                 ? std::nullopt
+                 : std::optional<fml::TimePoint>(fml::TimePoint::Now())) {}
+
+StartupReport::ScopedPhase::~ScopedPhase() {
+  if (start_.has_value()) {
+    GetReportForProcess()->RecordPhase(phase_, start_.value(),
+                                       fml::TimePoint::Now());
+  }
+}
+
+StartupReport* StartupReport::GetReportForProcess() {
+  static StartupReport* report = new StartupReport();
+  return report;
+}
+
+StartupReport::StartupReport() = default;
+
+StartupReport::~StartupReport() = default;
+
+void StartupReport::SetStartTime(fml::TimePoint start) {
+  std::scoped_lock lock(mutex_);
+  if (!start_time_.has_value()) {
+    start_time_ = start;
+    start_page_faults_ = GetProcessPageFaults();
+  }
+}
+
+void StartupReport::RecordPhase(Phase phase,
+                                fml::TimePoint start,
+                                fml::TimePoint end) {
+  if (complete_) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  Span& span = spans_[static_cast<size_t>(phase)];
+  if (!span.start.has_value() || start < span.start.value()) {
+    span.start = start;
+  }
+  span.end = std::max(span.end, end);
+  span.duration = span.duration + (end - start);
+  span.count++;
+}
+
+bool StartupReport::MarkFirstFrameRasterized(fml::TimePoint time) {
+  std::scoped_lock lock(mutex_);
+  if (complete_) {
+    return false;
+  }
+  first_frame_time_ = time;
+  first_frame_page_faults_ = GetProcessPageFaults();
+  complete_ = true;
+  return true;
+}
+
+std::optional<fml::TimePoint> StartupReport::GetStartTime() const {
+  std::scoped_lock lock(mutex_);
+  if (start_time_.has_value()) {
+    return start_time_;
+  }
+  std::optional<fml::TimePoint> earliest;
+  for (const auto& span : spans_) {
+    if (span.start.has_value() &&
+        (!earliest.has_value() || span.start.value() < earliest.value())) {
+      earliest = span.start;
+    }
+  }
+  return earliest;
+}
+
+std::optional<fml::TimePoint> StartupReport::GetFirstFrameTime() const {
+  std::scoped_lock lock(mutex_);
+  return first_frame_time_;
+}
+
+std::vector<StartupReport::PhaseTiming> StartupReport::GetPhaseTimings()
+    const {
+  std::vector<PhaseTiming> timings;
+  std::optional<fml::TimePoint> start_time = GetStartTime();
+  std::scoped_lock lock(mutex_);
+  for (size_t i = 0; i < kPhaseCount; i++) {
+    const Span& span = spans_[i];
+    if (span.count == 0) {
+      continue;
+    }
+    PhaseTiming timing;
+    timing.phase = static_cast<Phase>(i);
+    timing.start = span.start.value();
+    timing.end = span.end;
+    timing.duration = span.duration;
+    timing.count = span.count;
+    timings.push_back(timing);
+  }
+  std::stable_sort(timings.begin(), timings.end(),
+                   [](const PhaseTiming& a, const PhaseTiming& b) {
+                     return a.start < b.start;
+                   });
+
+  fml::TimePoint covered_until = start_time.value_or(fml::TimePoint());
+  for (auto& timing : timings) {
+    if (timing.start > covered_until) {
+      timing.gap_before = timing.start - covered_until;
+    }
+    covered_until = std::max(covered_until, timing.end);
+  }
+  return timings;
+}
+
+std::optional<StartupReport::PageFaults> StartupReport::GetPageFaults() const {
+  std::scoped_lock lock(mutex_);
+  if (!start_page_faults_.has_value()) {
+    return std::nullopt;
+  }
+  std::optional<PageFaults> end = first_frame_page_faults_.has_value()
+                                      ? first_frame_page_faults_
+                                      : GetProcessPageFaults();
+  if (!end.has_value()) {
+    return std::nullopt;
+  }
+  PageFaults faults;
+  faults.minor = end->minor - start_page_faults_->minor;
+  faults.major = end->major - start_page_faults_->major;
+  return faults;
+}
+
+void StartupReport::ResetForTesting() {
+  std::scoped_lock lock(mutex_);
+  complete_ = false;
+  start_time_.reset();
+  first_frame_time_.reset();
+  start_page_faults_.reset();
+  first_frame_page_faults_.reset();
+  spans_ = {};
+}
+
+}  // namespace flutter
@@ -0,0 +1,158 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_STARTUP_REPORT_H_
+#define FLUTTER_COMMON_STARTUP_REPORT_H_
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Records where the time goes between the engine being started and the first
+/// frame being rasterized.
+///
+/// Each phase of startup is recorded as spans of time, by whichever part of
+/// the engine does the work. Spans recorded after the first frame has been
+/// rasterized are ignored, so that recording costs no more than checking a
+/// flag once startup is over. The report covers the process, so when several
+/// shells start at once, their spans are added up.
+///
+class StartupReport {
+ public:
+  enum class Phase {
+    kICUInitialization,
+    kSnapshotMapping,
+    kVMInitialization,
+    kAssetManagerCreation,
+    kIsolateCreation,
+    kRootIsolateMain,
+    kFontLoading,
+    kBeginFrame,
+    kRasterizerDraw,
+    kShaderCompilation,
+  };
+
+  static constexpr size_t kPhaseCount =
+      static_cast<size_t>(Phase::kShaderCompilation) + 1;
+
+  static const char* GetPhaseName(Phase phase);
+
+  struct PhaseTiming {
+    Phase phase;
+    // The start of the first span and the end of the last.
+    fml::TimePoint start;
+    fml::TimePoint end;
+    // The sum of the spans, which is less than |end - start| if the phase
+    // was interrupted.
+    fml::TimeDelta duration;
+    size_t count = 0;
+    // The time since the end of the phases that started before this one, or
+    // zero if this one overlaps them. This is time spent in the critical path
+    // to the first frame that no phase accounts for.
+    fml::TimeDelta gap_before;
+  };
+
+  struct PageFaults {
+    // Faults served without I/O, such as for pages already in the page cache.
+    int64_t minor = 0;
+    // Faults that had to wait for the page to be read from storage.
+    int64_t major = 0;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records a span of |phase| while it is in scope.
+  ///
+  class ScopedPhase {
+   public:
+    explicit ScopedPhase(Phase phase);
+
+    ~ScopedPhase();
+
+   private:
+    const Phase phase_;
+    // Unset if the report was complete when the phase started.
+    const std::optional<fml::TimePoint> start_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(ScopedPhase);
+  };
+
+  static StartupReport* GetReportForProcess();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets when the engine was started. Only the first time set is
+  ///             kept. Until it is set, the start of the earliest span is
+  ///             used.
+  ///
+  void SetStartTime(fml::TimePoint start);
+
+  void RecordPhase(Phase phase, fml::TimePoint start, fml::TimePoint end);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Ends the report.
+  ///
+  /// @return     Whether this call ended it, which is only true of the first
+  ///             call.
+  ///
+  bool MarkFirstFrameRasterized(fml::TimePoint time);
+
+  bool IsComplete() const { return complete_; }
+
+  std::optional<fml::TimePoint> GetStartTime() const;
+
+  //----------------------------------------------------------------------------
+  /// @return     The time of the first rasterized frame, if there has been
+  ///             one.
+  ///
+  std::optional<fml::TimePoint> GetFirstFrameTime() const;
+
+  //----------------------------------------------------------------------------
+  /// @return     The phases that have been recorded, ordered by their start.
+  ///
+  std::vector<PhaseTiming> GetPhaseTimings() const;
+
+  //----------------------------------------------------------------------------
+  /// @return     The page faults the process took between the start time being
+  ///             set and the first frame being rasterized, or up to now if
+  ///             there hasn't been one. Unset on platforms that don't count
+  ///             page faults.
+  ///
+  std::optional<PageFaults> GetPageFaults() const;
+
+  void ResetForTesting();
+
+ private:
+  struct Span {
+    std::optional<fml::TimePoint> start;
+    fml::TimePoint end;
+    fml::TimeDelta duration;
+    size_t count = 0;
+  };
+
+  std::atomic<bool> complete_ = false;
+  mutable std::mutex mutex_;
+  std::optional<fml::TimePoint> start_time_;
+  std::optional<fml::TimePoint> first_frame_time_;
+  std::optional<PageFaults> start_page_faults_;
+  std::optional<PageFaults> first_frame_page_faults_;
+  std::array<Span, kPhaseCount> spans_;
+
+  StartupReport();
+
+  ~StartupReport();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(StartupReport);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_COMMON_STARTUP_REPORT_H_
@@ -12,6 +12,7 @@
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/instrumentation.h"
 #include "flutter/flow/raster_cache.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/raster_thread_merger.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -122,12 +123,25 @@ class CompositorContext {
 
   Stopwatch& ui_time() { return ui_time_; }
 
+  // Sets the task runner whose workers help paint frames that are drawn into
+  // CPU memory, each painting a part of the frame. Such frames are painted on
+  // the raster thread alone when there is none, which is the default.
+  void SetTileTaskRunner(
+      std::shared_ptr<fml::ConcurrentTaskRunner> tile_task_runner) {
+    tile_task_runner_ = std::move(tile_task_runner);
+  }
+
+  fml::ConcurrentTaskRunner* tile_task_runner() const {
+    return tile_task_runner_.get();
+  }
+
  private:
   RasterCache raster_cache_;
   TextureRegistry texture_registry_;
   Counter frame_count_;
   Stopwatch raster_time_;
   Stopwatch ui_time_;
+  std::shared_ptr<fml::ConcurrentTaskRunner> tile_task_runner_;
 
   void BeginFrame(ScopedFrame& frame, bool enable_instrumentation);
 
@@ -0,0 +1,1500 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/display_list.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+
+#include "flutter/flow/display_list_canvas.h"
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+#include "third_party/skia/src/core/SkDrawShadowInfo.h"
+
+namespace flutter {
+
+// Operations are laid out at the alignment of the pointers they hold.
+static constexpr size_t kOpAlignment = 8;
+
+static constexpr size_t AlignOpSize(size_t size) {
+  return (size + kOpAlignment - 1) & ~(kOpAlignment - 1);
+}
+
+// The largest operation, including its header and trailing data. Calls that
+// would need a larger operation are dropped instead of being recorded.
+static constexpr uint64_t kMaxOpSize =
+    std::numeric_limits<uint32_t>::max() & ~(kOpAlignment - 1);
+
+struct DLOp {
+  uint32_t type;
+  uint32_t size;
+
+  DisplayListOpType op_type() const {
+    return static_cast<DisplayListOpType>(type);
+  }
+
+  // Unless an operation says otherwise, it is compared and hashed by its
+  // bytes, so the objects it refers to through sk_sp are compared by identity.
+  // The bytes are zeroed before the operation is constructed, so padding
+  // doesn't differ between equal operations.
+  bool equals(const DLOp* other) const {
+    return memcmp(this, other, size) == 0;
+  }
+
+  void hash(size_t& seed) const {
+    const uint32_t* words = reinterpret_cast<const uint32_t*>(this);
+    for (size_t i = 0; i < size / sizeof(uint32_t); i++) {
+      fml::HashCombineSeed(seed, words[i]);
+    }
+  }
+};
+
+static void HashPath(size_t& seed, const SkPath& path) {
+  const SkRect& bounds = path.getBounds();
+  fml::HashCombineSeed(seed, path.countPoints(), path.countVerbs(),
+                       static_cast<int>(path.getFillType()), bounds.fLeft,
+                       bounds.fTop, bounds.fRight, bounds.fBottom);
+}
+
+#define DEFINE_SET_VALUE_OP(name, value_type)                    \
+  struct Set##name##Op final : DLOp {                            \
+    static constexpr auto kType = DisplayListOpType::kSet##name; \
+                                                                 \
+    explicit Set##name##Op(value_type value) : value(value) {}   \
+                                                                 \
+    const value_type value;                                      \
+                                                                 \
+    void dispatch(Dispatcher& dispatcher) const {                \
+      dispatcher.set##name(value);                               \
+    }                                                            \
+  };
+DEFINE_SET_VALUE_OP(AA, bool)
+DEFINE_SET_VALUE_OP(Dither, bool)
+DEFINE_SET_VALUE_OP(Color, SkColor)
+DEFINE_SET_VALUE_OP(Style, SkPaint::Style)
+DEFINE_SET_VALUE_OP(StrokeWidth, SkScalar)
+DEFINE_SET_VALUE_OP(MiterLimit, SkScalar)
+DEFINE_SET_VALUE_OP(Cap, SkPaint::Cap)
+DEFINE_SET_VALUE_OP(Join, SkPaint::Join)
+DEFINE_SET_VALUE_OP(BlendMode, SkBlendMode)
+#undef DEFINE_SET_VALUE_OP
+
+#define DEFINE_SET_REF_OP(name, ref_type)                        \
+  struct Set##name##Op final : DLOp {                            \
+    static constexpr auto kType = DisplayListOpType::kSet##name; \
+                                                                 \
+    explicit Set##name##Op(sk_sp<ref_type> value)                \
+        : value(std::move(value)) {}                             \
+                                                                 \
+    const sk_sp<ref_type> value;                                 \
+                                                                 \
+    void dispatch(Dispatcher& dispatcher) const {                \
+      dispatcher.set##name(value);                               \
+    }                                                            \
+  };
+DEFINE_SET_REF_OP(Shader, SkShader)
+DEFINE_SET_REF_OP(ColorFilter, SkColorFilter)
+DEFINE_SET_REF_OP(PathEffect, SkPathEffect)
+DEFINE_SET_REF_OP(MaskFilter, SkMaskFilter)
+DEFINE_SET_REF_OP(ImageFilter, SkImageFilter)
+#undef DEFINE_SET_REF_OP
+
+struct SaveOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kSave;
+
+  void dispatch(Dispatcher& dispatcher) const { dispatcher.save(); }
+};
+
+struct SaveLayerOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kSaveLayer;
+
+  SaveLayerOp(const SkRect* bounds,
+              bool with_paint,
+              sk_sp<SkImageFilter> backdrop)
+      : has_bounds(bounds != nullptr),
+        with_paint(with_paint),
+        bounds(bounds ? *bounds : SkRect::MakeEmpty()),
+        backdrop(std::move(backdrop)) {}
+
+  const bool has_bounds;
+  const bool with_paint;
+  const SkRect bounds;
+  const sk_sp<SkImageFilter> backdrop;
+
+  void dispatch(Dispatcher& dispatcher) const {
+    dispatcher.saveLayer(has_bounds ? &bounds : nullptr, with_paint, backdrop);
+  }
+};
+
+struct RestoreOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kRestore;
+
+  void dispatch(Dispatcher& dispatcher) const { dispatcher.restore(); }
+};
+
+#define DEFINE_TWO_SCALAR_OP(name, method)                    \
+  struct name##Op final : DLOp {                              \
+    static constexpr auto kType = DisplayListOpType::k##name; \
+                                                              \
+    name##Op(SkScalar x, SkScalar y) : x(x), y(y) {}          \
+                                                              \
+    const SkScalar x;                                         \
+    const SkScalar y;                                         \
+                                                              \
+    void dispatch(Dispatcher& dispatcher) const {             \
+      dispatcher.method(x, y);                                \
+    }                                                         \
+  };
+DEFINE_TWO_SCALAR_OP(Translate, translate)
+DEFINE_TWO_SCALAR_OP(Scale, scale)
+DEFINE_TWO_SCALAR_OP(Skew, skew)
+#undef DEFINE_TWO_SCALAR_OP
+
+struct RotateOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kRotate;
+
+  explicit RotateOp(SkScalar degrees) : degrees(degrees) {}
+
+  const SkScalar degrees;
+
+  void dispatch(Dispatcher& dispatcher) const { dispatcher.rotate(degrees); }
+};
+
+// Most transforms are affine, which only needs 6 of the 9 values.
+struct Transform2x3Op final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kTransform2x3;
+
+  explicit Transform2x3Op(const SkMatrix& matrix)
+      : mxx(matrix.getScaleX()),
+        mxy(matrix.getSkewX()),
+        mxt(matrix.getTranslateX()),
+        myx(matrix.getSkewY()),
+        myy(matrix.getScaleY()),
+        myt(matrix.getTranslateY()) {}
+
+  const SkScalar mxx, mxy, mxt;
+  const SkScalar myx, myy, myt;
+
+  void dispatch(Dispatcher& dispatcher) const {
+    dispatcher.transform(
+        SkMatrix::MakeAll(mxx, mxy, mxt, myx, myy, myt, 0, 0, 1));
+  }
+};
+
+struct Transform3x3Op final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kTransform3x3;
+
+  explicit Transform3x3Op(const SkMatrix& matrix) { matrix.get9(values); }
+
+  SkScalar values[9];
+
+  void dispatch(Dispatcher& dispatcher) const {
+    SkMatrix matrix;
+    matrix.set9(values);
+    dispatcher.transform(matrix);
+  }
+};
+
+struct ClipRectOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kClipRect;
+
+  ClipRectOp(const SkRect& rect, SkClipOp clip_op, bool is_aa)
+      : rect(rect), clip_op(clip_op), is_aa(is_aa) {}
+
+  const SkRect rect;
+  const SkClipOp clip_op;
+  const bool is_aa;
+
+  void dispatch(Dispatcher& dispatcher) const {
+    dispatcher.clipRect(rect, clip_op, is_aa);
+  }
+};
+
+struct ClipRRectOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kClipRRect;
+
+  ClipRRectOp(const SkRRect& rrect, SkClipOp clip_op, bool is_aa)
+      : rrect(rrect), clip_op(clip_op), is_aa(is_aa) {}
+
+  const SkRRect rrect;
+  const SkClipOp clip_op;
+  const bool is_aa;
+
+  void dispatch(Dispatcher& dispatcher) const {
+    dispatcher.clipRRect(rrect, clip_op, is_aa);
+  }
+};
+
+struct ClipPathOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kClipPath;
+
+  ClipPathOp(const SkPath& path, SkClipOp clip_op, bool is_aa)
+      : clip_op(clip_op), is_aa(is_aa), path(path) {}
+
+  const SkClipOp clip_op;
+  const bool is_aa;
+  const SkPath path;
+
+  void dispatch(Dispatcher& dispatcher) const {
+    dispatcher.clipPath(path, clip_op, is_aa);
+  }
+
+  bool equals(const ClipPathOp* other) const {
+    return clip_op == other->clip_op && is_aa == other->is_aa &&
+           path == other->path;
+  }
+
+  void hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, type, static_cast<int>(clip_op), is_aa);
+    HashPath(seed, path);
+  }
+};
+
+struct DrawPaintOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kDrawPaint;
+
+  void dispatch(Dispatcher& dispatcher) const { dispatcher.drawPaint(); }
+};
+
+struct DrawColorOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kDrawColor;
+
+  DrawColorOp(SkColor color, SkBlendMode mode) : color(color), mode(mode) {}
+
+  const SkColor color;
+  const SkBlendMode mode;
+
+  void dispatch(Dispatcher& dispatcher) const {
+    dispatcher.drawColor(color, mode);
+  }
+};
+
+struct DrawLineOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kDrawLine;
+
+  DrawLineOp(const SkPoint& p0, const SkPoint& p1) : p0(p0), p1(p1) {}
+
+  const SkPoint p0;
+  const SkPoint p1;
+
+  void dispatch(Dispatcher& dispatcher) const { dispatcher.drawLine(p0, p1); }
+};
+
+#define DEFINE_DRAW_RECT_OP(name, method)                     \
+  struct name##Op final : DLOp {                              \
+    static constexpr auto kType = DisplayListOpType::k##name; \
+                                                              \
+    explicit name##Op(const SkRect& rect) : rect(rect) {}     \
+                                                              \
+    const SkRect rect;                                        \
+                                                              \
+    void dispatch(Dispatcher& dispatcher) const {             \
+      dispatcher.method(rect);                                \
+    }                                                         \
+  };
+DEFINE_DRAW_RECT_OP(DrawRect, drawRect)
+DEFINE_DRAW_RECT_OP(DrawOval, drawOval)
+#undef DEFINE_DRAW_RECT_OP
+
+struct DrawCircleOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kDrawCircle;
+
+  DrawCircleOp(const SkPoint& center, SkScalar radius)
+      : center(center), radius(radius) {}
+
+  const SkPoint center;
+  const SkScalar radius;
+
+  void dispatch(Dispatcher& dispatcher) const {
+    dispatcher.drawCircle(center, radius);
+  }
+};
+
+struct DrawRRectOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kDrawRRect;
+
+  explicit DrawRRectOp(const SkRRect& rrect) : rrect(rrect) {}
+
+  const SkRRect rrect;
+
+  void dispatch(Dispatcher& dispatcher) const { dispatcher.drawRRect(rrect); }
+};
+
+struct DrawDRRectOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kDrawDRRect;
+
+  DrawDRRectOp(const SkRRect& outer, const SkRRect& inner)
+      : outer(outer), inner(inner) {}
+
+  const SkRRect outer;
+  const SkRRect inner;
+
+  void dispatch(Dispatcher& dispatcher) const {
+    dispatcher.drawDRRect(outer, inner);
+  }
+};
+
+struct DrawPathOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kDrawPath;
+
+  explicit DrawPathOp(const SkPath& path) : path(path) {}
+
+  const SkPath path;
+
+  void dispatch(Dispatcher& dispatcher) const { dispatcher.drawPath(path); }
+
+  bool equals(const DrawPathOp* other) const { return path == other->path; }
+
+  void hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, type);
+    HashPath(seed, path);
+  }
+};
+
+struct DrawArcOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kDrawArc;
+
+  DrawArcOp(const SkRect& bounds, SkScalar start, SkScalar sweep, bool center)
+      : bounds(bounds), start(start), sweep(sweep), center(center) {}
+
+  const SkRect bounds;
+  const SkScalar start;
+  const SkScalar sweep;
+  const bool center;
+
+  void dispatch(Dispatcher& dispatcher) const {
+    dispatcher.drawArc(bounds, start, sweep, center);
+  }
+};
+
+// Followed by |count| SkPoints.
+struct DrawPointsOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kDrawPoints;
+
+  DrawPointsOp(SkCanvas::PointMode mode, uint32_t count)
+      : mode(mode), count(count) {}
+
+  const SkCanvas::PointMode mode;
+  const uint32_t count;
+
+  void dispatch(Dispatcher& dispatcher) const {
+    dispatcher.drawPoints(mode, count,
+                          reinterpret_cast<const SkPoint*>(this + 1));
+  }
+};
+
+struct DrawVerticesOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kDrawVertices;
+
+  DrawVerticesOp(sk_sp<SkVertices> vertices, SkBlendMode mode)
+      : mode(mode), vertices(std::move(vertices)) {}
+
+  const SkBlendMode mode;
+  const sk_sp<SkVertices> vertices;
+
+  void dispatch(Dispatcher& dispatcher) const {
+    dispatcher.drawVertices(vertices, mode);
+  }
+};
+
+struct DrawPatchOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kDrawPatch;
+
+  DrawPatchOp(const SkPoint cubics[12],
+              const SkColor colors[4],
+              const SkPoint tex_coords[4],
+              SkBlendMode mode)
+      : has_colors(colors != nullptr),
+        has_tex_coords(tex_coords != nullptr),
+        mode(mode) {
+    memcpy(this->cubics, cubics, sizeof(this->cubics));
+    if (colors) {
+      memcpy(this->colors, colors, sizeof(this->colors));
+    }
+    if (tex_coords) {
+      memcpy(this->tex_coords, tex_coords, sizeof(this->tex_coords));
+    }
+  }
+
+  const bool has_colors;
+  const bool has_tex_coords;
+  const SkBlendMode mode;
+  SkPoint cubics[12];
+  SkColor colors[4];
+  SkPoint tex_coords[4];
+
+  void dispatch(Dispatcher& dispatcher) const {
+    dispatcher.drawPatch(cubics, has_colors ? colors : nullptr,
+                         has_tex_coords ? tex_coords : nullptr, mode);
+  }
+};
+
+struct DrawImageOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kDrawImage;
+
+  DrawImageOp(sk_sp<SkImage> image,
+              const SkPoint& point,
+              const SkSamplingOptions& sampling,
+              bool with_paint)
+      : with_paint(with_paint),
+        point(point),
+        image(std::move(image)),
+        sampling(sampling) {}
+
+  const bool with_paint;
+  const SkPoint point;
+  const sk_sp<SkImage> image;
+  const SkSamplingOptions sampling;
+
+  void dispatch(Dispatcher& dispatcher) const {
+    dispatcher.drawImage(image, point, sampling, with_paint);
+  }
+};
+
+struct DrawImageRectOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kDrawImageRect;
+
+  DrawImageRectOp(sk_sp<SkImage> image,
+                  const SkRect& src,
+                  const SkRect& dst,
+                  const SkSamplingOptions& sampling,
+                  bool with_paint,
+                  SkCanvas::SrcRectConstraint constraint)
+      : with_paint(with_paint),
+        constraint(constraint),
+        src(src),
+        dst(dst),
+        image(std::move(image)),
+        sampling(sampling) {}
+
+  const bool with_paint;
+  const SkCanvas::SrcRectConstraint constraint;
+  const SkRect src;
+  const SkRect dst;
+  const sk_sp<SkImage> image;
+  const SkSamplingOptions sampling;
+
+  void dispatch(Dispatcher& dispatcher) const {
+    dispatcher.drawImageRect(image, src, dst, sampling, with_paint,
+                             constraint);
+  }
+};
+
+// Followed by the x divs and the y divs, then the colors and the rect types of
+// the cells if the lattice has them.
+struct DrawImageLatticeOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kDrawImageLattice;
+
+  DrawImageLatticeOp(sk_sp<SkImage> image,
+                     const SkCanvas::Lattice& lattice,
+                     int cell_count,
+                     const SkRect& dst,
+                     SkFilterMode filter,
+                     bool with_paint)
+      : x_count(lattice.fXCount),
+        y_count(lattice.fYCount),
+        cell_count(cell_count),
+        filter(filter),
+        has_bounds(lattice.fBounds != nullptr),
+        has_colors(cell_count > 0 && lattice.fColors != nullptr),
+        with_paint(with_paint),
+        bounds(lattice.fBounds ? *lattice.fBounds : SkIRect::MakeEmpty()),
+        dst(dst),
+        image(std::move(image)) {}
+
+  const int x_count;
+  const int y_count;
+  const int cell_count;
+  const SkFilterMode filter;
+  const bool has_bounds;
+  const bool has_colors;
+  const bool with_paint;
+  const SkIRect bounds;
+  const SkRect dst;
+  const sk_sp<SkImage> image;
+
+  void dispatch(Dispatcher& dispatcher) const {
+    const int* x_divs = reinterpret_cast<const int*>(this + 1);
+    const int* y_divs = x_divs + x_count;
+    const SkColor* colors = reinterpret_cast<const SkColor*>(y_divs + y_count);
+    const SkCanvas::Lattice::RectType* rect_types =
+        reinterpret_cast<const SkCanvas::Lattice::RectType*>(
+            colors + (has_colors ? cell_count : 0));
+    SkCanvas::Lattice lattice = {
+        x_divs,
+        y_divs,
+        cell_count > 0 ? rect_types : nullptr,
+        x_count,
+        y_count,
+        has_bounds ? &bounds : nullptr,
+        has_colors ? colors : nullptr,
+    };
+    dispatcher.drawImageLattice(image, lattice, dst, filter, with_paint);
+  }
+};
+
+// Followed by |count| SkRSXforms, |count| texture SkRects, and |count|
+// SkColors if the atlas has colors.
+struct DrawAtlasOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kDrawAtlas;
+
+  DrawAtlasOp(sk_sp<SkImage> atlas,
+              int count,
+              SkBlendMode mode,
+              const SkSamplingOptions& sampling,
+              bool has_colors,
+              const SkRect* cull_rect,
+              bool with_paint)
+      : count(count),
+        mode(mode),
+        has_colors(has_colors),
+        has_cull_rect(cull_rect != nullptr),
+        with_paint(with_paint),
+        cull_rect(cull_rect ? *cull_rect : SkRect::MakeEmpty()),
+        atlas(std::move(atlas)),
+        sampling(sampling) {}
+
+  const int count;
+  const SkBlendMode mode;
+  const bool has_colors;
+  const bool has_cull_rect;
+  const bool with_paint;
+  const SkRect cull_rect;
+  const sk_sp<SkImage> atlas;
+  const SkSamplingOptions sampling;
+
+  void dispatch(Dispatcher& dispatcher) const {
+    const SkRSXform* xform = reinterpret_cast<const SkRSXform*>(this + 1);
+    const SkRect* tex = reinterpret_cast<const SkRect*>(xform + count);
+    const SkColor* colors =
+        has_colors ? reinterpret_cast<const SkColor*>(tex + count) : nullptr;
+    dispatcher.drawAtlas(atlas, xform, tex, colors, count, mode, sampling,
+                         has_cull_rect ? &cull_rect : nullptr, with_paint);
+  }
+};
+
+struct DrawPictureOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kDrawPicture;
+
+  DrawPictureOp(sk_sp<SkPicture> picture,
+                const SkMatrix* matrix,
+                bool with_paint)
+      : has_matrix(matrix != nullptr),
+        with_paint(with_paint),
+        picture(std::move(picture)) {
+    if (matrix) {
+      matrix->get9(values);
+    }
+  }
+
+  const bool has_matrix;
+  const bool with_paint;
+  SkScalar values[9];
+  const sk_sp<SkPicture> picture;
+
+  void dispatch(Dispatcher& dispatcher) const {
+    if (has_matrix) {
+      SkMatrix matrix;
+      matrix.set9(values);
+      dispatcher.drawPicture(picture, &matrix, with_paint);
+    } else {
+      dispatcher.drawPicture(picture, nullptr, with_paint);
+    }
+  }
+};
+
+struct DrawDisplayListOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kDrawDisplayList;
+
+  explicit DrawDisplayListOp(sk_sp<DisplayList> display_list)
+      : display_list(std::move(display_list)) {}
+
+  const sk_sp<DisplayList> display_list;
+
+  void dispatch(Dispatcher& dispatcher) const {
+    dispatcher.drawDisplayList(display_list);
+  }
+
+  bool equals(const DrawDisplayListOp* other) const {
+    return display_list->Equals(*other->display_list);
+  }
+
+  void hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, type, display_list->hash());
+  }
+};
+
+struct DrawTextBlobOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kDrawTextBlob;
+
+  DrawTextBlobOp(sk_sp<SkTextBlob> blob, SkScalar x, SkScalar y)
+      : x(x), y(y), blob(std::move(blob)) {}
+
+  const SkScalar x;
+  const SkScalar y;
+  const sk_sp<SkTextBlob> blob;
+
+  void dispatch(Dispatcher& dispatcher) const {
+    dispatcher.drawTextBlob(blob, x, y);
+  }
+};
+
+struct DrawShadowRecOp final : DLOp {
+  static constexpr auto kType = DisplayListOpType::kDrawShadowRec;
+
+  DrawShadowRecOp(const SkPath& path, const SkDrawShadowRec& rec)
+      : rec(rec), path(path) {}
+
+  const SkDrawShadowRec rec;
+  const SkPath path;
+
+  void dispatch(Dispatcher& dispatcher) const {
+    dispatcher.drawShadowRec(path, rec);
+  }
+
+  bool equals(const DrawShadowRecOp* other) const {
+    return memcmp(&rec, &other->rec, sizeof(rec)) == 0 && path == other->path;
+  }
+
+  void hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, type, rec.fAmbientColor, rec.fSpotColor,
+                         rec.fFlags);
+    HashPath(seed, path);
+  }
+};
+
+static bool IsDrawOp(DisplayListOpType type) {
+  return type >= DisplayListOpType::kDrawPaint;
+}
+
+static void DispatchOp(Dispatcher& dispatcher, const DLOp* op) {
+  switch (op->op_type()) {
+#define DL_OP_DISPATCH(name)                                \
+  case DisplayListOpType::k##name:                          \
+    static_cast<const name##Op*>(op)->dispatch(dispatcher); \
+    break;
+
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_DISPATCH)
+
+#undef DL_OP_DISPATCH
+  }
+}
+
+static bool OpEquals(const DLOp* op, const DLOp* other) {
+  switch (op->op_type()) {
+#define DL_OP_EQUALS(name)                           \
+  case DisplayListOpType::k##name:                   \
+    return static_cast<const name##Op*>(op)->equals( \
+        static_cast<const name##Op*>(other));
+
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_EQUALS)
+
+#undef DL_OP_EQUALS
+  }
+  FML_UNREACHABLE();
+}
+
+static void HashOp(size_t& seed, const DLOp* op) {
+  switch (op->op_type()) {
+#define DL_OP_HASH(name)                          \
+  case DisplayListOpType::k##name:                \
+    static_cast<const name##Op*>(op)->hash(seed); \
+    break;
+
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_HASH)
+
+#undef DL_OP_HASH
+  }
+}
+
+static void DisposeOps(uint8_t* ptr, uint8_t* end) {
+  while (ptr < end) {
+    DLOp* op = reinterpret_cast<DLOp*>(ptr);
+    ptr += op->size;
+    switch (op->op_type()) {
+#define DL_OP_DISPOSE(name)                  \
+  case DisplayListOpType::k##name:           \
+    static_cast<name##Op*>(op)->~name##Op(); \
+    break;
+
+      FOR_EACH_DISPLAY_LIST_OP(DL_OP_DISPOSE)
+
+#undef DL_OP_DISPOSE
+    }
+  }
+}
+
+// Whether drawing a layer with |paint| can change the pixels under the
+// transparent parts of the layer, which makes it cover the whole of its clip.
+static bool IsUnboundedLayerPaint(const SkPaint& paint) {
+  switch (paint.getBlendMode()) {
+    case SkBlendMode::kClear:
+    case SkBlendMode::kSrc:
+    case SkBlendMode::kSrcIn:
+    case SkBlendMode::kDstIn:
+    case SkBlendMode::kSrcOut:
+    case SkBlendMode::kDstATop:
+    case SkBlendMode::kModulate:
+      return true;
+    default:
+      break;
+  }
+  SkColorFilter* color_filter = paint.getColorFilter();
+  if (color_filter &&
+      color_filter->filterColor(SK_ColorTRANSPARENT) != SK_ColorTRANSPARENT) {
+    return true;
+  }
+  SkImageFilter* image_filter = paint.getImageFilter();
+  return image_filter && !image_filter->canComputeFastBounds();
+}
+
+// Whether a draw call with |paint| gives the same pixels when the alpha of the
+// paint is modulated as it does when drawn into a layer with that alpha, as
+// long as it doesn't overlap another draw call.
+static bool CanModulatePaintOpacity(const SkPaint& paint) {
+  return paint.getBlendMode() == SkBlendMode::kSrcOver &&
+         !paint.getColorFilter() && !paint.getImageFilter();
+}
+
+static uint32_t NextUniqueID() {
+  static std::atomic<uint32_t> next_id{1};
+  uint32_t id;
+  do {
+    id = next_id.fetch_add(1, std::memory_order_relaxed);
+  } while (id == 0);
+  return id;
+}
+
+DisplayList::DisplayList(std::unique_ptr<uint8_t[]> storage,
+                         size_t used,
+                         int op_count,
+                         const SkRect& bounds,
+                         sk_sp<SkBBoxHierarchy> draw_bounds,
+                         bool can_apply_group_opacity)
+    : storage_(std::move(storage)),
+      used_(used),
+      op_count_(op_count),
+      bounds_(bounds),
+      draw_bounds_(std::move(draw_bounds)),
+      unique_id_(NextUniqueID()),
+      can_apply_group_opacity_(can_apply_group_opacity) {
+  uint8_t* ptr = storage_.get();
+  uint8_t* end = ptr + used_;
+  hash_ = fml::HashCombine(op_count_);
+  while (ptr < end) {
+    const DLOp* op = reinterpret_cast<const DLOp*>(ptr);
+    ptr += op->size;
+    HashOp(hash_, op);
+  }
+}
+
+DisplayList::~DisplayList() {
+  DisposeOps(storage_.get(), storage_.get() + used_);
+}
+
+size_t DisplayList::bytes() const {
+  return sizeof(DisplayList) + used_ +
+         (draw_bounds_ ? draw_bounds_->bytesUsed() : 0);
+}
+
+void DisplayList::Dispatch(Dispatcher& dispatcher) const {
+  uint8_t* ptr = storage_.get();
+  uint8_t* end = ptr + used_;
+  while (ptr < end) {
+    const DLOp* op = reinterpret_cast<const DLOp*>(ptr);
+    ptr += op->size;
+    DispatchOp(dispatcher, op);
+  }
+}
+
+void DisplayList::Dispatch(Dispatcher& dispatcher,
+                           const SkRect& cull_rect) const {
+  if (!draw_bounds_) {
+    Dispatch(dispatcher);
+    return;
+  }
+  std::vector<int> visible;
+  draw_bounds_->search(cull_rect, &visible);
+  std::sort(visible.begin(), visible.end());
+
+  auto next_visible = visible.begin();
+  int draw_index = 0;
+  uint8_t* ptr = storage_.get();
+  uint8_t* end = ptr + used_;
+  while (ptr < end) {
+    const DLOp* op = reinterpret_cast<const DLOp*>(ptr);
+    ptr += op->size;
+    if (IsDrawOp(op->op_type())) {
+      bool is_visible =
+          next_visible != visible.end() && *next_visible == draw_index;
+      draw_index++;
+      if (!is_visible) {
+        continue;
+      }
+      next_visible++;
+    }
+    DispatchOp(dispatcher, op);
+  }
+}
+
+void DisplayList::RenderTo(SkCanvas* canvas, SkScalar opacity) const {
+  if (opacity < SK_Scalar1 && !can_apply_group_opacity_) {
+    SkPaint paint;
+    paint.setAlphaf(opacity);
+    canvas->saveLayer(&bounds_, &paint);
+    RenderTo(canvas);
+    canvas->restore();
+    return;
+  }
+  DisplayListCanvasDispatcher dispatcher(canvas, opacity);
+  SkRect clip_bounds = canvas->getLocalClipBounds();
+  if (clip_bounds.contains(bounds_)) {
+    Dispatch(dispatcher);
+  } else {
+    Dispatch(dispatcher, clip_bounds);
+  }
+}
+
+bool DisplayList::Equals(const DisplayList& other) const {
+  if (this == &other) {
+    return true;
+  }
+  if (used_ != other.used_ || op_count_ != other.op_count_ ||
+      hash_ != other.hash_ || bounds_ != other.bounds_) {
+    return false;
+  }
+  uint8_t* ptr = storage_.get();
+  uint8_t* other_ptr = other.storage_.get();
+  uint8_t* end = ptr + used_;
+  while (ptr < end) {
+    const DLOp* op = reinterpret_cast<const DLOp*>(ptr);
+    const DLOp* other_op = reinterpret_cast<const DLOp*>(other_ptr);
+    if (op->type != other_op->type || op->size != other_op->size ||
+        !OpEquals(op, other_op)) {
+      return false;
+    }
+    ptr += op->size;
+    other_ptr += other_op->size;
+  }
+  return true;
+}
+
+DisplayListBuilder::DisplayListBuilder(const SkRect& cull_rect)
+    : cull_rect_(cull_rect), current_clip_bounds_(cull_rect) {}
+
+DisplayListBuilder::~DisplayListBuilder() {
+  DisposeOps(storage_.get(), storage_.get() + used_);
+}
+
+template <typename T, typename... Args>
+void* DisplayListBuilder::Push(uint64_t trailing_bytes, Args&&... args) {
+  if (trailing_bytes > kMaxOpSize - sizeof(T) ||
+      AlignOpSize(sizeof(T) + trailing_bytes) >
+          std::numeric_limits<size_t>::max() - used_) {
+    FML_LOG(ERROR) << "Dropping a drawing operation of " << trailing_bytes
+                   << " bytes, which is too large for a display list.";
+    return nullptr;
+  }
+  size_t size = AlignOpSize(sizeof(T) + static_cast<size_t>(trailing_bytes));
+  if (used_ + size > allocated_) {
+    // The operations are moved by copying their bytes, which the types they
+    // hold (sk_sp and SkPath) allow.
+    size_t allocated = std::max(allocated_ * 2, used_ + size + 4096);
+    std::unique_ptr<uint8_t[]> storage(new uint8_t[allocated]);
+    if (used_ > 0) {
+      memcpy(storage.get(), storage_.get(), used_);
+    }
+    storage_ = std::move(storage);
+    allocated_ = allocated;
+  }
+  uint8_t* ptr = storage_.get() + used_;
+  used_ += size;
+  memset(ptr, 0, size);
+  T* op = new (ptr) T(std::forward<Args>(args)...);
+  op->type = static_cast<uint32_t>(T::kType);
+  op->size = size;
+  op_count_++;
+  return op + 1;
+}
+
+sk_sp<DisplayList> DisplayListBuilder::Build() {
+  while (!save_stack_.empty()) {
+    restore();
+  }
+  sk_sp<SkBBoxHierarchy> draw_bounds;
+  if (!draw_bounds_.empty()) {
+    draw_bounds = SkRTreeFactory()();
+    draw_bounds->insert(draw_bounds_.data(), draw_bounds_.size());
+  }
+  sk_sp<DisplayList> display_list(
+      new DisplayList(std::move(storage_), used_, op_count_,
+                      accumulated_bounds_, std::move(draw_bounds),
+                      can_apply_group_opacity_));
+
+  used_ = 0;
+  allocated_ = 0;
+  op_count_ = 0;
+  current_paint_ = SkPaint();
+  current_matrix_.reset();
+  current_clip_bounds_ = cull_rect_;
+  draw_bounds_.clear();
+  accumulated_bounds_.setEmpty();
+  can_apply_group_opacity_ = true;
+  return display_list;
+}
+
+void DisplayListBuilder::setAttributesFromPaint(const SkPaint& paint) {
+  setAA(paint.isAntiAlias());
+  setDither(paint.isDither());
+  setColor(paint.getColor());
+  setStyle(paint.getStyle());
+  setStrokeWidth(paint.getStrokeWidth());
+  setMiterLimit(paint.getStrokeMiter());
+  setCap(paint.getStrokeCap());
+  setJoin(paint.getStrokeJoin());
+  setBlendMode(paint.getBlendMode());
+  setShader(paint.refShader());
+  setColorFilter(paint.refColorFilter());
+  setPathEffect(paint.refPathEffect());
+  setMaskFilter(paint.refMaskFilter());
+  setImageFilter(paint.refImageFilter());
+}
+
+void DisplayListBuilder::setAA(bool aa) {
+  if (current_paint_.isAntiAlias() != aa) {
+    current_paint_.setAntiAlias(aa);
+    Push<SetAAOp>(0, aa);
+  }
+}
+
+void DisplayListBuilder::setDither(bool dither) {
+  if (current_paint_.isDither() != dither) {
+    current_paint_.setDither(dither);
+    Push<SetDitherOp>(0, dither);
+  }
+}
+
+void DisplayListBuilder::setColor(SkColor color) {
+  if (current_paint_.getColor() != color) {
+    current_paint_.setColor(color);
+    Push<SetColorOp>(0, color);
+  }
+}
+
+void DisplayListBuilder::setStyle(SkPaint::Style style) {
+  if (current_paint_.getStyle() != style) {
+    current_paint_.setStyle(style);
+    Push<SetStyleOp>(0, style);
+  }
+}
+
+void DisplayListBuilder::setStrokeWidth(SkScalar width) {
+  if (current_paint_.getStrokeWidth() != width) {
+    current_paint_.setStrokeWidth(width);
+    Push<SetStrokeWidthOp>(0, width);
+  }
+}
+
+void DisplayListBuilder::setMiterLimit(SkScalar limit) {
+  if (current_paint_.getStrokeMiter() != limit) {
+    current_paint_.setStrokeMiter(limit);
+    Push<SetMiterLimitOp>(0, limit);
+  }
+}
+
+void DisplayListBuilder::setCap(SkPaint::Cap cap) {
+  if (current_paint_.getStrokeCap() != cap) {
+    current_paint_.setStrokeCap(cap);
+    Push<SetCapOp>(0, cap);
+  }
+}
+
+void DisplayListBuilder::setJoin(SkPaint::Join join) {
+  if (current_paint_.getStrokeJoin() != join) {
+    current_paint_.setStrokeJoin(join);
+    Push<SetJoinOp>(0, join);
+  }
+}
+
+void DisplayListBuilder::setBlendMode(SkBlendMode mode) {
+  if (current_paint_.getBlendMode() != mode) {
+    current_paint_.setBlendMode(mode);
+    Push<SetBlendModeOp>(0, mode);
+  }
+}
+
+void DisplayListBuilder::setShader(sk_sp<SkShader> shader) {
+  if (current_paint_.getShader() != shader.get()) {
+    current_paint_.setShader(shader);
+    Push<SetShaderOp>(0, std::move(shader));
+  }
+}
+
+void DisplayListBuilder::setColorFilter(sk_sp<SkColorFilter> filter) {
+  if (current_paint_.getColorFilter() != filter.get()) {
+    current_paint_.setColorFilter(filter);
+    Push<SetColorFilterOp>(0, std::move(filter));
+  }
+}
+
+void DisplayListBuilder::setPathEffect(sk_sp<SkPathEffect> effect) {
+  if (current_paint_.getPathEffect() != effect.get()) {
+    current_paint_.setPathEffect(effect);
+    Push<SetPathEffectOp>(0, std::move(effect));
+  }
+}
+
+void DisplayListBuilder::setMaskFilter(sk_sp<SkMaskFilter> filter) {
+  if (current_paint_.getMaskFilter() != filter.get()) {
+    current_paint_.setMaskFilter(filter);
+    Push<SetMaskFilterOp>(0, std::move(filter));
+  }
+}
+
+void DisplayListBuilder::setImageFilter(sk_sp<SkImageFilter> filter) {
+  if (current_paint_.getImageFilter() != filter.get()) {
+    current_paint_.setImageFilter(filter);
+    Push<SetImageFilterOp>(0, std::move(filter));
+  }
+}
+
+void DisplayListBuilder::save() {
+  Push<SaveOp>(0);
+  SaveInfo info;
+  info.matrix = current_matrix_;
+  info.clip_bounds = current_clip_bounds_;
+  save_stack_.push_back(std::move(info));
+}
+
+void DisplayListBuilder::saveLayer(const SkRect* bounds,
+                                   bool with_paint,
+                                   sk_sp<SkImageFilter> backdrop) {
+  SaveInfo info;
+  info.matrix = current_matrix_;
+  info.clip_bounds = current_clip_bounds_;
+  info.is_layer = true;
+  info.outer_bounds = accumulated_bounds_;
+  info.first_draw_index = draw_bounds_.size();
+  if (with_paint) {
+    info.image_filter = current_paint_.refImageFilter();
+    info.is_unbounded = IsUnboundedLayerPaint(current_paint_);
+  }
+  // The backdrop is filtered across the whole layer.
+  info.is_unbounded |= backdrop != nullptr;
+  // The contents of a layer may overlap each other, and are not tracked
+  // separately from the draw calls outside of it.
+  can_apply_group_opacity_ = false;
+
+  Push<SaveLayerOp>(0, bounds, with_paint, std::move(backdrop));
+  save_stack_.push_back(std::move(info));
+
+  // Nothing is drawn into the layer outside of its bounds.
+  if (bounds) {
+    IntersectClipBounds(*bounds, SkClipOp::kIntersect);
+  }
+  save_stack_.back().layer_clip_bounds = current_clip_bounds_;
+  accumulated_bounds_.setEmpty();
+}
+
+void DisplayListBuilder::restore() {
+  if (save_stack_.empty()) {
+    // Like SkCanvas, a restore without a save is ignored.
+    return;
+  }
+  Push<RestoreOp>(0);
+  SaveInfo info = std::move(save_stack_.back());
+  save_stack_.pop_back();
+  current_matrix_ = info.matrix;
+  current_clip_bounds_ = info.clip_bounds;
+  if (!info.is_layer) {
+    return;
+  }
+
+  SkRect layer_bounds = accumulated_bounds_;
+  if (info.is_unbounded) {
+    layer_bounds = info.layer_clip_bounds;
+  } else if (info.image_filter && !layer_bounds.isEmpty()) {
+    SkMatrix inverse;
+    if (info.matrix.invert(&inverse)) {
+      SkRect local_bounds = inverse.mapRect(layer_bounds);
+      local_bounds = info.image_filter->computeFastBounds(local_bounds);
+      layer_bounds = info.matrix.mapRect(local_bounds);
+    } else {
+      layer_bounds = info.layer_clip_bounds;
+    }
+    if (!layer_bounds.intersect(info.clip_bounds)) {
+      layer_bounds.setEmpty();
+    }
+  }
+  if (info.image_filter) {
+    // The filter may move what was drawn into the layer anywhere within its
+    // output, so every draw call in the layer is taken to cover all of it.
+    for (size_t i = info.first_draw_index; i < draw_bounds_.size(); i++) {
+      draw_bounds_[i] = layer_bounds;
+    }
+  }
+  accumulated_bounds_ = info.outer_bounds;
+  accumulated_bounds_.join(layer_bounds);
+}
+
+void DisplayListBuilder::translate(SkScalar tx, SkScalar ty) {
+  Push<TranslateOp>(0, tx, ty);
+  current_matrix_.preTranslate(tx, ty);
+}
+
+void DisplayListBuilder::scale(SkScalar sx, SkScalar sy) {
+  Push<ScaleOp>(0, sx, sy);
+  current_matrix_.preScale(sx, sy);
+}
+
+void DisplayListBuilder::rotate(SkScalar degrees) {
+  Push<RotateOp>(0, degrees);
+  current_matrix_.preRotate(degrees);
+}
+
+void DisplayListBuilder::skew(SkScalar sx, SkScalar sy) {
+  Push<SkewOp>(0, sx, sy);
+  current_matrix_.preSkew(sx, sy);
+}
+
+void DisplayListBuilder::transform(const SkMatrix& matrix) {
+  if (matrix.hasPerspective()) {
+    Push<Transform3x3Op>(0, matrix);
+  } else {
+    Push<Transform2x3Op>(0, matrix);
+  }
+  current_matrix_.preConcat(matrix);
+}
+
+void DisplayListBuilder::clipRect(const SkRect& rect,
+                                  SkClipOp clip_op,
+                                  bool is_aa) {
+  Push<ClipRectOp>(0, rect, clip_op, is_aa);
+  IntersectClipBounds(rect, clip_op);
+}
+
+void DisplayListBuilder::clipRRect(const SkRRect& rrect,
+                                   SkClipOp clip_op,
+                                   bool is_aa) {
+  Push<ClipRRectOp>(0, rrect, clip_op, is_aa);
+  IntersectClipBounds(rrect.getBounds(), clip_op);
+}
+
+void DisplayListBuilder::clipPath(const SkPath& path,
+                                  SkClipOp clip_op,
+                                  bool is_aa) {
+  Push<ClipPathOp>(0, path, clip_op, is_aa);
+  if (!path.isInverseFillType()) {
+    IntersectClipBounds(path.getBounds(), clip_op);
+  }
+}
+
+void DisplayListBuilder::drawPaint() {
+  Push<DrawPaintOp>(0);
+  CheckPaintForGroupOpacity();
+  AccumulateUnbounded();
+}
+
+void DisplayListBuilder::drawColor(SkColor color, SkBlendMode mode) {
+  Push<DrawColorOp>(0, color, mode);
+  // The color doesn't come from the attributes, so it can't be modulated.
+  can_apply_group_opacity_ = false;
+  AccumulateUnbounded();
+}
+
+void DisplayListBuilder::drawLine(const SkPoint& p0, const SkPoint& p1) {
+  Push<DrawLineOp>(0, p0, p1);
+  SkRect bounds = SkRect::MakeLTRB(p0.fX, p0.fY, p1.fX, p1.fY).makeSorted();
+  AccumulateBounds(bounds, PaintUse::kStroke);
+}
+
+void DisplayListBuilder::drawRect(const SkRect& rect) {
+  Push<DrawRectOp>(0, rect);
+  AccumulateBounds(rect.makeSorted(), PaintUse::kAsIs);
+}
+
+void DisplayListBuilder::drawOval(const SkRect& bounds) {
+  Push<DrawOvalOp>(0, bounds);
+  AccumulateBounds(bounds.makeSorted(), PaintUse::kAsIs);
+}
+
+void DisplayListBuilder::drawCircle(const SkPoint& center, SkScalar radius) {
+  Push<DrawCircleOp>(0, center, radius);
+  AccumulateBounds(SkRect::MakeLTRB(center.fX - radius, center.fY - radius,
+                                    center.fX + radius, center.fY + radius),
+                   PaintUse::kAsIs);
+}
+
+void DisplayListBuilder::drawRRect(const SkRRect& rrect) {
+  Push<DrawRRectOp>(0, rrect);
+  AccumulateBounds(rrect.getBounds(), PaintUse::kAsIs);
+}
+
+void DisplayListBuilder::drawDRRect(const SkRRect& outer,
+                                    const SkRRect& inner) {
+  Push<DrawDRRectOp>(0, outer, inner);
+  AccumulateBounds(outer.getBounds(), PaintUse::kAsIs);
+}
+
+void DisplayListBuilder::drawPath(const SkPath& path) {
+  Push<DrawPathOp>(0, path);
+  if (path.isInverseFillType()) {
+    CheckPaintForGroupOpacity();
+    AccumulateUnbounded();
+  } else {
+    AccumulateBounds(path.getBounds(), PaintUse::kAsIs);
+  }
+}
+
+void DisplayListBuilder::drawArc(const SkRect& oval_bounds,
+                                 SkScalar start_degrees,
+                                 SkScalar sweep_degrees,
+                                 bool use_center) {
+  Push<DrawArcOp>(0, oval_bounds, start_degrees, sweep_degrees, use_center);
+  AccumulateBounds(oval_bounds.makeSorted(), PaintUse::kAsIs);
+}
+
+void DisplayListBuilder::drawPoints(SkCanvas::PointMode mode,
+                                    uint32_t count,
+                                    const SkPoint points[]) {
+  void* data = Push<DrawPointsOp>(
+      static_cast<uint64_t>(count) * sizeof(SkPoint), mode, count);
+  if (data == nullptr) {
+    return;
+  }
+  memcpy(data, points, count * sizeof(SkPoint));
+  // Separate points and lines are drawn one by one, and may overlap.
+  if (mode != SkCanvas::kPolygon_PointMode) {
+    can_apply_group_opacity_ = false;
+  }
+  SkRect bounds;
+  bounds.setBounds(points, count);
+  AccumulateBounds(bounds, PaintUse::kStroke);
+}
+
+void DisplayListBuilder::drawVertices(const sk_sp<SkVertices>& vertices,
+                                      SkBlendMode mode) {
+  Push<DrawVerticesOp>(0, vertices, mode);
+  // Triangles of a mesh may overlap.
+  can_apply_group_opacity_ = false;
+  AccumulateBounds(vertices->bounds(), PaintUse::kFill);
+}
+
+void DisplayListBuilder::drawPatch(const SkPoint cubics[12],
+                                   const SkColor colors[4],
+                                   const SkPoint tex_coords[4],
+                                   SkBlendMode mode) {
+  Push<DrawPatchOp>(0, cubics, colors, tex_coords, mode);
+  // A patch may fold over itself.
+  can_apply_group_opacity_ = false;
+  // The curves stay within the hull of their control points.
+  SkRect bounds;
+  bounds.setBounds(cubics, 12);
+  AccumulateBounds(bounds, PaintUse::kFill);
+}
+
+void DisplayListBuilder::drawImage(const sk_sp<SkImage>& image,
+                                   const SkPoint& point,
+                                   const SkSamplingOptions& sampling,
+                                   bool with_paint) {
+  Push<DrawImageOp>(0, image, point, sampling, with_paint);
+  AccumulateBounds(
+      SkRect::MakeXYWH(point.fX, point.fY, image->width(), image->height()),
+      with_paint ? PaintUse::kFill : PaintUse::kNone);
+}
+
+void DisplayListBuilder::drawImageRect(const sk_sp<SkImage>& image,
+                                       const SkRect& src,
+                                       const SkRect& dst,
+                                       const SkSamplingOptions& sampling,
+                                       bool with_paint,
+                                       SkCanvas::SrcRectConstraint constraint) {
+  Push<DrawImageRectOp>(0, image, src, dst, sampling, with_paint, constraint);
+  AccumulateBounds(dst.makeSorted(),
+                   with_paint ? PaintUse::kFill : PaintUse::kNone);
+}
+
+void DisplayListBuilder::drawImageLattice(const sk_sp<SkImage>& image,
+                                          const SkCanvas::Lattice& lattice,
+                                          const SkRect& dst,
+                                          SkFilterMode filter,
+                                          bool with_paint) {
+  int cell_count = lattice.fRectTypes
+                       ? (lattice.fXCount + 1) * (lattice.fYCount + 1)
+                       : 0;
+  uint64_t colors_bytes =
+      lattice.fColors ? static_cast<uint64_t>(cell_count) * sizeof(SkColor)
+                      : 0;
+  uint64_t bytes =
+      static_cast<uint64_t>(lattice.fXCount + lattice.fYCount) * sizeof(int) +
+      colors_bytes + static_cast<uint64_t>(cell_count) * sizeof(uint8_t);
+  uint8_t* data = static_cast<uint8_t*>(Push<DrawImageLatticeOp>(
+      bytes, image, lattice, cell_count, dst, filter, with_paint));
+  if (data == nullptr) {
+    return;
+  }
+  memcpy(data, lattice.fXDivs, lattice.fXCount * sizeof(int));
+  data += lattice.fXCount * sizeof(int);
+  memcpy(data, lattice.fYDivs, lattice.fYCount * sizeof(int));
+  data += lattice.fYCount * sizeof(int);
+  if (colors_bytes > 0) {
+    memcpy(data, lattice.fColors, colors_bytes);
+    data += colors_bytes;
+  }
+  if (cell_count > 0) {
+    memcpy(data, lattice.fRectTypes, cell_count * sizeof(uint8_t));
+  }
+  AccumulateBounds(dst.makeSorted(),
+                   with_paint ? PaintUse::kFill : PaintUse::kNone);
+}
+
+void DisplayListBuilder::drawAtlas(const sk_sp<SkImage>& atlas,
+                                   const SkRSXform xform[],
+                                   const SkRect tex[],
+                                   const SkColor colors[],
+                                   int count,
+                                   SkBlendMode mode,
+                                   const SkSamplingOptions& sampling,
+                                   const SkRect* cull_rect,
+                                   bool with_paint) {
+  uint64_t xform_bytes = static_cast<uint64_t>(count) * sizeof(SkRSXform);
+  uint64_t tex_bytes = static_cast<uint64_t>(count) * sizeof(SkRect);
+  uint64_t colors_bytes =
+      colors ? static_cast<uint64_t>(count) * sizeof(SkColor) : 0;
+  uint8_t* data = static_cast<uint8_t*>(Push<DrawAtlasOp>(
+      xform_bytes + tex_bytes + colors_bytes, atlas, count, mode, sampling,
+      colors != nullptr, cull_rect, with_paint));
+  if (data == nullptr) {
+    return;
+  }
+  memcpy(data, xform, xform_bytes);
+  memcpy(data + xform_bytes, tex, tex_bytes);
+  if (colors) {
+    memcpy(data + xform_bytes + tex_bytes, colors, colors_bytes);
+  }
+  // Sprites of an atlas may overlap.
+  can_apply_group_opacity_ = false;
+
+  SkRect bounds = SkRect::MakeEmpty();
+  if (cull_rect) {
+    bounds = *cull_rect;
+  } else {
+    for (int i = 0; i < count; i++) {
+      SkPoint quad[4];
+      xform[i].toQuad(tex[i].width(), tex[i].height(), quad);
+      SkRect quad_bounds;
+      quad_bounds.setBounds(quad, 4);
+      bounds.join(quad_bounds);
+    }
+  }
+  AccumulateBounds(bounds, with_paint ? PaintUse::kFill : PaintUse::kNone);
+}
+
+void DisplayListBuilder::drawPicture(const sk_sp<SkPicture>& picture,
+                                     const SkMatrix* matrix,
+                                     bool with_paint) {
+  Push<DrawPictureOp>(0, picture, matrix, with_paint);
+  // What a picture draws is not known.
+  can_apply_group_opacity_ = false;
+  // A picture drawn with a paint is drawn through a layer.
+  if (with_paint && IsUnboundedLayerPaint(current_paint_)) {
+    AccumulateUnbounded();
+    return;
+  }
+  SkRect bounds = picture->cullRect();
+  if (matrix) {
+    matrix->mapRect(&bounds);
+  }
+  AccumulateBounds(bounds, with_paint ? PaintUse::kFill : PaintUse::kNone);
+}
+
+void DisplayListBuilder::drawDisplayList(
+    const sk_sp<DisplayList>& display_list) {
+  Push<DrawDisplayListOp>(0, display_list);
+  if (!display_list->can_apply_group_opacity()) {
+    can_apply_group_opacity_ = false;
+  }
+  AccumulateBounds(display_list->bounds(), PaintUse::kNone);
+}
+
+void DisplayListBuilder::drawTextBlob(const sk_sp<SkTextBlob>& blob,
+                                      SkScalar x,
+                                      SkScalar y) {
+  Push<DrawTextBlobOp>(0, blob, x, y);
+  // Glyphs within a blob are drawn one by one, and may overlap.
+  can_apply_group_opacity_ = false;
+  AccumulateBounds(blob->bounds().makeOffset(x, y), PaintUse::kAsIs);
+}
+
+void DisplayListBuilder::drawShadowRec(const SkPath& path,
+                                       const SkDrawShadowRec& rec) {
+  Push<DrawShadowRecOp>(0, path, rec);
+  // Shadows are drawn with colors of their own.
+  can_apply_group_opacity_ = false;
+  SkRect bounds;
+  SkDrawShadowMetrics::GetLocalBounds(path, rec, current_matrix_, &bounds);
+  AccumulateBounds(bounds, PaintUse::kNone);
+}
+
+void DisplayListBuilder::IntersectClipBounds(const SkRect& bounds,
+                                             SkClipOp clip_op) {
+  // A difference clip may make the clip smaller, but not in a way that a
+  // rect can describe.
+  if (clip_op != SkClipOp::kIntersect) {
+    return;
+  }
+  if (!current_clip_bounds_.intersect(current_matrix_.mapRect(bounds))) {
+    current_clip_bounds_.setEmpty();
+  }
+}
+
+void DisplayListBuilder::AccumulateBounds(SkRect bounds, PaintUse use) {
+  if (use != PaintUse::kNone) {
+    CheckPaintForGroupOpacity();
+    const SkPaint* paint = &current_paint_;
+    SkPaint styled_paint;
+    if (use != PaintUse::kAsIs) {
+      SkPaint::Style style = use == PaintUse::kFill ? SkPaint::kFill_Style
+                                                    : SkPaint::kStroke_Style;
+      if (current_paint_.getStyle() != style) {
+        styled_paint = current_paint_;
+        styled_paint.setStyle(style);
+        paint = &styled_paint;
+      }
+    }
+    if (!paint->canComputeFastBounds()) {
+      AccumulateUnbounded();
+      return;
+    }
+    SkRect storage;
+    bounds = paint->computeFastBounds(bounds, &storage);
+  }
+  AccumulateDeviceBounds(current_matrix_.mapRect(bounds));
+}
+
+void DisplayListBuilder::AccumulateUnbounded() {
+  AccumulateDeviceBounds(current_clip_bounds_);
+}
+
+void DisplayListBuilder::AccumulateDeviceBounds(const SkRect& device_bounds) {
+  SkRect bounds = device_bounds;
+  if (!bounds.intersect(current_clip_bounds_)) {
+    bounds.setEmpty();
+  }
+  if (SkRect::Intersects(bounds, accumulated_bounds_)) {
+    can_apply_group_opacity_ = false;
+  }
+  draw_bounds_.push_back(bounds);
+  accumulated_bounds_.join(bounds);
+}
+
+void DisplayListBuilder::CheckPaintForGroupOpacity() {
+  if (!CanModulatePaintOpacity(current_paint_)) {
+    can_apply_group_opacity_ = false;
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,504 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DISPLAY_LIST_H_
+#define FLUTTER_FLOW_DISPLAY_LIST_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkBBHFactory.h"
+#include "third_party/skia/include/core/SkBlendMode.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkColorFilter.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkImageFilter.h"
+#include "third_party/skia/include/core/SkMaskFilter.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkPathEffect.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkRSXform.h"
+#include "third_party/skia/include/core/SkRefCnt.h"
+#include "third_party/skia/include/core/SkSamplingOptions.h"
+#include "third_party/skia/include/core/SkShader.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/core/SkVertices.h"
+
+struct SkDrawShadowRec;
+
+// A display list is a flat buffer of drawing operations recorded by the engine
+// itself, as a lighter weight alternative to recording into an SkPicture.
+//
+// Each operation is encoded as a small header holding its type and size,
+// followed by its arguments. The attributes of an SkPaint are not stored with
+// each draw call; they are recorded as separate operations when they change,
+// and the draw calls that follow use them. Recording an operation is an append
+// to the buffer, and playing it back is a switch on its type.
+//
+// The bounds of each draw call are computed as it is recorded, so that the
+// list knows its bounds without replaying it, and playback can skip the calls
+// that fall outside of the clip. The list also has a hash of its contents, so
+// that lists recorded from the same calls can be found to be equal without
+// comparing them call by call in the common case where they are not.
+
+namespace flutter {
+
+#define FOR_EACH_DISPLAY_LIST_OP(V) \
+  V(SetAA)                          \
+  V(SetDither)                      \
+  V(SetColor)                       \
+  V(SetStyle)                       \
+  V(SetStrokeWidth)                 \
+  V(SetMiterLimit)                  \
+  V(SetCap)                         \
+  V(SetJoin)                        \
+  V(SetBlendMode)                   \
+  V(SetShader)                      \
+  V(SetColorFilter)                 \
+  V(SetPathEffect)                  \
+  V(SetMaskFilter)                  \
+  V(SetImageFilter)                 \
+                                    \
+  V(Save)                           \
+  V(SaveLayer)                      \
+  V(Restore)                        \
+                                    \
+  V(Translate)                      \
+  V(Scale)                          \
+  V(Rotate)                         \
+  V(Skew)                           \
+  V(Transform2x3)                   \
+  V(Transform3x3)                   \
+                                    \
+  V(ClipRect)                       \
+  V(ClipRRect)                      \
+  V(ClipPath)                       \
+                                    \
+  V(DrawPaint)                      \
+  V(DrawColor)                      \
+  V(DrawLine)                       \
+  V(DrawRect)                       \
+  V(DrawOval)                       \
+  V(DrawCircle)                     \
+  V(DrawRRect)                      \
+  V(DrawDRRect)                     \
+  V(DrawPath)                       \
+  V(DrawArc)                        \
+  V(DrawPoints)                     \
+  V(DrawVertices)                   \
+  V(DrawPatch)                      \
+  V(DrawImage)                      \
+  V(DrawImageRect)                  \
+  V(DrawImageLattice)               \
+  V(DrawAtlas)                      \
+  V(DrawPicture)                    \
+  V(DrawDisplayList)                \
+  V(DrawTextBlob)                   \
+  V(DrawShadowRec)
+
+#define DL_OP_TO_ENUM_VALUE(name) k##name,
+enum class DisplayListOpType { FOR_EACH_DISPLAY_LIST_OP(DL_OP_TO_ENUM_VALUE) };
+#undef DL_OP_TO_ENUM_VALUE
+
+class Dispatcher;
+class DisplayListBuilder;
+
+//------------------------------------------------------------------------------
+/// An immutable list of drawing operations, built by a |DisplayListBuilder|.
+///
+/// Like an SkPicture, a display list may hold references to images that are
+/// backed by GPU resources, so it must be collected on the IO thread once it
+/// has been handed to the engine.
+///
+class DisplayList : public SkRefCnt {
+ public:
+  ~DisplayList() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Plays the operations back to |dispatcher|, in order.
+  ///
+  void Dispatch(Dispatcher& dispatcher) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Plays the operations back to |dispatcher|, leaving out the
+  ///             draw calls that don't touch |cull_rect|. The operations that
+  ///             change the state of the canvas are always played back.
+  ///
+  void Dispatch(Dispatcher& dispatcher, const SkRect& cull_rect) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Draws the list into |canvas|, culled to its clip, as if it
+  ///             were drawn into a layer with the given |opacity|.
+  ///
+  void RenderTo(SkCanvas* canvas, SkScalar opacity = SK_Scalar1) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether this list has the same operations as |other|. Images
+  ///             and the other objects that the operations refer to are
+  ///             compared by identity, and paths by value.
+  ///
+  bool Equals(const DisplayList& other) const;
+
+  //----------------------------------------------------------------------------
+  /// @return     The bounds of everything the list draws, in the coordinates
+  ///             it was recorded in, limited to the cull rect it was recorded
+  ///             with.
+  ///
+  const SkRect& bounds() const { return bounds_; }
+
+  //----------------------------------------------------------------------------
+  /// @return     The number of operations in the list, including those that
+  ///             change attributes or the state of the canvas.
+  ///
+  int op_count() const { return op_count_; }
+
+  //----------------------------------------------------------------------------
+  /// @return     The memory held by the list, not counting the objects that
+  ///             its operations refer to.
+  ///
+  size_t bytes() const;
+
+  //----------------------------------------------------------------------------
+  /// @return     A hash of the operations, which is the same for lists that
+  ///             are |Equals|.
+  ///
+  size_t hash() const { return hash_; }
+
+  //----------------------------------------------------------------------------
+  /// @return     An ID unique to this list in the process, which is never 0.
+  ///
+  uint32_t unique_id() const { return unique_id_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether an opacity can be applied to the list by modulating
+  ///             the alpha of each draw call, instead of drawing the list
+  ///             into a layer with that opacity. This holds when no two draw
+  ///             calls overlap and each of them blends its source over what
+  ///             is under it.
+  ///
+  bool can_apply_group_opacity() const { return can_apply_group_opacity_; }
+
+ private:
+  DisplayList(std::unique_ptr<uint8_t[]> storage,
+              size_t used,
+              int op_count,
+              const SkRect& bounds,
+              sk_sp<SkBBoxHierarchy> draw_bounds,
+              bool can_apply_group_opacity);
+
+  std::unique_ptr<uint8_t[]> storage_;
+  const size_t used_;
+  const int op_count_;
+  const SkRect bounds_;
+  // Indexes the bounds of the draw calls in the order they were recorded, for
+  // culling.
+  const sk_sp<SkBBoxHierarchy> draw_bounds_;
+  const uint32_t unique_id_;
+  const bool can_apply_group_opacity_;
+  size_t hash_ = 0;
+
+  friend class DisplayListBuilder;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayList);
+};
+
+//------------------------------------------------------------------------------
+/// Receives the operations of a display list as it is played back, and the
+/// calls that record them into a |DisplayListBuilder|.
+///
+/// The attribute calls change the state used by the draw calls that follow,
+/// in the same way as changing the fields of an SkPaint that is passed to
+/// each of them. Draw calls that take an optional paint in SkCanvas take a
+/// |with_paint| flag instead, which says whether they use the attributes.
+///
+class Dispatcher {
+ public:
+  virtual void setAA(bool aa) = 0;
+  virtual void setDither(bool dither) = 0;
+  virtual void setColor(SkColor color) = 0;
+  virtual void setStyle(SkPaint::Style style) = 0;
+  virtual void setStrokeWidth(SkScalar width) = 0;
+  virtual void setMiterLimit(SkScalar limit) = 0;
+  virtual void setCap(SkPaint::Cap cap) = 0;
+  virtual void setJoin(SkPaint::Join join) = 0;
+  virtual void setBlendMode(SkBlendMode mode) = 0;
+  virtual void setShader(sk_sp<SkShader> shader) = 0;
+  virtual void setColorFilter(sk_sp<SkColorFilter> filter) = 0;
+  virtual void setPathEffect(sk_sp<SkPathEffect> effect) = 0;
+  virtual void setMaskFilter(sk_sp<SkMaskFilter> filter) = 0;
+  virtual void setImageFilter(sk_sp<SkImageFilter> filter) = 0;
+
+  virtual void save() = 0;
+  virtual void saveLayer(const SkRect* bounds,
+                         bool with_paint,
+                         sk_sp<SkImageFilter> backdrop) = 0;
+  virtual void restore() = 0;
+
+  virtual void translate(SkScalar tx, SkScalar ty) = 0;
+  virtual void scale(SkScalar sx, SkScalar sy) = 0;
+  virtual void rotate(SkScalar degrees) = 0;
+  virtual void skew(SkScalar sx, SkScalar sy) = 0;
+  virtual void transform(const SkMatrix& matrix) = 0;
+
+  virtual void clipRect(const SkRect& rect, SkClipOp clip_op, bool is_aa) = 0;
+  virtual void clipRRect(const SkRRect& rrect,
+                         SkClipOp clip_op,
+                         bool is_aa) = 0;
+  virtual void clipPath(const SkPath& path, SkClipOp clip_op, bool is_aa) = 0;
+
+  virtual void drawPaint() = 0;
+  virtual void drawColor(SkColor color, SkBlendMode mode) = 0;
+  virtual void drawLine(const SkPoint& p0, const SkPoint& p1) = 0;
+  virtual void drawRect(const SkRect& rect) = 0;
+  virtual void drawOval(const SkRect& bounds) = 0;
+  virtual void drawCircle(const SkPoint& center, SkScalar radius) = 0;
+  virtual void drawRRect(const SkRRect& rrect) = 0;
+  virtual void drawDRRect(const SkRRect& outer, const SkRRect& inner) = 0;
+  virtual void drawPath(const SkPath& path) = 0;
+  virtual void drawArc(const SkRect& oval_bounds,
+                       SkScalar start_degrees,
+                       SkScalar sweep_degrees,
+                       bool use_center) = 0;
+  virtual void drawPoints(SkCanvas::PointMode mode,
+                          uint32_t count,
+                          const SkPoint points[]) = 0;
+  virtual void drawVertices(const sk_sp<SkVertices>& vertices,
+                            SkBlendMode mode) = 0;
+  virtual void drawPatch(const SkPoint cubics[12],
+                         const SkColor colors[4],
+                         const SkPoint tex_coords[4],
+                         SkBlendMode mode) = 0;
+  virtual void drawImage(const sk_sp<SkImage>& image,
+                         const SkPoint& point,
+                         const SkSamplingOptions& sampling,
+                         bool with_paint) = 0;
+  virtual void drawImageRect(const sk_sp<SkImage>& image,
+                             const SkRect& src,
+                             const SkRect& dst,
+                             const SkSamplingOptions& sampling,
+                             bool with_paint,
+                             SkCanvas::SrcRectConstraint constraint) = 0;
+  virtual void drawImageLattice(const sk_sp<SkImage>& image,
+                                const SkCanvas::Lattice& lattice,
+                                const SkRect& dst,
+                                SkFilterMode filter,
+                                bool with_paint) = 0;
+  virtual void drawAtlas(const sk_sp<SkImage>& atlas,
+                         const SkRSXform xform[],
+                         const SkRect tex[],
+                         const SkColor colors[],
+                         int count,
+                         SkBlendMode mode,
+                         const SkSamplingOptions& sampling,
+                         const SkRect* cull_rect,
+                         bool with_paint) = 0;
+  virtual void drawPicture(const sk_sp<SkPicture>& picture,
+                           const SkMatrix* matrix,
+                           bool with_paint) = 0;
+  virtual void drawDisplayList(const sk_sp<DisplayList>& display_list) = 0;
+  virtual void drawTextBlob(const sk_sp<SkTextBlob>& blob,
+                            SkScalar x,
+                            SkScalar y) = 0;
+  virtual void drawShadowRec(const SkPath& path,
+                             const SkDrawShadowRec& rec) = 0;
+
+ protected:
+  virtual ~Dispatcher() = default;
+};
+
+//------------------------------------------------------------------------------
+/// Records the calls made to it into a |DisplayList|.
+///
+/// Attribute calls that don't change the current value are not recorded, so
+/// a caller may set all of the attributes of a paint before each draw call
+/// and only the ones that changed take up space in the list.
+///
+class DisplayListBuilder final : public Dispatcher {
+ public:
+  static constexpr SkRect kMaxCullRect =
+      SkRect::MakeLTRB(-1E9F, -1E9F, 1E9F, 1E9F);
+
+  explicit DisplayListBuilder(const SkRect& cull_rect = kMaxCullRect);
+
+  ~DisplayListBuilder() override;
+
+  // |Dispatcher|
+  void setAA(bool aa) override;
+  void setDither(bool dither) override;
+  void setColor(SkColor color) override;
+  void setStyle(SkPaint::Style style) override;
+  void setStrokeWidth(SkScalar width) override;
+  void setMiterLimit(SkScalar limit) override;
+  void setCap(SkPaint::Cap cap) override;
+  void setJoin(SkPaint::Join join) override;
+  void setBlendMode(SkBlendMode mode) override;
+  void setShader(sk_sp<SkShader> shader) override;
+  void setColorFilter(sk_sp<SkColorFilter> filter) override;
+  void setPathEffect(sk_sp<SkPathEffect> effect) override;
+  void setMaskFilter(sk_sp<SkMaskFilter> filter) override;
+  void setImageFilter(sk_sp<SkImageFilter> filter) override;
+
+  // |Dispatcher|
+  void save() override;
+  void saveLayer(const SkRect* bounds,
+                 bool with_paint,
+                 sk_sp<SkImageFilter> backdrop = nullptr) override;
+  void restore() override;
+
+  // |Dispatcher|
+  void translate(SkScalar tx, SkScalar ty) override;
+  void scale(SkScalar sx, SkScalar sy) override;
+  void rotate(SkScalar degrees) override;
+  void skew(SkScalar sx, SkScalar sy) override;
+  void transform(const SkMatrix& matrix) override;
+
+  // |Dispatcher|
+  void clipRect(const SkRect& rect, SkClipOp clip_op, bool is_aa) override;
+  void clipRRect(const SkRRect& rrect, SkClipOp clip_op, bool is_aa) override;
+  void clipPath(const SkPath& path, SkClipOp clip_op, bool is_aa) override;
+
+  // |Dispatcher|
+  void drawPaint() override;
+  void drawColor(SkColor color, SkBlendMode mode) override;
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override;
+  void drawRect(const SkRect& rect) override;
+  void drawOval(const SkRect& bounds) override;
+  void drawCircle(const SkPoint& center, SkScalar radius) override;
+  void drawRRect(const SkRRect& rrect) override;
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override;
+  void drawPath(const SkPath& path) override;
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override;
+  void drawPoints(SkCanvas::PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override;
+  void drawVertices(const sk_sp<SkVertices>& vertices,
+                    SkBlendMode mode) override;
+  void drawPatch(const SkPoint cubics[12],
+                 const SkColor colors[4],
+                 const SkPoint tex_coords[4],
+                 SkBlendMode mode) override;
+  void drawImage(const sk_sp<SkImage>& image,
+                 const SkPoint& point,
+                 const SkSamplingOptions& sampling,
+                 bool with_paint) override;
+  void drawImageRect(const sk_sp<SkImage>& image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     const SkSamplingOptions& sampling,
+                     bool with_paint,
+                     SkCanvas::SrcRectConstraint constraint) override;
+  void drawImageLattice(const sk_sp<SkImage>& image,
+                        const SkCanvas::Lattice& lattice,
+                        const SkRect& dst,
+                        SkFilterMode filter,
+                        bool with_paint) override;
+  void drawAtlas(const sk_sp<SkImage>& atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const SkColor colors[],
+                 int count,
+                 SkBlendMode mode,
+                 const SkSamplingOptions& sampling,
+                 const SkRect* cull_rect,
+                 bool with_paint) override;
+  void drawPicture(const sk_sp<SkPicture>& picture,
+                   const SkMatrix* matrix,
+                   bool with_paint) override;
+  void drawDisplayList(const sk_sp<DisplayList>& display_list) override;
+  void drawTextBlob(const sk_sp<SkTextBlob>& blob,
+                    SkScalar x,
+                    SkScalar y) override;
+  void drawShadowRec(const SkPath& path, const SkDrawShadowRec& rec) override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets each attribute to its value in |paint|, recording only
+  ///             those that change. Callers that hold an SkPaint use this
+  ///             before a draw call instead of setting the attributes one by
+  ///             one.
+  ///
+  void setAttributesFromPaint(const SkPaint& paint);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Ends the recording, restoring any unbalanced saves, and
+  ///             resets the builder to record a new list with the same cull
+  ///             rect.
+  ///
+  /// @return     The recorded list.
+  ///
+  sk_sp<DisplayList> Build();
+
+ private:
+  // How the current attributes affect the bounds of a draw call.
+  enum class PaintUse {
+    // The call doesn't use the attributes.
+    kNone,
+    // The call fills its geometry whatever the style.
+    kFill,
+    // The call strokes its geometry whatever the style.
+    kStroke,
+    // The call follows the style.
+    kAsIs,
+  };
+
+  struct SaveInfo {
+    SkMatrix matrix;
+    SkRect clip_bounds;
+    bool is_layer = false;
+    // For layers, the bounds accumulated before the layer was saved, the clip
+    // of its contents, and how the layer is drawn when it is restored.
+    SkRect outer_bounds;
+    SkRect layer_clip_bounds;
+    size_t first_draw_index = 0;
+    sk_sp<SkImageFilter> image_filter;
+    bool is_unbounded = false;
+  };
+
+  const SkRect cull_rect_;
+
+  std::unique_ptr<uint8_t[]> storage_;
+  size_t used_ = 0;
+  size_t allocated_ = 0;
+  int op_count_ = 0;
+
+  // The attributes as they stand after the operations recorded so far.
+  SkPaint current_paint_;
+
+  // The transform and a conservative bound of the clip, in the coordinates of
+  // the list, as they stand after the operations recorded so far.
+  SkMatrix current_matrix_;
+  SkRect current_clip_bounds_;
+  std::vector<SaveInfo> save_stack_;
+
+  // The bounds of each draw call, in the coordinates of the list, and of all
+  // of them since the innermost layer was saved.
+  std::vector<SkRect> draw_bounds_;
+  SkRect accumulated_bounds_ = SkRect::MakeEmpty();
+
+  // Whether the operations recorded so far allow the list to take an opacity
+  // without a layer. See |DisplayList::can_apply_group_opacity|.
+  bool can_apply_group_opacity_ = true;
+
+  // Returns where the trailing data of the operation goes, or null if the
+  // operation is too large to record, in which case nothing is recorded.
+  template <typename T, typename... Args>
+  void* Push(uint64_t trailing_bytes, Args&&... args);
+
+  void IntersectClipBounds(const SkRect& bounds, SkClipOp clip_op);
+  void AccumulateBounds(SkRect bounds, PaintUse use);
+  void AccumulateUnbounded();
+  void AccumulateDeviceBounds(const SkRect& device_bounds);
+  void CheckPaintForGroupOpacity();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListBuilder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_DISPLAY_LIST_H_
@@ -0,0 +1,143 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/display_list.h"
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/flow/display_list_canvas.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/utils/SkNoDrawCanvas.h"
+
+namespace flutter {
+namespace {
+
+constexpr SkRect kBounds = SkRect::MakeLTRB(0, 0, 1000, 1000);
+
+// A mix of the calls the framework makes when painting widgets, with a paint
+// whose color changes every few calls.
+template <typename Draw>
+void DrawScene(int draw_count, Draw draw) {
+  SkPath path;
+  path.addCircle(20, 20, 15);
+  SkPaint paint;
+  paint.setAntiAlias(true);
+  for (int i = 0; i < draw_count; i++) {
+    paint.setColor(SkColorSetARGB(255, i % 4 * 60, 0, 0));
+    SkScalar x = (i * 37) % 960;
+    SkScalar y = (i * 53) % 960;
+    draw(i % 3, SkRect::MakeXYWH(x, y, 40, 40), path, paint);
+  }
+}
+
+void DrawSceneToCanvas(SkCanvas* canvas, int draw_count) {
+  DrawScene(draw_count, [canvas](int kind, const SkRect& rect,
+                                 const SkPath& path, const SkPaint& paint) {
+    switch (kind) {
+      case 0:
+        canvas->drawRect(rect, paint);
+        break;
+      case 1:
+        canvas->drawRRect(SkRRect::MakeRectXY(rect, 4, 4), paint);
+        break;
+      default:
+        canvas->save();
+        canvas->translate(rect.fLeft, rect.fTop);
+        canvas->drawPath(path, paint);
+        canvas->restore();
+        break;
+    }
+  });
+}
+
+void DrawSceneToBuilder(DisplayListBuilder& builder, int draw_count) {
+  DrawScene(draw_count, [&builder](int kind, const SkRect& rect,
+                                   const SkPath& path, const SkPaint& paint) {
+    builder.setAttributesFromPaint(paint);
+    switch (kind) {
+      case 0:
+        builder.drawRect(rect);
+        break;
+      case 1:
+        builder.drawRRect(SkRRect::MakeRectXY(rect, 4, 4));
+        break;
+      default:
+        builder.save();
+        builder.translate(rect.fLeft, rect.fTop);
+        builder.drawPath(path);
+        builder.restore();
+        break;
+    }
+  });
+}
+
+sk_sp<SkPicture> RecordPicture(int draw_count) {
+  SkPictureRecorder recorder;
+  SkRTreeFactory rtree_factory;
+  DrawSceneToCanvas(recorder.beginRecording(kBounds, &rtree_factory),
+                    draw_count);
+  return recorder.finishRecordingAsPicture();
+}
+
+sk_sp<DisplayList> RecordDisplayList(int draw_count) {
+  DisplayListBuilder builder(kBounds);
+  DrawSceneToBuilder(builder, draw_count);
+  return builder.Build();
+}
+
+}  // namespace
+
+static void BM_RecordSkPicture(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(RecordPicture(state.range(0)));
+  }
+}
+
+static void BM_RecordDisplayList(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(RecordDisplayList(state.range(0)));
+  }
+}
+
+// The cost of recording a display list through an SkCanvas, as code that
+// only has an SkCanvas does.
+static void BM_RecordDisplayListThroughCanvas(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    auto recorder = sk_make_sp<DisplayListCanvasRecorder>(kBounds);
+    DrawSceneToCanvas(recorder.get(), state.range(0));
+    benchmark::DoNotOptimize(recorder->Build());
+  }
+}
+
+static void BM_PlaybackSkPicture(benchmark::State& state) {
+  sk_sp<SkPicture> picture = RecordPicture(state.range(0));
+  SkNoDrawCanvas canvas(kBounds.width(), kBounds.height());
+  while (state.KeepRunning()) {
+    picture->playback(&canvas);
+  }
+}
+
+static void BM_PlaybackDisplayList(benchmark::State& state) {
+  sk_sp<DisplayList> display_list = RecordDisplayList(state.range(0));
+  SkNoDrawCanvas canvas(kBounds.width(), kBounds.height());
+  while (state.KeepRunning()) {
+    display_list->RenderTo(&canvas);
+  }
+}
+
+static void BM_CompareEqualDisplayLists(benchmark::State& state) {
+  sk_sp<DisplayList> display_list = RecordDisplayList(state.range(0));
+  sk_sp<DisplayList> same_display_list = RecordDisplayList(state.range(0));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(display_list->Equals(*same_display_list));
+  }
+}
+
+BENCHMARK(BM_RecordSkPicture)->Arg(100)->Arg(1000);
+BENCHMARK(BM_RecordDisplayList)->Arg(100)->Arg(1000);
+BENCHMARK(BM_RecordDisplayListThroughCanvas)->Arg(100)->Arg(1000);
+BENCHMARK(BM_PlaybackSkPicture)->Arg(100)->Arg(1000);
+BENCHMARK(BM_PlaybackDisplayList)->Arg(100)->Arg(1000);
+BENCHMARK(BM_CompareEqualDisplayLists)->Arg(100)->Arg(1000);
+
+}  // namespace flutter
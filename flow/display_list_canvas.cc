@@ -0,0 +1,631 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/display_list_canvas.h"
+
+#include "third_party/skia/include/core/SkDrawable.h"
+#include "third_party/skia/include/core/SkM44.h"
+#include "third_party/skia/include/core/SkRegion.h"
+
+namespace flutter {
+
+// The canvas hands the objects it draws over as const pointers, while the
+// display list holds them the way the rest of the engine does.
+template <typename T>
+static sk_sp<T> RefConst(const T* object) {
+  return sk_ref_sp(const_cast<T*>(object));
+}
+
+DisplayListCanvasDispatcher::DisplayListCanvasDispatcher(SkCanvas* canvas,
+                                                         SkScalar opacity)
+    : canvas_(canvas), opacity_(opacity) {
+  paint_.setAlphaf(opacity_);
+  opacity_paint_.setAlphaf(opacity_);
+}
+
+DisplayListCanvasDispatcher::~DisplayListCanvasDispatcher() = default;
+
+void DisplayListCanvasDispatcher::setAA(bool aa) {
+  paint_.setAntiAlias(aa);
+}
+
+void DisplayListCanvasDispatcher::setDither(bool dither) {
+  paint_.setDither(dither);
+}
+
+void DisplayListCanvasDispatcher::setColor(SkColor color) {
+  paint_.setColor(color);
+  if (opacity_ < SK_Scalar1) {
+    paint_.setAlphaf(paint_.getAlphaf() * opacity_);
+  }
+}
+
+void DisplayListCanvasDispatcher::setStyle(SkPaint::Style style) {
+  paint_.setStyle(style);
+}
+
+void DisplayListCanvasDispatcher::setStrokeWidth(SkScalar width) {
+  paint_.setStrokeWidth(width);
+}
+
+void DisplayListCanvasDispatcher::setMiterLimit(SkScalar limit) {
+  paint_.setStrokeMiter(limit);
+}
+
+void DisplayListCanvasDispatcher::setCap(SkPaint::Cap cap) {
+  paint_.setStrokeCap(cap);
+}
+
+void DisplayListCanvasDispatcher::setJoin(SkPaint::Join join) {
+  paint_.setStrokeJoin(join);
+}
+
+void DisplayListCanvasDispatcher::setBlendMode(SkBlendMode mode) {
+  paint_.setBlendMode(mode);
+}
+
+void DisplayListCanvasDispatcher::setShader(sk_sp<SkShader> shader) {
+  paint_.setShader(std::move(shader));
+}
+
+void DisplayListCanvasDispatcher::setColorFilter(sk_sp<SkColorFilter> filter) {
+  paint_.setColorFilter(std::move(filter));
+}
+
+void DisplayListCanvasDispatcher::setPathEffect(sk_sp<SkPathEffect> effect) {
+  paint_.setPathEffect(std::move(effect));
+}
+
+void DisplayListCanvasDispatcher::setMaskFilter(sk_sp<SkMaskFilter> filter) {
+  paint_.setMaskFilter(std::move(filter));
+}
+
+void DisplayListCanvasDispatcher::setImageFilter(sk_sp<SkImageFilter> filter) {
+  paint_.setImageFilter(std::move(filter));
+}
+
+void DisplayListCanvasDispatcher::save() {
+  canvas_->save();
+}
+
+void DisplayListCanvasDispatcher::saveLayer(const SkRect* bounds,
+                                            bool with_paint,
+                                            sk_sp<SkImageFilter> backdrop) {
+  canvas_->saveLayer(
+      SkCanvas::SaveLayerRec(bounds, paint(with_paint), backdrop.get(), 0));
+}
+
+void DisplayListCanvasDispatcher::restore() {
+  canvas_->restore();
+}
+
+void DisplayListCanvasDispatcher::translate(SkScalar tx, SkScalar ty) {
+  canvas_->translate(tx, ty);
+}
+
+void DisplayListCanvasDispatcher::scale(SkScalar sx, SkScalar sy) {
+  canvas_->scale(sx, sy);
+}
+
+void DisplayListCanvasDispatcher::rotate(SkScalar degrees) {
+  canvas_->rotate(degrees);
+}
+
+void DisplayListCanvasDispatcher::skew(SkScalar sx, SkScalar sy) {
+  canvas_->skew(sx, sy);
+}
+
+void DisplayListCanvasDispatcher::transform(const SkMatrix& matrix) {
+  canvas_->concat(matrix);
+}
+
+void DisplayListCanvasDispatcher::clipRect(const SkRect& rect,
+                                           SkClipOp clip_op,
+                                           bool is_aa) {
+  canvas_->clipRect(rect, clip_op, is_aa);
+}
+
+void DisplayListCanvasDispatcher::clipRRect(const SkRRect& rrect,
+                                            SkClipOp clip_op,
+                                            bool is_aa) {
+  canvas_->clipRRect(rrect, clip_op, is_aa);
+}
+
+void DisplayListCanvasDispatcher::clipPath(const SkPath& path,
+                                           SkClipOp clip_op,
+                                           bool is_aa) {
+  canvas_->clipPath(path, clip_op, is_aa);
+}
+
+void DisplayListCanvasDispatcher::drawPaint() {
+  canvas_->drawPaint(paint_);
+}
+
+void DisplayListCanvasDispatcher::drawColor(SkColor color, SkBlendMode mode) {
+  canvas_->drawColor(color, mode);
+}
+
+void DisplayListCanvasDispatcher::drawLine(const SkPoint& p0,
+                                           const SkPoint& p1) {
+  canvas_->drawLine(p0, p1, paint_);
+}
+
+void DisplayListCanvasDispatcher::drawRect(const SkRect& rect) {
+  canvas_->drawRect(rect, paint_);
+}
+
+void DisplayListCanvasDispatcher::drawOval(const SkRect& bounds) {
+  canvas_->drawOval(bounds, paint_);
+}
+
+void DisplayListCanvasDispatcher::drawCircle(const SkPoint& center,
+                                             SkScalar radius) {
+  canvas_->drawCircle(center, radius, paint_);
+}
+
+void DisplayListCanvasDispatcher::drawRRect(const SkRRect& rrect) {
+  canvas_->drawRRect(rrect, paint_);
+}
+
+void DisplayListCanvasDispatcher::drawDRRect(const SkRRect& outer,
+                                             const SkRRect& inner) {
+  canvas_->drawDRRect(outer, inner, paint_);
+}
+
+void DisplayListCanvasDispatcher::drawPath(const SkPath& path) {
+  canvas_->drawPath(path, paint_);
+}
+
+void DisplayListCanvasDispatcher::drawArc(const SkRect& oval_bounds,
+                                          SkScalar start_degrees,
+                                          SkScalar sweep_degrees,
+                                          bool use_center) {
+  canvas_->drawArc(oval_bounds, start_degrees, sweep_degrees, use_center,
+                   paint_);
+}
+
+void DisplayListCanvasDispatcher::drawPoints(SkCanvas::PointMode mode,
+                                             uint32_t count,
+                                             const SkPoint points[]) {
+  canvas_->drawPoints(mode, count, points, paint_);
+}
+
+void DisplayListCanvasDispatcher::drawVertices(
+    const sk_sp<SkVertices>& vertices,
+    SkBlendMode mode) {
+  canvas_->drawVertices(vertices, mode, paint_);
+}
+
+void DisplayListCanvasDispatcher::drawPatch(const SkPoint cubics[12],
+                                            const SkColor colors[4],
+                                            const SkPoint tex_coords[4],
+                                            SkBlendMode mode) {
+  canvas_->drawPatch(cubics, colors, tex_coords, mode, paint_);
+}
+
+void DisplayListCanvasDispatcher::drawImage(const sk_sp<SkImage>& image,
+                                            const SkPoint& point,
+                                            const SkSamplingOptions& sampling,
+                                            bool with_paint) {
+  canvas_->drawImage(image.get(), point.fX, point.fY, sampling,
+                     paint(with_paint));
+}
+
+void DisplayListCanvasDispatcher::drawImageRect(
+    const sk_sp<SkImage>& image,
+    const SkRect& src,
+    const SkRect& dst,
+    const SkSamplingOptions& sampling,
+    bool with_paint,
+    SkCanvas::SrcRectConstraint constraint) {
+  canvas_->drawImageRect(image.get(), src, dst, sampling, paint(with_paint),
+                         constraint);
+}
+
+void DisplayListCanvasDispatcher::drawImageLattice(
+    const sk_sp<SkImage>& image,
+    const SkCanvas::Lattice& lattice,
+    const SkRect& dst,
+    SkFilterMode filter,
+    bool with_paint) {
+  canvas_->drawImageLattice(image.get(), lattice, dst, filter,
+                            paint(with_paint));
+}
+
+void DisplayListCanvasDispatcher::drawAtlas(const sk_sp<SkImage>& atlas,
+                                            const SkRSXform xform[],
+                                            const SkRect tex[],
+                                            const SkColor colors[],
+                                            int count,
+                                            SkBlendMode mode,
+                                            const SkSamplingOptions& sampling,
+                                            const SkRect* cull_rect,
+                                            bool with_paint) {
+  canvas_->drawAtlas(atlas.get(), xform, tex, colors, count, mode, sampling,
+                     cull_rect, paint(with_paint));
+}
+
+void DisplayListCanvasDispatcher::drawPicture(const sk_sp<SkPicture>& picture,
+                                              const SkMatrix* matrix,
+                                              bool with_paint) {
+  canvas_->drawPicture(picture, matrix, paint(with_paint));
+}
+
+void DisplayListCanvasDispatcher::drawDisplayList(
+    const sk_sp<DisplayList>& display_list) {
+  int save_count = canvas_->save();
+  display_list->RenderTo(canvas_, opacity_);
+  canvas_->restoreToCount(save_count);
+}
+
+void DisplayListCanvasDispatcher::drawTextBlob(const sk_sp<SkTextBlob>& blob,
+                                               SkScalar x,
+                                               SkScalar y) {
+  canvas_->drawTextBlob(blob, x, y, paint_);
+}
+
+void DisplayListCanvasDispatcher::drawShadowRec(const SkPath& path,
+                                                const SkDrawShadowRec& rec) {
+  canvas_->private_draw_shadow_rec(path, rec);
+}
+
+DisplayListCanvasRecorder::DisplayListCanvasRecorder(const SkRect& bounds)
+    : SkCanvasVirtualEnforcer(bounds.roundOut()), builder_(bounds) {}
+
+DisplayListCanvasRecorder::~DisplayListCanvasRecorder() = default;
+
+sk_sp<DisplayList> DisplayListCanvasRecorder::Build() {
+  return builder_.Build();
+}
+
+void DisplayListCanvasRecorder::RecordPaint(const SkPaint& paint) {
+  builder_.setAttributesFromPaint(paint);
+}
+
+void DisplayListCanvasRecorder::willSave() {
+  builder_.save();
+}
+
+SkCanvas::SaveLayerStrategy DisplayListCanvasRecorder::getSaveLayerStrategy(
+    const SaveLayerRec& rec) {
+  if (rec.fPaint) {
+    RecordPaint(*rec.fPaint);
+  }
+  builder_.saveLayer(rec.fBounds, rec.fPaint != nullptr,
+                     RefConst(rec.fBackdrop));
+  return kNoLayer_SaveLayerStrategy;
+}
+
+bool DisplayListCanvasRecorder::onDoSaveBehind(const SkRect* bounds) {
+  // Saving behind is only used by Android's own canvas, and is not recorded.
+  return false;
+}
+
+void DisplayListCanvasRecorder::willRestore() {
+  builder_.restore();
+}
+
+void DisplayListCanvasRecorder::didConcat44(const SkM44& matrix) {
+  builder_.transform(matrix.asM33());
+}
+
+void DisplayListCanvasRecorder::didScale(SkScalar sx, SkScalar sy) {
+  builder_.scale(sx, sy);
+}
+
+void DisplayListCanvasRecorder::didTranslate(SkScalar tx, SkScalar ty) {
+  builder_.translate(tx, ty);
+}
+
+void DisplayListCanvasRecorder::onClipRect(const SkRect& rect,
+                                           SkClipOp clip_op,
+                                           ClipEdgeStyle edge_style) {
+  builder_.clipRect(rect, clip_op, edge_style == kSoft_ClipEdgeStyle);
+  SkCanvasVirtualEnforcer::onClipRect(rect, clip_op, edge_style);
+}
+
+void DisplayListCanvasRecorder::onClipRRect(const SkRRect& rrect,
+                                            SkClipOp clip_op,
+                                            ClipEdgeStyle edge_style) {
+  builder_.clipRRect(rrect, clip_op, edge_style == kSoft_ClipEdgeStyle);
+  SkCanvasVirtualEnforcer::onClipRRect(rrect, clip_op, edge_style);
+}
+
+void DisplayListCanvasRecorder::onClipPath(const SkPath& path,
+                                           SkClipOp clip_op,
+                                           ClipEdgeStyle edge_style) {
+  builder_.clipPath(path, clip_op, edge_style == kSoft_ClipEdgeStyle);
+  SkCanvasVirtualEnforcer::onClipPath(path, clip_op, edge_style);
+}
+
+void DisplayListCanvasRecorder::onClipRegion(const SkRegion& region,
+                                             SkClipOp clip_op) {
+  // Regions are in device coordinates, which a display list doesn't have, so
+  // the region is recorded as a path clip.
+  SkPath path;
+  region.getBoundaryPath(&path);
+  builder_.clipPath(path, clip_op, false);
+  SkCanvasVirtualEnforcer::onClipRegion(region, clip_op);
+}
+
+void DisplayListCanvasRecorder::onDrawPaint(const SkPaint& paint) {
+  RecordPaint(paint);
+  builder_.drawPaint();
+}
+
+void DisplayListCanvasRecorder::onDrawBehind(const SkPaint& paint) {
+  // Drawing behind is only used by Android's own canvas, and is not recorded.
+}
+
+void DisplayListCanvasRecorder::onDrawPoints(PointMode mode,
+                                             size_t count,
+                                             const SkPoint pts[],
+                                             const SkPaint& paint) {
+  RecordPaint(paint);
+  if (mode == kLines_PointMode && count == 2) {
+    // SkCanvas::drawLine arrives here.
+    builder_.drawLine(pts[0], pts[1]);
+  } else {
+    builder_.drawPoints(mode, count, pts);
+  }
+}
+
+void DisplayListCanvasRecorder::onDrawRect(const SkRect& rect,
+                                           const SkPaint& paint) {
+  RecordPaint(paint);
+  builder_.drawRect(rect);
+}
+
+void DisplayListCanvasRecorder::onDrawRegion(const SkRegion& region,
+                                             const SkPaint& paint) {
+  RecordPaint(paint);
+  if (region.isRect()) {
+    builder_.drawRect(SkRect::Make(region.getBounds()));
+  } else {
+    SkPath path;
+    region.getBoundaryPath(&path);
+    builder_.drawPath(path);
+  }
+}
+
+void DisplayListCanvasRecorder::onDrawOval(const SkRect& rect,
+                                           const SkPaint& paint) {
+  RecordPaint(paint);
+  builder_.drawOval(rect);
+}
+
+void DisplayListCanvasRecorder::onDrawArc(const SkRect& rect,
+                                          SkScalar start_angle,
+                                          SkScalar sweep_angle,
+                                          bool use_center,
+                                          const SkPaint& paint) {
+  RecordPaint(paint);
+  builder_.drawArc(rect, start_angle, sweep_angle, use_center);
+}
+
+void DisplayListCanvasRecorder::onDrawRRect(const SkRRect& rrect,
+                                            const SkPaint& paint) {
+  RecordPaint(paint);
+  builder_.drawRRect(rrect);
+}
+
+void DisplayListCanvasRecorder::onDrawDRRect(const SkRRect& outer,
+                                             const SkRRect& inner,
+                                             const SkPaint& paint) {
+  RecordPaint(paint);
+  builder_.drawDRRect(outer, inner);
+}
+
+void DisplayListCanvasRecorder::onDrawPath(const SkPath& path,
+                                           const SkPaint& paint) {
+  RecordPaint(paint);
+  builder_.drawPath(path);
+}
+
+void DisplayListCanvasRecorder::onDrawTextBlob(const SkTextBlob* blob,
+                                               SkScalar x,
+                                               SkScalar y,
+                                               const SkPaint& paint) {
+  RecordPaint(paint);
+  builder_.drawTextBlob(RefConst(blob), x, y);
+}
+
+void DisplayListCanvasRecorder::onDrawPatch(const SkPoint cubics[12],
+                                            const SkColor colors[4],
+                                            const SkPoint tex_coords[4],
+                                            SkBlendMode mode,
+                                            const SkPaint& paint) {
+  RecordPaint(paint);
+  builder_.drawPatch(cubics, colors, tex_coords, mode);
+}
+
+void DisplayListCanvasRecorder::onDrawVerticesObject(const SkVertices* vertices,
+                                                     SkBlendMode mode,
+                                                     const SkPaint& paint) {
+  RecordPaint(paint);
+  builder_.drawVertices(RefConst(vertices), mode);
+}
+
+void DisplayListCanvasRecorder::onDrawShadowRec(const SkPath& path,
+                                                const SkDrawShadowRec& rec) {
+  builder_.drawShadowRec(path, rec);
+}
+
+#ifdef SK_SUPPORT_LEGACY_ONDRAWIMAGERECT
+void DisplayListCanvasRecorder::onDrawImage(const SkImage* image,
+                                            SkScalar left,
+                                            SkScalar top,
+                                            const SkPaint* paint) {
+  onDrawImage2(image, left, top, SkSamplingOptions(), paint);
+}
+
+void DisplayListCanvasRecorder::onDrawImageRect(const SkImage* image,
+                                                const SkRect* src,
+                                                const SkRect& dst,
+                                                const SkPaint* paint,
+                                                SrcRectConstraint constraint) {
+  onDrawImageRect2(image, src ? *src : SkRect::Make(image->bounds()), dst,
+                   SkSamplingOptions(), paint, constraint);
+}
+
+void DisplayListCanvasRecorder::onDrawImageLattice(const SkImage* image,
+                                                   const Lattice& lattice,
+                                                   const SkRect& dst,
+                                                   const SkPaint* paint) {
+  onDrawImageLattice2(image, lattice, dst, SkFilterMode::kNearest, paint);
+}
+
+void DisplayListCanvasRecorder::onDrawAtlas(const SkImage* atlas,
+                                            const SkRSXform xform[],
+                                            const SkRect tex[],
+                                            const SkColor colors[],
+                                            int count,
+                                            SkBlendMode mode,
+                                            const SkRect* cull_rect,
+                                            const SkPaint* paint) {
+  onDrawAtlas2(atlas, xform, tex, colors, count, mode, SkSamplingOptions(),
+               cull_rect, paint);
+}
+
+void DisplayListCanvasRecorder::onDrawEdgeAAImageSet(
+    const ImageSetEntry set[],
+    int count,
+    const SkPoint dst_clips[],
+    const SkMatrix pre_view_matrices[],
+    const SkPaint* paint,
+    SrcRectConstraint constraint) {
+  onDrawEdgeAAImageSet2(set, count, dst_clips, pre_view_matrices,
+                        SkSamplingOptions(), paint, constraint);
+}
+#endif
+
+void DisplayListCanvasRecorder::onDrawImage2(const SkImage* image,
+                                             SkScalar left,
+                                             SkScalar top,
+                                             const SkSamplingOptions& sampling,
+                                             const SkPaint* paint) {
+  if (paint) {
+    RecordPaint(*paint);
+  }
+  builder_.drawImage(RefConst(image), SkPoint::Make(left, top), sampling,
+                     paint != nullptr);
+}
+
+void DisplayListCanvasRecorder::onDrawImageRect2(
+    const SkImage* image,
+    const SkRect& src,
+    const SkRect& dst,
+    const SkSamplingOptions& sampling,
+    const SkPaint* paint,
+    SrcRectConstraint constraint) {
+  if (paint) {
+    RecordPaint(*paint);
+  }
+  builder_.drawImageRect(RefConst(image), src, dst, sampling,
+                         paint != nullptr, constraint);
+}
+
+void DisplayListCanvasRecorder::onDrawImageLattice2(const SkImage* image,
+                                                    const Lattice& lattice,
+                                                    const SkRect& dst,
+                                                    SkFilterMode filter,
+                                                    const SkPaint* paint) {
+  if (paint) {
+    RecordPaint(*paint);
+  }
+  builder_.drawImageLattice(RefConst(image), lattice, dst, filter,
+                            paint != nullptr);
+}
+
+void DisplayListCanvasRecorder::onDrawAtlas2(const SkImage* atlas,
+                                             const SkRSXform xform[],
+                                             const SkRect tex[],
+                                             const SkColor colors[],
+                                             int count,
+                                             SkBlendMode mode,
+                                             const SkSamplingOptions& sampling,
+                                             const SkRect* cull_rect,
+                                             const SkPaint* paint) {
+  if (paint) {
+    RecordPaint(*paint);
+  }
+  builder_.drawAtlas(RefConst(atlas), xform, tex, colors, count, mode,
+                     sampling, cull_rect, paint != nullptr);
+}
+
+void DisplayListCanvasRecorder::onDrawEdgeAAImageSet2(
+    const ImageSetEntry set[],
+    int count,
+    const SkPoint dst_clips[],
+    const SkMatrix pre_view_matrices[],
+    const SkSamplingOptions& sampling,
+    const SkPaint* paint,
+    SrcRectConstraint constraint) {
+  // Each entry is recorded as an image rect with its own transform, clip and
+  // alpha.
+  int clip_index = 0;
+  for (int i = 0; i < count; i++) {
+    const ImageSetEntry& entry = set[i];
+    SkPaint entry_paint = paint ? *paint : SkPaint();
+    entry_paint.setAlphaf(entry_paint.getAlphaf() * entry.fAlpha);
+    entry_paint.setAntiAlias(entry.fAAFlags != kNone_QuadAAFlags);
+    RecordPaint(entry_paint);
+    builder_.save();
+    if (entry.fMatrixIndex >= 0) {
+      builder_.transform(pre_view_matrices[entry.fMatrixIndex]);
+    }
+    if (entry.fHasClip) {
+      SkPath clip;
+      clip.addPoly(dst_clips + clip_index, 4, true);
+      builder_.clipPath(clip, SkClipOp::kIntersect, entry_paint.isAntiAlias());
+      clip_index += 4;
+    }
+    builder_.drawImageRect(RefConst(entry.fImage.get()), entry.fSrcRect,
+                           entry.fDstRect, sampling, true, constraint);
+    builder_.restore();
+  }
+}
+
+void DisplayListCanvasRecorder::onDrawPicture(const SkPicture* picture,
+                                              const SkMatrix* matrix,
+                                              const SkPaint* paint) {
+  if (paint) {
+    RecordPaint(*paint);
+  }
+  builder_.drawPicture(RefConst(picture), matrix, paint != nullptr);
+}
+
+void DisplayListCanvasRecorder::onDrawDrawable(SkDrawable* drawable,
+                                               const SkMatrix* matrix) {
+  builder_.drawPicture(drawable->makePictureSnapshot(), matrix, false);
+}
+
+void DisplayListCanvasRecorder::onDrawAnnotation(const SkRect& rect,
+                                                 const char key[],
+                                                 SkData* value) {
+  // Annotations only matter to document backends, and are not recorded.
+}
+
+void DisplayListCanvasRecorder::onDrawEdgeAAQuad(const SkRect& rect,
+                                                 const SkPoint clip[4],
+                                                 SkCanvas::QuadAAFlags aa_flags,
+                                                 const SkColor4f& color,
+                                                 SkBlendMode mode) {
+  SkPaint paint;
+  paint.setColor4f(color);
+  paint.setBlendMode(mode);
+  paint.setAntiAlias(aa_flags != kNone_QuadAAFlags);
+  RecordPaint(paint);
+  if (clip) {
+    SkPath path;
+    path.addPoly(clip, 4, true);
+    builder_.drawPath(path);
+  } else {
+    builder_.drawRect(rect);
+  }
+}
+
+void DisplayListCanvasRecorder::onFlush() {}
+
+}  // namespace flutter
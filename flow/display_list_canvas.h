@@ -0,0 +1,308 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DISPLAY_LIST_CANVAS_H_
+#define FLUTTER_FLOW_DISPLAY_LIST_CANVAS_H_
+
+#include "flutter/flow/display_list.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkCanvasVirtualEnforcer.h"
+#include "third_party/skia/include/utils/SkNoDrawCanvas.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Plays the operations of a display list back into an SkCanvas.
+///
+/// An |opacity| below 1 is applied by modulating the alpha of each draw call,
+/// which is only correct for lists that |can_apply_group_opacity|.
+///
+class DisplayListCanvasDispatcher final : public Dispatcher {
+ public:
+  explicit DisplayListCanvasDispatcher(SkCanvas* canvas,
+                                       SkScalar opacity = SK_Scalar1);
+
+  ~DisplayListCanvasDispatcher() override;
+
+  // |Dispatcher|
+  void setAA(bool aa) override;
+  void setDither(bool dither) override;
+  void setColor(SkColor color) override;
+  void setStyle(SkPaint::Style style) override;
+  void setStrokeWidth(SkScalar width) override;
+  void setMiterLimit(SkScalar limit) override;
+  void setCap(SkPaint::Cap cap) override;
+  void setJoin(SkPaint::Join join) override;
+  void setBlendMode(SkBlendMode mode) override;
+  void setShader(sk_sp<SkShader> shader) override;
+  void setColorFilter(sk_sp<SkColorFilter> filter) override;
+  void setPathEffect(sk_sp<SkPathEffect> effect) override;
+  void setMaskFilter(sk_sp<SkMaskFilter> filter) override;
+  void setImageFilter(sk_sp<SkImageFilter> filter) override;
+
+  // |Dispatcher|
+  void save() override;
+  void saveLayer(const SkRect* bounds,
+                 bool with_paint,
+                 sk_sp<SkImageFilter> backdrop) override;
+  void restore() override;
+
+  // |Dispatcher|
+  void translate(SkScalar tx, SkScalar ty) override;
+  void scale(SkScalar sx, SkScalar sy) override;
+  void rotate(SkScalar degrees) override;
+  void skew(SkScalar sx, SkScalar sy) override;
+  void transform(const SkMatrix& matrix) override;
+
+  // |Dispatcher|
+  void clipRect(const SkRect& rect, SkClipOp clip_op, bool is_aa) override;
+  void clipRRect(const SkRRect& rrect, SkClipOp clip_op, bool is_aa) override;
+  void clipPath(const SkPath& path, SkClipOp clip_op, bool is_aa) override;
+
+  // |Dispatcher|
+  void drawPaint() override;
+  void drawColor(SkColor color, SkBlendMode mode) override;
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override;
+  void drawRect(const SkRect& rect) override;
+  void drawOval(const SkRect& bounds) override;
+  void drawCircle(const SkPoint& center, SkScalar radius) override;
+  void drawRRect(const SkRRect& rrect) override;
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override;
+  void drawPath(const SkPath& path) override;
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override;
+  void drawPoints(SkCanvas::PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override;
+  void drawVertices(const sk_sp<SkVertices>& vertices,
+                    SkBlendMode mode) override;
+  void drawPatch(const SkPoint cubics[12],
+                 const SkColor colors[4],
+                 const SkPoint tex_coords[4],
+                 SkBlendMode mode) override;
+  void drawImage(const sk_sp<SkImage>& image,
+                 const SkPoint& point,
+                 const SkSamplingOptions& sampling,
+                 bool with_paint) override;
+  void drawImageRect(const sk_sp<SkImage>& image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     const SkSamplingOptions& sampling,
+                     bool with_paint,
+                     SkCanvas::SrcRectConstraint constraint) override;
+  void drawImageLattice(const sk_sp<SkImage>& image,
+                        const SkCanvas::Lattice& lattice,
+                        const SkRect& dst,
+                        SkFilterMode filter,
+                        bool with_paint) override;
+  void drawAtlas(const sk_sp<SkImage>& atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const SkColor colors[],
+                 int count,
+                 SkBlendMode mode,
+                 const SkSamplingOptions& sampling,
+                 const SkRect* cull_rect,
+                 bool with_paint) override;
+  void drawPicture(const sk_sp<SkPicture>& picture,
+                   const SkMatrix* matrix,
+                   bool with_paint) override;
+  void drawDisplayList(const sk_sp<DisplayList>& display_list) override;
+  void drawTextBlob(const sk_sp<SkTextBlob>& blob,
+                    SkScalar x,
+                    SkScalar y) override;
+  void drawShadowRec(const SkPath& path, const SkDrawShadowRec& rec) override;
+
+ private:
+  SkCanvas* canvas_;
+  const SkScalar opacity_;
+  SkPaint paint_;
+  // Draws the calls that are recorded without a paint with |opacity_|.
+  SkPaint opacity_paint_;
+
+  const SkPaint* paint(bool with_paint) const {
+    if (with_paint) {
+      return &paint_;
+    }
+    return opacity_ < SK_Scalar1 ? &opacity_paint_ : nullptr;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListCanvasDispatcher);
+};
+
+//------------------------------------------------------------------------------
+/// An SkCanvas that records the calls made to it into a display list, so that
+/// code written against SkCanvas can record one.
+///
+/// The canvas tracks the transform and clip like any other, but draws
+/// nothing. Annotations are not recorded.
+///
+class DisplayListCanvasRecorder
+    : public SkCanvasVirtualEnforcer<SkNoDrawCanvas>,
+      public SkRefCnt {
+ public:
+  explicit DisplayListCanvasRecorder(const SkRect& bounds);
+
+  ~DisplayListCanvasRecorder() override;
+
+  DisplayListBuilder& builder() { return builder_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Ends the recording.
+  ///
+  /// @return     The display list of the calls made to the canvas so far.
+  ///
+  sk_sp<DisplayList> Build();
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void willSave() override;
+  SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec& rec) override;
+  bool onDoSaveBehind(const SkRect* bounds) override;
+  void willRestore() override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void didConcat44(const SkM44& matrix) override;
+  void didScale(SkScalar sx, SkScalar sy) override;
+  void didTranslate(SkScalar tx, SkScalar ty) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onClipRect(const SkRect& rect,
+                  SkClipOp clip_op,
+                  ClipEdgeStyle edge_style) override;
+  void onClipRRect(const SkRRect& rrect,
+                   SkClipOp clip_op,
+                   ClipEdgeStyle edge_style) override;
+  void onClipPath(const SkPath& path,
+                  SkClipOp clip_op,
+                  ClipEdgeStyle edge_style) override;
+  void onClipRegion(const SkRegion& region, SkClipOp clip_op) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawPaint(const SkPaint& paint) override;
+  void onDrawBehind(const SkPaint& paint) override;
+  void onDrawPoints(PointMode mode,
+                    size_t count,
+                    const SkPoint pts[],
+                    const SkPaint& paint) override;
+  void onDrawRect(const SkRect& rect, const SkPaint& paint) override;
+  void onDrawRegion(const SkRegion& region, const SkPaint& paint) override;
+  void onDrawOval(const SkRect& rect, const SkPaint& paint) override;
+  void onDrawArc(const SkRect& rect,
+                 SkScalar start_angle,
+                 SkScalar sweep_angle,
+                 bool use_center,
+                 const SkPaint& paint) override;
+  void onDrawRRect(const SkRRect& rrect, const SkPaint& paint) override;
+  void onDrawDRRect(const SkRRect& outer,
+                    const SkRRect& inner,
+                    const SkPaint& paint) override;
+  void onDrawPath(const SkPath& path, const SkPaint& paint) override;
+  void onDrawTextBlob(const SkTextBlob* blob,
+                      SkScalar x,
+                      SkScalar y,
+                      const SkPaint& paint) override;
+  void onDrawPatch(const SkPoint cubics[12],
+                   const SkColor colors[4],
+                   const SkPoint tex_coords[4],
+                   SkBlendMode mode,
+                   const SkPaint& paint) override;
+  void onDrawVerticesObject(const SkVertices* vertices,
+                            SkBlendMode mode,
+                            const SkPaint& paint) override;
+  void onDrawShadowRec(const SkPath& path, const SkDrawShadowRec& rec) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+#ifdef SK_SUPPORT_LEGACY_ONDRAWIMAGERECT
+  void onDrawImage(const SkImage* image,
+                   SkScalar left,
+                   SkScalar top,
+                   const SkPaint* paint) override;
+  void onDrawImageRect(const SkImage* image,
+                       const SkRect* src,
+                       const SkRect& dst,
+                       const SkPaint* paint,
+                       SrcRectConstraint constraint) override;
+  void onDrawImageLattice(const SkImage* image,
+                          const Lattice& lattice,
+                          const SkRect& dst,
+                          const SkPaint* paint) override;
+  void onDrawAtlas(const SkImage* atlas,
+                   const SkRSXform xform[],
+                   const SkRect tex[],
+                   const SkColor colors[],
+                   int count,
+                   SkBlendMode mode,
+                   const SkRect* cull_rect,
+                   const SkPaint* paint) override;
+  void onDrawEdgeAAImageSet(const ImageSetEntry set[],
+                            int count,
+                            const SkPoint dst_clips[],
+                            const SkMatrix pre_view_matrices[],
+                            const SkPaint* paint,
+                            SrcRectConstraint constraint) override;
+#endif
+  void onDrawImage2(const SkImage* image,
+                    SkScalar left,
+                    SkScalar top,
+                    const SkSamplingOptions& sampling,
+                    const SkPaint* paint) override;
+  void onDrawImageRect2(const SkImage* image,
+                        const SkRect& src,
+                        const SkRect& dst,
+                        const SkSamplingOptions& sampling,
+                        const SkPaint* paint,
+                        SrcRectConstraint constraint) override;
+  void onDrawImageLattice2(const SkImage* image,
+                           const Lattice& lattice,
+                           const SkRect& dst,
+                           SkFilterMode filter,
+                           const SkPaint* paint) override;
+  void onDrawAtlas2(const SkImage* atlas,
+                    const SkRSXform xform[],
+                    const SkRect tex[],
+                    const SkColor colors[],
+                    int count,
+                    SkBlendMode mode,
+                    const SkSamplingOptions& sampling,
+                    const SkRect* cull_rect,
+                    const SkPaint* paint) override;
+  void onDrawEdgeAAImageSet2(const ImageSetEntry set[],
+                             int count,
+                             const SkPoint dst_clips[],
+                             const SkMatrix pre_view_matrices[],
+                             const SkSamplingOptions& sampling,
+                             const SkPaint* paint,
+                             SrcRectConstraint constraint) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawPicture(const SkPicture* picture,
+                     const SkMatrix* matrix,
+                     const SkPaint* paint) override;
+  void onDrawDrawable(SkDrawable* drawable, const SkMatrix* matrix) override;
+  void onDrawAnnotation(const SkRect& rect,
+                        const char key[],
+                        SkData* value) override;
+  void onDrawEdgeAAQuad(const SkRect& rect,
+                        const SkPoint clip[4],
+                        SkCanvas::QuadAAFlags aa_flags,
+                        const SkColor4f& color,
+                        SkBlendMode mode) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onFlush() override;
+
+ private:
+  DisplayListBuilder builder_;
+
+  // Brings the attributes of the builder in line with |paint|.
+  void RecordPaint(const SkPaint& paint);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListCanvasRecorder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_DISPLAY_LIST_CANVAS_H_
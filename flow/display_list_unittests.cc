@@ -0,0 +1,236 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/display_list.h"
+
+#include "flutter/flow/display_list_canvas.h"
+#include "flutter/testing/mock_canvas.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/effects/SkImageFilters.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(DisplayList, EmptyBuild) {
+  DisplayListBuilder builder;
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  EXPECT_EQ(display_list->op_count(), 0);
+  EXPECT_TRUE(display_list->bounds().isEmpty());
+  EXPECT_NE(display_list->unique_id(), 0u);
+}
+
+TEST(DisplayList, AttributesAreOnlyRecordedWhenTheyChange) {
+  DisplayListBuilder builder;
+  builder.setColor(SK_ColorRED);
+  builder.drawRect(SkRect::MakeLTRB(10, 10, 20, 20));
+  builder.setColor(SK_ColorRED);
+  builder.drawRect(SkRect::MakeLTRB(30, 30, 40, 40));
+  // Black is the default color.
+  builder.setAA(false);
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  EXPECT_EQ(display_list->op_count(), 3);
+}
+
+TEST(DisplayList, ListsOfTheSameCallsAreEqual) {
+  SkPath path;
+  path.addCircle(20, 20, 10);
+  auto build = [](const SkPath& path, const SkRect& rect) {
+    DisplayListBuilder builder;
+    builder.setColor(SK_ColorBLUE);
+    builder.save();
+    builder.translate(5, 5);
+    builder.drawPath(path);
+    builder.restore();
+    builder.drawRect(rect);
+    return builder.Build();
+  };
+
+  SkPath same_path;
+  same_path.addCircle(20, 20, 10);
+  sk_sp<DisplayList> list_1 = build(path, SkRect::MakeLTRB(0, 0, 10, 10));
+  sk_sp<DisplayList> list_2 = build(same_path, SkRect::MakeLTRB(0, 0, 10, 10));
+  sk_sp<DisplayList> list_3 = build(path, SkRect::MakeLTRB(0, 0, 10, 20));
+
+  EXPECT_NE(list_1->unique_id(), list_2->unique_id());
+  EXPECT_EQ(list_1->hash(), list_2->hash());
+  EXPECT_TRUE(list_1->Equals(*list_2));
+  EXPECT_FALSE(list_1->Equals(*list_3));
+}
+
+TEST(DisplayList, NestedListsAreComparedByValue) {
+  auto build = [](const SkRect& rect) {
+    DisplayListBuilder nested_builder;
+    nested_builder.drawRect(rect);
+    DisplayListBuilder builder;
+    builder.drawDisplayList(nested_builder.Build());
+    return builder.Build();
+  };
+
+  sk_sp<DisplayList> list_1 = build(SkRect::MakeLTRB(0, 0, 10, 10));
+  sk_sp<DisplayList> list_2 = build(SkRect::MakeLTRB(0, 0, 10, 10));
+  sk_sp<DisplayList> list_3 = build(SkRect::MakeLTRB(0, 0, 10, 20));
+
+  EXPECT_TRUE(list_1->Equals(*list_2));
+  EXPECT_FALSE(list_1->Equals(*list_3));
+}
+
+TEST(DisplayList, RecordsOperationsLargerThan16MB) {
+  // Each point takes 8 bytes, so this takes more than 2^24 bytes.
+  std::vector<SkPoint> points((1u << 21) + 1, SkPoint::Make(1, 1));
+  points.back() = SkPoint::Make(10, 20);
+  DisplayListBuilder builder;
+  builder.drawPoints(SkCanvas::kPolygon_PointMode, points.size(),
+                     points.data());
+  builder.drawRect(SkRect::MakeLTRB(0, 0, 1, 1));
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  EXPECT_EQ(display_list->op_count(), 2);
+  EXPECT_GT(display_list->bytes(), points.size() * sizeof(SkPoint));
+  EXPECT_TRUE(
+      display_list->bounds().contains(SkRect::MakeLTRB(1, 1, 10, 20)));
+}
+
+TEST(DisplayList, BoundsIncludeStrokeWidth) {
+  DisplayListBuilder builder;
+  builder.setStyle(SkPaint::kStroke_Style);
+  builder.setStrokeWidth(4);
+  builder.setJoin(SkPaint::kRound_Join);
+  builder.drawRect(SkRect::MakeLTRB(10, 10, 20, 20));
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  EXPECT_EQ(display_list->bounds(), SkRect::MakeLTRB(8, 8, 22, 22));
+}
+
+TEST(DisplayList, BoundsAreTransformedAndClipped) {
+  DisplayListBuilder builder;
+  builder.save();
+  builder.clipRect(SkRect::MakeLTRB(0, 0, 25, 25), SkClipOp::kIntersect,
+                   false);
+  builder.translate(10, 10);
+  builder.drawRect(SkRect::MakeLTRB(0, 0, 20, 20));
+  builder.restore();
+  builder.drawRect(SkRect::MakeLTRB(50, 50, 60, 60));
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  EXPECT_EQ(display_list->bounds(), SkRect::MakeLTRB(10, 10, 60, 60));
+}
+
+TEST(DisplayList, DrawPaintCoversTheCullRect) {
+  const SkRect cull_rect = SkRect::MakeLTRB(0, 0, 100, 100);
+  DisplayListBuilder builder(cull_rect);
+  builder.drawPaint();
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  EXPECT_EQ(display_list->bounds(), cull_rect);
+}
+
+TEST(DisplayList, LayerImageFilterGrowsBounds) {
+  DisplayListBuilder builder;
+  builder.setImageFilter(SkImageFilters::Blur(5, 5, nullptr));
+  builder.saveLayer(nullptr, true);
+  builder.setImageFilter(nullptr);
+  builder.drawRect(SkRect::MakeLTRB(40, 40, 60, 60));
+  builder.restore();
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  // A blur reaches three sigmas out.
+  EXPECT_EQ(display_list->bounds(), SkRect::MakeLTRB(25, 25, 75, 75));
+}
+
+TEST(DisplayList, CulledDispatchSkipsDrawsOutsideOfTheCullRect) {
+  DisplayListBuilder builder;
+  builder.setColor(SK_ColorBLUE);
+  builder.drawRect(SkRect::MakeLTRB(0, 0, 10, 10));
+  builder.drawRect(SkRect::MakeLTRB(40, 40, 50, 50));
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  MockCanvas mock_canvas;
+  DisplayListCanvasDispatcher dispatcher(&mock_canvas);
+  display_list->Dispatch(dispatcher, SkRect::MakeLTRB(0, 0, 20, 20));
+
+  SkPaint paint;
+  paint.setColor(SK_ColorBLUE);
+  EXPECT_EQ(mock_canvas.draw_calls(),
+            std::vector({MockCanvas::DrawCall{
+                0, MockCanvas::DrawRectData{SkRect::MakeLTRB(0, 0, 10, 10),
+                                            paint}}}));
+}
+
+TEST(DisplayList, GroupOpacityNeedsDrawsThatDontOverlap) {
+  DisplayListBuilder builder;
+  builder.drawRect(SkRect::MakeLTRB(0, 0, 10, 10));
+  builder.drawRect(SkRect::MakeLTRB(10, 0, 20, 10));
+  EXPECT_TRUE(builder.Build()->can_apply_group_opacity());
+
+  builder.drawRect(SkRect::MakeLTRB(0, 0, 10, 10));
+  builder.drawRect(SkRect::MakeLTRB(5, 0, 15, 10));
+  EXPECT_FALSE(builder.Build()->can_apply_group_opacity());
+}
+
+TEST(DisplayList, GroupOpacityNeedsSourceOverDraws) {
+  DisplayListBuilder builder;
+  builder.setBlendMode(SkBlendMode::kSrc);
+  builder.drawRect(SkRect::MakeLTRB(0, 0, 10, 10));
+  EXPECT_FALSE(builder.Build()->can_apply_group_opacity());
+
+  builder.saveLayer(nullptr, false);
+  builder.drawRect(SkRect::MakeLTRB(0, 0, 10, 10));
+  builder.restore();
+  EXPECT_FALSE(builder.Build()->can_apply_group_opacity());
+}
+
+TEST(DisplayList, DispatcherModulatesEachDrawWithTheOpacity) {
+  DisplayListBuilder builder;
+  builder.setColor(SK_ColorBLUE);
+  builder.drawRect(SkRect::MakeLTRB(0, 0, 10, 10));
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  MockCanvas mock_canvas;
+  DisplayListCanvasDispatcher dispatcher(&mock_canvas, 0.5f);
+  display_list->Dispatch(dispatcher);
+
+  SkPaint paint;
+  paint.setColor(SK_ColorBLUE);
+  paint.setAlphaf(0.5f);
+  EXPECT_EQ(mock_canvas.draw_calls(),
+            std::vector({MockCanvas::DrawCall{
+                0, MockCanvas::DrawRectData{SkRect::MakeLTRB(0, 0, 10, 10),
+                                            paint}}}));
+}
+
+TEST(DisplayList, RecorderCanvasRecordsPaintAttributes) {
+  auto recorder = sk_make_sp<DisplayListCanvasRecorder>(
+      SkRect::MakeLTRB(0, 0, 100, 100));
+  SkPaint paint;
+  paint.setColor(SK_ColorGREEN);
+  paint.setAntiAlias(true);
+  recorder->drawRect(SkRect::MakeLTRB(10, 10, 20, 20), paint);
+  recorder->drawRect(SkRect::MakeLTRB(30, 30, 40, 40), paint);
+  sk_sp<DisplayList> display_list = recorder->Build();
+
+  // The color and anti-aliasing are recorded once, before the first rect.
+  EXPECT_EQ(display_list->op_count(), 4);
+  EXPECT_EQ(display_list->bounds(), SkRect::MakeLTRB(10, 10, 40, 40));
+}
+
+TEST(DisplayList, RecorderCanvasRecordsPatches) {
+  auto recorder = sk_make_sp<DisplayListCanvasRecorder>(
+      SkRect::MakeLTRB(0, 0, 100, 100));
+  SkPoint cubics[12];
+  for (int i = 0; i < 12; i++) {
+    cubics[i] = SkPoint::Make(10 + i * 5, 20 + (i % 4) * 10);
+  }
+  recorder->drawPatch(cubics, nullptr, nullptr, SkBlendMode::kModulate,
+                      SkPaint());
+  sk_sp<DisplayList> display_list = recorder->Build();
+
+  EXPECT_EQ(display_list->op_count(), 1);
+  EXPECT_EQ(display_list->bounds(), SkRect::MakeLTRB(10, 20, 65, 50));
+  EXPECT_FALSE(display_list->can_apply_group_opacity());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -49,6 +49,8 @@ void ClipRRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   if (child_paint_bounds.intersect(clip_rrect_bounds)) {
     set_paint_bounds(child_paint_bounds);
   }
+  set_layer_can_inherit_opacity(!UsesSaveLayer() &&
+                                children_can_inherit_opacity());
 
   context->mutators_stack.Pop();
   context->cull_rect = previous_cull_rect;
@@ -33,6 +33,9 @@ void ColorFilterLayer::Preroll(PrerollContext* context,
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
   ContainerLayer::Preroll(context, matrix);
+  // The children are drawn into a layer of their own, so an inherited
+  // opacity would only reach them before the filter was applied.
+  set_layer_can_inherit_opacity(false);
 }
 
 void ColorFilterLayer::Paint(PaintContext& context) const {
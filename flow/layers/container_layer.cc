@@ -116,6 +116,7 @@ void ContainerLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   SkRect child_paint_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, matrix, &child_paint_bounds);
   set_paint_bounds(child_paint_bounds);
+  set_layer_can_inherit_opacity(children_can_inherit_opacity());
 }
 
 void ContainerLayer::Paint(PaintContext& context) const {
@@ -140,6 +141,7 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   FML_DCHECK(!context->has_platform_view);
   bool child_has_platform_view = false;
   bool child_has_texture_layer = false;
+  children_can_inherit_opacity_ = true;
   for (auto& layer : layers_) {
     // Reset context->has_platform_view to false so that layers aren't treated
     // as if they have a platform view based on one being previously found in a
@@ -151,6 +153,10 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     if (layer->needs_system_composite()) {
       set_needs_system_composite(true);
     }
+    if (!layer->layer_can_inherit_opacity() ||
+        SkRect::Intersects(*child_paint_bounds, layer->paint_bounds())) {
+      children_can_inherit_opacity_ = false;
+    }
     child_paint_bounds->join(layer->paint_bounds());
 
     child_has_platform_view =
@@ -45,6 +45,13 @@ class ContainerLayer : public Layer {
                        SkRect* child_paint_bounds);
   void PaintChildren(PaintContext& context) const;
 
+  // Whether every child can inherit opacity and no two children overlap, so
+  // that the children as a whole can inherit opacity. Set by
+  // PrerollChildren().
+  bool children_can_inherit_opacity() const {
+    return children_can_inherit_opacity_;
+  }
+
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   void UpdateSceneChildren(std::shared_ptr<SceneUpdateContext> context);
 #endif
@@ -65,6 +72,7 @@ class ContainerLayer : public Layer {
 
  private:
   std::vector<std::shared_ptr<Layer>> layers_;
+  bool children_can_inherit_opacity_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
 };
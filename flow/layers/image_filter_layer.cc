@@ -57,6 +57,9 @@ void ImageFilterLayer::Preroll(PrerollContext* context,
 
   SkRect child_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, matrix, &child_bounds);
+  // The filter is applied to a layer holding the children, so it can't be
+  // folded into an inherited opacity.
+  set_layer_can_inherit_opacity(false);
 
   if (!filter_) {
     set_paint_bounds(child_bounds);
@@ -13,7 +13,8 @@ Layer::Layer()
     : paint_bounds_(SkRect::MakeEmpty()),
       unique_id_(NextUniqueID()),
       original_layer_id_(unique_id_),
-      needs_system_composite_(false) {}
+      needs_system_composite_(false),
+      layer_can_inherit_opacity_(false) {}
 
 Layer::~Layer() = default;
 
@@ -72,6 +72,11 @@ struct PrerollContext {
   // These allow us to track properties like elevation, opacity, and the
   // prescence of a texture layer during Preroll.
   bool has_texture_layer = false;
+
+  // Whether any layer filters what was drawn under it, whether on the surface
+  // or in a layer saved by an ancestor. Such layers read pixels outside of
+  // their own bounds, so the frame can't be painted in separate tiles.
+  bool has_backdrop_filter = false;
 };
 
 class PictureLayer;
@@ -161,6 +166,11 @@ class Layer {
     const RasterCache* raster_cache;
     const bool checkerboard_offscreen_layers;
     const float frame_device_pixel_ratio;
+
+    // The opacity that an ancestor has left for the layer to apply to its own
+    // draw calls, instead of drawing the layer into an offscreen one. It is
+    // only ever below 1 for layers that |layer_can_inherit_opacity|.
+    SkScalar inherited_opacity = SK_Scalar1;
   };
 
   // Calls SkCanvas::saveLayer and restores the layer upon destruction. Also
@@ -226,6 +236,18 @@ class Layer {
   // Determines if the layer has any content.
   bool is_empty() const { return paint_bounds_.isEmpty(); }
 
+  // Whether the layer can apply the |PaintContext::inherited_opacity| to each
+  // of its draw calls and get the same result as an offscreen layer with that
+  // opacity would. This is the case when the draw calls don't overlap and
+  // don't depend on the pixels under them other than by blending over them.
+  //
+  // This must be set by the time Preroll() returns. Layers are assumed not to
+  // be able to inherit opacity unless they say otherwise.
+  bool layer_can_inherit_opacity() const { return layer_can_inherit_opacity_; }
+  void set_layer_can_inherit_opacity(bool value) {
+    layer_can_inherit_opacity_ = value;
+  }
+
   // Determines if the Paint() method is necessary based on the properties
   // of the indicated PaintContext object.
   bool needs_painting(PaintContext& context) const {
@@ -264,6 +286,7 @@ class Layer {
   uint64_t unique_id_;
   uint64_t original_layer_id_;
   bool needs_system_composite_;
+  bool layer_can_inherit_opacity_;
 
   static uint64_t NextUniqueID();
 
@@ -4,13 +4,85 @@
 
 #include "flutter/flow/layers/layer_tree.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
 #include "flutter/flow/layers/layer.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkSurfaceProps.h"
 #include "third_party/skia/include/utils/SkNWayCanvas.h"
 
 namespace flutter {
 
+// The size of the square tiles that a frame drawn into CPU memory is split
+// into, in pixels. Small tiles spread the work evenly across threads, while
+// each tile has to find the draw calls that touch it.
+static constexpr int kTileSize = 256;
+
+namespace {
+
+// Plays a recording back into the tiles of a frame from any number of
+// threads. It is shared with the threads that help, so that one that only
+// gets to run after the frame was painted still has valid state to look at.
+class TilePainter {
+ public:
+  TilePainter(sk_sp<SkPicture> picture,
+              const SkPixmap& pixmap,
+              const SkSurfaceProps& props,
+              std::vector<SkIRect> tiles)
+      : picture_(std::move(picture)),
+        pixmap_(pixmap),
+        props_(props),
+        tiles_(std::move(tiles)),
+        painted_tiles_(tiles_.size()) {}
+
+  size_t tile_count() const { return tiles_.size(); }
+
+  // Paints tiles that no other thread has taken until none are left.
+  void PaintTiles() {
+    size_t index;
+    while ((index = next_tile_.fetch_add(1)) < tiles_.size()) {
+      PaintTile(tiles_[index]);
+      painted_tiles_.CountDown();
+    }
+  }
+
+  // Waits until every tile has been painted, whichever thread painted it.
+  void WaitForTiles() { painted_tiles_.Wait(); }
+
+ private:
+  const sk_sp<SkPicture> picture_;
+  const SkPixmap pixmap_;
+  const SkSurfaceProps props_;
+  const std::vector<SkIRect> tiles_;
+  std::atomic<size_t> next_tile_{0};
+  fml::CountDownLatch painted_tiles_;
+
+  void PaintTile(const SkIRect& tile) const {
+    SkPixmap tile_pixmap;
+    if (!pixmap_.extractSubset(&tile_pixmap, tile)) {
+      return;
+    }
+    std::unique_ptr<SkCanvas> tile_canvas =
+        SkCanvas::MakeRasterDirect(tile_pixmap.info(),
+                                   tile_pixmap.writable_addr(),
+                                   tile_pixmap.rowBytes(), &props_);
+    if (!tile_canvas) {
+      return;
+    }
+    tile_canvas->translate(-tile.x(), -tile.y());
+    tile_canvas->drawPicture(picture_);
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TilePainter);
+};
+
+}  // namespace
+
 LayerTree::LayerTree(const SkISize& frame_size, float device_pixel_ratio)
     : frame_size_(frame_size),
       device_pixel_ratio_(device_pixel_ratio),
@@ -58,6 +130,7 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       device_pixel_ratio_};
 
   root_layer_->Preroll(&context, frame.root_surface_transformation());
+  has_backdrop_filter_ = context.has_backdrop_filter;
   return context.surface_needs_readback;
 }
 
@@ -91,6 +164,15 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
     return;
   }
 
+  // With platform views, the layers are painted into several canvases in
+  // turn, which can't be split up.
+  SkPixmap pixmap;
+  if (frame.context().tile_task_runner() && !frame.view_embedder() &&
+      !has_backdrop_filter_ && frame.canvas()->peekPixels(&pixmap)) {
+    PaintInTiles(frame, ignore_raster_cache, pixmap);
+    return;
+  }
+
   SkISize canvas_size = frame.canvas()->getBaseLayerSize();
   SkNWayCanvas internal_nodes_canvas(canvas_size.width(), canvas_size.height());
   internal_nodes_canvas.addCanvas(frame.canvas());
@@ -118,6 +200,80 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
   }
 }
 
+void LayerTree::PaintInTiles(CompositorContext::ScopedFrame& frame,
+                             bool ignore_raster_cache,
+                             const SkPixmap& pixmap) const {
+  TRACE_EVENT0("flutter", "LayerTree::PaintInTiles");
+
+  // The layers themselves are painted on this thread, as the raster cache,
+  // textures and instrumentation they draw from are not meant to be shared
+  // across threads. What they paint is recorded, and the recording is what
+  // gets played back in parallel.
+  SkCanvas* frame_canvas = frame.canvas();
+  SkRTreeFactory rtree_factory;
+  SkPictureRecorder recorder;
+  SkCanvas* recording_canvas =
+      recorder.beginRecording(SkRect::Make(pixmap.bounds()), &rtree_factory);
+  recording_canvas->clipRect(
+      SkRect::Make(frame_canvas->getDeviceClipBounds()));
+  recording_canvas->setMatrix(frame_canvas->getLocalToDevice());
+
+  SkNWayCanvas internal_nodes_canvas(pixmap.width(), pixmap.height());
+  internal_nodes_canvas.addCanvas(recording_canvas);
+
+  Layer::PaintContext context = {
+      static_cast<SkCanvas*>(&internal_nodes_canvas),
+      recording_canvas,
+      frame.gr_context(),
+      nullptr,
+      frame.context().raster_time(),
+      frame.context().ui_time(),
+      frame.context().texture_registry(),
+      ignore_raster_cache ? nullptr : &frame.context().raster_cache(),
+      checkerboard_offscreen_layers_,
+      device_pixel_ratio_};
+
+  if (!root_layer_->needs_painting(context)) {
+    return;
+  }
+  root_layer_->Paint(context);
+  sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+  std::vector<SkIRect> tiles;
+  for (int y = 0; y < pixmap.height(); y += kTileSize) {
+    for (int x = 0; x < pixmap.width(); x += kTileSize) {
+      SkIRect tile = SkIRect::MakeXYWH(x, y, kTileSize, kTileSize);
+      if (tile.intersect(pixmap.bounds())) {
+        tiles.push_back(tile);
+      }
+    }
+  }
+  if (tiles.empty()) {
+    return;
+  }
+
+  // The tiles write straight into the pixels of the frame. Any snapshot of
+  // the surface was already detached from them when the canvas was cleared
+  // for this frame.
+  SkSurfaceProps props;
+  frame_canvas->getProps(&props);
+  auto painter = std::make_shared<TilePainter>(std::move(picture), pixmap,
+                                               props, std::move(tiles));
+
+  // This thread paints tiles too instead of just waiting, so that the frame
+  // still gets painted when the workers are busy with something else. A
+  // helper that only starts once every tile has been taken finds nothing
+  // left to do and returns without touching the frame.
+  size_t thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+  size_t helper_count = std::min<size_t>(thread_count, painter->tile_count());
+  fml::ConcurrentTaskRunner* task_runner = frame.context().tile_task_runner();
+  for (size_t i = 1; i < helper_count; i++) {
+    task_runner->PostTask([painter]() { painter->PaintTiles(); });
+  }
+  painter->PaintTiles();
+  painter->WaitForTiles();
+}
+
 sk_sp<SkPicture> LayerTree::Flatten(const SkRect& bounds) {
   TRACE_EVENT0("flutter", "LayerTree::Flatten");
 
@@ -13,6 +13,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_delta.h"
 #include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/skia/include/core/SkSize.h"
 
 namespace flutter {
@@ -35,6 +36,12 @@ class LayerTree {
   void UpdateScene(std::shared_ptr<SceneUpdateContext> context);
 #endif
 
+  // Paints the tree into the canvas of the frame.
+  //
+  // When the frame is drawn into CPU memory and the compositor context has a
+  // tile task runner, the tree is recorded on this thread and then played back
+  // in tiles by the workers of that runner and by this thread, each tile
+  // writing to its own part of the pixels.
   void Paint(CompositorContext::ScopedFrame& frame,
              bool ignore_raster_cache = false) const;
 
@@ -86,6 +93,10 @@ class LayerTree {
   }
 
  private:
+  void PaintInTiles(CompositorContext::ScopedFrame& frame,
+                    bool ignore_raster_cache,
+                    const SkPixmap& pixmap) const;
+
   std::shared_ptr<Layer> root_layer_;
   fml::TimePoint vsync_start_;
   fml::TimePoint build_start_;
@@ -96,6 +107,8 @@ class LayerTree {
   uint32_t rasterizer_tracing_threshold_;
   bool checkerboard_raster_cache_images_;
   bool checkerboard_offscreen_layers_;
+  // Whether the last Preroll() saw a layer that rules out painting in tiles.
+  bool has_backdrop_filter_ = false;
 
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
   PaintRegionMap paint_region_map_;
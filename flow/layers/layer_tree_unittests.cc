@@ -5,12 +5,15 @@
 #include "flutter/flow/layers/layer_tree.h"
 
 #include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layers/backdrop_filter_layer.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/testing/mock_layer.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/canvas_test.h"
 #include "flutter/testing/mock_canvas.h"
 #include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/effects/SkImageFilters.h"
 
 namespace flutter {
 namespace testing {
@@ -203,5 +206,124 @@ TEST_F(LayerTreeTest, NeedsSystemComposite) {
                                                child_path2, child_paint2}}}));
 }
 
+namespace {
+
+// Runs tasks on the thread that posts them and counts them.
+class CountingTaskRunner : public fml::ConcurrentTaskRunner {
+ public:
+  CountingTaskRunner()
+      : fml::ConcurrentTaskRunner(std::weak_ptr<fml::ConcurrentMessageLoop>()) {
+  }
+
+  void PostTask(const fml::closure& task) override {
+    posted_task_count_++;
+    task();
+  }
+
+  size_t posted_task_count() const { return posted_task_count_; }
+
+ private:
+  size_t posted_task_count_ = 0;
+};
+
+// An embedder for a frame that has no platform views in it.
+class EmptyViewEmbedder : public ExternalViewEmbedder {
+ public:
+  SkCanvas* GetRootCanvas() override { return nullptr; }
+  void CancelFrame() override {}
+  void BeginFrame(
+      SkISize frame_size,
+      GrDirectContext* context,
+      double device_pixel_ratio,
+      fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger) override {}
+  void PrerollCompositeEmbeddedView(
+      int view_id,
+      std::unique_ptr<EmbeddedViewParams> params) override {}
+  std::vector<SkCanvas*> GetCurrentCanvases() override { return {}; }
+  SkCanvas* CompositeEmbeddedView(int view_id) override { return nullptr; }
+};
+
+const SkISize kTiledFrameSize = SkISize::Make(600, 300);
+
+sk_sp<SkImage> PaintFrame(
+    std::shared_ptr<Layer> root_layer,
+    std::shared_ptr<fml::ConcurrentTaskRunner> tile_task_runner,
+    ExternalViewEmbedder* view_embedder = nullptr) {
+  CompositorContext compositor_context(fml::kDefaultFrameBudget);
+  compositor_context.SetTileTaskRunner(std::move(tile_task_runner));
+  LayerTree layer_tree(kTiledFrameSize, 1.0f);
+  layer_tree.set_root_layer(std::move(root_layer));
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(
+      kTiledFrameSize.width(), kTiledFrameSize.height());
+  auto frame = compositor_context.AcquireFrame(nullptr, surface->getCanvas(),
+                                               view_embedder, SkMatrix(),
+                                               false, true, nullptr);
+  frame->Raster(layer_tree, false);
+  return surface->makeImageSnapshot();
+}
+
+void ExpectSamePixels(const sk_sp<SkImage>& expected,
+                      const sk_sp<SkImage>& actual) {
+  SkPixmap expected_pixels;
+  SkPixmap actual_pixels;
+  ASSERT_TRUE(expected->peekPixels(&expected_pixels));
+  ASSERT_TRUE(actual->peekPixels(&actual_pixels));
+  ASSERT_EQ(expected_pixels.computeByteSize(), actual_pixels.computeByteSize());
+  EXPECT_EQ(memcmp(expected_pixels.addr(), actual_pixels.addr(),
+                   expected_pixels.computeByteSize()),
+            0);
+}
+
+}  // namespace
+
+TEST(LayerTreePaintInTilesTest, TilesMatchPaintingOnOneThread) {
+  const SkPath child_path = SkPath().addCircle(300.0f, 150.0f, 140.0f);
+  auto mock_layer =
+      std::make_shared<MockLayer>(child_path, SkPaint(SkColors::kCyan));
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer);
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  ExpectSamePixels(PaintFrame(layer, nullptr),
+                   PaintFrame(layer, loop->GetTaskRunner()));
+}
+
+TEST(LayerTreePaintInTilesTest, BackdropFilterIsPaintedOnOneThread) {
+  const SkPath background_path = SkPath().addCircle(300.0f, 150.0f, 140.0f);
+  const SkPath foreground_path =
+      SkPath().addRect(SkRect::MakeLTRB(250.0f, 100.0f, 350.0f, 200.0f));
+  auto background =
+      std::make_shared<MockLayer>(background_path, SkPaint(SkColors::kCyan));
+  auto foreground =
+      std::make_shared<MockLayer>(foreground_path, SkPaint(SkColors::kRed));
+  auto backdrop = std::make_shared<BackdropFilterLayer>(
+      SkImageFilters::Blur(10, 10, SkTileMode::kClamp, nullptr));
+  backdrop->Add(foreground);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(background);
+  layer->Add(backdrop);
+
+  auto task_runner = std::make_shared<CountingTaskRunner>();
+  sk_sp<SkImage> painted = PaintFrame(layer, task_runner);
+  // The blur reads what was painted below it, which a tile can't see across
+  // its edges, so the whole frame is painted without help.
+  EXPECT_EQ(task_runner->posted_task_count(), 0u);
+  ExpectSamePixels(PaintFrame(layer, nullptr), painted);
+}
+
+TEST(LayerTreePaintInTilesTest, FramesWithPlatformViewsArePaintedOnOneThread) {
+  const SkPath child_path = SkPath().addCircle(300.0f, 150.0f, 140.0f);
+  auto mock_layer =
+      std::make_shared<MockLayer>(child_path, SkPaint(SkColors::kCyan));
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer);
+
+  auto task_runner = std::make_shared<CountingTaskRunner>();
+  EmptyViewEmbedder view_embedder;
+  sk_sp<SkImage> painted = PaintFrame(layer, task_runner, &view_embedder);
+  EXPECT_EQ(task_runner->posted_task_count(), 0u);
+  ExpectSamePixels(PaintFrame(layer, nullptr), painted);
+}
+
 }  // namespace testing
 }  // namespace flutter
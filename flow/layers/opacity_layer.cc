@@ -50,12 +50,21 @@ void OpacityLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   context->mutators_stack.Pop();
   context->mutators_stack.Pop();
 
+  // The opacity of this layer and any opacity it inherits are applied
+  // together, either by the children or by the layer that they are drawn
+  // into.
+  set_layer_can_inherit_opacity(true);
+
   {
     set_paint_bounds(paint_bounds().makeOffset(offset_.fX, offset_.fY));
+    // Children that take the opacity themselves are drawn without a layer,
+    // so caching them wouldn't save a change of surface.
+    if (!children_can_inherit_opacity()) {
 #ifndef SUPPORT_FRACTIONAL_TRANSLATION
-    child_matrix = RasterCache::GetIntegralTransCTM(child_matrix);
+      child_matrix = RasterCache::GetIntegralTransCTM(child_matrix);
 #endif
-    TryToPrepareRasterCache(context, GetCacheableChild(), child_matrix);
+      TryToPrepareRasterCache(context, GetCacheableChild(), child_matrix);
+    }
   }
 
   // Restore cull_rect
@@ -68,6 +77,7 @@ void OpacityLayer::Paint(PaintContext& context) const {
 
   SkPaint paint;
   paint.setAlpha(alpha_);
+  paint.setAlphaf(paint.getAlphaf() * context.inherited_opacity);
 
   SkAutoCanvasRestore save(context.internal_nodes_canvas, true);
   context.internal_nodes_canvas->translate(offset_.fX, offset_.fY);
@@ -77,6 +87,14 @@ void OpacityLayer::Paint(PaintContext& context) const {
       context.leaf_nodes_canvas->getTotalMatrix()));
 #endif
 
+  SkScalar inherited_opacity = context.inherited_opacity;
+  if (children_can_inherit_opacity()) {
+    context.inherited_opacity = paint.getAlphaf();
+    PaintChildren(context);
+    context.inherited_opacity = inherited_opacity;
+    return;
+  }
+
   if (context.raster_cache &&
       context.raster_cache->Draw(GetCacheableChild(),
                                  *context.leaf_nodes_canvas, &paint)) {
@@ -98,7 +116,9 @@ void OpacityLayer::Paint(PaintContext& context) const {
 
   Layer::AutoSaveLayer save_layer =
       Layer::AutoSaveLayer::Create(context, saveLayerBounds, &paint);
+  context.inherited_opacity = SK_Scalar1;
   PaintChildren(context);
+  context.inherited_opacity = inherited_opacity;
 }
 
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
@@ -13,6 +13,9 @@ namespace flutter {
 // OpacityLayer is very costly due to the saveLayer call. If there's no child,
 // having the OpacityLayer or not has the same effect. In debug_unopt build,
 // |Preroll| will assert if there are no children.
+//
+// The saveLayer call is skipped when the children can inherit the opacity, in
+// which case they apply it to their own draw calls instead.
 class OpacityLayer : public MergedContainerLayer {
  public:
   // An offset is provided here because OpacityLayer.addToScene method in the
@@ -5,10 +5,14 @@
 #include "flutter/flow/layers/opacity_layer.h"
 
 #include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/color_filter_layer.h"
+#include "flutter/flow/layers/shader_mask_layer.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/mock_canvas.h"
+#include "third_party/skia/include/core/SkColorFilter.h"
+#include "third_party/skia/include/core/SkShader.h"
 
 namespace flutter {
 namespace testing {
@@ -395,6 +399,137 @@ TEST_F(OpacityLayerTest, Nested) {
   EXPECT_EQ(mock_canvas().draw_calls(), expected_draw_calls);
 }
 
+TEST_F(OpacityLayerTest, ChildrenInheritOpacity) {
+  const SkPath child1_path = SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f));
+  const SkPath child2_path =
+      SkPath().addRect(SkRect::MakeXYWH(10.0f, 0.0f, 5.0f, 5.0f));
+  const SkPoint layer_offset = SkPoint::Make(0.5f, 1.5f);
+  const SkMatrix initial_transform = SkMatrix::Translate(0.5f, 0.5f);
+  const SkMatrix layer_transform =
+      SkMatrix::Translate(layer_offset.fX, layer_offset.fY);
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+  const SkMatrix integral_layer_transform = RasterCache::GetIntegralTransCTM(
+      SkMatrix::Concat(initial_transform, layer_transform));
+#endif
+  const SkPaint child_paint = SkPaint(SkColors::kGreen);
+  const SkAlpha alpha_half = 255 / 2;
+  auto mock_layer1 = std::make_shared<MockLayer>(child1_path, child_paint);
+  auto mock_layer2 = std::make_shared<MockLayer>(child2_path, child_paint);
+  mock_layer1->set_fake_can_inherit_opacity(true);
+  mock_layer2->set_fake_can_inherit_opacity(true);
+  auto layer = std::make_shared<OpacityLayer>(alpha_half, layer_offset);
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+
+  layer->Preroll(preroll_context(), initial_transform);
+  EXPECT_TRUE(layer->layer_can_inherit_opacity());
+
+  SkPaint opacity_paint;
+  opacity_paint.setAlpha(alpha_half);
+  SkPaint expected_child_paint = child_paint;
+  expected_child_paint.setAlphaf(opacity_paint.getAlphaf());
+  auto expected_draw_calls = std::vector(
+      {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+       MockCanvas::DrawCall{
+           1, MockCanvas::ConcatMatrixData{SkM44(layer_transform)}},
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+       MockCanvas::DrawCall{
+           1, MockCanvas::SetMatrixData{SkM44(integral_layer_transform)}},
+#endif
+       MockCanvas::DrawCall{
+           1, MockCanvas::DrawPathData{child1_path, expected_child_paint}},
+       MockCanvas::DrawCall{
+           1, MockCanvas::DrawPathData{child2_path, expected_child_paint}},
+       MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}});
+  layer->Paint(paint_context());
+  EXPECT_EQ(mock_canvas().draw_calls(), expected_draw_calls);
+}
+
+TEST_F(OpacityLayerTest, OverlappingChildrenDontInheritOpacity) {
+  const SkPath child1_path = SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f));
+  const SkPath child2_path =
+      SkPath().addRect(SkRect::MakeXYWH(2.0f, 2.0f, 5.0f, 5.0f));
+  auto mock_layer1 = std::make_shared<MockLayer>(child1_path);
+  auto mock_layer2 = std::make_shared<MockLayer>(child2_path);
+  mock_layer1->set_fake_can_inherit_opacity(true);
+  mock_layer2->set_fake_can_inherit_opacity(true);
+  auto layer = std::make_shared<OpacityLayer>(255 / 2, SkPoint());
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  // The layer itself can still take an opacity from its ancestors.
+  EXPECT_TRUE(layer->layer_can_inherit_opacity());
+
+  layer->Paint(paint_context());
+  int save_layer_count = 0;
+  for (const auto& draw_call : mock_canvas().draw_calls()) {
+    if (std::holds_alternative<MockCanvas::SaveLayerData>(draw_call.data)) {
+      save_layer_count++;
+    }
+  }
+  EXPECT_EQ(save_layer_count, 1);
+}
+
+TEST_F(OpacityLayerTest, ColorFilterChildKeepsSaveLayer) {
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f));
+  const SkPaint child_paint = SkPaint(SkColors::kGreen);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  mock_layer->set_fake_can_inherit_opacity(true);
+  auto filter_layer = std::make_shared<ColorFilterLayer>(
+      SkColorFilters::Blend(SK_ColorRED, SkBlendMode::kSrcIn));
+  filter_layer->Add(mock_layer);
+  auto layer = std::make_shared<OpacityLayer>(255 / 2, SkPoint());
+  layer->Add(filter_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_FALSE(filter_layer->layer_can_inherit_opacity());
+
+  layer->Paint(paint_context());
+  int save_layer_count = 0;
+  for (const auto& draw_call : mock_canvas().draw_calls()) {
+    if (std::holds_alternative<MockCanvas::SaveLayerData>(draw_call.data)) {
+      save_layer_count++;
+    }
+    if (auto* draw_path =
+            std::get_if<MockCanvas::DrawPathData>(&draw_call.data)) {
+      // The opacity must not be applied before the filter.
+      EXPECT_EQ(draw_path->paint, child_paint);
+    }
+  }
+  EXPECT_EQ(save_layer_count, 2);
+}
+
+TEST_F(OpacityLayerTest, ShaderMaskChildKeepsSaveLayer) {
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f));
+  const SkPaint child_paint = SkPaint(SkColors::kGreen);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  mock_layer->set_fake_can_inherit_opacity(true);
+  auto mask_layer = std::make_shared<ShaderMaskLayer>(
+      SkShaders::Color(SK_ColorBLUE), SkRect::MakeWH(5.0f, 5.0f),
+      SkBlendMode::kSrc);
+  mask_layer->Add(mock_layer);
+  auto layer = std::make_shared<OpacityLayer>(255 / 2, SkPoint());
+  layer->Add(mask_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_FALSE(mask_layer->layer_can_inherit_opacity());
+
+  layer->Paint(paint_context());
+  int save_layer_count = 0;
+  for (const auto& draw_call : mock_canvas().draw_calls()) {
+    if (std::holds_alternative<MockCanvas::SaveLayerData>(draw_call.data)) {
+      save_layer_count++;
+    }
+    if (auto* draw_path =
+            std::get_if<MockCanvas::DrawPathData>(&draw_call.data)) {
+      // The opacity must not be applied before the mask.
+      EXPECT_EQ(draw_path->paint, child_paint);
+    }
+  }
+  EXPECT_EQ(save_layer_count, 2);
+}
+
 TEST_F(OpacityLayerTest, Readback) {
   auto initial_transform = SkMatrix();
   auto layer = std::make_shared<OpacityLayer>(kOpaque_SkAlphaType, SkPoint());
@@ -18,6 +18,19 @@ PictureLayer::PictureLayer(const SkPoint& offset,
       is_complex_(is_complex),
       will_change_(will_change) {}
 
+PictureLayer::PictureLayer(const SkPoint& offset,
+                           SkiaGPUObject<DisplayList> display_list,
+                           bool is_complex,
+                           bool will_change)
+    : offset_(offset),
+      display_list_(std::move(display_list)),
+      is_complex_(is_complex),
+      will_change_(will_change) {}
+
+SkRect PictureLayer::content_bounds() const {
+  return display_list() ? display_list()->bounds() : picture()->cullRect();
+}
+
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
 bool PictureLayer::IsReplacing(DiffContext* context, const Layer* layer) const {
@@ -42,13 +55,17 @@ void PictureLayer::Diff(DiffContext* context, const Layer* old_layer) {
 #endif
   }
   context->PushTransform(SkMatrix::Translate(offset_.x(), offset_.y()));
-  context->AddLayerBounds(picture()->cullRect());
+  context->AddLayerBounds(content_bounds());
   context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
 }
 
 bool PictureLayer::Compare(DiffContext::Statistics& statistics,
                            const PictureLayer* l1,
                            const PictureLayer* l2) {
+  if (l1->display_list() || l2->display_list()) {
+    return CompareDisplayLists(statistics, l1->display_list(),
+                               l2->display_list());
+  }
   const auto& pic1 = l1->picture_.get();
   const auto& pic2 = l2->picture_.get();
   if (pic1.get() == pic2.get()) {
@@ -83,6 +100,33 @@ bool PictureLayer::Compare(DiffContext::Statistics& statistics,
   return res;
 }
 
+bool PictureLayer::CompareDisplayLists(DiffContext::Statistics& statistics,
+                                       const DisplayList* dl1,
+                                       const DisplayList* dl2) {
+  if (dl1 == dl2) {
+    statistics.AddSameInstancePicture();
+    return true;
+  }
+  // A layer with a display list is never equal to one with a picture.
+  if (!dl1 || !dl2 || dl1->op_count() != dl2->op_count() ||
+      dl1->bounds() != dl2->bounds()) {
+    statistics.AddNewPicture();
+    return false;
+  }
+
+  // Unlike pictures, display lists are hashed as they are built, so they can
+  // be compared without limiting the comparison to small ones: lists that
+  // differ almost always have different hashes.
+  statistics.AddDeepComparePicture();
+  bool res = dl1->Equals(*dl2);
+  if (res) {
+    statistics.AddDifferentInstanceButEqualPicture();
+  } else {
+    statistics.AddNewPicture();
+  }
+  return res;
+}
+
 sk_sp<SkData> PictureLayer::SerializedPicture() const {
   if (!cached_serialized_picture_) {
     SkSerialProcs procs = {
@@ -113,8 +157,6 @@ void PictureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   CheckForChildLayerBelow(context);
 #endif
 
-  SkPicture* sk_picture = picture();
-
   if (auto* cache = context->raster_cache) {
     TRACE_EVENT0("flutter", "PictureLayer::RasterCache (Preroll)");
 
@@ -123,17 +165,25 @@ void PictureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 #ifndef SUPPORT_FRACTIONAL_TRANSLATION
     ctm = RasterCache::GetIntegralTransCTM(ctm);
 #endif
-    cache->Prepare(context->gr_context, sk_picture, ctm,
-                   context->dst_color_space, is_complex_, will_change_);
+    if (display_list()) {
+      cache->Prepare(context->gr_context, display_list_, ctm,
+                     context->dst_color_space, is_complex_, will_change_);
+    } else {
+      cache->Prepare(context->gr_context, picture(), ctm,
+                     context->dst_color_space, is_complex_, will_change_);
+    }
   }
 
-  SkRect bounds = sk_picture->cullRect().makeOffset(offset_.x(), offset_.y());
+  SkRect bounds = content_bounds().makeOffset(offset_.x(), offset_.y());
   set_paint_bounds(bounds);
+  // Nothing is known about the draw calls of a picture.
+  DisplayList* dl = display_list();
+  set_layer_can_inherit_opacity(dl && dl->can_apply_group_opacity());
 }
 
 void PictureLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "PictureLayer::Paint");
-  FML_DCHECK(picture_.get());
+  FML_DCHECK(picture_.get() || display_list_.get());
   FML_DCHECK(needs_painting(context));
 
   SkAutoCanvasRestore save(context.leaf_nodes_canvas, true);
@@ -143,6 +193,23 @@ void PictureLayer::Paint(PaintContext& context) const {
       context.leaf_nodes_canvas->getTotalMatrix()));
 #endif
 
+  if (DisplayList* dl = display_list()) {
+    SkPaint opacity_paint;
+    opacity_paint.setAlphaf(context.inherited_opacity);
+    SkPaint* cache_paint =
+        context.inherited_opacity < SK_Scalar1 ? &opacity_paint : nullptr;
+    if (context.raster_cache &&
+        context.raster_cache->Draw(*dl, *context.leaf_nodes_canvas,
+                                   cache_paint)) {
+      TRACE_EVENT_INSTANT0("flutter", "raster cache hit");
+      return;
+    }
+    dl->RenderTo(context.leaf_nodes_canvas, context.inherited_opacity);
+    return;
+  }
+
+  FML_DCHECK(context.inherited_opacity == SK_Scalar1);
+
   if (context.raster_cache &&
       context.raster_cache->Draw(*picture(), *context.leaf_nodes_canvas)) {
     TRACE_EVENT_INSTANT0("flutter", "raster cache hit");
@@ -7,6 +7,7 @@
 
 #include <memory>
 
+#include "flutter/flow/display_list.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/skia_gpu_object.h"
@@ -20,8 +21,15 @@ class PictureLayer : public Layer {
                bool is_complex,
                bool will_change);
 
+  PictureLayer(const SkPoint& offset,
+               SkiaGPUObject<DisplayList> display_list,
+               bool is_complex,
+               bool will_change);
+
   SkPicture* picture() const { return picture_.get().get(); }
 
+  DisplayList* display_list() const { return display_list_.get().get(); }
+
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
   bool IsReplacing(DiffContext* context, const Layer* layer) const override;
@@ -41,9 +49,15 @@ class PictureLayer : public Layer {
   // Even though pictures themselves are not GPU resources, they may reference
   // images that have a reference to a GPU resource.
   SkiaGPUObject<SkPicture> picture_;
+  // Set instead of the picture when the content was recorded into a display
+  // list. The same holds for the images it references.
+  SkiaGPUObject<DisplayList> display_list_;
   bool is_complex_ = false;
   bool will_change_ = false;
 
+  // The bounds of the picture or display list, before the offset.
+  SkRect content_bounds() const;
+
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
   sk_sp<SkData> SerializedPicture() const;
@@ -51,6 +65,9 @@ class PictureLayer : public Layer {
   static bool Compare(DiffContext::Statistics& statistics,
                       const PictureLayer* l1,
                       const PictureLayer* l2);
+  static bool CompareDisplayLists(DiffContext::Statistics& statistics,
+                                  const DisplayList* dl1,
+                                  const DisplayList* dl2);
 
 #endif  // FLUTTER_ENABLE_DIFF_CONTEXT
 
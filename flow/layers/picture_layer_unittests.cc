@@ -6,15 +6,16 @@
 
 #include "flutter/flow/layers/picture_layer.h"
 
+#include "flutter/flow/layers/opacity_layer.h"
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/skia_gpu_object_layer_test.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/mock_canvas.h"
+#include "third_party/skia/include/core/SkFont.h"
 #include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
 
-#ifndef SUPPORT_FRACTIONAL_TRANSLATION
 #include "flutter/flow/raster_cache.h"
-#endif
 
 namespace flutter {
 namespace testing {
@@ -99,6 +100,83 @@ TEST_F(PictureLayerTest, SimplePicture) {
   EXPECT_EQ(mock_canvas().draw_calls(), expected_draw_calls);
 }
 
+TEST_F(PictureLayerTest, PictureDoesNotInheritOpacity) {
+  const SkRect picture_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_picture = SkPicture::MakePlaceholder(picture_bounds);
+  auto layer = std::make_shared<PictureLayer>(
+      SkPoint(), SkiaGPUObject(mock_picture, unref_queue()), false, false);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_FALSE(layer->layer_can_inherit_opacity());
+}
+
+TEST_F(PictureLayerTest, DisplayListInheritsOpacity) {
+  auto make_layer = [this](const SkRect& second_rect) {
+    DisplayListBuilder builder;
+    builder.drawRect(SkRect::MakeLTRB(0, 0, 10, 10));
+    builder.drawRect(second_rect);
+    return std::make_shared<PictureLayer>(
+        SkPoint(), SkiaGPUObject(builder.Build(), unref_queue()), false,
+        false);
+  };
+
+  auto layer = make_layer(SkRect::MakeLTRB(20, 0, 30, 10));
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(layer->layer_can_inherit_opacity());
+
+  auto overlapping_layer = make_layer(SkRect::MakeLTRB(5, 0, 15, 10));
+  overlapping_layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_FALSE(overlapping_layer->layer_can_inherit_opacity());
+}
+
+TEST_F(PictureLayerTest, TextKeepsOpacitySaveLayer) {
+  DisplayListBuilder builder;
+  // The rect gives the list non-empty bounds whatever fonts are available.
+  builder.drawRect(SkRect::MakeLTRB(0, 20, 10, 30));
+  builder.drawTextBlob(SkTextBlob::MakeFromString("Hello", SkFont()), 0, 10);
+  auto picture_layer = std::make_shared<PictureLayer>(
+      SkPoint(), SkiaGPUObject(builder.Build(), unref_queue()), false, false);
+  auto opacity_layer = std::make_shared<OpacityLayer>(255 / 2, SkPoint());
+  opacity_layer->Add(picture_layer);
+
+  opacity_layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_FALSE(picture_layer->layer_can_inherit_opacity());
+
+  opacity_layer->Paint(paint_context());
+  int save_layer_count = 0;
+  for (const auto& draw_call : mock_canvas().draw_calls()) {
+    if (std::holds_alternative<MockCanvas::SaveLayerData>(draw_call.data)) {
+      save_layer_count++;
+    }
+  }
+  EXPECT_EQ(save_layer_count, 1);
+}
+
+TEST_F(PictureLayerTest, EqualDisplayListsShareARasterCacheEntry) {
+  auto build = [this](const SkRect& rect) {
+    DisplayListBuilder builder;
+    builder.drawRect(rect);
+    return SkiaGPUObject(builder.Build(), unref_queue());
+  };
+  RasterCache cache(1);
+  SkMatrix matrix;
+  SkCanvas canvas;
+
+  auto first = build(SkRect::MakeLTRB(0, 0, 10, 10));
+  EXPECT_FALSE(cache.Prepare(nullptr, first, matrix, nullptr, true, false));
+  EXPECT_FALSE(cache.Draw(*first.get(), canvas));
+  cache.SweepAfterFrame();
+
+  // A list recorded again with the same calls uses the entry of the first.
+  auto second = build(SkRect::MakeLTRB(0, 0, 10, 10));
+  EXPECT_TRUE(cache.Prepare(nullptr, second, matrix, nullptr, true, false));
+  EXPECT_TRUE(cache.Draw(*second.get(), canvas));
+  EXPECT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+
+  auto different = build(SkRect::MakeLTRB(0, 0, 10, 20));
+  EXPECT_FALSE(cache.Draw(*different.get(), canvas));
+}
+
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
 using PictureLayerDiffTest = DiffContextTest;
@@ -39,6 +39,9 @@ void ShaderMaskLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
   ContainerLayer::Preroll(context, matrix);
+  // The children are drawn into a layer of their own, so an inherited
+  // opacity would only reach them before the mask was applied.
+  set_layer_can_inherit_opacity(false);
 }
 
 void ShaderMaskLayer::Paint(PaintContext& context) const {
@@ -42,13 +42,7 @@ RasterCache::RasterCache(size_t access_threshold,
       picture_cache_limit_per_frame_(picture_cache_limit_per_frame),
       checkerboard_images_(false) {}
 
-static bool CanRasterizePicture(SkPicture* picture) {
-  if (picture == nullptr) {
-    return false;
-  }
-
-  const SkRect cull_rect = picture->cullRect();
-
+static bool CanRasterizeRect(const SkRect& cull_rect) {
   if (cull_rect.isEmpty()) {
     // No point in ever rasterizing an empty picture.
     return false;
@@ -62,6 +56,22 @@ static bool CanRasterizePicture(SkPicture* picture) {
   return true;
 }
 
+static bool CanRasterizePicture(SkPicture* picture) {
+  if (picture == nullptr) {
+    return false;
+  }
+
+  return CanRasterizeRect(picture->cullRect());
+}
+
+static bool CanRasterizeDisplayList(DisplayList* display_list) {
+  if (display_list == nullptr) {
+    return false;
+  }
+
+  return CanRasterizeRect(display_list->bounds());
+}
+
 static bool IsPictureWorthRasterizing(SkPicture* picture,
                                       bool will_change,
                                       bool is_complex) {
@@ -88,6 +98,32 @@ static bool IsPictureWorthRasterizing(SkPicture* picture,
   return picture->approximateOpCount() > 5;
 }
 
+static bool IsDisplayListWorthRasterizing(DisplayList* display_list,
+                                          bool will_change,
+                                          bool is_complex) {
+  if (will_change) {
+    // If the display list is going to change in the future, there is no point
+    // in doing to extra work to rasterize.
+    return false;
+  }
+
+  if (!CanRasterizeDisplayList(display_list)) {
+    // No point in deciding whether the display list is worth rasterizing if it
+    // cannot be rasterized at all.
+    return false;
+  }
+
+  if (is_complex) {
+    // The caller seems to have extra information about the display list and
+    // thinks the display list is always worth rasterizing.
+    return true;
+  }
+
+  // Same heuristic as for pictures. The op count of a display list includes
+  // the attribute changes, which pictures fold into their draw calls.
+  return display_list->op_count() > 5;
+}
+
 /// @note Procedure doesn't copy all closures.
 static std::unique_ptr<RasterCacheResult> Rasterize(
     GrDirectContext* context,
@@ -136,6 +172,17 @@ std::unique_ptr<RasterCacheResult> RasterCache::RasterizePicture(
                    [=](SkCanvas* canvas) { canvas->drawPicture(picture); });
 }
 
+std::unique_ptr<RasterCacheResult> RasterCache::RasterizeDisplayList(
+    DisplayList* display_list,
+    GrDirectContext* context,
+    const SkMatrix& ctm,
+    SkColorSpace* dst_color_space,
+    bool checkerboard) const {
+  return Rasterize(
+      context, ctm, dst_color_space, checkerboard, display_list->bounds(),
+      [=](SkCanvas* canvas) { display_list->RenderTo(canvas); });
+}
+
 void RasterCache::Prepare(PrerollContext* context,
                           Layer* layer,
                           const SkMatrix& ctm) {
@@ -223,6 +270,64 @@ bool RasterCache::Prepare(GrDirectContext* context,
   return true;
 }
 
+bool RasterCache::Prepare(GrDirectContext* context,
+                          const SkiaGPUObject<DisplayList>& display_list_object,
+                          const SkMatrix& transformation_matrix,
+                          SkColorSpace* dst_color_space,
+                          bool is_complex,
+                          bool will_change) {
+  // Disabling caching when access_threshold is zero is historic behavior.
+  if (access_threshold_ == 0) {
+    return false;
+  }
+  if (picture_cached_this_frame_ >= picture_cache_limit_per_frame_) {
+    return false;
+  }
+  DisplayList* display_list = display_list_object.get().get();
+  if (!IsDisplayListWorthRasterizing(display_list, will_change, is_complex)) {
+    // We only deal with display lists that are worthy of rasterization.
+    return false;
+  }
+
+  // Decompose the matrix (once) for all subsequent operations. We want to make
+  // sure to avoid volumetric distortions while accounting for scaling.
+  const MatrixDecomposition matrix(transformation_matrix);
+
+  if (!matrix.IsValid()) {
+    // The matrix was singular. No point in going further.
+    return false;
+  }
+
+  DisplayListRasterCacheKey cache_key(display_list->hash(),
+                                      transformation_matrix);
+
+  // Creates an entry, if not present prior. An entry made for a different
+  // list with the same hash is started over for this one. The entry holds the
+  // latest list it is used for, so that |Draw| usually finds the same list.
+  DisplayListEntry& entry = display_list_cache_[cache_key];
+  DisplayList* cached_list = entry.display_list.get().get();
+  if (cached_list != display_list) {
+    if (cached_list == nullptr || !cached_list->Equals(*display_list)) {
+      entry.access_count = 0;
+      entry.image.reset();
+    }
+    entry.display_list.reset();
+    entry.display_list = display_list_object.Share();
+  }
+  if (entry.access_count < access_threshold_) {
+    // Frame threshold has not yet been reached.
+    return false;
+  }
+
+  if (!entry.image) {
+    entry.image =
+        RasterizeDisplayList(display_list, context, transformation_matrix,
+                             dst_color_space, checkerboard_images_);
+    picture_cached_this_frame_++;
+  }
+  return true;
+}
+
 bool RasterCache::Draw(const SkPicture& picture, SkCanvas& canvas) const {
   PictureRasterCacheKey cache_key(picture.uniqueID(), canvas.getTotalMatrix());
   auto it = picture_cache_.find(cache_key);
@@ -242,6 +347,33 @@ bool RasterCache::Draw(const SkPicture& picture, SkCanvas& canvas) const {
   return false;
 }
 
+bool RasterCache::Draw(const DisplayList& display_list,
+                       SkCanvas& canvas,
+                       SkPaint* paint) const {
+  DisplayListRasterCacheKey cache_key(display_list.hash(),
+                                      canvas.getTotalMatrix());
+  auto it = display_list_cache_.find(cache_key);
+  if (it == display_list_cache_.end()) {
+    return false;
+  }
+
+  DisplayListEntry& entry = it->second;
+  DisplayList* cached_list = entry.display_list.get().get();
+  if (cached_list == nullptr || !cached_list->Equals(display_list)) {
+    return false;
+  }
+
+  entry.access_count++;
+  entry.used_this_frame = true;
+
+  if (entry.image) {
+    entry.image->draw(canvas, paint);
+    return true;
+  }
+
+  return false;
+}
+
 bool RasterCache::Draw(const Layer* layer,
                        SkCanvas& canvas,
                        SkPaint* paint) const {
@@ -265,6 +397,7 @@ bool RasterCache::Draw(const Layer* layer,
 
 void RasterCache::SweepAfterFrame() {
   SweepOneCacheAfterFrame(picture_cache_);
+  SweepOneCacheAfterFrame(display_list_cache_);
   SweepOneCacheAfterFrame(layer_cache_);
   picture_cached_this_frame_ = 0;
   TraceStatsToTimeline();
@@ -272,11 +405,13 @@ void RasterCache::SweepAfterFrame() {
 
 void RasterCache::Clear() {
   picture_cache_.clear();
+  display_list_cache_.clear();
   layer_cache_.clear();
 }
 
 size_t RasterCache::GetCachedEntriesCount() const {
-  return layer_cache_.size() + picture_cache_.size();
+  return layer_cache_.size() + picture_cache_.size() +
+         display_list_cache_.size();
 }
 
 size_t RasterCache::GetLayerCachedEntriesCount() const {
@@ -284,7 +419,7 @@ size_t RasterCache::GetLayerCachedEntriesCount() const {
 }
 
 size_t RasterCache::GetPictureCachedEntriesCount() const {
-  return picture_cache_.size();
+  return picture_cache_.size() + display_list_cache_.size();
 }
 
 void RasterCache::SetCheckboardCacheImages(bool checkerboard) {
@@ -304,7 +439,8 @@ void RasterCache::TraceStatsToTimeline() const {
   FML_TRACE_COUNTER("flutter", "RasterCache", reinterpret_cast<int64_t>(this),
                     "LayerCount", layer_cache_.size(), "LayerMBytes",
                     EstimateLayerCacheByteSize() / kMegaByteSizeInBytes,
-                    "PictureCount", picture_cache_.size(), "PictureMBytes",
+                    "PictureCount", GetPictureCachedEntriesCount(),
+                    "PictureMBytes",
                     EstimatePictureCacheByteSize() / kMegaByteSizeInBytes);
 
 #endif  // !FLUTTER_RELEASE
@@ -327,6 +463,11 @@ size_t RasterCache::EstimatePictureCacheByteSize() const {
       picture_cache_bytes += item.second.image->image_bytes();
     }
   }
+  for (const auto& item : display_list_cache_) {
+    if (item.second.image) {
+      picture_cache_bytes += item.second.image->image_bytes();
+    }
+  }
   return picture_cache_bytes;
 }
 
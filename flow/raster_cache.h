@@ -8,7 +8,9 @@
 #include <memory>
 #include <unordered_map>
 
+#include "flutter/flow/display_list.h"
 #include "flutter/flow/raster_cache_key.h"
+#include "flutter/flow/skia_gpu_object.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "third_party/skia/include/core/SkImage.h"
@@ -75,6 +77,28 @@ class RasterCache {
       SkColorSpace* dst_color_space,
       bool checkerboard) const;
 
+  /**
+   * @brief Rasterize a display list and produce a RasterCacheResult
+   * to be stored in the cache.
+   *
+   * @param display_list the DisplayList to be cached.
+   * @param context the GrDirectContext used for rendering.
+   * @param ctm the transformation matrix used for rendering.
+   * @param dst_color_space the destination color space that the cached
+   *        rendering will be drawn into
+   * @param checkerboard a flag indicating whether or not a checkerboard
+   *        pattern should be rendered into the cached image for debug
+   *        analysis
+   * @return a RasterCacheResult that can draw the rendered display list into
+   *         the destination using a simple image blit
+   */
+  virtual std::unique_ptr<RasterCacheResult> RasterizeDisplayList(
+      DisplayList* display_list,
+      GrDirectContext* context,
+      const SkMatrix& ctm,
+      SkColorSpace* dst_color_space,
+      bool checkerboard) const;
+
   /**
    * @brief Rasterize an engine Layer and produce a RasterCacheResult
    * to be stored in the cache.
@@ -139,6 +163,17 @@ class RasterCache {
                bool is_complex,
                bool will_change);
 
+  // Like the picture variant above, for display lists. Lists that are equal
+  // share an entry, so a list that is recorded again each frame with the same
+  // contents is still cached. The entry keeps the list alive until it is
+  // swept.
+  bool Prepare(GrDirectContext* context,
+               const SkiaGPUObject<DisplayList>& display_list,
+               const SkMatrix& transformation_matrix,
+               SkColorSpace* dst_color_space,
+               bool is_complex,
+               bool will_change);
+
   void Prepare(PrerollContext* context, Layer* layer, const SkMatrix& ctm);
 
   // Find the raster cache for the picture and draw it to the canvas.
@@ -146,6 +181,16 @@ class RasterCache {
   // Return true if it's found and drawn.
   bool Draw(const SkPicture& picture, SkCanvas& canvas) const;
 
+  // Find the raster cache for the display list and draw it to the canvas.
+  //
+  // Addional paint can be given to change how the raster cache is drawn (e.g.,
+  // draw the raster cache with some opacity).
+  //
+  // Return true if it's found and drawn.
+  bool Draw(const DisplayList& display_list,
+            SkCanvas& canvas,
+            SkPaint* paint = nullptr) const;
+
   // Find the raster cache for the layer and draw it to the canvas.
   //
   // Addional paint can be given to change how the raster cache is drawn (e.g.,
@@ -166,11 +211,12 @@ class RasterCache {
 
   size_t GetLayerCachedEntriesCount() const;
 
+  // Pictures and display lists are counted together.
   size_t GetPictureCachedEntriesCount() const;
 
   /**
    * @brief Estimate how much memory is used by picture raster cache entries in
-   * bytes.
+   * bytes, including those of display lists.
    *
    * Only SkImage's memory usage is counted as other objects are often much
    * smaller compared to SkImage. SkImageInfo::computeMinByteSize is used to
@@ -195,6 +241,12 @@ class RasterCache {
     std::unique_ptr<RasterCacheResult> image;
   };
 
+  struct DisplayListEntry : Entry {
+    // The list the entry was made for, which a list with the same hash must
+    // be equal to in order to use the entry.
+    SkiaGPUObject<DisplayList> display_list;
+  };
+
   template <class Cache>
   static void SweepOneCacheAfterFrame(Cache& cache) {
     std::vector<typename Cache::iterator> dead;
@@ -216,6 +268,7 @@ class RasterCache {
   const size_t picture_cache_limit_per_frame_;
   size_t picture_cached_this_frame_ = 0;
   mutable PictureRasterCacheKey::Map<Entry> picture_cache_;
+  mutable DisplayListRasterCacheKey::Map<DisplayListEntry> display_list_cache_;
   mutable LayerRasterCacheKey::Map<Entry> layer_cache_;
   bool checkerboard_images_;
 
@@ -52,6 +52,10 @@ class RasterCacheKey {
 // The ID is the uint32_t picture uniqueID
 using PictureRasterCacheKey = RasterCacheKey<uint32_t>;
 
+// The ID is the display list hash(). Since lists that are not equal may have
+// the same hash, the entries also hold the list they were made from.
+using DisplayListRasterCacheKey = RasterCacheKey<size_t>;
+
 class Layer;
 
 // The ID is the uint64_t layer unique_id
@@ -71,6 +71,12 @@ class SkiaGPUObject {
 
   sk_sp<SkiaObjectType> get() const { return object_; }
 
+  // Returns another reference to the object, which is also released through
+  // the unref queue.
+  SkiaGPUObject Share() const {
+    return object_ ? SkiaGPUObject(object_, queue_) : SkiaGPUObject();
+  }
+
   void reset() {
     if (object_ && queue_) {
       queue_->Unref(object_.release());
@@ -30,6 +30,12 @@ class MockLayer : public Layer {
   const SkRect& parent_cull_rect() { return parent_cull_rect_; }
   bool parent_has_platform_view() { return parent_has_platform_view_; }
 
+  // Makes the layer report that it can inherit opacity, in which case it
+  // paints its path with the inherited opacity applied.
+  void set_fake_can_inherit_opacity(bool value) {
+    fake_can_inherit_opacity_ = value;
+  }
+
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
   bool IsReplacing(DiffContext* context, const Layer* layer) const override;
@@ -48,6 +54,7 @@ class MockLayer : public Layer {
   bool fake_has_platform_view_ = false;
   bool fake_needs_system_composite_ = false;
   bool fake_reads_surface_ = false;
+  bool fake_can_inherit_opacity_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(MockLayer);
 };
@@ -5,9 +5,11 @@
 #ifndef FLUTTER_FML_FILE_H_
 #define FLUTTER_FML_FILE_H_
 
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -67,11 +69,33 @@ bool IsDirectory(const fml::UniqueFD& directory);
 
 bool IsDirectory(const fml::UniqueFD& base_directory, const char* path);
 
+/// Identifies a file or directory independently of the path used to open it,
+/// along with the time its contents were last modified. For a directory, the
+/// modification time changes when entries are added to or removed from it.
+struct FileIdentity {
+  uint64_t device = 0;
+  uint64_t file = 0;
+  int64_t modification_time_ns = 0;
+
+  bool operator<(const FileIdentity& other) const {
+    return std::tie(device, file, modification_time_ns) <
+           std::tie(other.device, other.file, other.modification_time_ns);
+  }
+};
+
+/// Returns false if the identity of the open `file` could not be determined.
+bool GetFileIdentity(const fml::UniqueFD& file, FileIdentity* identity);
+
 // Returns whether the given path is a file.
 bool IsFile(const std::string& path);
 
 bool TruncateFile(const fml::UniqueFD& file, size_t size);
 
+/// Asks the OS to start reading the whole file into its cache in the
+/// background, so that mapping it later doesn't wait on storage. Returns
+/// whether the OS took the hint. It is not supported on Windows.
+bool ReadAhead(const fml::UniqueFD& file);
+
 bool FileExists(const fml::UniqueFD& base_directory, const char* path);
 
 bool UnlinkDirectory(const char* path);
@@ -90,6 +114,15 @@ bool WriteAtomically(const fml::UniqueFD& base_directory,
                      const char* file_name,
                      const Mapping& mapping);
 
+/// Appends the contents of `mapping` to the end of the file, creating the file
+/// if necessary. Unlike `WriteAtomically`, the data is not flushed to storage,
+/// so it may be lost, in whole or in part, if the system crashes. If this fails
+/// part way through, the file may have been extended by only part of the
+/// mapping.
+bool AppendToFile(const fml::UniqueFD& base_directory,
+                  const char* file_name,
+                  const Mapping& mapping);
+
 /// Signature of a callback on a file in `directory` with `filename` (relative
 /// to `directory`). The returned bool should be false if and only if further
 /// traversal should be stopped. For example, a file-search visitor may return
@@ -253,6 +253,28 @@ TEST(FileTest, AtomicWriteTest) {
   ASSERT_TRUE(fml::UnlinkFile(dir.fd(), "precious_data"));
 }
 
+TEST(FileTest, AppendToFileTest) {
+  fml::ScopedTemporaryDirectory dir;
+
+  const std::string first = "These are ";
+  const std::string second = "my contents.";
+
+  // Appending creates the file, and later appends extend it.
+  ASSERT_TRUE(fml::AppendToFile(
+      dir.fd(), "log", fml::DataMapping(std::vector<uint8_t>{
+                           first.begin(), first.end()})));
+  ASSERT_TRUE(fml::AppendToFile(
+      dir.fd(), "log", fml::DataMapping(std::vector<uint8_t>{
+                           second.begin(), second.end()})));
+
+  ASSERT_EQ(first + second,
+            ReadStringFromFile(fml::OpenFile(dir.fd(), "log", false,
+                                             fml::FilePermission::kRead)));
+
+  // Cleanup.
+  ASSERT_TRUE(fml::UnlinkFile(dir.fd(), "log"));
+}
+
 TEST(FileTest, EmptyMappingTest) {
   fml::ScopedTemporaryDirectory dir;
 
@@ -296,3 +318,45 @@ TEST(FileTest, FileTestsSupportsUnicode) {
       fml::IsFile(fml::paths::JoinPaths({dir.path(), filename}).c_str()));
   ASSERT_TRUE(fml::UnlinkFile(dir.fd(), filename));
 }
+
+TEST(FileTest, CanPrefetchMappedFile) {
+  fml::ScopedTemporaryDirectory dir;
+  auto fd = fml::OpenFile(dir.fd(), "prefetched", true,
+                          fml::FilePermission::kReadWrite);
+  ASSERT_TRUE(fd.is_valid());
+  std::string contents(3 * 4096 + 17, 'x');
+  ASSERT_TRUE(WriteStringToFile(fd, contents));
+
+#if OS_WIN
+  ASSERT_FALSE(fml::ReadAhead(fd));
+#else
+  ASSERT_TRUE(fml::ReadAhead(fd));
+#endif
+
+  {
+    fml::FileMapping mapping(fd);
+    ASSERT_EQ(mapping.GetSize(), contents.size());
+    fml::AdviseWillNeed(mapping.GetMapping(), mapping.GetSize());
+    fml::TouchPages(mapping.GetMapping(), mapping.GetSize());
+    // Prefetching doesn't change what is mapped.
+    ASSERT_EQ(ReadStringFromFile(fd), contents);
+  }
+
+  fd.reset();
+  ASSERT_TRUE(fml::UnlinkFile(dir.fd(), "prefetched"));
+}
+
+TEST(FileTest, FileIdentityIgnoresPath) {
+  fml::ScopedTemporaryDirectory dir;
+  auto first = fml::OpenDirectory(dir.path().c_str(), false,
+                                  fml::FilePermission::kRead);
+  auto second = fml::OpenDirectory(dir.path().c_str(), false,
+                                   fml::FilePermission::kRead);
+  fml::FileIdentity first_identity;
+  fml::FileIdentity second_identity;
+  ASSERT_TRUE(fml::GetFileIdentity(first, &first_identity));
+  ASSERT_TRUE(fml::GetFileIdentity(second, &second_identity));
+  ASSERT_FALSE(first_identity < second_identity);
+  ASSERT_FALSE(second_identity < first_identity);
+  ASSERT_FALSE(fml::GetFileIdentity(fml::UniqueFD{}, &first_identity));
+}
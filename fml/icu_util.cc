@@ -4,6 +4,7 @@
 
 #include "flutter/fml/icu_util.h"
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 
@@ -117,5 +118,41 @@ void InitializeICUFromMapping(std::unique_ptr<Mapping> mapping) {
   });
 }
 
+std::mutex g_lazy_icu_mutex;
+std::function<void()> g_lazy_icu_initializer;
+// Lets |EnsureICUInitialized| return without locking once there is nothing
+// left to do, as it is called for every paragraph.
+std::atomic<bool> g_lazy_icu_pending = false;
+
+void SetLazyICUInitializer(std::function<void()> initializer) {
+  std::scoped_lock lock(g_lazy_icu_mutex);
+  g_lazy_icu_initializer = std::move(initializer);
+  g_lazy_icu_pending.store(true, std::memory_order_release);
+}
+
+void InitializeICULazily(const std::string& icu_data_path) {
+  SetLazyICUInitializer([icu_data_path]() { InitializeICU(icu_data_path); });
+}
+
+void InitializeICUFromMappingLazily(
+    std::function<std::unique_ptr<Mapping>()> mapper) {
+  SetLazyICUInitializer([mapper = std::move(mapper)]() {
+    InitializeICUFromMapping(mapper());
+  });
+}
+
+void EnsureICUInitialized() {
+  if (!g_lazy_icu_pending.load(std::memory_order_acquire)) {
+    return;
+  }
+  // Other callers wait here until ICU is ready for them to use.
+  std::scoped_lock lock(g_lazy_icu_mutex);
+  if (g_lazy_icu_initializer) {
+    g_lazy_icu_initializer();
+    g_lazy_icu_initializer = nullptr;
+  }
+  g_lazy_icu_pending.store(false, std::memory_order_release);
+}
+
 }  // namespace icu
 }  // namespace fml
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_FML_ICU_UTIL_H_
 #define FLUTTER_FML_ICU_UTIL_H_
 
+#include <functional>
+#include <memory>
 #include <string>
 
 #include "flutter/fml/macros.h"
@@ -17,6 +19,21 @@ void InitializeICU(const std::string& icu_data_path = "");
 
 void InitializeICUFromMapping(std::unique_ptr<Mapping> mapping);
 
+// Records how to initialize ICU, which is then done by the first call to
+// |EnsureICUInitialized|. This keeps opening and mapping the ICU data off the
+// startup path of applications that don't lay out text right away.
+void InitializeICULazily(const std::string& icu_data_path = "");
+
+void InitializeICUFromMappingLazily(
+    std::function<std::unique_ptr<Mapping>()> mapper);
+
+// Initializes ICU as recorded by |InitializeICULazily| or
+// |InitializeICUFromMappingLazily| if that hasn't been done yet. Must be
+// called before using ICU from code that may run with lazy initialization,
+// which is every entry point into ICU outside of the paragraph builder and
+// the Android text utilities that already call it.
+void EnsureICUInitialized();
+
 }  // namespace icu
 }  // namespace fml
 
@@ -135,4 +135,18 @@ const uint8_t* SymbolMapping::GetMapping() const {
   return mapping_;
 }
 
+void TouchPages(const uint8_t* data, size_t size) {
+  if (data == nullptr || size == 0) {
+    return;
+  }
+  // Pages are at least this large on every supported platform, so touching
+  // at this stride touches every page.
+  constexpr size_t kMinPageSize = 4096;
+  volatile uint8_t sink = 0;
+  for (size_t offset = 0; offset < size; offset += kMinPageSize) {
+    sink = sink ^ data[offset];
+  }
+  sink = sink ^ data[size - 1];
+}
+
 }  // namespace fml
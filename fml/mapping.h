@@ -69,6 +69,13 @@ class FileMapping final : public Mapping {
 
   bool IsValid() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Hints that the |size| bytes at |offset| will be read soon, so
+  ///             that the OS can start paging them in. This is a no-op on
+  ///             platforms without such hints.
+  ///
+  void WillNeed(size_t offset, size_t size) const;
+
  private:
   bool valid_ = false;
   size_t size_ = 0;
@@ -125,6 +132,44 @@ class NonOwnedMapping final : public Mapping {
   FML_DISALLOW_COPY_AND_ASSIGN(NonOwnedMapping);
 };
 
+//------------------------------------------------------------------------------
+/// @brief      Hints that the |size| bytes of mapped memory at |data| will be
+///             read soon, so that the OS can start paging them in. This is a
+///             no-op on platforms without such hints.
+///
+void AdviseWillNeed(const uint8_t* data, size_t size);
+
+//------------------------------------------------------------------------------
+/// @brief      Asks the OS to back the |size| bytes of mapped memory at |data|
+///             with transparent huge pages, which take fewer page faults and
+///             TLB entries to cover large mappings. Only the part of the
+///             memory that spans whole huge pages can be backed by them.
+///
+/// @return     Whether the OS took the advice. It doesn't without transparent
+///             huge page support, which is only available on Linux and
+///             Android, and for file backed memory also needs support from
+///             the file system.
+///
+bool AdviseHugePages(const uint8_t* data, size_t size);
+
+//------------------------------------------------------------------------------
+/// @brief      Reads a byte of every page of the |size| bytes of mapped memory
+///             at |data|, so that the calling thread takes the page faults
+///             instead of the next thread to use the memory.
+///
+void TouchPages(const uint8_t* data, size_t size);
+
+//------------------------------------------------------------------------------
+/// @brief      Finds where the segment of a shared library or executable that
+///             the loader mapped at |address| ends. This gives the extent of
+///             symbols, which |SymbolMapping| doesn't know.
+///
+/// @return     The number of bytes from |address| to the end of its segment,
+///             or zero if |address| isn't in a loaded segment or the platform
+///             can't tell.
+///
+size_t GetLoadedSegmentSizeFrom(const uint8_t* address);
+
 class SymbolMapping final : public Mapping {
  public:
   SymbolMapping(fml::RefPtr<fml::NativeLibrary> native_library,
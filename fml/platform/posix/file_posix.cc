@@ -13,6 +13,7 @@
 #include <memory>
 #include <sstream>
 
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/eintr_wrapper.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/mapping.h"
@@ -140,6 +141,29 @@ bool IsDirectory(const fml::UniqueFD& base_directory, const char* path) {
   return (file.is_valid() && IsDirectory(file));
 }
 
+bool GetFileIdentity(const fml::UniqueFD& file, FileIdentity* identity) {
+  if (!file.is_valid() || identity == nullptr) {
+    return false;
+  }
+
+  struct stat stat_result = {};
+
+  if (::fstat(file.get(), &stat_result) != 0) {
+    return false;
+  }
+
+#if OS_MACOSX || OS_IOS
+  const struct timespec& modified = stat_result.st_mtimespec;
+#else
+  const struct timespec& modified = stat_result.st_mtim;
+#endif
+  identity->device = static_cast<uint64_t>(stat_result.st_dev);
+  identity->file = static_cast<uint64_t>(stat_result.st_ino);
+  identity->modification_time_ns =
+      static_cast<int64_t>(modified.tv_sec) * 1000000000 + modified.tv_nsec;
+  return true;
+}
+
 bool IsFile(const std::string& path) {
   struct stat buf;
   if (stat(path.c_str(), &buf) != 0) {
@@ -157,6 +181,24 @@ bool TruncateFile(const fml::UniqueFD& file, size_t size) {
   return ::ftruncate(file.get(), size) == 0;
 }
 
+bool ReadAhead(const fml::UniqueFD& file) {
+  if (!file.is_valid()) {
+    return false;
+  }
+#if OS_MACOSX
+  struct stat stat_buffer = {};
+  if (::fstat(file.get(), &stat_buffer) != 0) {
+    return false;
+  }
+  struct radvisory advisory = {};
+  advisory.ra_offset = 0;
+  advisory.ra_count = stat_buffer.st_size;
+  return ::fcntl(file.get(), F_RDADVISE, &advisory) != -1;
+#else
+  return ::posix_fadvise(file.get(), 0, 0, POSIX_FADV_WILLNEED) == 0;
+#endif
+}
+
 bool UnlinkDirectory(const char* path) {
   return UnlinkDirectory(fml::UniqueFD{AT_FDCWD}, path);
 }
@@ -230,6 +272,40 @@ bool WriteAtomically(const fml::UniqueFD& base_directory,
                     base_directory.get(), file_name) == 0;
 }
 
+bool AppendToFile(const fml::UniqueFD& base_directory,
+                  const char* file_name,
+                  const Mapping& data) {
+  if (file_name == nullptr || data.GetMapping() == nullptr) {
+    return false;
+  }
+
+  fml::UniqueFD file{FML_HANDLE_EINTR(
+      ::openat(base_directory.get(), file_name,
+               ToPosixAccessFlags(FilePermission::kWrite) | O_CREAT | O_APPEND,
+               ToPosixCreateModeFlags(FilePermission::kReadWrite)))};
+  if (!file.is_valid()) {
+    return false;
+  }
+
+  ssize_t remaining = data.GetSize();
+  ssize_t written = 0;
+  ssize_t offset = 0;
+
+  while (remaining > 0) {
+    written = FML_HANDLE_EINTR(
+        ::write(file.get(), data.GetMapping() + offset, remaining));
+
+    if (written == -1) {
+      return false;
+    }
+
+    remaining -= written;
+    offset += written;
+  }
+
+  return true;
+}
+
 bool VisitFiles(const fml::UniqueFD& directory, const FileVisitor& visitor) {
   fml::UniqueFD dup_fd(dup(directory.get()));
   if (!dup_fd.is_valid()) {
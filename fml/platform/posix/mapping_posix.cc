@@ -5,10 +5,14 @@
 #include "flutter/fml/mapping.h"
 
 #include <fcntl.h>
+#if OS_LINUX || OS_ANDROID
+#include <link.h>
+#endif
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <type_traits>
 
 #include "flutter/fml/build_config.h"
@@ -104,4 +108,76 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+void FileMapping::WillNeed(size_t offset, size_t size) const {
+  if (mapping_ == nullptr || offset >= size_) {
+    return;
+  }
+  AdviseWillNeed(mapping_ + offset, std::min(size, size_ - offset));
+}
+
+static size_t GetPageSize() {
+  static const size_t page_size = ::sysconf(_SC_PAGESIZE);
+  return page_size;
+}
+
+void AdviseWillNeed(const uint8_t* data, size_t size) {
+  if (data == nullptr || size == 0) {
+    return;
+  }
+  // The advice must start at a page boundary.
+  const uintptr_t address = reinterpret_cast<uintptr_t>(data);
+  const uintptr_t start = address - address % GetPageSize();
+  ::madvise(reinterpret_cast<void*>(start), size + (address - start),
+            MADV_WILLNEED);
+}
+
+bool AdviseHugePages(const uint8_t* data, size_t size) {
+#if defined(MADV_HUGEPAGE)
+  // The size of the huge pages that cover a page table entry on x86_64 and
+  // arm64 kernels with 4 KiB pages.
+  constexpr uintptr_t kHugePageSize = 2 * 1024 * 1024;
+  const uintptr_t address = reinterpret_cast<uintptr_t>(data);
+  const uintptr_t start =
+      (address + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+  const uintptr_t end = (address + size) / kHugePageSize * kHugePageSize;
+  if (data == nullptr || end <= start) {
+    return false;
+  }
+  return ::madvise(reinterpret_cast<void*>(start), end - start,
+                   MADV_HUGEPAGE) == 0;
+#else
+  return false;
+#endif
+}
+
+size_t GetLoadedSegmentSizeFrom(const uint8_t* address) {
+#if OS_LINUX || OS_ANDROID
+  struct Search {
+    uintptr_t address;
+    size_t size;
+  } search = {reinterpret_cast<uintptr_t>(address), 0};
+  ::dl_iterate_phdr(
+      [](struct dl_phdr_info* info, size_t, void* data) {
+        auto* search = static_cast<Search*>(data);
+        for (int i = 0; i < info->dlpi_phnum; i++) {
+          const auto& header = info->dlpi_phdr[i];
+          if (header.p_type != PT_LOAD) {
+            continue;
+          }
+          const uintptr_t start = info->dlpi_addr + header.p_vaddr;
+          const uintptr_t end = start + header.p_memsz;
+          if (search->address >= start && search->address < end) {
+            search->size = end - search->address;
+            return 1;
+          }
+        }
+        return 0;
+      },
+      &search);
+  return search.size;
+#else
+  return 0;
+#endif
+}
+
 }  // namespace fml
@@ -312,6 +312,27 @@ bool IsDirectory(const fml::UniqueFD& base_directory, const char* path) {
          FILE_ATTRIBUTE_DIRECTORY;
 }
 
+bool GetFileIdentity(const fml::UniqueFD& file, FileIdentity* identity) {
+  if (!file.is_valid() || identity == nullptr) {
+    return false;
+  }
+  BY_HANDLE_FILE_INFORMATION info;
+  if (!::GetFileInformationByHandle(file.get(), &info)) {
+    FML_DLOG(ERROR) << "Could not get file information. "
+                    << GetLastErrorMessage();
+    return false;
+  }
+  identity->device = info.dwVolumeSerialNumber;
+  identity->file = (static_cast<uint64_t>(info.nFileIndexHigh) << 32) |
+                   info.nFileIndexLow;
+  // FILETIME counts 100ns intervals.
+  identity->modification_time_ns =
+      ((static_cast<int64_t>(info.ftLastWriteTime.dwHighDateTime) << 32) |
+       info.ftLastWriteTime.dwLowDateTime) *
+      100;
+  return true;
+}
+
 bool IsFile(const std::string& path) {
   DWORD attributes = GetFileAttributesForUtf8Path(path.c_str());
   if (attributes == INVALID_FILE_ATTRIBUTES) {
@@ -359,6 +380,10 @@ bool UnlinkFile(const fml::UniqueFD& base_directory, const char* path) {
   return true;
 }
 
+bool ReadAhead(const fml::UniqueFD& file) {
+  return false;
+}
+
 bool TruncateFile(const fml::UniqueFD& file, size_t size) {
   LARGE_INTEGER large_size;
   large_size.QuadPart = size;
@@ -444,8 +469,9 @@ bool WriteAtomically(const fml::UniqueFD& base_directory,
 
   temp_file.reset();
 
-  if (!::MoveFile(StringToWideString(temp_file_path).c_str(),
-                  StringToWideString(file_path).c_str())) {
+  if (!::MoveFileEx(StringToWideString(temp_file_path).c_str(),
+                    StringToWideString(file_path).c_str(),
+                    MOVEFILE_REPLACE_EXISTING)) {
     FML_DLOG(ERROR)
         << "Could not replace temp file at correct path. File path: "
         << file_path << ". Temp file path: " << temp_file_path << " "
@@ -456,6 +482,48 @@ bool WriteAtomically(const fml::UniqueFD& base_directory,
   return true;
 }
 
+bool AppendToFile(const fml::UniqueFD& base_directory,
+                  const char* file_name,
+                  const Mapping& mapping) {
+  if (file_name == nullptr || mapping.GetMapping() == nullptr) {
+    return false;
+  }
+
+  auto file_path = GetAbsolutePath(base_directory, file_name);
+  fml::UniqueFD file{::CreateFile(
+      StringToWideString(file_path).c_str(),  // lpFileName
+      FILE_APPEND_DATA,                       // dwDesiredAccess
+      FILE_SHARE_READ,                        // dwShareMode
+      nullptr,                                // lpSecurityAttributes
+      OPEN_ALWAYS,                            // dwCreationDisposition
+      FILE_ATTRIBUTE_NORMAL,                  // dwFlagsAndAttributes
+      nullptr                                 // hTemplateFile
+      )};
+  if (!file.is_valid()) {
+    FML_DLOG(ERROR) << "Could not open file for appending. "
+                    << GetLastErrorMessage();
+    return false;
+  }
+
+  // |WriteFile| takes a 32-bit size.
+  constexpr size_t kMaxChunkSize = 1u << 30;
+  const uint8_t* data = mapping.GetMapping();
+  size_t remaining = mapping.GetSize();
+  while (remaining > 0) {
+    const DWORD chunk = static_cast<DWORD>(
+        remaining < kMaxChunkSize ? remaining : kMaxChunkSize);
+    DWORD written = 0;
+    if (!::WriteFile(file.get(), data, chunk, &written, nullptr)) {
+      FML_DLOG(ERROR) << "Could not append to file. " << GetLastErrorMessage();
+      return false;
+    }
+    data += written;
+    remaining -= written;
+  }
+
+  return true;
+}
+
 bool VisitFiles(const fml::UniqueFD& directory, const FileVisitor& visitor) {
   std::string search_pattern = GetFullHandlePath(directory) + "\\*";
   WIN32_FIND_DATA find_file_data;
@@ -119,4 +119,20 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+void FileMapping::WillNeed(size_t offset, size_t size) const {
+  AdviseWillNeed(mapping_ + offset, size);
+}
+
+void AdviseWillNeed(const uint8_t* data, size_t size) {
+  // PrefetchVirtualMemory is not available on all supported versions.
+}
+
+bool AdviseHugePages(const uint8_t* data, size_t size) {
+  return false;
+}
+
+size_t GetLoadedSegmentSizeFrom(const uint8_t* address) {
+  return 0;
+}
+
 }  // namespace fml
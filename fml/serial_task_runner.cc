@@ -0,0 +1,121 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include "flutter/fml/serial_task_runner.h"
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/message_loop_impl.h"
+#include "flutter/fml/thread_local.h"
+
+namespace fml {
+
+// The serial task runner whose tasks are currently being run on this thread.
+FML_THREAD_LOCAL ThreadLocalUniquePtr<SerialTaskRunner*> tls_current_runner;
+
+fml::RefPtr<SerialTaskRunner> SerialTaskRunner::Create(
+    std::shared_ptr<ConcurrentTaskRunner> worker_task_runner,
+    fml::RefPtr<TaskRunner> timer_task_runner) {
+  FML_DCHECK(worker_task_runner);
+  return fml::AdoptRef(new SerialTaskRunner(std::move(worker_task_runner),
+                                            std::move(timer_task_runner)));
+}
+
+SerialTaskRunner::SerialTaskRunner(
+    std::shared_ptr<ConcurrentTaskRunner> worker_task_runner,
+    fml::RefPtr<TaskRunner> timer_task_runner)
+    : TaskRunner(nullptr),
+      worker_task_runner_(std::move(worker_task_runner)),
+      timer_task_runner_(std::move(timer_task_runner)),
+      task_queues_(MessageLoopTaskQueues::GetInstance()),
+      queue_id_(task_queues_->CreateTaskQueue()) {
+  task_queues_->SetWakeable(queue_id_, this);
+}
+
+SerialTaskRunner::~SerialTaskRunner() {
+  task_queues_->Dispose(queue_id_);
+}
+
+void SerialTaskRunner::PostTask(const fml::closure& task) {
+  task_queues_->RegisterTask(queue_id_, task, fml::TimePoint::Now());
+}
+
+void SerialTaskRunner::PostTaskForTime(const fml::closure& task,
+                                       fml::TimePoint target_time) {
+  FML_DCHECK(timer_task_runner_ || target_time <= fml::TimePoint::Now())
+      << "Delayed tasks require a timer task runner.";
+  task_queues_->RegisterTask(queue_id_, task, target_time);
+}
+
+void SerialTaskRunner::PostDelayedTask(const fml::closure& task,
+                                       fml::TimeDelta delay) {
+  PostTaskForTime(task, fml::TimePoint::Now() + delay);
+}
+
+bool SerialTaskRunner::RunsTasksOnCurrentThread() {
+  return tls_current_runner.get() && *tls_current_runner.get() == this;
+}
+
+TaskQueueId SerialTaskRunner::GetTaskQueueId() {
+  return queue_id_;
+}
+
+// |Wakeable|
+void SerialTaskRunner::WakeUp(fml::TimePoint time_point) {
+  // This is called with the lock of the task queues held. Posting to another
+  // |TaskRunner| (which would register a task in the same task queues) must
+  // be done from a different task.
+  if (time_point == fml::TimePoint::Max()) {
+    return;
+  }
+
+  if (time_point > fml::TimePoint::Now()) {
+    if (!timer_task_runner_) {
+      return;
+    }
+    worker_task_runner_->PostTask(
+        [runner = fml::Ref(this), time_point]() {
+          runner->timer_task_runner_->PostTaskForTime(
+              [runner]() { runner->ScheduleDrain(); }, time_point);
+        });
+    return;
+  }
+
+  ScheduleDrain();
+}
+
+void SerialTaskRunner::ScheduleDrain() {
+  std::scoped_lock lock(drain_mutex_);
+  if (drain_scheduled_) {
+    // The drain in flight will pick up the new tasks.
+    drain_requested_ = true;
+    return;
+  }
+  drain_scheduled_ = true;
+  worker_task_runner_->PostTask([runner = fml::Ref(this)]() {
+    runner->Drain();
+  });
+}
+
+void SerialTaskRunner::Drain() {
+  tls_current_runner.reset(new SerialTaskRunner*(this));
+  while (true) {
+    fml::closure task;
+    while ((task = task_queues_->GetNextTaskToRun(queue_id_,
+                                                  fml::TimePoint::Now()))) {
+      task();
+    }
+
+    std::scoped_lock lock(drain_mutex_);
+    if (!drain_requested_) {
+      drain_scheduled_ = false;
+      break;
+    }
+    drain_requested_ = false;
+  }
+  tls_current_runner.reset(nullptr);
+}
+
+}  // namespace fml
@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_SERIAL_TASK_RUNNER_H_
+#define FLUTTER_FML_SERIAL_TASK_RUNNER_H_
+
+#include <memory>
+#include <mutex>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/message_loop_task_queues.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/wakeable.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// A task runner whose tasks are executed one at a time, in order, on the
+/// threads of a concurrent worker pool instead of on a dedicated thread.
+///
+/// Tasks are stored in a task queue owned by |MessageLoopTaskQueues|, just like
+/// the tasks of a |MessageLoop|. When tasks become ready, a single drain task
+/// is posted to the worker pool that runs them until the queue is empty. At
+/// most one drain is in flight at any time, so tasks never run concurrently
+/// with one another, but consecutive drains may run on different workers.
+///
+/// Delayed tasks require a |timer_task_runner| on which wake ups are scheduled.
+/// No tasks other than these wake ups are posted to it.
+///
+class SerialTaskRunner final : public TaskRunner, public Wakeable {
+ public:
+  static fml::RefPtr<SerialTaskRunner> Create(
+      std::shared_ptr<ConcurrentTaskRunner> worker_task_runner,
+      fml::RefPtr<TaskRunner> timer_task_runner = nullptr);
+
+  ~SerialTaskRunner() override;
+
+  // |TaskRunner|
+  void PostTask(const fml::closure& task) override;
+
+  // |TaskRunner|
+  void PostTaskForTime(const fml::closure& task,
+                       fml::TimePoint target_time) override;
+
+  // |TaskRunner|
+  void PostDelayedTask(const fml::closure& task, fml::TimeDelta delay) override;
+
+  // |TaskRunner|
+  bool RunsTasksOnCurrentThread() override;
+
+  // |TaskRunner|
+  TaskQueueId GetTaskQueueId() override;
+
+  // |Wakeable|
+  void WakeUp(fml::TimePoint time_point) override;
+
+ private:
+  SerialTaskRunner(std::shared_ptr<ConcurrentTaskRunner> worker_task_runner,
+                   fml::RefPtr<TaskRunner> timer_task_runner);
+
+  void ScheduleDrain();
+
+  void Drain();
+
+  const std::shared_ptr<ConcurrentTaskRunner> worker_task_runner_;
+  const fml::RefPtr<TaskRunner> timer_task_runner_;
+  const fml::RefPtr<MessageLoopTaskQueues> task_queues_;
+  const TaskQueueId queue_id_;
+
+  std::mutex drain_mutex_;
+  bool drain_scheduled_ = false;
+  bool drain_requested_ = false;
+
+  FML_FRIEND_MAKE_REF_COUNTED(SerialTaskRunner);
+  FML_FRIEND_REF_COUNTED_THREAD_SAFE(SerialTaskRunner);
+  FML_DISALLOW_COPY_AND_ASSIGN(SerialTaskRunner);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_SERIAL_TASK_RUNNER_H_
@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include "flutter/fml/serial_task_runner.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/message_loop.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(SerialTaskRunnerTest, RunsTasksInOrderWithoutOverlap) {
+  auto loop = ConcurrentMessageLoop::Create(4);
+  auto runner = SerialTaskRunner::Create(loop->GetTaskRunner());
+
+  const size_t kTaskCount = 1000;
+  std::vector<size_t> order;
+  std::atomic_int running = 0;
+  std::atomic_bool overlapped = false;
+  CountDownLatch latch(kTaskCount);
+  for (size_t i = 0; i < kTaskCount; i++) {
+    runner->PostTask([&, i]() {
+      if (++running != 1) {
+        overlapped = true;
+      }
+      ASSERT_TRUE(runner->RunsTasksOnCurrentThread());
+      order.push_back(i);
+      --running;
+      latch.CountDown();
+    });
+  }
+  latch.Wait();
+
+  ASSERT_FALSE(overlapped);
+  ASSERT_EQ(order.size(), kTaskCount);
+  for (size_t i = 0; i < kTaskCount; i++) {
+    ASSERT_EQ(order[i], i);
+  }
+  ASSERT_FALSE(runner->RunsTasksOnCurrentThread());
+}
+
+TEST(SerialTaskRunnerTest, IndependentRunnersDoNotBlockEachOther) {
+  auto loop = ConcurrentMessageLoop::Create(2);
+  auto blocked = SerialTaskRunner::Create(loop->GetTaskRunner());
+  auto other = SerialTaskRunner::Create(loop->GetTaskRunner());
+
+  AutoResetWaitableEvent unblock;
+  AutoResetWaitableEvent other_ran;
+  blocked->PostTask([&unblock]() { unblock.Wait(); });
+  other->PostTask([&other_ran]() { other_ran.Signal(); });
+  other_ran.Wait();
+  unblock.Signal();
+}
+
+TEST(SerialTaskRunnerTest, DelayedTasksUseTheTimerTaskRunner) {
+  fml::RefPtr<TaskRunner> timer_runner;
+  AutoResetWaitableEvent timer_ready;
+  AutoResetWaitableEvent timer_done;
+  std::thread timer_thread([&]() {
+    MessageLoop::EnsureInitializedForCurrentThread();
+    timer_runner = MessageLoop::GetCurrent().GetTaskRunner();
+    timer_ready.Signal();
+    MessageLoop::GetCurrent().Run();
+    timer_done.Signal();
+  });
+  timer_ready.Wait();
+
+  {
+    auto loop = ConcurrentMessageLoop::Create(1);
+    auto runner = SerialTaskRunner::Create(loop->GetTaskRunner(), timer_runner);
+
+    const auto begin = TimePoint::Now();
+    const auto delay = TimeDelta::FromMilliseconds(10);
+    AutoResetWaitableEvent ran;
+    TimePoint ran_at;
+    runner->PostDelayedTask(
+        [&]() {
+          ran_at = TimePoint::Now();
+          ran.Signal();
+        },
+        delay);
+    ran.Wait();
+    ASSERT_GE(ran_at - begin, delay);
+  }
+
+  timer_runner->PostTask([]() { MessageLoop::GetCurrent().Terminate(); });
+  timer_done.Wait();
+  timer_thread.join();
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -274,6 +274,12 @@ void SceneBuilder::addPicture(double dx,
                               double dy,
                               Picture* picture,
                               int hints) {
+  if (auto display_list = picture->display_list()) {
+    AddLayer(std::make_unique<flutter::PictureLayer>(
+        SkPoint::Make(dx, dy), UIDartState::CreateGPUObject(display_list),
+        !!(hints & 1), !!(hints & 2)));
+    return;
+  }
   auto layer = std::make_unique<flutter::PictureLayer>(
       SkPoint::Make(dx, dy), UIDartState::CreateGPUObject(picture->picture()),
       !!(hints & 1), !!(hints & 2));
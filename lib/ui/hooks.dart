@@ -90,6 +90,12 @@ void _dispatchPlatformMessage(String name, ByteData? data, int responseId) {
   PlatformDispatcher.instance._dispatchPlatformMessage(name, data, responseId);
 }
 
+@pragma('vm:entry-point')
+// ignore: unused_element
+void _dispatchPlatformMessageBatch(String name, List<ByteData?> messages) {
+  PlatformDispatcher.instance._dispatchPlatformMessageBatch(name, messages);
+}
+
 @pragma('vm:entry-point')
 // ignore: unused_element
 void _dispatchPointerDataPacket(ByteData packet) {
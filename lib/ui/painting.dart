@@ -1587,6 +1587,32 @@ enum ImageByteFormat {
   ///  * <https://en.wikipedia.org/wiki/Portable_Network_Graphics>, the Wikipedia page on PNG.
   ///  * <https://tools.ietf.org/rfc/rfc2083.txt>, the PNG standard.
   png,
+
+  /// JPEG format.
+  ///
+  /// A lossy compression format well suited for photographs. Transparency is
+  /// not supported; the alpha channel is ignored when encoding.
+  ///
+  /// JPEG images normally use the `.jpg` file extension and the `image/jpeg`
+  /// MIME type.
+  ///
+  /// See also:
+  ///
+  ///  * <https://en.wikipedia.org/wiki/JPEG>, the Wikipedia page on JPEG.
+  jpeg,
+
+  /// WebP format.
+  ///
+  /// A lossy compression format that supports transparency and typically
+  /// produces smaller files than JPEG at equivalent quality.
+  ///
+  /// WebP images normally use the `.webp` file extension and the `image/webp`
+  /// MIME type.
+  ///
+  /// See also:
+  ///
+  ///  * <https://developers.google.com/speed/webp>, the WebP home page.
+  webp,
 }
 
 /// The format of pixel data given to [decodeImageFromPixels].
@@ -1693,11 +1719,19 @@ class Image {
   /// The [format] argument specifies the format in which the bytes will be
   /// returned.
   ///
+  /// The [quality] argument is only used by the compressed formats. For
+  /// [ImageByteFormat.jpeg] and [ImageByteFormat.webp] it is the encoding
+  /// quality in the range 0 to 100. For [ImageByteFormat.png] it is the zlib
+  /// compression level in the range 0 (fastest, largest output) to 9
+  /// (slowest, smallest output). If null, a format specific default is used.
+  ///
+  /// Compression happens on a background worker thread.
+  ///
   /// Returns a future that completes with the binary image data or an error
   /// if encoding fails.
-  Future<ByteData?> toByteData({ImageByteFormat format = ImageByteFormat.rawRgba}) {
+  Future<ByteData?> toByteData({ImageByteFormat format = ImageByteFormat.rawRgba, int? quality}) {
     assert(!_disposed && !_image._disposed);
-    return _image.toByteData(format: format);
+    return _image.toByteData(format: format, quality: quality);
   }
 
   /// If asserts are enabled, returns the [StackTrace]s of each open handle from
@@ -1829,16 +1863,17 @@ class _Image extends NativeFieldWrapperClass2 {
 
   int get height native 'Image_height';
 
-  Future<ByteData?> toByteData({ImageByteFormat format = ImageByteFormat.rawRgba}) {
+  Future<ByteData?> toByteData({ImageByteFormat format = ImageByteFormat.rawRgba, int? quality}) {
+    assert(quality == null || quality >= 0);
     return _futurize((_Callback<ByteData> callback) {
-      return _toByteData(format.index, (Uint8List? encoded) {
+      return _toByteData(format.index, quality ?? -1, (Uint8List? encoded) {
         callback(encoded!.buffer.asByteData());
       });
     });
   }
 
   /// Returns an error message on failure, null on success.
-  String? _toByteData(int format, _Callback<Uint8List?> callback) native 'Image_toByteData';
+  String? _toByteData(int format, int quality, _Callback<Uint8List?> callback) native 'Image_toByteData';
 
   bool _disposed = false;
   void dispose() {
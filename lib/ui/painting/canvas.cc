@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/painting/canvas.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "flutter/flow/layers/physical_shape_layer.h"
@@ -83,6 +84,14 @@ fml::RefPtr<Canvas> Canvas::Create(PictureRecorder* recorder,
   }
   fml::RefPtr<Canvas> canvas = fml::MakeRefCounted<Canvas>(
       recorder->BeginRecording(SkRect::MakeLTRB(left, top, right, bottom)));
+  canvas->display_list_recorder_ = recorder->display_list_recorder();
+  auto* platform_configuration =
+      UIDartState::Current()->platform_configuration();
+  if (platform_configuration && platform_configuration->get_window(0)) {
+    canvas->device_pixel_ratio_ = platform_configuration->get_window(0)
+                                      ->viewport_metrics()
+                                      .device_pixel_ratio;
+  }
   recorder->set_canvas(canvas);
   return canvas;
 }
@@ -204,6 +213,10 @@ void Canvas::drawColor(SkColor color, SkBlendMode blend_mode) {
   if (!canvas_) {
     return;
   }
+  if (auto* builder = display_list_builder()) {
+    builder->drawColor(color, blend_mode);
+    return;
+  }
   canvas_->drawColor(color, blend_mode);
 }
 
@@ -216,6 +229,11 @@ void Canvas::drawLine(double x1,
   if (!canvas_) {
     return;
   }
+  if (auto* builder = display_list_builder()) {
+    builder->setAttributesFromPaint(*paint.paint());
+    builder->drawLine(SkPoint::Make(x1, y1), SkPoint::Make(x2, y2));
+    return;
+  }
   canvas_->drawLine(x1, y1, x2, y2, *paint.paint());
 }
 
@@ -223,6 +241,11 @@ void Canvas::drawPaint(const Paint& paint, const PaintData& paint_data) {
   if (!canvas_) {
     return;
   }
+  if (auto* builder = display_list_builder()) {
+    builder->setAttributesFromPaint(*paint.paint());
+    builder->drawPaint();
+    return;
+  }
   canvas_->drawPaint(*paint.paint());
 }
 
@@ -235,7 +258,13 @@ void Canvas::drawRect(double left,
   if (!canvas_) {
     return;
   }
-  canvas_->drawRect(SkRect::MakeLTRB(left, top, right, bottom), *paint.paint());
+  SkRect rect = SkRect::MakeLTRB(left, top, right, bottom);
+  if (auto* builder = display_list_builder()) {
+    builder->setAttributesFromPaint(*paint.paint());
+    builder->drawRect(rect);
+    return;
+  }
+  canvas_->drawRect(rect, *paint.paint());
 }
 
 void Canvas::drawRRect(const RRect& rrect,
@@ -244,6 +273,11 @@ void Canvas::drawRRect(const RRect& rrect,
   if (!canvas_) {
     return;
   }
+  if (auto* builder = display_list_builder()) {
+    builder->setAttributesFromPaint(*paint.paint());
+    builder->drawRRect(rrect.sk_rrect);
+    return;
+  }
   canvas_->drawRRect(rrect.sk_rrect, *paint.paint());
 }
 
@@ -254,6 +288,11 @@ void Canvas::drawDRRect(const RRect& outer,
   if (!canvas_) {
     return;
   }
+  if (auto* builder = display_list_builder()) {
+    builder->setAttributesFromPaint(*paint.paint());
+    builder->drawDRRect(outer.sk_rrect, inner.sk_rrect);
+    return;
+  }
   canvas_->drawDRRect(outer.sk_rrect, inner.sk_rrect, *paint.paint());
 }
 
@@ -266,7 +305,13 @@ void Canvas::drawOval(double left,
   if (!canvas_) {
     return;
   }
-  canvas_->drawOval(SkRect::MakeLTRB(left, top, right, bottom), *paint.paint());
+  SkRect bounds = SkRect::MakeLTRB(left, top, right, bottom);
+  if (auto* builder = display_list_builder()) {
+    builder->setAttributesFromPaint(*paint.paint());
+    builder->drawOval(bounds);
+    return;
+  }
+  canvas_->drawOval(bounds, *paint.paint());
 }
 
 void Canvas::drawCircle(double x,
@@ -277,6 +322,12 @@ void Canvas::drawCircle(double x,
   if (!canvas_) {
     return;
   }
+  if (auto* builder = display_list_builder()) {
+    builder->setAttributesFromPaint(*paint.paint());
+    // SkCanvas clamps negative radii to zero.
+    builder->drawCircle(SkPoint::Make(x, y), std::max(radius, 0.0));
+    return;
+  }
   canvas_->drawCircle(x, y, radius, *paint.paint());
 }
 
@@ -292,9 +343,16 @@ void Canvas::drawArc(double left,
   if (!canvas_) {
     return;
   }
-  canvas_->drawArc(SkRect::MakeLTRB(left, top, right, bottom),
-                   startAngle * 180.0 / M_PI, sweepAngle * 180.0 / M_PI,
-                   useCenter, *paint.paint());
+  SkRect oval = SkRect::MakeLTRB(left, top, right, bottom);
+  SkScalar start_degrees = startAngle * 180.0 / M_PI;
+  SkScalar sweep_degrees = sweepAngle * 180.0 / M_PI;
+  if (auto* builder = display_list_builder()) {
+    builder->setAttributesFromPaint(*paint.paint());
+    builder->drawArc(oval, start_degrees, sweep_degrees, useCenter);
+    return;
+  }
+  canvas_->drawArc(oval, start_degrees, sweep_degrees, useCenter,
+                   *paint.paint());
 }
 
 void Canvas::drawPath(const CanvasPath* path,
@@ -308,6 +366,11 @@ void Canvas::drawPath(const CanvasPath* path,
         ToDart("Canvas.drawPath called with non-genuine Path."));
     return;
   }
+  if (auto* builder = display_list_builder()) {
+    builder->setAttributesFromPaint(*paint.paint());
+    builder->drawPath(path->path());
+    return;
+  }
   canvas_->drawPath(path->path(), *paint.paint());
 }
 
@@ -317,7 +380,7 @@ static SkSamplingOptions paint_to_sampling(const SkPaint* paint) {
       SkSamplingOptions::kMedium_asMipmapLinear);
 }
 
-void Canvas::drawImage(const CanvasImage* image,
+void Canvas::drawImage(CanvasImage* image,
                        double x,
                        double y,
                        const Paint& paint,
@@ -332,10 +395,24 @@ void Canvas::drawImage(const CanvasImage* image,
   }
   // TODO: add filtering to public API, since paint's quality is deprecated
   SkSamplingOptions sampling = paint_to_sampling(paint.paint());
+  if (auto sk_image = image->image()) {
+    RecordImageDrawSize(image, SkRect::MakeXYWH(x, y, sk_image->width(),
+                                                sk_image->height()));
+  }
+  if (auto* builder = display_list_builder()) {
+    if (auto sk_image = image->image()) {
+      if (paint.paint()) {
+        builder->setAttributesFromPaint(*paint.paint());
+      }
+      builder->drawImage(sk_image, SkPoint::Make(x, y), sampling,
+                         paint.paint() != nullptr);
+    }
+    return;
+  }
   canvas_->drawImage(image->image(), x, y, sampling, paint.paint());
 }
 
-void Canvas::drawImageRect(const CanvasImage* image,
+void Canvas::drawImageRect(CanvasImage* image,
                            double src_left,
                            double src_top,
                            double src_right,
@@ -358,7 +435,27 @@ void Canvas::drawImageRect(const CanvasImage* image,
   SkRect dst = SkRect::MakeLTRB(dst_left, dst_top, dst_right, dst_bottom);
   // TODO: add filtering to public API, since paint's quality is deprecated
   SkSamplingOptions sampling = paint_to_sampling(paint.paint());
-  canvas_->drawImageRect(image->image(), src, dst, sampling, paint.paint(),
+  auto sk_image = image->image();
+  if (sk_image && src.width() > 0 && src.height() > 0) {
+    // Only |src| of the image is visible in |dst|. Scale the destination up
+    // to the size the whole image would need to be drawn at.
+    RecordImageDrawSize(
+        image,
+        SkRect::MakeWH(dst.width() * sk_image->width() / src.width(),
+                       dst.height() * sk_image->height() / src.height()));
+  }
+  if (auto* builder = display_list_builder()) {
+    if (sk_image) {
+      if (paint.paint()) {
+        builder->setAttributesFromPaint(*paint.paint());
+      }
+      builder->drawImageRect(sk_image, src, dst, sampling,
+                             paint.paint() != nullptr,
+                             SkCanvas::kFast_SrcRectConstraint);
+    }
+    return;
+  }
+  canvas_->drawImageRect(sk_image, src, dst, sampling, paint.paint(),
                          SkCanvas::kFast_SrcRectConstraint);
 }
 
@@ -368,7 +465,7 @@ static SkFilterMode paint_to_filter(const SkPaint* paint) {
              : SkFilterMode::kNearest;
 }
 
-void Canvas::drawImageNine(const CanvasImage* image,
+void Canvas::drawImageNine(CanvasImage* image,
                            double center_left,
                            double center_top,
                            double center_right,
@@ -394,6 +491,10 @@ void Canvas::drawImageNine(const CanvasImage* image,
   SkRect dst = SkRect::MakeLTRB(dst_left, dst_top, dst_right, dst_bottom);
   // TODO: add filtering to public API, since paint's quality is deprecated
   SkFilterMode filter = paint_to_filter(paint.paint());
+  RecordImageDrawSize(image, dst);
+  // SkCanvas checks the centre against the image and falls back to drawing
+  // the whole image when it doesn't fit, so nine-patches are recorded through
+  // it even when recording into a display list.
   canvas_->drawImageNine(image->image().get(), icenter, dst, filter,
                          paint.paint());
 }
@@ -407,6 +508,14 @@ void Canvas::drawPicture(Picture* picture) {
         ToDart("Canvas.drawPicture called with non-genuine Picture."));
     return;
   }
+  if (auto display_list = picture->display_list()) {
+    if (display_list_recorder_) {
+      display_list_recorder_->builder().drawDisplayList(display_list);
+    } else {
+      display_list->RenderTo(canvas_);
+    }
+    return;
+  }
   canvas_->drawPicture(picture->picture().get());
 }
 
@@ -421,10 +530,16 @@ void Canvas::drawPoints(const Paint& paint,
   static_assert(sizeof(SkPoint) == sizeof(float) * 2,
                 "SkPoint doesn't use floats.");
 
-  canvas_->drawPoints(point_mode,
-                      points.num_elements() / 2,  // SkPoints have two floats.
-                      reinterpret_cast<const SkPoint*>(points.data()),
-                      *paint.paint());
+  const size_t count = points.num_elements() / 2;  // SkPoints have two floats.
+  const SkPoint* sk_points = reinterpret_cast<const SkPoint*>(points.data());
+  if (auto* builder = display_list_builder()) {
+    if (count > 0) {
+      builder->setAttributesFromPaint(*paint.paint());
+      builder->drawPoints(point_mode, count, sk_points);
+    }
+    return;
+  }
+  canvas_->drawPoints(point_mode, count, sk_points, *paint.paint());
 }
 
 void Canvas::drawVertices(const Vertices* vertices,
@@ -439,6 +554,13 @@ void Canvas::drawVertices(const Vertices* vertices,
         ToDart("Canvas.drawVertices called with non-genuine Vertices."));
     return;
   }
+  if (auto* builder = display_list_builder()) {
+    if (vertices->vertices()) {
+      builder->setAttributesFromPaint(*paint.paint());
+      builder->drawVertices(vertices->vertices(), blend_mode);
+    }
+    return;
+  }
   canvas_->drawVertices(vertices->vertices(), blend_mode, *paint.paint());
 }
 
@@ -470,13 +592,38 @@ void Canvas::drawAtlas(const Paint& paint,
   // TODO: add filtering to public API, since paint's quality is deprecated
   SkSamplingOptions sampling = paint_to_sampling(paint.paint());
 
-  canvas_->drawAtlas(
-      skImage.get(), reinterpret_cast<const SkRSXform*>(transforms.data()),
-      reinterpret_cast<const SkRect*>(rects.data()),
-      reinterpret_cast<const SkColor*>(colors.data()),
-      rects.num_elements() / 4,  // SkRect have four floats.
-      blend_mode, sampling, reinterpret_cast<const SkRect*>(cull_rect.data()),
-      paint.paint());
+  const SkRSXform* xforms =
+      reinterpret_cast<const SkRSXform*>(transforms.data());
+  const size_t sprite_count = rects.num_elements() / 4;
+  if (skImage && sprite_count > 0) {
+    // Each sprite is drawn at the scale of its transform, so the atlas is
+    // needed at most at the largest of those scales.
+    SkScalar max_scale = 0;
+    for (size_t i = 0; i < sprite_count; i++) {
+      max_scale = std::max(max_scale,
+                           SkPoint::Length(xforms[i].fSCos, xforms[i].fSSin));
+    }
+    RecordImageDrawSize(atlas, SkRect::MakeWH(skImage->width() * max_scale,
+                                              skImage->height() * max_scale));
+  }
+
+  const SkRect* tex = reinterpret_cast<const SkRect*>(rects.data());
+  const SkColor* sk_colors = reinterpret_cast<const SkColor*>(colors.data());
+  const SkRect* sk_cull_rect =
+      reinterpret_cast<const SkRect*>(cull_rect.data());
+  if (auto* builder = display_list_builder()) {
+    if (skImage && sprite_count > 0) {
+      if (paint.paint()) {
+        builder->setAttributesFromPaint(*paint.paint());
+      }
+      builder->drawAtlas(skImage, xforms, tex, sk_colors, sprite_count,
+                         blend_mode, sampling, sk_cull_rect,
+                         paint.paint() != nullptr);
+    }
+    return;
+  }
+  canvas_->drawAtlas(skImage.get(), xforms, tex, sk_colors, sprite_count,
+                     blend_mode, sampling, sk_cull_rect, paint.paint());
 }
 
 void Canvas::drawShadow(const CanvasPath* path,
@@ -497,8 +644,19 @@ void Canvas::drawShadow(const CanvasPath* path,
                                           elevation, transparentOccluder, dpr);
 }
 
+void Canvas::RecordImageDrawSize(CanvasImage* image, const SkRect& dst) {
+  // The picture may be drawn with further transforms applied by its layer,
+  // but the framework records pictures in logical pixels with the device pixel
+  // ratio applied at the root. This is a good approximation of the final size.
+  SkRect device_rect = canvas_->getTotalMatrix().mapRect(dst);
+  image->RecordDrawSize(
+      SkSize::Make(device_rect.width() * device_pixel_ratio_,
+                   device_rect.height() * device_pixel_ratio_));
+}
+
 void Canvas::Invalidate() {
   canvas_ = nullptr;
+  display_list_recorder_ = nullptr;
   if (dart_wrapper()) {
     ClearDartWrapper();
   }
@@ -106,12 +106,12 @@ class Canvas : public RefCountedDartWrappable<Canvas> {
   void drawPath(const CanvasPath* path,
                 const Paint& paint,
                 const PaintData& paint_data);
-  void drawImage(const CanvasImage* image,
+  void drawImage(CanvasImage* image,
                  double x,
                  double y,
                  const Paint& paint,
                  const PaintData& paint_data);
-  void drawImageRect(const CanvasImage* image,
+  void drawImageRect(CanvasImage* image,
                      double src_left,
                      double src_top,
                      double src_right,
@@ -122,7 +122,7 @@ class Canvas : public RefCountedDartWrappable<Canvas> {
                      double dst_bottom,
                      const Paint& paint,
                      const PaintData& paint_data);
-  void drawImageNine(const CanvasImage* image,
+  void drawImageNine(CanvasImage* image,
                      double center_left,
                      double center_top,
                      double center_right,
@@ -172,10 +172,30 @@ class Canvas : public RefCountedDartWrappable<Canvas> {
  private:
   explicit Canvas(SkCanvas* canvas);
 
+  // Records the physical pixel size of |dst| (in the current canvas
+  // coordinates) with |image| so oversized decodes can be detected.
+  void RecordImageDrawSize(CanvasImage* image, const SkRect& dst);
+
   // The SkCanvas is supplied by a call to SkPictureRecorder::beginRecording,
   // which does not transfer ownership.  For this reason, we hold a raw
   // pointer and manually set to null in Clear.
   SkCanvas* canvas_;
+
+  // The device pixel ratio of the window when recording began, used to
+  // compute the physical size images are drawn at.
+  SkScalar device_pixel_ratio_ = 1.0f;
+
+  // When recording into a display list, the recorder that |canvas_| points
+  // to. Draw calls are recorded into its builder directly. Calls that change
+  // the transform or clip still go through |canvas_|, which forwards them to
+  // the builder, so that the canvas keeps the state that paragraphs and
+  // shadows are drawn with.
+  sk_sp<DisplayListCanvasRecorder> display_list_recorder_;
+
+  DisplayListBuilder* display_list_builder() const {
+    return display_list_recorder_ ? &display_list_recorder_->builder()
+                                  : nullptr;
+  }
 };
 
 }  // namespace flutter
@@ -4,6 +4,13 @@
 
 #include "flutter/lib/ui/painting/image.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <string>
+
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/image_encoding.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
@@ -35,12 +42,46 @@ void CanvasImage::RegisterNatives(tonic::DartLibraryNatives* natives) {
   natives->Register({FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
 }
 
+namespace {
+
+// An image is considered oversized when it has at least this many times the
+// pixels of the largest destination it is drawn into.
+constexpr int64_t kOversizedImagePixelRatio = 4;
+
+// Bytes that could be saved across all live images by decoding them at the
+// size they are drawn at.
+std::atomic<int64_t> gOversizedImageBytes = 0;
+
+// Rounds |extent| up to whole pixels, saturating instead of overflowing for
+// extents beyond what an int32_t can hold. |extent| must not be NaN.
+int32_t ToPixelExtent(SkScalar extent) {
+  const double pixels = std::ceil(static_cast<double>(extent));
+  if (pixels <= 0) {
+    return 0;
+  }
+  if (pixels >= std::numeric_limits<int32_t>::max()) {
+    return std::numeric_limits<int32_t>::max();
+  }
+  return static_cast<int32_t>(pixels);
+}
+
+void TraceOversizedImageBytes(int64_t delta) {
+  const int64_t total = gOversizedImageBytes.fetch_add(delta) + delta;
+  FML_TRACE_COUNTER("flutter", "OversizedImages", 0, "WastedBytes", total);
+}
+
+}  // namespace
+
 CanvasImage::CanvasImage() = default;
 
-CanvasImage::~CanvasImage() = default;
+CanvasImage::~CanvasImage() {
+  ResetDrawSizeTracking();
+}
 
-Dart_Handle CanvasImage::toByteData(int format, Dart_Handle callback) {
-  return EncodeImage(this, format, callback);
+Dart_Handle CanvasImage::toByteData(int format,
+                                    int quality,
+                                    Dart_Handle callback) {
+  return EncodeImage(this, format, quality, callback);
 }
 
 void CanvasImage::dispose() {
@@ -48,10 +89,67 @@ void CanvasImage::dispose() {
   if (hint_freed_delegate) {
     hint_freed_delegate->HintFreed(GetAllocationSize());
   }
+  ResetDrawSizeTracking();
   image_.reset();
   ClearDartWrapper();
 }
 
+void CanvasImage::RecordDrawSize(const SkSize& device_size) {
+  auto image = image_.get();
+  if (!image || device_size.isEmpty() || std::isnan(device_size.width()) ||
+      std::isnan(device_size.height())) {
+    return;
+  }
+
+  SkISize draw_size =
+      SkISize::Make(std::max(max_draw_size_.width(),
+                             ToPixelExtent(device_size.width())),
+                    std::max(max_draw_size_.height(),
+                             ToPixelExtent(device_size.height())));
+  if (draw_size == max_draw_size_) {
+    return;
+  }
+  max_draw_size_ = draw_size;
+
+  const auto& info = image->imageInfo();
+  const int64_t image_pixels =
+      static_cast<int64_t>(info.width()) * static_cast<int64_t>(info.height());
+  const int64_t draw_pixels = static_cast<int64_t>(draw_size.width()) *
+                              static_cast<int64_t>(draw_size.height());
+
+  size_t oversized_bytes = 0;
+  // Divided rather than multiplied, so that clamped draw sizes can't
+  // overflow.
+  if (image_pixels / kOversizedImagePixelRatio >= draw_pixels) {
+    oversized_bytes = (image_pixels - draw_pixels) * info.bytesPerPixel();
+  }
+
+  if (oversized_bytes == oversized_bytes_) {
+    return;
+  }
+
+  if (oversized_bytes_ == 0) {
+    std::string image_size =
+        std::to_string(info.width()) + "x" + std::to_string(info.height());
+    std::string drawn_size = std::to_string(draw_size.width()) + "x" +
+                             std::to_string(draw_size.height());
+    TRACE_EVENT_INSTANT2("flutter", "OversizedImageDecode", "image_size",
+                         image_size.c_str(), "draw_size", drawn_size.c_str());
+  }
+
+  TraceOversizedImageBytes(static_cast<int64_t>(oversized_bytes) -
+                           static_cast<int64_t>(oversized_bytes_));
+  oversized_bytes_ = oversized_bytes;
+}
+
+void CanvasImage::ResetDrawSizeTracking() {
+  if (oversized_bytes_ > 0) {
+    TraceOversizedImageBytes(-static_cast<int64_t>(oversized_bytes_));
+  }
+  oversized_bytes_ = 0;
+  max_draw_size_ = SkISize::MakeEmpty();
+}
+
 size_t CanvasImage::GetAllocationSize() const {
   if (auto image = image_.get()) {
     const auto& info = image->imageInfo();
@@ -9,6 +9,7 @@
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkSize.h"
 
 namespace tonic {
 class DartLibraryNatives;
@@ -30,23 +31,47 @@ class CanvasImage final : public RefCountedDartWrappable<CanvasImage> {
 
   int height() { return image_.get()->height(); }
 
-  Dart_Handle toByteData(int format, Dart_Handle callback);
+  Dart_Handle toByteData(int format, int quality, Dart_Handle callback);
 
   void dispose();
 
   sk_sp<SkImage> image() const { return image_.get(); }
   void set_image(flutter::SkiaGPUObject<SkImage> image) {
+    ResetDrawSizeTracking();
     image_ = std::move(image);
   }
 
   size_t GetAllocationSize() const override;
 
+  /// Records that this image was drawn into a destination of |device_size|
+  /// physical pixels by a picture being recorded.
+  ///
+  /// When the image is significantly larger than any destination it has been
+  /// drawn into, the decode was oversized. This is reported once per image on
+  /// the timeline, and the total number of bytes that could be saved by
+  /// decoding at the drawn size is tracked in the "OversizedImages" counter.
+  void RecordDrawSize(const SkSize& device_size);
+
+  /// The largest destination, in physical pixels, that this image has been
+  /// drawn into. Empty if the image has not been drawn.
+  SkISize max_draw_size() const { return max_draw_size_; }
+
+  /// The number of bytes that would be saved if this image were decoded at
+  /// |max_draw_size()|. Zero unless the decode is considered oversized.
+  size_t oversized_bytes() const { return oversized_bytes_; }
+
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
  private:
   CanvasImage();
 
+  void ResetDrawSizeTracking();
+
   flutter::SkiaGPUObject<SkImage> image_;
+
+  // Only updated on the UI thread, while pictures are recorded.
+  SkISize max_draw_size_ = SkISize::MakeEmpty();
+  size_t oversized_bytes_ = 0;
 };
 
 }  // namespace flutter
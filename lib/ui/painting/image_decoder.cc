@@ -90,7 +90,8 @@ static sk_sp<SkImage> ImageFromDecompressedData(
   }
 
   if (!target_width && !target_height) {
-    // No resizing requested. Just rasterize the image.
+    // No resizing requested. The image already wraps the buffer's pixels, so
+    // this returns it as is instead of copying them.
     return image->makeRasterImage();
   }
 
@@ -52,6 +52,12 @@ class ImageDecoder {
 
   fml::WeakPtr<ImageDecoder> GetWeakPtr() const;
 
+  // The worker pool on which images are decompressed. Other expensive image
+  // work (such as encoding) may be scheduled on it as well.
+  std::shared_ptr<fml::ConcurrentTaskRunner> GetConcurrentTaskRunner() const {
+    return concurrent_task_runner_;
+  }
+
  private:
   TaskRunners runners_;
   std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
@@ -0,0 +1,354 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <tuple>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/lib/ui/painting/image_decoder.h"
+#include "flutter/shell/common/thread_host.h"
+#include "flutter/testing/test_gl_surface.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/codec/SkCodec.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/encode/SkJpegEncoder.h"
+#include "third_party/skia/include/encode/SkPngEncoder.h"
+#include "third_party/skia/include/encode/SkWebpEncoder.h"
+
+#if OS_POSIX
+#include <sys/resource.h>
+#endif  // OS_POSIX
+
+namespace flutter {
+namespace {
+
+// Images are uploaded through a resource context on SwiftShader's OpenGL ES
+// implementation, the same one the unit tests render with. Without a GPU
+// context the upload is skipped, which is the path the software backend
+// takes.
+class BenchmarkIOManager final : public IOManager {
+ public:
+  BenchmarkIOManager(fml::RefPtr<fml::TaskRunner> task_runner,
+                     bool has_gpu_context)
+      : gl_surface_(SkISize::Make(1, 1)),
+        gl_context_(has_gpu_context ? gl_surface_.CreateGrContext() : nullptr),
+        weak_gl_context_factory_(
+            has_gpu_context
+                ? std::make_unique<fml::WeakPtrFactory<GrDirectContext>>(
+                      gl_context_.get())
+                : nullptr),
+        unref_queue_(fml::MakeRefCounted<SkiaUnrefQueue>(
+            std::move(task_runner),
+            fml::TimeDelta::FromNanoseconds(0))),
+        is_gpu_disabled_sync_switch_(std::make_shared<fml::SyncSwitch>()),
+        weak_factory_(this) {
+    FML_CHECK(!has_gpu_context || gl_context_)
+        << "Could not create a GL context to upload images with.";
+    weak_prototype_ = weak_factory_.GetWeakPtr();
+  }
+
+  ~BenchmarkIOManager() override { unref_queue_->Drain(); }
+
+  // |IOManager|
+  fml::WeakPtr<IOManager> GetWeakIOManager() const override {
+    return weak_prototype_;
+  }
+
+  // |IOManager|
+  fml::WeakPtr<GrDirectContext> GetResourceContext() const override {
+    return weak_gl_context_factory_ ? weak_gl_context_factory_->GetWeakPtr()
+                                    : fml::WeakPtr<GrDirectContext>{};
+  }
+
+  // |IOManager|
+  fml::RefPtr<flutter::SkiaUnrefQueue> GetSkiaUnrefQueue() const override {
+    return unref_queue_;
+  }
+
+  // |IOManager|
+  std::shared_ptr<fml::SyncSwitch> GetIsGpuDisabledSyncSwitch() override {
+    return is_gpu_disabled_sync_switch_;
+  }
+
+ private:
+  testing::TestGLSurface gl_surface_;
+  sk_sp<GrDirectContext> gl_context_;
+  std::unique_ptr<fml::WeakPtrFactory<GrDirectContext>>
+      weak_gl_context_factory_;
+  fml::RefPtr<SkiaUnrefQueue> unref_queue_;
+  std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch_;
+  fml::WeakPtr<BenchmarkIOManager> weak_prototype_;
+  fml::WeakPtrFactory<BenchmarkIOManager> weak_factory_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(BenchmarkIOManager);
+};
+
+enum class Format { kJPEG, kPNG, kWebP };
+
+sk_sp<SkData> OpenFixtureAsSkData(const char* name) {
+  auto mapping = testing::OpenFixtureAsMapping(name);
+  if (!mapping) {
+    return nullptr;
+  }
+  return SkData::MakeWithCopy(mapping->GetMapping(), mapping->GetSize());
+}
+
+// Returns the encoded data of the reference fixture, resized so its longest
+// edge is |size| pixels and encoded as |format|. Results are cached since
+// producing them is not part of the measurement.
+sk_sp<SkData> GetEncodedFixture(Format format, int size) {
+  static std::map<std::tuple<Format, int>, sk_sp<SkData>> cache;
+  auto found = cache.find({format, size});
+  if (found != cache.end()) {
+    return found->second;
+  }
+
+  auto source = SkImage::MakeFromEncoded(
+      OpenFixtureAsSkData("DashInNooglerHat.jpg"));
+  FML_CHECK(source);
+
+  const float scale = static_cast<float>(size) /
+                      std::max(source->width(), source->height());
+  const auto info = SkImageInfo::MakeN32Premul(
+      std::max(1, static_cast<int>(source->width() * scale)),
+      std::max(1, static_cast<int>(source->height() * scale)));
+  SkBitmap bitmap;
+  FML_CHECK(bitmap.tryAllocPixels(info));
+  FML_CHECK(source->scalePixels(
+      bitmap.pixmap(),
+      SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kNone)));
+
+  SkDynamicMemoryWStream stream;
+  switch (format) {
+    case Format::kJPEG:
+      FML_CHECK(SkJpegEncoder::Encode(&stream, bitmap.pixmap(), {}));
+      break;
+    case Format::kPNG:
+      FML_CHECK(SkPngEncoder::Encode(&stream, bitmap.pixmap(), {}));
+      break;
+    case Format::kWebP:
+      FML_CHECK(SkWebpEncoder::Encode(&stream, bitmap.pixmap(), {}));
+      break;
+  }
+
+  auto data = stream.detachAsData();
+  cache[{format, size}] = data;
+  return data;
+}
+
+fml::RefPtr<ImageDescriptor> CreateDescriptor(sk_sp<SkData> data) {
+  auto codec = SkCodec::MakeFromData(data);
+  FML_CHECK(codec);
+  return fml::MakeRefCounted<ImageDescriptor>(std::move(data),
+                                              std::move(codec));
+}
+
+void ReportPeakRSS(benchmark::State& state) {
+#if OS_POSIX
+  struct rusage usage = {};
+  if (::getrusage(RUSAGE_SELF, &usage) == 0) {
+#if OS_MACOSX
+    // Reported in bytes on Darwin, kilobytes elsewhere.
+    const double peak_rss_kb = usage.ru_maxrss / 1024.0;
+#else
+    const double peak_rss_kb = usage.ru_maxrss;
+#endif  // OS_MACOSX
+    state.counters["PeakRSS_KB"] = peak_rss_kb;
+  }
+#endif  // OS_POSIX
+}
+
+void ReportDecodedBytes(benchmark::State& state, const SkImageInfo& info) {
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * info.computeMinByteSize());
+  ReportPeakRSS(state);
+}
+
+}  // namespace
+
+static void BM_ImageDecode(benchmark::State& state, Format format) {
+  auto descriptor = CreateDescriptor(GetEncodedFixture(format, state.range(0)));
+  const auto& info = descriptor->image_info();
+
+  while (state.KeepRunning()) {
+    auto image = ImageFromCompressedData(descriptor.get(), info.width(),
+                                         info.height(),
+                                         fml::tracing::TraceFlow(""));
+    FML_CHECK(image);
+  }
+
+  ReportDecodedBytes(state, info);
+}
+
+static void BM_ImageDecodeScaled(benchmark::State& state, Format format) {
+  auto descriptor = CreateDescriptor(GetEncodedFixture(format, state.range(0)));
+  const auto& info = descriptor->image_info();
+  const auto target = info.makeWH(std::max(1, info.width() / 4),
+                                   std::max(1, info.height() / 4));
+
+  while (state.KeepRunning()) {
+    auto image = ImageFromCompressedData(descriptor.get(), target.width(),
+                                         target.height(),
+                                         fml::tracing::TraceFlow(""));
+    FML_CHECK(image);
+  }
+
+  ReportDecodedBytes(state, target);
+}
+
+static void BM_ImageResize(benchmark::State& state) {
+  auto source = SkImage::MakeFromEncoded(
+      GetEncodedFixture(Format::kPNG, state.range(0)));
+  FML_CHECK(source);
+  source = source->makeRasterImage();
+  const auto target = source->imageInfo().makeWH(
+      std::max(1, source->width() / 3), std::max(1, source->height() / 3));
+
+  while (state.KeepRunning()) {
+    SkBitmap bitmap;
+    FML_CHECK(bitmap.tryAllocPixels(target));
+    FML_CHECK(source->scalePixels(
+        bitmap.pixmap(),
+        SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kNone),
+        SkImage::kDisallow_CachingHint));
+  }
+
+  ReportDecodedBytes(state, target);
+}
+
+// Measures a full |ImageDecoder::Decode| round trip: decompression on a
+// concurrent worker, the upload step on the IO thread and the result
+// delivered on the UI thread. |upload| selects whether the IO manager has a
+// resource context to upload the image into a texture with.
+static void BM_ImageDecodeRoundTrip(benchmark::State& state,
+                                    Format format,
+                                    bool upload) {
+  ThreadHost thread_host("test",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners runners("test", thread_host.platform_thread->GetTaskRunner(),
+                      thread_host.raster_thread->GetTaskRunner(),
+                      thread_host.ui_thread->GetTaskRunner(),
+                      thread_host.io_thread->GetTaskRunner());
+  auto loop = fml::ConcurrentMessageLoop::Create();
+
+  std::unique_ptr<BenchmarkIOManager> io_manager;
+  std::unique_ptr<ImageDecoder> image_decoder;
+  fml::AutoResetWaitableEvent latch;
+  runners.GetIOTaskRunner()->PostTask([&]() {
+    io_manager =
+        std::make_unique<BenchmarkIOManager>(runners.GetIOTaskRunner(), upload);
+    latch.Signal();
+  });
+  latch.Wait();
+  runners.GetUITaskRunner()->PostTask([&]() {
+    image_decoder = std::make_unique<ImageDecoder>(
+        runners, loop->GetTaskRunner(), io_manager->GetWeakIOManager());
+    latch.Signal();
+  });
+  latch.Wait();
+
+  auto descriptor = CreateDescriptor(GetEncodedFixture(format, state.range(0)));
+  const auto& info = descriptor->image_info();
+
+  while (state.KeepRunning()) {
+    runners.GetUITaskRunner()->PostTask([&]() {
+      image_decoder->Decode(descriptor, info.width(), info.height(),
+                            [&](SkiaGPUObject<SkImage> image) {
+                              FML_CHECK(image.get());
+                              latch.Signal();
+                            });
+    });
+    latch.Wait();
+  }
+
+  runners.GetUITaskRunner()->PostTask([&]() {
+    descriptor = nullptr;
+    image_decoder.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+  runners.GetIOTaskRunner()->PostTask([&]() {
+    io_manager.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+
+  ReportDecodedBytes(state, info);
+}
+
+// Steps through every frame of an animated image the same way
+// |MultiFrameCodec| does, reusing the previous frame when the codec requires
+// it.
+static void BM_MultiFrameCodecStepping(benchmark::State& state,
+                                       const char* fixture) {
+  auto data = OpenFixtureAsSkData(fixture);
+  FML_CHECK(data);
+  auto codec = SkCodec::MakeFromData(data);
+  FML_CHECK(codec);
+  const auto info = codec->getInfo().makeColorType(kN32_SkColorType);
+  const auto frame_infos = codec->getFrameInfo();
+  FML_CHECK(!frame_infos.empty());
+
+  while (state.KeepRunning()) {
+    SkBitmap last_required_frame;
+    for (size_t index = 0; index < frame_infos.size(); index++) {
+      SkBitmap bitmap;
+      FML_CHECK(bitmap.tryAllocPixels(info));
+      SkCodec::Options options;
+      options.fFrameIndex = index;
+      const int required_frame = frame_infos[index].fRequiredFrame;
+      if (required_frame != SkCodec::kNoFrame && !last_required_frame.isNull()) {
+        FML_CHECK(last_required_frame.readPixels(bitmap.pixmap()));
+        options.fPriorFrame = required_frame;
+      }
+      codec->getPixels(info, bitmap.getPixels(), bitmap.rowBytes(), &options);
+      last_required_frame = bitmap;
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * frame_infos.size());
+  state.SetBytesProcessed(state.iterations() * frame_infos.size() *
+                          info.computeMinByteSize());
+  ReportPeakRSS(state);
+}
+
+#define IMAGE_SIZE_RANGE Arg(64)->Arg(256)->Arg(1024)->Arg(2048)
+
+BENCHMARK_CAPTURE(BM_ImageDecode, JPEG, Format::kJPEG)
+    ->IMAGE_SIZE_RANGE->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ImageDecode, PNG, Format::kPNG)
+    ->IMAGE_SIZE_RANGE->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ImageDecode, WebP, Format::kWebP)
+    ->IMAGE_SIZE_RANGE->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_ImageDecodeScaled, JPEG, Format::kJPEG)
+    ->IMAGE_SIZE_RANGE->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ImageDecodeScaled, PNG, Format::kPNG)
+    ->IMAGE_SIZE_RANGE->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ImageDecodeScaled, WebP, Format::kWebP)
+    ->IMAGE_SIZE_RANGE->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_ImageResize)->IMAGE_SIZE_RANGE->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_ImageDecodeRoundTrip, JPEGUpload, Format::kJPEG, true)
+    ->IMAGE_SIZE_RANGE->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ImageDecodeRoundTrip, PNGUpload, Format::kPNG, true)
+    ->IMAGE_SIZE_RANGE->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ImageDecodeRoundTrip, JPEGSoftware, Format::kJPEG, false)
+    ->IMAGE_SIZE_RANGE->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_MultiFrameCodecStepping, GIF, "hello_loop_2.gif")
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_MultiFrameCodecStepping, WebP, "hello_loop_2.webp")
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/painting/image_encoding.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -16,7 +17,11 @@
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkEncodedImageFormat.h"
 #include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkStream.h"
 #include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/encode/SkJpegEncoder.h"
+#include "third_party/skia/include/encode/SkPngEncoder.h"
+#include "third_party/skia/include/encode/SkWebpEncoder.h"
 #include "third_party/tonic/dart_persistent_value.h"
 #include "third_party/tonic/logging/dart_invoke.h"
 #include "third_party/tonic/typed_data/typed_list.h"
@@ -33,8 +38,17 @@ enum ImageByteFormat {
   kRawRGBA,
   kRawUnmodified,
   kPNG,
+  kJPEG,
+  kWebP,
 };
 
+// The quality used for lossy formats when the caller does not specify one.
+constexpr int kDefaultLossyQuality = 80;
+
+// Sentinel for "no quality was specified". See |Image.toByteData| in
+// painting.dart.
+constexpr int kUnspecifiedQuality = -1;
+
 void FinalizeSkData(void* isolate_callback_data, void* peer) {
   SkData* buffer = reinterpret_cast<SkData*>(peer);
   buffer->unref();
@@ -186,23 +200,77 @@ sk_sp<SkData> CopyImageByteData(sk_sp<SkImage> raster_image,
   return SkData::MakeWithCopy(pixmap.addr(), pixmap.computeByteSize());
 }
 
-sk_sp<SkData> EncodeImage(sk_sp<SkImage> raster_image, ImageByteFormat format) {
-  TRACE_EVENT0("flutter", __FUNCTION__);
+sk_sp<SkData> EncodeImageWithSkiaEncoder(sk_sp<SkImage> raster_image,
+                                         ImageByteFormat format,
+                                         int quality) {
+  FML_DCHECK(raster_image);
 
-  if (!raster_image) {
+  SkPixmap pixmap;
+  if (!raster_image->peekPixels(&pixmap)) {
+    FML_LOG(ERROR) << "Could not read the pixels of the raster image.";
     return nullptr;
   }
 
+  SkDynamicMemoryWStream stream;
+  bool encoded = false;
   switch (format) {
     case kPNG: {
-      auto png_image =
-          raster_image->encodeToData(SkEncodedImageFormat::kPNG, 0);
+      TRACE_EVENT0("flutter", "EncodePNG");
+      SkPngEncoder::Options options;
+      if (quality != kUnspecifiedQuality) {
+        options.fZLibLevel = std::clamp(quality, 0, 9);
+      }
+      encoded = SkPngEncoder::Encode(&stream, pixmap, options);
+    } break;
+    case kJPEG: {
+      TRACE_EVENT0("flutter", "EncodeJPEG");
+      SkJpegEncoder::Options options;
+      options.fQuality = quality == kUnspecifiedQuality
+                             ? kDefaultLossyQuality
+                             : std::clamp(quality, 0, 100);
+      encoded = SkJpegEncoder::Encode(&stream, pixmap, options);
+    } break;
+    case kWebP: {
+      TRACE_EVENT0("flutter", "EncodeWebP");
+      SkWebpEncoder::Options options;
+      options.fQuality = quality == kUnspecifiedQuality
+                             ? kDefaultLossyQuality
+                             : std::clamp(quality, 0, 100);
+      encoded = SkWebpEncoder::Encode(&stream, pixmap, options);
+    } break;
+    default:
+      FML_DCHECK(false);
+      break;
+  }
 
-      if (png_image == nullptr) {
-        FML_LOG(ERROR) << "Could not convert raster image to PNG.";
+  if (!encoded) {
+    return nullptr;
+  }
+  return stream.detachAsData();
+}
+
+sk_sp<SkData> EncodeImage(sk_sp<SkImage> raster_image,
+                          ImageByteFormat format,
+                          int quality) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+
+  if (!raster_image) {
+    return nullptr;
+  }
+
+  switch (format) {
+    case kPNG:
+    case kJPEG:
+    case kWebP: {
+      auto encoded_image =
+          EncodeImageWithSkiaEncoder(raster_image, format, quality);
+
+      if (encoded_image == nullptr) {
+        FML_LOG(ERROR) << "Could not encode raster image to format " << format
+                       << ".";
         return nullptr;
       };
-      return png_image;
+      return encoded_image;
     } break;
     case kRawRGBA: {
       return CopyImageByteData(raster_image, kRGBA_8888_SkColorType);
@@ -220,7 +288,9 @@ void EncodeImageAndInvokeDataCallback(
     sk_sp<SkImage> image,
     std::unique_ptr<DartPersistentValue> callback,
     ImageByteFormat format,
+    int quality,
     fml::RefPtr<fml::TaskRunner> ui_task_runner,
+    std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
     fml::RefPtr<fml::TaskRunner> raster_task_runner,
     fml::RefPtr<fml::TaskRunner> io_task_runner,
     GrDirectContext* resource_context,
@@ -231,12 +301,26 @@ void EncodeImageAndInvokeDataCallback(
       });
 
   auto encode_task = [callback_task = std::move(callback_task), format,
-                      ui_task_runner](sk_sp<SkImage> raster_image) {
-    sk_sp<SkData> encoded = EncodeImage(std::move(raster_image), format);
-    ui_task_runner->PostTask([callback_task = std::move(callback_task),
-                              encoded = std::move(encoded)]() mutable {
-      callback_task(std::move(encoded));
-    });
+                      quality, ui_task_runner,
+                      concurrent_task_runner](sk_sp<SkImage> raster_image) {
+    auto encode_and_respond = [callback_task, format, quality, ui_task_runner,
+                               raster_image = std::move(raster_image)]() {
+      sk_sp<SkData> encoded = EncodeImage(raster_image, format, quality);
+      ui_task_runner->PostTask([callback_task = std::move(callback_task),
+                                encoded = std::move(encoded)]() mutable {
+        callback_task(std::move(encoded));
+      });
+    };
+
+    // Encoding a large image can take hundreds of milliseconds. Keep it off
+    // the IO thread (which also services texture uploads) if a concurrent
+    // worker pool is available. Raster images are immutable and may be read
+    // from any thread.
+    if (concurrent_task_runner) {
+      concurrent_task_runner->PostTask(std::move(encode_and_respond));
+    } else {
+      encode_and_respond();
+    }
   };
 
   ConvertImageToRaster(std::move(image), encode_task, raster_task_runner,
@@ -247,6 +331,7 @@ void EncodeImageAndInvokeDataCallback(
 
 Dart_Handle EncodeImage(CanvasImage* canvas_image,
                         int format,
+                        int quality,
                         Dart_Handle callback_handle) {
   if (!canvas_image) {
     return ToDart("encode called with non-genuine Image.");
@@ -263,17 +348,24 @@ Dart_Handle EncodeImage(CanvasImage* canvas_image,
 
   const auto& task_runners = UIDartState::Current()->GetTaskRunners();
 
+  std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner;
+  if (auto image_decoder = UIDartState::Current()->GetImageDecoder()) {
+    concurrent_task_runner = image_decoder->GetConcurrentTaskRunner();
+  }
+
   task_runners.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
       [callback = std::move(callback), image = canvas_image->image(),
-       image_format, ui_task_runner = task_runners.GetUITaskRunner(),
+       image_format, quality, ui_task_runner = task_runners.GetUITaskRunner(),
+       concurrent_task_runner = std::move(concurrent_task_runner),
        raster_task_runner = task_runners.GetRasterTaskRunner(),
        io_task_runner = task_runners.GetIOTaskRunner(),
        io_manager = UIDartState::Current()->GetIOManager(),
        snapshot_delegate =
            UIDartState::Current()->GetSnapshotDelegate()]() mutable {
         EncodeImageAndInvokeDataCallback(
-            std::move(image), std::move(callback), image_format,
-            std::move(ui_task_runner), std::move(raster_task_runner),
+            std::move(image), std::move(callback), image_format, quality,
+            std::move(ui_task_runner), std::move(concurrent_task_runner),
+            std::move(raster_task_runner),
             std::move(io_task_runner), io_manager->GetResourceContext().get(),
             std::move(snapshot_delegate));
       }));
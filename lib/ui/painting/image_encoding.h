@@ -11,8 +11,13 @@ namespace flutter {
 
 class CanvasImage;
 
+// Encodes the image into the |ImageByteFormat| given by |format| and invokes
+// the Dart callback with the bytes on the UI thread. Compression happens on the
+// concurrent worker pool. |quality| is -1 for the format's default, 0-100 for
+// lossy formats and the zlib level (0-9) for PNG.
 Dart_Handle EncodeImage(CanvasImage* canvas_image,
                         int format,
+                        int quality,
                         Dart_Handle callback_handle);
 
 }  // namespace flutter
@@ -38,7 +38,7 @@ TEST_F(ShellTest, EncodeImageGivesExternalTypedData) {
     result = Dart_IntegerToInt64(format_handle, &format);
     ASSERT_FALSE(Dart_IsError(result));
 
-    result = EncodeImage(canvas_image, format, callback_handle);
+    result = EncodeImage(canvas_image, format, -1, callback_handle);
     ASSERT_TRUE(Dart_IsNull(result));
   };
 
@@ -5,6 +5,7 @@
 #include "flutter/lib/ui/painting/image_filter.h"
 
 #include "flutter/lib/ui/painting/matrix.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
 #include "third_party/skia/include/effects/SkImageFilters.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
@@ -49,6 +50,14 @@ void ImageFilter::initImage(CanvasImage* image) {
 }
 
 void ImageFilter::initPicture(Picture* picture) {
+  if (auto display_list = picture->display_list()) {
+    // Skia filters can only draw SkPictures, so the display list is played
+    // back into one.
+    SkPictureRecorder recorder;
+    display_list->RenderTo(recorder.beginRecording(display_list->bounds()));
+    filter_ = SkImageFilters::Picture(recorder.finishRecordingAsPicture());
+    return;
+  }
   filter_ = SkImageFilters::Picture(picture->picture());
 }
 
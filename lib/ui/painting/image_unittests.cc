@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image.h"
+
+#include <limits>
+
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+
+namespace flutter {
+namespace testing {
+
+static fml::RefPtr<CanvasImage> MakeImage(sk_sp<SkImage> sk_image) {
+  auto image = CanvasImage::Create();
+  image->set_image({std::move(sk_image), nullptr});
+  return image;
+}
+
+TEST(CanvasImageTest, ReportsImagesDrawnMuchSmallerThanDecoded) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(100, 100);
+  bitmap.setImmutable();
+  auto image = MakeImage(SkImage::MakeFromBitmap(bitmap));
+
+  image->RecordDrawSize(SkSize::Make(19.5, 20));
+  EXPECT_EQ(image->max_draw_size(), SkISize::Make(20, 20));
+  EXPECT_EQ(image->oversized_bytes(), (100u * 100u - 20u * 20u) * 4u);
+
+  // Only the largest destination counts, so drawing it smaller again does not
+  // change anything.
+  image->RecordDrawSize(SkSize::Make(10, 10));
+  EXPECT_EQ(image->max_draw_size(), SkISize::Make(20, 20));
+
+  // An image that is less than four times too large is not reported.
+  image->RecordDrawSize(SkSize::Make(60, 60));
+  EXPECT_EQ(image->max_draw_size(), SkISize::Make(60, 60));
+  EXPECT_EQ(image->oversized_bytes(), 0u);
+}
+
+TEST(CanvasImageTest, ReportsImagesWithMoreThanTwoGigapixels) {
+  // A lazy picture image, so that the pixels are never allocated.
+  SkPictureRecorder recorder;
+  recorder.beginRecording(SkRect::MakeWH(1, 1));
+  auto image = MakeImage(SkImage::MakeFromPicture(
+      recorder.finishRecordingAsPicture(), SkISize::Make(50000, 50000),
+      nullptr, nullptr, SkImage::BitDepth::kU8, SkColorSpace::MakeSRGB()));
+
+  image->RecordDrawSize(SkSize::Make(100, 100));
+  const uint64_t image_pixels = 50000ull * 50000ull;
+  EXPECT_EQ(image->oversized_bytes(), (image_pixels - 100u * 100u) * 4u);
+}
+
+TEST(CanvasImageTest, IgnoresNaNAndClampsHugeDrawSizes) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(100, 100);
+  bitmap.setImmutable();
+  auto image = MakeImage(SkImage::MakeFromBitmap(bitmap));
+
+  const SkScalar nan = std::numeric_limits<SkScalar>::quiet_NaN();
+  image->RecordDrawSize(SkSize::Make(nan, 10));
+  image->RecordDrawSize(SkSize::Make(10, nan));
+  EXPECT_TRUE(image->max_draw_size().isEmpty());
+
+  const SkScalar infinity = std::numeric_limits<SkScalar>::infinity();
+  image->RecordDrawSize(SkSize::Make(infinity, 1e20f));
+  EXPECT_EQ(image->max_draw_size(),
+            SkISize::Make(std::numeric_limits<int32_t>::max(),
+                          std::numeric_limits<int32_t>::max()));
+  EXPECT_EQ(image->oversized_bytes(), 0u);
+}
+
+TEST(CanvasImageTest, SettingAnotherImageResetsTheDrawSize) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(100, 100);
+  bitmap.setImmutable();
+  auto image = MakeImage(SkImage::MakeFromBitmap(bitmap));
+  image->RecordDrawSize(SkSize::Make(10, 10));
+  ASSERT_GT(image->oversized_bytes(), 0u);
+
+  image->set_image({SkImage::MakeFromBitmap(bitmap), nullptr});
+  EXPECT_TRUE(image->max_draw_size().isEmpty());
+  EXPECT_EQ(image->oversized_bytes(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
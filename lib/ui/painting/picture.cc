@@ -37,14 +37,30 @@ fml::RefPtr<Picture> Picture::Create(
   return canvas_picture;
 }
 
+fml::RefPtr<Picture> Picture::Create(
+    Dart_Handle dart_handle,
+    flutter::SkiaGPUObject<DisplayList> display_list) {
+  auto canvas_picture = fml::MakeRefCounted<Picture>(std::move(display_list));
+
+  canvas_picture->AssociateWithDartWrapper(dart_handle);
+  return canvas_picture;
+}
+
 Picture::Picture(flutter::SkiaGPUObject<SkPicture> picture)
     : picture_(std::move(picture)) {}
 
+Picture::Picture(flutter::SkiaGPUObject<DisplayList> display_list)
+    : display_list_(std::move(display_list)) {}
+
 Picture::~Picture() = default;
 
 Dart_Handle Picture::toImage(uint32_t width,
                              uint32_t height,
                              Dart_Handle raw_image_callback) {
+  if (auto display_list = display_list_.get()) {
+    return RasterizeToImage(display_list, width, height, raw_image_callback);
+  }
+
   if (!picture_.get()) {
     return tonic::ToDart("Picture is null");
   }
@@ -54,12 +70,15 @@ Dart_Handle Picture::toImage(uint32_t width,
 
 void Picture::dispose() {
   picture_.reset();
+  display_list_.reset();
   ClearDartWrapper();
 }
 
 size_t Picture::GetAllocationSize() const {
   if (auto picture = picture_.get()) {
     return picture->approximateBytesUsed() + sizeof(Picture);
+  } else if (auto display_list = display_list_.get()) {
+    return display_list->bytes() + sizeof(Picture);
   } else {
     return sizeof(Picture);
   }
@@ -69,6 +88,29 @@ Dart_Handle Picture::RasterizeToImage(sk_sp<SkPicture> picture,
                                       uint32_t width,
                                       uint32_t height,
                                       Dart_Handle raw_image_callback) {
+  return RasterizeToImage(
+      [picture](SnapshotDelegate* snapshot_delegate, SkISize size) {
+        return snapshot_delegate->MakeRasterSnapshot(picture, size);
+      },
+      width, height, raw_image_callback);
+}
+
+Dart_Handle Picture::RasterizeToImage(sk_sp<DisplayList> display_list,
+                                      uint32_t width,
+                                      uint32_t height,
+                                      Dart_Handle raw_image_callback) {
+  return RasterizeToImage(
+      [display_list](SnapshotDelegate* snapshot_delegate, SkISize size) {
+        return snapshot_delegate->MakeRasterSnapshot(display_list, size);
+      },
+      width, height, raw_image_callback);
+}
+
+Dart_Handle Picture::RasterizeToImage(
+    std::function<sk_sp<SkImage>(SnapshotDelegate*, SkISize)> snapshot,
+    uint32_t width,
+    uint32_t height,
+    Dart_Handle raw_image_callback) {
   if (Dart_IsNull(raw_image_callback) || !Dart_IsClosure(raw_image_callback)) {
     return tonic::ToDart("Image callback was invalid");
   }
@@ -122,9 +164,9 @@ Dart_Handle Picture::RasterizeToImage(sk_sp<SkPicture> picture,
   // Kick things off on the raster rask runner.
   fml::TaskRunner::RunNowOrPostTask(
       raster_task_runner,
-      [ui_task_runner, snapshot_delegate, picture, picture_bounds, ui_task] {
+      [ui_task_runner, snapshot_delegate, snapshot, picture_bounds, ui_task] {
         sk_sp<SkImage> raster_image =
-            snapshot_delegate->MakeRasterSnapshot(picture, picture_bounds);
+            snapshot(snapshot_delegate.get(), picture_bounds);
 
         fml::TaskRunner::RunNowOrPostTask(
             ui_task_runner,
@@ -5,9 +5,13 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_PICTURE_H_
 #define FLUTTER_LIB_UI_PAINTING_PICTURE_H_
 
+#include <functional>
+
+#include "flutter/flow/display_list.h"
 #include "flutter/flow/skia_gpu_object.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/image.h"
+#include "flutter/lib/ui/snapshot_delegate.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/skia/include/core/SkPicture.h"
 
@@ -27,8 +31,16 @@ class Picture : public RefCountedDartWrappable<Picture> {
   static fml::RefPtr<Picture> Create(Dart_Handle dart_handle,
                                      flutter::SkiaGPUObject<SkPicture> picture);
 
+  static fml::RefPtr<Picture> Create(
+      Dart_Handle dart_handle,
+      flutter::SkiaGPUObject<DisplayList> display_list);
+
   sk_sp<SkPicture> picture() const { return picture_.get(); }
 
+  // Set instead of the picture when the picture was recorded into a display
+  // list.
+  sk_sp<DisplayList> display_list() const { return display_list_.get(); }
+
   Dart_Handle toImage(uint32_t width,
                       uint32_t height,
                       Dart_Handle raw_image_callback);
@@ -44,10 +56,23 @@ class Picture : public RefCountedDartWrappable<Picture> {
                                       uint32_t height,
                                       Dart_Handle raw_image_callback);
 
+  static Dart_Handle RasterizeToImage(sk_sp<DisplayList> display_list,
+                                      uint32_t width,
+                                      uint32_t height,
+                                      Dart_Handle raw_image_callback);
+
  private:
   Picture(flutter::SkiaGPUObject<SkPicture> picture);
+  Picture(flutter::SkiaGPUObject<DisplayList> display_list);
 
   flutter::SkiaGPUObject<SkPicture> picture_;
+  flutter::SkiaGPUObject<DisplayList> display_list_;
+
+  static Dart_Handle RasterizeToImage(
+      std::function<sk_sp<SkImage>(SnapshotDelegate*, SkISize)> snapshot,
+      uint32_t width,
+      uint32_t height,
+      Dart_Handle raw_image_callback);
 };
 
 }  // namespace flutter
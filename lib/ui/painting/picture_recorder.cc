@@ -39,6 +39,10 @@ PictureRecorder::PictureRecorder() {}
 PictureRecorder::~PictureRecorder() {}
 
 SkCanvas* PictureRecorder::BeginRecording(SkRect bounds) {
+  if (UIDartState::Current()->enable_display_list()) {
+    display_list_recorder_ = sk_make_sp<DisplayListCanvasRecorder>(bounds);
+    return display_list_recorder_.get();
+  }
   return picture_recorder_.beginRecording(bounds, &rtree_factory_);
 }
 
@@ -47,9 +51,17 @@ fml::RefPtr<Picture> PictureRecorder::endRecording(Dart_Handle dart_picture) {
     return nullptr;
   }
 
-  fml::RefPtr<Picture> picture = Picture::Create(
-      dart_picture, UIDartState::CreateGPUObject(
-                        picture_recorder_.finishRecordingAsPicture()));
+  fml::RefPtr<Picture> picture;
+  if (display_list_recorder_) {
+    picture = Picture::Create(
+        dart_picture,
+        UIDartState::CreateGPUObject(display_list_recorder_->Build()));
+    display_list_recorder_ = nullptr;
+  } else {
+    picture = Picture::Create(
+        dart_picture, UIDartState::CreateGPUObject(
+                          picture_recorder_.finishRecordingAsPicture()));
+  }
 
   canvas_->Invalidate();
   canvas_ = nullptr;
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_PICTURE_RECORDER_H_
 #define FLUTTER_LIB_UI_PAINTING_PICTURE_RECORDER_H_
 
+#include "flutter/flow/display_list_canvas.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
 
@@ -30,6 +31,11 @@ class PictureRecorder : public RefCountedDartWrappable<PictureRecorder> {
 
   void set_canvas(fml::RefPtr<Canvas> canvas) { canvas_ = std::move(canvas); }
 
+  // Set while recording into a display list.
+  sk_sp<DisplayListCanvasRecorder> display_list_recorder() const {
+    return display_list_recorder_;
+  }
+
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
  private:
@@ -37,6 +43,7 @@ class PictureRecorder : public RefCountedDartWrappable<PictureRecorder> {
 
   SkRTreeFactory rtree_factory_;
   SkPictureRecorder picture_recorder_;
+  sk_sp<DisplayListCanvasRecorder> display_list_recorder_;
   fml::RefPtr<Canvas> canvas_;
 };
 
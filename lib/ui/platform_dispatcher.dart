@@ -533,6 +533,16 @@ class PlatformDispatcher {
     }
   }
 
+  /// Delivers a batch of messages received on a channel for which the
+  /// embedder enabled batching, in the order in which they were sent.
+  ///
+  /// Batched messages never expect a response.
+  void _dispatchPlatformMessageBatch(String name, List<ByteData?> messages) {
+    for (final ByteData? data in messages) {
+      _dispatchPlatformMessage(name, data, 0);
+    }
+  }
+
   /// Set the debug name associated with this platform dispatcher's root
   /// isolate.
   ///
@@ -0,0 +1,128 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// @dart = 2.12
+part of dart.ui;
+
+/// Signature for the callback passed to [RingBufferReader.read].
+///
+/// The `data` view refers directly to the ring buffer's memory, and is only
+/// valid until the callback returns. Copy any bytes that are needed later.
+typedef RingBufferDataCallback = void Function(Uint8List data);
+
+/// Reads a stream of bytes written by the embedder into a ring buffer, without
+/// copying them into the Dart heap.
+///
+/// Embedders create ring buffers with `FlutterEngineCreateRingBuffer` and
+/// write to them from any thread using `FlutterEngineRingBufferWrite`. The
+/// buffer's identifier is passed to Dart code by some other means, such as a
+/// platform message, and the buffer is then opened with [open].
+///
+/// Rather than sending a message for every write, the embedder wakes the
+/// reader only when it is not already due to be woken, so [onData] is called
+/// at most once for each time the reader drains the buffer with [read],
+/// however many writes happened in between. This makes ring buffers suitable
+/// for sustained, high bandwidth streams, such as audio or sensor data, that
+/// would otherwise flood the platform thread with platform messages.
+///
+/// A ring buffer has a single reader. Opening a buffer that is already open
+/// closes the existing reader.
+class RingBufferReader {
+  RingBufferReader._(this.identifier, this._storage, this._port, this._readOffset);
+
+  /// Opens the ring buffer with the given identifier.
+  ///
+  /// The `onData` callback is invoked when data has been written to the
+  /// buffer, and should call [read] to consume it.
+  ///
+  /// Only ring buffers created with the engine running this isolate can be
+  /// opened. Returns null if that engine has no ring buffer with the given
+  /// identifier.
+  static RingBufferReader? open(int identifier, void Function(RingBufferReader reader) onData) {
+    assert(identifier != null, "'identifier' cannot be null.");
+    assert(onData != null, "'onData' cannot be null.");
+    final RawReceivePort port = RawReceivePort();
+    final Uint8List? storage = _open(identifier, port.sendPort);
+    if (storage == null) {
+      port.close();
+      return null;
+    }
+    final RingBufferReader reader = RingBufferReader._(identifier, storage, port, _getReadOffset(identifier));
+    port.handler = (dynamic message) {
+      if (!reader._closed) {
+        onData(reader);
+      }
+    };
+    return reader;
+  }
+
+  /// The identifier the embedder assigned to the ring buffer.
+  final int identifier;
+
+  final Uint8List _storage;
+  final RawReceivePort _port;
+  int _readOffset;
+  bool _closed = false;
+
+  /// The size of the ring buffer in bytes.
+  int get capacity => _storage.length;
+
+  /// Whether the reader has been closed, either by calling [close], by the
+  /// buffer having been opened again, or by the embedder having collected it.
+  bool get isClosed => _closed;
+
+  /// Passes all the data written since the last call to `callback`, and then
+  /// hands the space it occupied back to the embedder.
+  ///
+  /// The data is passed as one view, or two if it wraps around the end of the
+  /// buffer.
+  ///
+  /// Returns the number of bytes read.
+  int read(RingBufferDataCallback callback) {
+    if (_closed) {
+      return 0;
+    }
+    final int writeOffset = _acquire(identifier, _port.sendPort);
+    if (writeOffset < 0) {
+      close();
+      return 0;
+    }
+    final int length = writeOffset - _readOffset;
+    if (length == 0) {
+      return 0;
+    }
+    final int start = _readOffset & (capacity - 1);
+    final int head = math.min(length, capacity - start);
+    callback(Uint8List.sublistView(_storage, start, start + head));
+    if (head < length) {
+      callback(Uint8List.sublistView(_storage, 0, length - head));
+    }
+    _readOffset = writeOffset;
+    _release(identifier, _port.sendPort, writeOffset);
+    return length;
+  }
+
+  /// Stops receiving notifications for the ring buffer.
+  ///
+  /// The buffer remains registered and may be opened again.
+  void close() {
+    if (_closed) {
+      return;
+    }
+    _closed = true;
+    _close(identifier, _port.sendPort);
+    _port.close();
+  }
+
+  static Uint8List? _open(int identifier, SendPort port)
+      native 'RingBufferNatives_Open';
+  static int _getReadOffset(int identifier)
+      native 'RingBufferNatives_ReadOffset';
+  static int _acquire(int identifier, SendPort port)
+      native 'RingBufferNatives_Acquire';
+  static void _release(int identifier, SendPort port, int readOffset)
+      native 'RingBufferNatives_Release';
+  static void _close(int identifier, SendPort port)
+      native 'RingBufferNatives_Close';
+}
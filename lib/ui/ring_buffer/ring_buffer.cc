@@ -0,0 +1,142 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/ring_buffer/ring_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "flutter/fml/logging.h"
+#include "third_party/dart/runtime/include/dart_native_api.h"
+
+namespace flutter {
+
+namespace {
+
+// Returns the smallest power of two that is at least |value|, which must not
+// be larger than the largest power of two a size_t can hold.
+size_t RoundUpToPowerOfTwo(size_t value) {
+  constexpr size_t kLargestPowerOfTwo =
+      (std::numeric_limits<size_t>::max() >> 1) + 1;
+  FML_CHECK(value <= kLargestPowerOfTwo);
+  size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+}  // namespace
+
+RingBuffer::RingBuffer(size_t capacity)
+    : capacity_(RoundUpToPowerOfTwo(capacity)),
+      data_(new uint8_t[capacity_]) {
+  FML_DCHECK(capacity <= kMaxCapacity);
+}
+
+RingBuffer::~RingBuffer() = default;
+
+size_t RingBuffer::Write(const uint8_t* data, size_t size) {
+  // Only the producer stores the write offset, so it may load it relaxed.
+  const uint64_t write_offset = write_offset_.load(std::memory_order_relaxed);
+  const uint64_t read_offset = read_offset_.load(std::memory_order_acquire);
+  size = std::min<size_t>(size, capacity_ - (write_offset - read_offset));
+  if (size == 0) {
+    return 0;
+  }
+
+  const size_t start = write_offset & (capacity_ - 1);
+  const size_t head = std::min(size, capacity_ - start);
+  memcpy(data_.get() + start, data, head);
+  memcpy(data_.get(), data + head, size - head);
+
+  // Sequentially consistent, so that either this write is seen by the
+  // consumer's next |Acquire| or the wakeup it clears there is seen here.
+  write_offset_.store(write_offset + size);
+  Wake();
+  return size;
+}
+
+void RingBuffer::Wake() {
+  const Dart_Port port = port_.load();
+  if (port == ILLEGAL_PORT || wakeup_pending_.exchange(true)) {
+    return;
+  }
+  // The message carries no data; the consumer reads whatever is available
+  // once it runs.
+  Dart_PostInteger(port, 0);
+}
+
+void RingBuffer::Attach(Dart_Port port) {
+  port_.store(port);
+  // A wakeup left pending for a previous consumer would never be cleared.
+  wakeup_pending_.store(false);
+  if (write_offset_.load() != read_offset_.load()) {
+    Wake();
+  }
+}
+
+void RingBuffer::Detach(Dart_Port port) {
+  port_.compare_exchange_strong(port, ILLEGAL_PORT);
+}
+
+uint64_t RingBuffer::Acquire() {
+  wakeup_pending_.store(false);
+  return write_offset_.load();
+}
+
+void RingBuffer::Release(uint64_t read_offset) {
+  FML_DCHECK(read_offset <= write_offset_.load(std::memory_order_relaxed));
+  read_offset_.store(read_offset, std::memory_order_release);
+}
+
+RingBufferRegistry& RingBufferRegistry::GetInstance() {
+  static RingBufferRegistry* instance = new RingBufferRegistry();
+  return *instance;
+}
+
+RingBufferRegistry::RingBufferRegistry() = default;
+
+int64_t RingBufferRegistry::Register(fml::TaskQueueId owner,
+                                     std::shared_ptr<RingBuffer> ring_buffer) {
+  std::scoped_lock lock(mutex_);
+  const int64_t identifier = next_identifier_++;
+  ring_buffers_.emplace(identifier, Entry{owner, std::move(ring_buffer)});
+  return identifier;
+}
+
+bool RingBufferRegistry::Unregister(fml::TaskQueueId owner,
+                                    int64_t identifier) {
+  std::scoped_lock lock(mutex_);
+  auto found = Find(owner, identifier);
+  if (found == ring_buffers_.end()) {
+    return false;
+  }
+  ring_buffers_.erase(found);
+  return true;
+}
+
+std::shared_ptr<RingBuffer> RingBufferRegistry::Lookup(
+    fml::TaskQueueId owner,
+    int64_t identifier) const {
+  std::scoped_lock lock(mutex_);
+  auto found = Find(owner, identifier);
+  if (found == ring_buffers_.end()) {
+    return nullptr;
+  }
+  return found->second.ring_buffer;
+}
+
+std::map<int64_t, RingBufferRegistry::Entry>::const_iterator
+RingBufferRegistry::Find(fml::TaskQueueId owner, int64_t identifier) const {
+  auto found = ring_buffers_.find(identifier);
+  if (found == ring_buffers_.end() ||
+      static_cast<int>(found->second.owner) != static_cast<int>(owner)) {
+    return ring_buffers_.end();
+  }
+  return found;
+}
+
+}  // namespace flutter
@@ -0,0 +1,170 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_RING_BUFFER_RING_BUFFER_H_
+#define FLUTTER_LIB_UI_RING_BUFFER_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/message_loop_task_queues.h"
+#include "third_party/dart/runtime/include/dart_api.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A single-producer, single-consumer byte ring buffer used to stream data
+/// from native code into a Dart isolate.
+///
+/// The producer appends bytes with |Write| from any one thread at a time. The
+/// consumer is a Dart isolate that reads the buffer's storage in place, via an
+/// external typed data view, between |Acquire| and |Release|. Neither side
+/// takes a lock.
+///
+/// Rather than posting a message for every write, the producer wakes the
+/// consumer's port only if it isn't already due to be woken. The pending
+/// wakeup is cleared by |Acquire|, so bursts of writes made while the consumer
+/// is busy are coalesced into a single message.
+///
+class RingBuffer {
+ public:
+  /// The largest capacity a ring buffer can be created with.
+  static constexpr size_t kMaxCapacity = size_t{1} << 30;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a ring buffer with room for at least |capacity|
+  ///             bytes, which must not exceed |kMaxCapacity|. The capacity is
+  ///             rounded up to a power of two.
+  ///
+  explicit RingBuffer(size_t capacity);
+
+  ~RingBuffer();
+
+  size_t capacity() const { return capacity_; }
+
+  uint8_t* data() const { return data_.get(); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Appends up to |size| bytes of |data| to the buffer and wakes
+  ///             the consumer if required. Must only be called by the
+  ///             producer.
+  ///
+  /// @return     The number of bytes written, which is less than |size| if
+  ///             the buffer is full.
+  ///
+  size_t Write(const uint8_t* data, size_t size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Makes |port| the consumer's port, replacing any previously
+  ///             attached one so that a buffer left open by an isolate that
+  ///             has since gone away can be opened again. A wakeup is posted
+  ///             right away if there is data waiting to be read.
+  ///
+  void Attach(Dart_Port port);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Detaches |port| if it is still the consumer's port.
+  ///
+  void Detach(Dart_Port port);
+
+  bool IsAttached(Dart_Port port) const { return port_.load() == port; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Clears the pending wakeup and returns the offset, counted in
+  ///             bytes since the buffer was created, up to which data may be
+  ///             read. Must only be called by the consumer.
+  ///
+  uint64_t Acquire();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Hands the bytes before |read_offset| back to the producer.
+  ///             Must only be called by the consumer.
+  ///
+  void Release(uint64_t read_offset);
+
+  uint64_t read_offset() const {
+    return read_offset_.load(std::memory_order_acquire);
+  }
+
+ private:
+  const size_t capacity_;
+  std::unique_ptr<uint8_t[]> data_;
+
+  // Both offsets only ever increase. Each is stored by one side and loaded by
+  // the other.
+  std::atomic<uint64_t> write_offset_ = 0;
+  std::atomic<uint64_t> read_offset_ = 0;
+
+  std::atomic<Dart_Port> port_ = ILLEGAL_PORT;
+  std::atomic<bool> wakeup_pending_ = false;
+
+  void Wake();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RingBuffer);
+};
+
+//------------------------------------------------------------------------------
+/// The process wide table of ring buffers, through which Dart code looks up
+/// the buffers the embedder registered by identifier.
+///
+/// Each buffer belongs to the engine it was created with, identified by the
+/// queue of the engine's UI task runner, which its isolates share. A buffer
+/// can only be looked up or unregistered on behalf of that engine, so one
+/// engine can neither read nor collect another engine's buffers.
+///
+class RingBufferRegistry {
+ public:
+  static RingBufferRegistry& GetInstance();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Registers |ring_buffer| on behalf of the engine whose UI task
+  ///             queue is |owner|, and returns its identifier. Identifiers
+  ///             are never reused.
+  ///
+  int64_t Register(fml::TaskQueueId owner,
+                   std::shared_ptr<RingBuffer> ring_buffer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes the ring buffer from the table. Isolates that have
+  ///             it open keep its storage alive until they let go of it, but
+  ///             see no further data.
+  ///
+  /// @return     Whether |owner| had a ring buffer with this identifier.
+  ///
+  bool Unregister(fml::TaskQueueId owner, int64_t identifier);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the ring buffer with this identifier if it belongs
+  ///             to |owner|, or null.
+  ///
+  std::shared_ptr<RingBuffer> Lookup(fml::TaskQueueId owner,
+                                     int64_t identifier) const;
+
+ private:
+  struct Entry {
+    fml::TaskQueueId owner;
+    std::shared_ptr<RingBuffer> ring_buffer;
+  };
+
+  RingBufferRegistry();
+
+  // Returns the entry for |identifier| if it belongs to |owner|. Must be
+  // called with |mutex_| held.
+  std::map<int64_t, Entry>::const_iterator Find(fml::TaskQueueId owner,
+                                                int64_t identifier) const;
+
+  mutable std::mutex mutex_;
+  std::map<int64_t, Entry> ring_buffers_;
+  int64_t next_identifier_ = 1;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RingBufferRegistry);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_RING_BUFFER_RING_BUFFER_H_
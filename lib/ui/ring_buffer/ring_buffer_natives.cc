@@ -0,0 +1,109 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/ring_buffer/ring_buffer_natives.h"
+
+#include <memory>
+
+#include "flutter/lib/ui/ring_buffer/ring_buffer.h"
+#include "flutter/lib/ui/ui_dart_state.h"
+#include "third_party/tonic/dart_binding_macros.h"
+#include "third_party/tonic/dart_library_natives.h"
+
+namespace flutter {
+
+namespace {
+
+void FinalizeRingBuffer(void* isolate_callback_data, void* peer) {
+  delete reinterpret_cast<std::shared_ptr<RingBuffer>*>(peer);
+}
+
+Dart_Port GetPort(Dart_Handle port_handle) {
+  Dart_Port port = ILLEGAL_PORT;
+  Dart_SendPortGetId(port_handle, &port);
+  return port;
+}
+
+// Looks up a ring buffer belonging to the engine of the current isolate.
+std::shared_ptr<RingBuffer> Lookup(int64_t identifier) {
+  const auto& task_runners = UIDartState::Current()->GetTaskRunners();
+  return RingBufferRegistry::GetInstance().Lookup(
+      task_runners.GetUITaskRunner()->GetTaskQueueId(), identifier);
+}
+
+// Returns the ring buffer if |port_handle| is still its consumer. A reader
+// whose buffer was opened by another reader since, or unregistered by the
+// embedder, is treated as closed.
+std::shared_ptr<RingBuffer> LookupAttached(int64_t identifier,
+                                           Dart_Handle port_handle) {
+  auto ring_buffer = Lookup(identifier);
+  if (!ring_buffer || !ring_buffer->IsAttached(GetPort(port_handle))) {
+    return nullptr;
+  }
+  return ring_buffer;
+}
+
+}  // namespace
+
+Dart_Handle RingBufferNatives::Open(int64_t identifier,
+                                    Dart_Handle port_handle) {
+  auto ring_buffer = Lookup(identifier);
+  if (!ring_buffer) {
+    return Dart_Null();
+  }
+  // The view keeps the storage alive for as long as Dart can reach it, even
+  // if the embedder unregisters the buffer in the meantime.
+  Dart_Handle storage = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kUint8, ring_buffer->data(), ring_buffer->capacity(),
+      new std::shared_ptr<RingBuffer>(ring_buffer), ring_buffer->capacity(),
+      FinalizeRingBuffer);
+  if (Dart_IsError(storage)) {
+    return storage;
+  }
+  ring_buffer->Attach(GetPort(port_handle));
+  return storage;
+}
+
+int64_t RingBufferNatives::ReadOffset(int64_t identifier) {
+  auto ring_buffer = Lookup(identifier);
+  return ring_buffer ? ring_buffer->read_offset() : 0;
+}
+
+int64_t RingBufferNatives::Acquire(int64_t identifier,
+                                   Dart_Handle port_handle) {
+  auto ring_buffer = LookupAttached(identifier, port_handle);
+  return ring_buffer ? ring_buffer->Acquire() : -1;
+}
+
+void RingBufferNatives::Release(int64_t identifier,
+                                Dart_Handle port_handle,
+                                int64_t read_offset) {
+  if (auto ring_buffer = LookupAttached(identifier, port_handle)) {
+    ring_buffer->Release(read_offset);
+  }
+}
+
+void RingBufferNatives::Close(int64_t identifier, Dart_Handle port_handle) {
+  if (auto ring_buffer = Lookup(identifier)) {
+    ring_buffer->Detach(GetPort(port_handle));
+  }
+}
+
+#define FOR_EACH_BINDING(V)        \
+  V(RingBufferNatives, Open)       \
+  V(RingBufferNatives, ReadOffset) \
+  V(RingBufferNatives, Acquire)    \
+  V(RingBufferNatives, Release)    \
+  V(RingBufferNatives, Close)
+
+FOR_EACH_BINDING(DART_NATIVE_CALLBACK_STATIC)
+
+#define DART_REGISTER_NATIVE_STATIC_(CLASS, METHOD) \
+  DART_REGISTER_NATIVE_STATIC(CLASS, METHOD),
+
+void RingBufferNatives::RegisterNatives(tonic::DartLibraryNatives* natives) {
+  natives->Register({FOR_EACH_BINDING(DART_REGISTER_NATIVE_STATIC_)});
+}
+
+}  // namespace flutter
@@ -0,0 +1,32 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_RING_BUFFER_RING_BUFFER_NATIVES_H_
+#define FLUTTER_LIB_UI_RING_BUFFER_RING_BUFFER_NATIVES_H_
+
+#include <cstdint>
+
+#include "third_party/dart/runtime/include/dart_api.h"
+
+namespace tonic {
+class DartLibraryNatives;
+}  // namespace tonic
+
+namespace flutter {
+
+class RingBufferNatives {
+ public:
+  static Dart_Handle Open(int64_t identifier, Dart_Handle port_handle);
+  static int64_t ReadOffset(int64_t identifier);
+  static int64_t Acquire(int64_t identifier, Dart_Handle port_handle);
+  static void Release(int64_t identifier,
+                      Dart_Handle port_handle,
+                      int64_t read_offset);
+  static void Close(int64_t identifier, Dart_Handle port_handle);
+  static void RegisterNatives(tonic::DartLibraryNatives* natives);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_RING_BUFFER_RING_BUFFER_NATIVES_H_
@@ -0,0 +1,125 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/ring_buffer/ring_buffer.h"
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Reads everything available from |ring_buffer| as the Dart reader does.
+std::vector<uint8_t> ReadAll(RingBuffer& ring_buffer) {
+  const uint64_t read_offset = ring_buffer.read_offset();
+  const uint64_t write_offset = ring_buffer.Acquire();
+  std::vector<uint8_t> result;
+  for (uint64_t offset = read_offset; offset < write_offset; offset++) {
+    result.push_back(
+        ring_buffer.data()[offset & (ring_buffer.capacity() - 1)]);
+  }
+  ring_buffer.Release(write_offset);
+  return result;
+}
+
+}  // namespace
+
+TEST(RingBufferTest, RoundsCapacityUpToPowerOfTwo) {
+  EXPECT_EQ(RingBuffer(1).capacity(), 1u);
+  EXPECT_EQ(RingBuffer(64).capacity(), 64u);
+  EXPECT_EQ(RingBuffer(100).capacity(), 128u);
+}
+
+TEST(RingBufferTest, WritesWrapAroundAndStopWhenFull) {
+  RingBuffer ring_buffer(8);
+  const uint8_t data[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+  EXPECT_EQ(ring_buffer.Write(data, 6), 6u);
+  EXPECT_EQ(ReadAll(ring_buffer), std::vector<uint8_t>({0, 1, 2, 3, 4, 5}));
+
+  // Only 8 of the 10 bytes fit, and they wrap around the end of the storage.
+  EXPECT_EQ(ring_buffer.Write(data, 10), 8u);
+  EXPECT_EQ(ring_buffer.Write(data, 1), 0u);
+  EXPECT_EQ(ReadAll(ring_buffer),
+            std::vector<uint8_t>({0, 1, 2, 3, 4, 5, 6, 7}));
+  EXPECT_EQ(ReadAll(ring_buffer), std::vector<uint8_t>());
+
+  EXPECT_EQ(ring_buffer.Write(data + 8, 2), 2u);
+  EXPECT_EQ(ReadAll(ring_buffer), std::vector<uint8_t>({8, 9}));
+}
+
+TEST(RingBufferTest, StreamsBetweenThreads) {
+  RingBuffer ring_buffer(64);
+  constexpr size_t kLength = 1 << 14;
+
+  std::thread producer([&ring_buffer]() {
+    uint8_t chunk[24];
+    size_t written = 0;
+    while (written < kLength) {
+      for (size_t i = 0; i < sizeof(chunk); i++) {
+        chunk[i] = (written + i) % 251;
+      }
+      const size_t size = std::min(sizeof(chunk), kLength - written);
+      const size_t result = ring_buffer.Write(chunk, size);
+      if (result == 0) {
+        std::this_thread::yield();
+      }
+      written += result;
+    }
+  });
+
+  std::vector<uint8_t> received;
+  while (received.size() < kLength) {
+    auto data = ReadAll(ring_buffer);
+    received.insert(received.end(), data.begin(), data.end());
+  }
+  producer.join();
+
+  ASSERT_EQ(received.size(), kLength);
+  for (size_t i = 0; i < kLength; i++) {
+    ASSERT_EQ(received[i], i % 251) << "at offset " << i;
+  }
+}
+
+TEST(RingBufferTest, RegistryLooksUpByIdentifier) {
+  auto& registry = RingBufferRegistry::GetInstance();
+  const fml::TaskQueueId owner(1);
+  auto ring_buffer = std::make_shared<RingBuffer>(16);
+
+  const int64_t identifier = registry.Register(owner, ring_buffer);
+  EXPECT_EQ(registry.Lookup(owner, identifier), ring_buffer);
+
+  const int64_t other =
+      registry.Register(owner, std::make_shared<RingBuffer>(16));
+  EXPECT_NE(other, identifier);
+
+  EXPECT_TRUE(registry.Unregister(owner, identifier));
+  EXPECT_FALSE(registry.Unregister(owner, identifier));
+  EXPECT_EQ(registry.Lookup(owner, identifier), nullptr);
+  EXPECT_TRUE(registry.Unregister(owner, other));
+}
+
+TEST(RingBufferTest, RegistryKeepsBuffersToTheirOwner) {
+  auto& registry = RingBufferRegistry::GetInstance();
+  const fml::TaskQueueId owner(1);
+  const fml::TaskQueueId other_owner(2);
+
+  const int64_t identifier =
+      registry.Register(owner, std::make_shared<RingBuffer>(16));
+  EXPECT_EQ(registry.Lookup(other_owner, identifier), nullptr);
+  EXPECT_FALSE(registry.Unregister(other_owner, identifier));
+
+  // The failed attempt leaves the buffer registered with its owner.
+  EXPECT_NE(registry.Lookup(owner, identifier), nullptr);
+  EXPECT_TRUE(registry.Unregister(owner, identifier));
+}
+
+}  // namespace testing
+}  // namespace flutter
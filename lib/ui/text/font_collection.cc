@@ -6,6 +6,7 @@
 
 #include <mutex>
 
+#include "flutter/common/startup_report.h"
 #include "flutter/lib/ui/text/asset_manager_font_provider.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_configuration.h"
@@ -74,6 +75,7 @@ void FontCollection::SetupDefaultFontManager() {
 
 void FontCollection::RegisterFonts(
     std::shared_ptr<AssetManager> asset_manager) {
+  StartupReport::ScopedPhase font_loading(StartupReport::Phase::kFontLoading);
   std::unique_ptr<fml::Mapping> manifest_mapping =
       asset_manager->GetAsMapping("FontManifest.json");
   if (manifest_mapping == nullptr) {
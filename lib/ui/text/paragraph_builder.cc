@@ -8,6 +8,7 @@
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/fml/icu_util.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/task_runner.h"
 #include "flutter/lib/ui/text/font_collection.h"
@@ -245,6 +246,9 @@ ParagraphBuilder::ParagraphBuilder(
     double height,
     const std::u16string& ellipsis,
     const std::string& locale) {
+  // Text layout is the first use of ICU, which may be initialized lazily.
+  fml::icu::EnsureICUInitialized();
+
   int32_t mask = encoded[0];
   txt::ParagraphStyle style;
 
@@ -17,7 +17,7 @@ import 'dart:collection' as collection;
 import 'dart:convert';
 import 'dart:developer' as developer;
 import 'dart:io'; // ignore: unused_import
-import 'dart:isolate' show SendPort;
+import 'dart:isolate' show RawReceivePort, SendPort;
 import 'dart:math' as math;
 import 'dart:nativewrappers';
 import 'dart:typed_data';
@@ -36,6 +36,7 @@ part 'painting.dart';
 part 'platform_dispatcher.dart';
 part 'plugins.dart';
 part 'pointer.dart';
+part 'ring_buffer.dart';
 part 'semantics.dart';
 part 'text.dart';
 part 'window.dart';
@@ -29,7 +29,8 @@ UIDartState::UIDartState(
     std::shared_ptr<IsolateNameServer> isolate_name_server,
     bool is_root_isolate,
     std::shared_ptr<VolatilePathTracker> volatile_path_tracker,
-    bool enable_skparagraph)
+    bool enable_skparagraph,
+    bool enable_display_list)
     : task_runners_(std::move(task_runners)),
       add_callback_(std::move(add_callback)),
       remove_callback_(std::move(remove_callback)),
@@ -45,7 +46,8 @@ UIDartState::UIDartState(
       is_root_isolate_(is_root_isolate),
       unhandled_exception_callback_(unhandled_exception_callback),
       isolate_name_server_(std::move(isolate_name_server)),
-      enable_skparagraph_(enable_skparagraph) {
+      enable_skparagraph_(enable_skparagraph),
+      enable_display_list_(enable_display_list) {
   AddOrRemoveTaskObserver(true /* add */);
 }
 
@@ -191,4 +193,8 @@ bool UIDartState::enable_skparagraph() const {
   return enable_skparagraph_;
 }
 
+bool UIDartState::enable_display_list() const {
+  return enable_display_list_;
+}
+
 }  // namespace flutter
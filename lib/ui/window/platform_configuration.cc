@@ -194,6 +194,29 @@ Dart_Handle ToByteData(const std::vector<uint8_t>& buffer) {
   return tonic::DartByteData::Create(buffer.data(), buffer.size());
 }
 
+// Messages at least this large are handed to Dart as external typed data that
+// references the message payload instead of a copy of it. Smaller messages are
+// cheaper to copy into the Dart heap.
+constexpr size_t kExternalMessageSizeThreshold = 1000;
+
+void FinalizeMapping(void* isolate_callback_data, void* peer) {
+  delete reinterpret_cast<fml::Mapping*>(peer);
+}
+
+// Takes ownership of the message payload.
+Dart_Handle ToByteData(std::unique_ptr<fml::Mapping> mapping) {
+  const size_t size = mapping->GetSize();
+  if (size < kExternalMessageSizeThreshold) {
+    return tonic::DartByteData::Create(mapping->GetMapping(), size);
+  }
+  // Platform message payloads are owned by the message and writable (see
+  // |PlatformMessage::data|), so Dart can be given direct access.
+  void* bytes = const_cast<uint8_t*>(mapping->GetMapping());
+  return Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kByteData, bytes, size, mapping.release(), size,
+      FinalizeMapping);
+}
+
 }  // namespace
 
 PlatformConfigurationClient::~PlatformConfigurationClient() {}
@@ -223,6 +246,9 @@ void PlatformConfiguration::DidCreateIsolate() {
   dispatch_platform_message_.Set(
       tonic::DartState::Current(),
       Dart_GetField(library, tonic::ToDart("_dispatchPlatformMessage")));
+  dispatch_platform_message_batch_.Set(
+      tonic::DartState::Current(),
+      Dart_GetField(library, tonic::ToDart("_dispatchPlatformMessageBatch")));
   dispatch_semantics_action_.Set(
       tonic::DartState::Current(),
       Dart_GetField(library, tonic::ToDart("_dispatchSemanticsAction")));
@@ -316,7 +342,7 @@ void PlatformConfiguration::DispatchPlatformMessage(
   }
   tonic::DartState::Scope scope(dart_state);
   Dart_Handle data_handle =
-      (message->hasData()) ? ToByteData(message->data()) : Dart_Null();
+      (message->hasData()) ? ToByteData(message->releaseData()) : Dart_Null();
   if (Dart_IsError(data_handle)) {
     FML_DLOG(WARNING)
         << "Dropping platform message because of a Dart error on channel: "
@@ -336,6 +362,43 @@ void PlatformConfiguration::DispatchPlatformMessage(
                          tonic::ToDart(response_id)}));
 }
 
+void PlatformConfiguration::DispatchPlatformMessageBatch(
+    const std::string& channel,
+    std::vector<fml::RefPtr<PlatformMessage>> messages) {
+  std::shared_ptr<tonic::DartState> dart_state =
+      dispatch_platform_message_batch_.dart_state().lock();
+  if (!dart_state) {
+    FML_DLOG(WARNING)
+        << "Dropping platform message batch for lack of DartState on channel: "
+        << channel;
+    return;
+  }
+  tonic::DartState::Scope scope(dart_state);
+
+  Dart_Handle list = Dart_NewList(messages.size());
+  if (Dart_IsError(list)) {
+    FML_DLOG(WARNING) << "Dropping platform message batch on channel: "
+                      << channel;
+    return;
+  }
+  for (size_t i = 0; i < messages.size(); i++) {
+    FML_DCHECK(!messages[i]->response());
+    Dart_Handle data_handle = messages[i]->hasData()
+                                  ? ToByteData(messages[i]->releaseData())
+                                  : Dart_Null();
+    if (Dart_IsError(data_handle)) {
+      FML_DLOG(WARNING)
+          << "Dropping platform message because of a Dart error on channel: "
+          << channel;
+      data_handle = Dart_Null();
+    }
+    Dart_ListSetAt(list, i, data_handle);
+  }
+
+  tonic::LogIfError(tonic::DartInvoke(dispatch_platform_message_batch_.Get(),
+                                      {tonic::ToDart(channel), list}));
+}
+
 void PlatformConfiguration::DispatchSemanticsAction(int32_t id,
                                                     SemanticsAction action,
                                                     std::vector<uint8_t> args) {
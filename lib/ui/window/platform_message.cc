@@ -12,16 +12,34 @@ PlatformMessage::PlatformMessage(std::string channel,
                                  std::vector<uint8_t> data,
                                  fml::RefPtr<PlatformMessageResponse> response)
     : channel_(std::move(channel)),
-      data_(std::move(data)),
+      data_(std::make_unique<fml::DataMapping>(std::move(data))),
       hasData_(true),
       response_(std::move(response)) {}
+PlatformMessage::PlatformMessage(std::string channel,
+                                 std::unique_ptr<fml::Mapping> data,
+                                 fml::RefPtr<PlatformMessageResponse> response)
+    : channel_(std::move(channel)),
+      data_(std::move(data)),
+      hasData_(data_ != nullptr),
+      response_(std::move(response)) {
+  if (!data_) {
+    data_ = std::make_unique<fml::DataMapping>(std::vector<uint8_t>{});
+  }
+}
 PlatformMessage::PlatformMessage(std::string channel,
                                  fml::RefPtr<PlatformMessageResponse> response)
     : channel_(std::move(channel)),
-      data_(),
+      data_(std::make_unique<fml::DataMapping>(std::vector<uint8_t>{})),
       hasData_(false),
       response_(std::move(response)) {}
 
 PlatformMessage::~PlatformMessage() = default;
 
+std::unique_ptr<fml::Mapping> PlatformMessage::releaseData() {
+  auto data = std::move(data_);
+  data_ = std::make_unique<fml::DataMapping>(std::vector<uint8_t>{});
+  hasData_ = false;
+  return data;
+}
+
 }  // namespace flutter
@@ -35,6 +35,7 @@ class CanvasKit {
   external SkFillTypeEnum get FillType;
   external SkAlphaTypeEnum get AlphaType;
   external SkColorTypeEnum get ColorType;
+  external SkImageFormatEnum get ImageFormat;
   external SkPathOpEnum get PathOp;
   external SkClipOpEnum get ClipOp;
   external SkPointModeEnum get PointMode;
@@ -709,6 +710,18 @@ class SkColorType {
   external int get value;
 }
 
+@JS()
+class SkImageFormatEnum {
+  external SkImageFormat get PNG;
+  external SkImageFormat get JPEG;
+  external SkImageFormat get WEBP;
+}
+
+@JS()
+class SkImageFormat {
+  external int get value;
+}
+
 @JS()
 @anonymous
 class SkAnimatedImage {
@@ -742,7 +755,7 @@ class SkImage {
     Float32List? matrix, // 3x3 matrix
   );
   external Uint8List readPixels(int srcX, int srcY, SkImageInfo imageInfo);
-  external Uint8List? encodeToBytes();
+  external Uint8List? encodeToBytes(SkImageFormat format, int quality);
   external bool isAliasOf(SkImage other);
   external bool isDeleted();
 }
@@ -279,11 +279,13 @@ class CkImage implements ui.Image, StackTraceDebugger {
   @override
   Future<ByteData> toByteData({
     ui.ImageByteFormat format = ui.ImageByteFormat.rawRgba,
+    int? quality,
   }) {
     assert(_debugCheckIsNotDisposed());
     ByteData? data = _encodeImage(
       skImage: skImage,
       format: format,
+      quality: quality,
       alphaType: canvasKit.AlphaType.Premul,
       colorType: canvasKit.ColorType.RGBA_8888,
       colorSpace: SkColorSpaceSRGB,
@@ -298,6 +300,7 @@ class CkImage implements ui.Image, StackTraceDebugger {
   static ByteData? _encodeImage({
     required SkImage skImage,
     required ui.ImageByteFormat format,
+    required int? quality,
     required SkAlphaType alphaType,
     required SkColorType colorType,
     required ColorSpace colorSpace,
@@ -314,12 +317,30 @@ class CkImage implements ui.Image, StackTraceDebugger {
       );
       bytes = skImage.readPixels(0, 0, imageInfo);
     } else {
-      bytes = skImage.encodeToBytes(); //defaults to PNG 100%
+      // CanvasKit has no zlib level for PNG, so the quality only applies to
+      // the lossy formats.
+      final bool isLossy = format == ui.ImageByteFormat.jpeg ||
+          format == ui.ImageByteFormat.webp;
+      final int encodeQuality = isLossy
+          ? (quality ?? _kDefaultLossyQuality).clamp(0, 100).toInt()
+          : 100;
+      bytes = skImage.encodeToBytes(_toSkImageFormat(format), encodeQuality);
     }
 
     return bytes?.buffer.asByteData(0, bytes.length);
   }
 
+  static SkImageFormat _toSkImageFormat(ui.ImageByteFormat format) {
+    switch (format) {
+      case ui.ImageByteFormat.jpeg:
+        return canvasKit.ImageFormat.JPEG;
+      case ui.ImageByteFormat.webp:
+        return canvasKit.ImageFormat.WEBP;
+      default:
+        return canvasKit.ImageFormat.PNG;
+    }
+  }
+
   @override
   String toString() {
     assert(_debugCheckIsNotDisposed());
@@ -121,6 +121,19 @@ class SingleFrameInfo implements ui.FrameInfo {
   final ui.Image image;
 }
 
+/// The MIME types passed to the browser's encoder for each compressed
+/// [ui.ImageByteFormat].
+const Map<ui.ImageByteFormat, String> _encodedMimeTypes =
+    <ui.ImageByteFormat, String>{
+  ui.ImageByteFormat.png: 'image/png',
+  ui.ImageByteFormat.jpeg: 'image/jpeg',
+  ui.ImageByteFormat.webp: 'image/webp',
+};
+
+/// The quality used for lossy formats when the caller does not specify one.
+/// Matches the default of the engine's native encoder.
+const int _kDefaultLossyQuality = 80;
+
 class HtmlImage implements ui.Image {
   final html.ImageElement imgElement;
   bool _requiresClone = false;
@@ -161,7 +174,7 @@ class HtmlImage implements ui.Image {
   final int height;
 
   @override
-  Future<ByteData?> toByteData({ui.ImageByteFormat format = ui.ImageByteFormat.rawRgba}) {
+  Future<ByteData?> toByteData({ui.ImageByteFormat format = ui.ImageByteFormat.rawRgba, int? quality}) {
     if (format == ui.ImageByteFormat.rawRgba) {
       final html.CanvasElement canvas = html.CanvasElement()
         ..width = width
@@ -171,6 +184,24 @@ class HtmlImage implements ui.Image {
       final html.ImageData imageData = ctx.getImageData(0, 0, width, height);
       return Future.value(imageData.data.buffer.asByteData());
     }
+    final String? mimeType = _encodedMimeTypes[format];
+    if (mimeType != null) {
+      final html.CanvasElement canvas = html.CanvasElement()
+        ..width = width
+        ..height = height;
+      canvas.context2D.drawImage(imgElement, 0, 0);
+      // Browsers ignore the quality for PNG.
+      final double encoderQuality =
+          (quality ?? _kDefaultLossyQuality).clamp(0, 100) / 100.0;
+      final UriData data =
+          UriData.fromUri(Uri.parse(canvas.toDataUrl(mimeType, encoderQuality)));
+      // Browsers that can't encode a format fall back to PNG.
+      if (data.mimeType != mimeType) {
+        return Future<ByteData?>.error(UnsupportedError(
+            'This browser cannot encode images as $mimeType.'));
+      }
+      return Future.value(data.contentAsBytes().buffer.asByteData());
+    }
     if (imgElement.src?.startsWith('data:') == true) {
       final data = UriData.fromUri(Uri.parse(imgElement.src!));
       return Future.value(data.contentAsBytes().buffer.asByteData());
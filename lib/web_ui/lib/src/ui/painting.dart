@@ -328,7 +328,7 @@ abstract class Gradient extends Shader {
 abstract class Image {
   int get width;
   int get height;
-  Future<ByteData?> toByteData({ImageByteFormat format = ImageByteFormat.rawRgba});
+  Future<ByteData?> toByteData({ImageByteFormat format = ImageByteFormat.rawRgba, int? quality});
   void dispose();
   bool get debugDisposed;
 
@@ -419,6 +419,8 @@ enum ImageByteFormat {
   rawRgba,
   rawUnmodified,
   png,
+  jpeg,
+  webp,
 }
 
 enum PixelFormat {
@@ -241,4 +241,26 @@ class IsolateNameServer {
   }
 }
 
+typedef RingBufferDataCallback = void Function(Uint8List data);
+
+class RingBufferReader {
+  RingBufferReader._();
+
+  static RingBufferReader? open(int identifier, void Function(RingBufferReader reader) onData) {
+    throw UnimplementedError();
+  }
+
+  int get identifier => throw UnimplementedError();
+  int get capacity => throw UnimplementedError();
+  bool get isClosed => throw UnimplementedError();
+
+  int read(RingBufferDataCallback callback) {
+    throw UnimplementedError();
+  }
+
+  void close() {
+    throw UnimplementedError();
+  }
+}
+
 SingletonFlutterWindow get window => engine.window;
@@ -1170,6 +1170,10 @@ void _canvasTests() {
     final ByteData pngData =
         await image.toByteData(format: ui.ImageByteFormat.png);
     expect(pngData.lengthInBytes, greaterThan(0));
+    final ByteData jpegData =
+        await image.toByteData(format: ui.ImageByteFormat.jpeg, quality: 50);
+    // JPEG files start with the SOI marker.
+    expect(jpegData.buffer.asUint8List().sublist(0, 2), <int>[0xFF, 0xD8]);
   });
 }
 
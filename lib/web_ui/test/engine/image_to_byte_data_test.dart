@@ -46,5 +46,10 @@ void testMain() async {
       pngBytes.buffer.asUint8List().sublist(0, pngHeader.length),
       pngHeader,
     );
+
+    // Every browser can encode JPEG, and the data is not the PNG above.
+    final ByteData jpegBytes =
+        await testImage.toByteData(format: ImageByteFormat.jpeg);
+    expect(jpegBytes.buffer.asUint8List().sublist(0, 2), <int>[0xFF, 0xD8]);
   });
 }
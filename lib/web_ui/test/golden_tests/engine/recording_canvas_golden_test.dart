@@ -714,7 +714,7 @@ class TestImage implements Image {
 
   @override
   Future<ByteData> toByteData(
-      {ImageByteFormat format = ImageByteFormat.rawRgba}) async {
+      {ImageByteFormat format = ImageByteFormat.rawRgba, int? quality}) async {
     throw UnsupportedError('Cannot encode test image');
   }
 
@@ -7,6 +7,7 @@
 #include <cstdlib>
 #include <tuple>
 
+#include "flutter/common/startup_report.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/posix_wrappers.h"
 #include "flutter/fml/trace_event.h"
@@ -128,6 +129,8 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRunningRootIsolate(
     return {};
   }
 
+  const auto isolate_creation_start = fml::TimePoint::Now();
+
   isolate_flags.SetNullSafetyEnabled(
       isolate_configration->IsNullSafetyEnabled(*isolate_snapshot));
 
@@ -178,6 +181,10 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRunningRootIsolate(
     return {};
   }
 
+  StartupReport::GetReportForProcess()->RecordPhase(
+      StartupReport::Phase::kIsolateCreation, isolate_creation_start,
+      fml::TimePoint::Now());
+
   if (settings.root_isolate_create_callback) {
     // Isolate callbacks always occur in isolate scope and before user code has
     // had a chance to run.
@@ -185,12 +192,16 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRunningRootIsolate(
     settings.root_isolate_create_callback(*isolate.get());
   }
 
-  if (!isolate->RunFromLibrary(dart_entrypoint_library,       //
-                               dart_entrypoint,               //
-                               settings.dart_entrypoint_args  //
-                               )) {
-    FML_LOG(ERROR) << "Could not run the run main Dart entrypoint.";
-    return {};
+  {
+    StartupReport::ScopedPhase root_isolate_main(
+        StartupReport::Phase::kRootIsolateMain);
+    if (!isolate->RunFromLibrary(dart_entrypoint_library,       //
+                                 dart_entrypoint,               //
+                                 settings.dart_entrypoint_args  //
+                                 )) {
+      FML_LOG(ERROR) << "Could not run the run main Dart entrypoint.";
+      return {};
+    }
   }
 
   if (settings.root_isolate_shutdown_callback) {
@@ -334,7 +345,8 @@ DartIsolate::DartIsolate(
                   DartVMRef::GetIsolateNameServer(),
                   is_root_isolate,
                   std::move(volatile_path_tracker),
-                  settings.enable_skparagraph),
+                  settings.enable_skparagraph,
+                  settings.enable_display_list),
       may_insecurely_connect_to_all_domains_(
           settings.may_insecurely_connect_to_all_domains),
       domain_network_policy_(settings.domain_network_policy) {
@@ -6,6 +6,7 @@
 
 #include <sstream>
 
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/native_library.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
@@ -214,6 +215,43 @@ const uint8_t* DartSnapshot::GetInstructionsMapping() const {
   return instructions_ ? instructions_->GetMapping() : nullptr;
 }
 
+// Symbols in the loaded application library don't have a size, so the extent of
+// the snapshot is taken to be the rest of the segment it is in.
+static size_t GetMappedExtent(const fml::Mapping* mapping) {
+  if (!mapping || !mapping->GetMapping()) {
+    return 0;
+  }
+  if (mapping->GetSize() > 0) {
+    return mapping->GetSize();
+  }
+  return fml::GetLoadedSegmentSizeFrom(mapping->GetMapping());
+}
+
+void DartSnapshot::AdviseWillNeed() const {
+  for (const fml::Mapping* mapping : {data_.get(), instructions_.get()}) {
+    if (size_t size = GetMappedExtent(mapping)) {
+      fml::AdviseWillNeed(mapping->GetMapping(), size);
+    }
+  }
+}
+
+void DartSnapshot::Prefetch() const {
+  TRACE_EVENT0("flutter", "DartSnapshot::Prefetch");
+  for (const fml::Mapping* mapping : {data_.get(), instructions_.get()}) {
+    if (size_t size = GetMappedExtent(mapping)) {
+      fml::TouchPages(mapping->GetMapping(), size);
+    }
+  }
+}
+
+bool DartSnapshot::AdviseHugePagesForInstructions() const {
+  size_t size = GetMappedExtent(instructions_.get());
+  if (size == 0) {
+    return false;
+  }
+  return fml::AdviseHugePages(instructions_->GetMapping(), size);
+}
+
 bool DartSnapshot::IsNullSafetyEnabled(const fml::Mapping* kernel) const {
   return ::Dart_DetectNullSafety(
       nullptr,           // script_uri (unsupported by Flutter)
@@ -154,6 +154,28 @@ class DartSnapshot : public fml::RefCountedThreadSafe<DartSnapshot> {
   bool IsNullSafetyEnabled(
       const fml::Mapping* application_kernel_mapping) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Asks the OS to start reading the heap and instructions
+  ///             snapshots in the background. This doesn't block.
+  ///
+  void AdviseWillNeed() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Faults in every page of the heap and instructions snapshots on
+  ///             the calling thread, so that the thread that runs the snapshot
+  ///             doesn't wait on them. This blocks until the snapshots are
+  ///             resident, so should be called on a background thread.
+  ///
+  void Prefetch() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Asks the OS to back the instructions snapshot with transparent
+  ///             huge pages.
+  ///
+  /// @return     Whether the OS took the advice.
+  ///
+  bool AdviseHugePagesForInstructions() const;
+
  private:
   std::shared_ptr<const fml::Mapping> data_;
   std::shared_ptr<const fml::Mapping> instructions_;
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "flutter/common/settings.h"
+#include "flutter/common/startup_report.h"
 #include "flutter/fml/compiler_specific.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/logging.h"
@@ -248,6 +249,8 @@ std::shared_ptr<DartVM> DartVM::Create(
     fml::RefPtr<const DartSnapshot> vm_snapshot,
     fml::RefPtr<const DartSnapshot> isolate_snapshot,
     std::shared_ptr<IsolateNameServer> isolate_name_server) {
+  StartupReport::ScopedPhase vm_initialization(
+      StartupReport::Phase::kVMInitialization);
   auto vm_data = DartVMData::Create(settings,                    //
                                     std::move(vm_snapshot),      //
                                     std::move(isolate_snapshot)  //
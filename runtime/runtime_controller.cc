@@ -250,6 +250,20 @@ bool RuntimeController::DispatchPlatformMessage(
   return false;
 }
 
+bool RuntimeController::DispatchPlatformMessageBatch(
+    const std::string& channel,
+    std::vector<fml::RefPtr<PlatformMessage>> messages) {
+  if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
+    TRACE_EVENT1("flutter", "RuntimeController::DispatchPlatformMessageBatch",
+                 "count", std::to_string(messages.size()).c_str());
+    platform_configuration->DispatchPlatformMessageBatch(channel,
+                                                         std::move(messages));
+    return true;
+  }
+
+  return false;
+}
+
 bool RuntimeController::DispatchPointerDataPacket(
     const PointerDataPacket& packet) {
   if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
@@ -413,6 +413,21 @@ class RuntimeController : public PlatformConfigurationClient {
   ///
   virtual bool DispatchPlatformMessage(fml::RefPtr<PlatformMessage> message);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Dispatch a batch of platform messages sent on the same
+  ///             channel to the running root isolate in a single invocation.
+  ///
+  /// @param[in]  channel   The channel the messages were sent on.
+  /// @param[in]  messages  The messages to dispatch to the isolate. None of
+  ///                       them may expect a response.
+  ///
+  /// @return     If the messages were dispatched to the running root isolate.
+  ///             This may fail is an isolate is not running.
+  ///
+  bool DispatchPlatformMessageBatch(
+      const std::string& channel,
+      std::vector<fml::RefPtr<PlatformMessage>> messages);
+
   //----------------------------------------------------------------------------
   /// @brief      Dispatch the specified pointer data message to the running
   ///             root isolate.
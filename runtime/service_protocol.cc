@@ -37,6 +37,13 @@ const std::string_view ServiceProtocol::kGetSkSLsExtensionName =
 const std::string_view
     ServiceProtocol::kEstimateRasterCacheMemoryExtensionName =
         "_flutter.estimateRasterCacheMemory";
+const std::string_view
+    ServiceProtocol::kGetShaderPrecompileProgressExtensionName =
+        "_flutter.getShaderPrecompileProgress";
+const std::string_view ServiceProtocol::kGetShaderUsageExtensionName =
+    "_flutter.getShaderUsage";
+const std::string_view ServiceProtocol::kGetStartupReportExtensionName =
+    "_flutter.getStartupReport";
 
 static constexpr std::string_view kViewIdPrefx = "_flutterView/";
 static constexpr std::string_view kListViewsExtensionName =
@@ -56,6 +63,9 @@ ServiceProtocol::ServiceProtocol()
           kGetDisplayRefreshRateExtensionName,
           kGetSkSLsExtensionName,
           kEstimateRasterCacheMemoryExtensionName,
+          kGetShaderPrecompileProgressExtensionName,
+          kGetShaderUsageExtensionName,
+          kGetStartupReportExtensionName,
       }),
       handlers_mutex_(fml::SharedMutex::Create()) {}
 
@@ -29,6 +29,9 @@ class ServiceProtocol {
   static const std::string_view kGetDisplayRefreshRateExtensionName;
   static const std::string_view kGetSkSLsExtensionName;
   static const std::string_view kEstimateRasterCacheMemoryExtensionName;
+  static const std::string_view kGetShaderPrecompileProgressExtensionName;
+  static const std::string_view kGetShaderUsageExtensionName;
+  static const std::string_view kGetStartupReportExtensionName;
 
   class Handler {
    public:
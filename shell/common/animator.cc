@@ -4,6 +4,7 @@
 
 #include "flutter/shell/common/animator.h"
 
+#include "flutter/common/startup_report.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 
@@ -101,6 +102,7 @@ void Animator::BeginFrame(fml::TimePoint vsync_start_time,
   TRACE_EVENT_ASYNC_END0("flutter", "Frame Request Pending", frame_number_++);
 
   TRACE_EVENT0("flutter", "Animator::BeginFrame");
+  StartupReport::ScopedPhase begin_frame(StartupReport::Phase::kBeginFrame);
   while (!trace_flow_ids_.empty()) {
     uint64_t trace_flow_id = trace_flow_ids_.front();
     TRACE_FLOW_END("flutter", "PointerEvent", trace_flow_id);
@@ -4,6 +4,7 @@
 
 #include "flutter/shell/common/engine.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -286,36 +287,64 @@ void Engine::SetViewportMetrics(const ViewportMetrics& metrics) {
 }
 
 void Engine::DispatchPlatformMessage(fml::RefPtr<PlatformMessage> message) {
+  if (HandleEnginePlatformMessage(message)) {
+    return;
+  }
+
   std::string channel = message->channel();
+  if (runtime_controller_->IsRootIsolateRunning() &&
+      runtime_controller_->DispatchPlatformMessage(std::move(message))) {
+    return;
+  }
+
+  FML_DLOG(WARNING) << "Dropping platform message on channel: " << channel;
+}
+
+void Engine::DispatchPlatformMessageBatch(
+    const std::string& channel,
+    std::vector<fml::RefPtr<PlatformMessage>> messages) {
+  messages.erase(std::remove_if(messages.begin(), messages.end(),
+                                [this](fml::RefPtr<PlatformMessage>& message) {
+                                  return HandleEnginePlatformMessage(message);
+                                }),
+                 messages.end());
+  if (messages.empty()) {
+    return;
+  }
+
+  if (runtime_controller_->IsRootIsolateRunning() &&
+      runtime_controller_->DispatchPlatformMessageBatch(channel,
+                                                        std::move(messages))) {
+    return;
+  }
+
+  FML_DLOG(WARNING) << "Dropping platform message batch on channel: "
+                    << channel;
+}
+
+bool Engine::HandleEnginePlatformMessage(
+    fml::RefPtr<PlatformMessage>& message) {
+  const std::string& channel = message->channel();
   if (channel == kLifecycleChannel) {
-    if (HandleLifecyclePlatformMessage(message.get())) {
-      return;
-    }
+    return HandleLifecyclePlatformMessage(message.get());
   } else if (channel == kLocalizationChannel) {
-    if (HandleLocalizationPlatformMessage(message.get())) {
-      return;
-    }
+    return HandleLocalizationPlatformMessage(message.get());
   } else if (channel == kSettingsChannel) {
     HandleSettingsPlatformMessage(message.get());
-    return;
+    return true;
   } else if (!runtime_controller_->IsRootIsolateRunning() &&
              channel == kNavigationChannel) {
     // If there's no runtime_, we may still need to set the initial route.
     HandleNavigationPlatformMessage(std::move(message));
-    return;
+    return true;
   }
-
-  if (runtime_controller_->IsRootIsolateRunning() &&
-      runtime_controller_->DispatchPlatformMessage(std::move(message))) {
-    return;
-  }
-
-  FML_DLOG(WARNING) << "Dropping platform message on channel: " << channel;
+  return false;
 }
 
 bool Engine::HandleLifecyclePlatformMessage(PlatformMessage* message) {
   const auto& data = message->data();
-  std::string state(reinterpret_cast<const char*>(data.data()), data.size());
+  std::string state(reinterpret_cast<const char*>(data.GetMapping()),
+                    data.GetSize());
   if (state == "AppLifecycleState.paused" ||
       state == "AppLifecycleState.detached") {
     activity_running_ = false;
@@ -342,7 +371,8 @@ bool Engine::HandleNavigationPlatformMessage(
   const auto& data = message->data();
 
   rapidjson::Document document;
-  document.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  document.Parse(reinterpret_cast<const char*>(data.GetMapping()),
+                 data.GetSize());
   if (document.HasParseError() || !document.IsObject()) {
     return false;
   }
@@ -360,7 +390,8 @@ bool Engine::HandleLocalizationPlatformMessage(PlatformMessage* message) {
   const auto& data = message->data();
 
   rapidjson::Document document;
-  document.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  document.Parse(reinterpret_cast<const char*>(data.GetMapping()),
+                 data.GetSize());
   if (document.HasParseError() || !document.IsObject()) {
     return false;
   }
@@ -400,7 +431,8 @@ bool Engine::HandleLocalizationPlatformMessage(PlatformMessage* message) {
 
 void Engine::HandleSettingsPlatformMessage(PlatformMessage* message) {
   const auto& data = message->data();
-  std::string jsonData(reinterpret_cast<const char*>(data.data()), data.size());
+  std::string jsonData(reinterpret_cast<const char*>(data.GetMapping()),
+                       data.GetSize());
   if (runtime_controller_->SetUserSettingsData(std::move(jsonData)) &&
       have_surface_) {
     ScheduleFrame();
@@ -526,8 +558,8 @@ void Engine::HandleAssetPlatformMessage(fml::RefPtr<PlatformMessage> message) {
     return;
   }
   const auto& data = message->data();
-  std::string asset_name(reinterpret_cast<const char*>(data.data()),
-                         data.size());
+  std::string asset_name(reinterpret_cast<const char*>(data.GetMapping()),
+                         data.GetSize());
 
   if (asset_manager_) {
     std::unique_ptr<fml::Mapping> asset_mapping =
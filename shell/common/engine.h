@@ -708,6 +708,21 @@ class Engine final : public RuntimeDelegate,
   ///
   void DispatchPlatformMessage(fml::RefPtr<PlatformMessage> message);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the engine that the embedder has sent it a batch of
+  ///             messages on a channel for which batching is enabled. The
+  ///             batch is delivered to the framework in a single invocation,
+  ///             after the engine has seen each message as it would have in
+  ///             `DispatchPlatformMessage`.
+  ///
+  /// @param[in]  channel   The channel all messages were sent on.
+  /// @param[in]  messages  The messages sent from the embedder to the Dart
+  ///                       application. None of them may expect a response.
+  ///
+  void DispatchPlatformMessageBatch(
+      const std::string& channel,
+      std::vector<fml::RefPtr<PlatformMessage>> messages);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the engine that the embedder has sent it a pointer
   ///             data packet. A pointer data packet may contain multiple
@@ -952,6 +967,10 @@ class Engine final : public RuntimeDelegate,
 
   void StartAnimatorIfPossible();
 
+  // Handles messages on the channels the engine itself listens to. Returns
+  // true if |message| was consumed and must not reach the framework.
+  bool HandleEnginePlatformMessage(fml::RefPtr<PlatformMessage>& message);
+
   bool HandleLifecyclePlatformMessage(PlatformMessage* message);
 
   bool HandleNavigationPlatformMessage(fml::RefPtr<PlatformMessage> message);
@@ -4,9 +4,12 @@
 
 #include "flutter/common/graphics/persistent_cache.h"
 
+#include <chrono>
 #include <memory>
+#include <thread>
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/common/graphics/packed_shader_cache.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/layers/physical_shape_layer.h"
@@ -31,6 +34,28 @@ static void WaitForIO(Shell* shell) {
   io_task_finished.get_future().wait();
 }
 
+// Waits until the rasterizer has precompiled all the cached SkSLs, and fails
+// the test if that takes longer than |timeout|.
+static void WaitForShaderPrecompilation(
+    Shell* shell,
+    std::chrono::seconds timeout = std::chrono::seconds(30)) {
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (true) {
+    rapidjson::Document document;
+    ShellTest::OnServiceProtocol(
+        shell, ShellTest::ServiceProtocolEnum::kGetShaderPrecompileProgress,
+        shell->GetTaskRunners().GetRasterTaskRunner(), {}, &document);
+    if (document["done"].GetBool()) {
+      return;
+    }
+    if (std::chrono::steady_clock::now() >= deadline) {
+      FAIL() << "Shader precompilation did not finish within "
+             << timeout.count() << " seconds.";
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
 TEST_F(ShellTest, CacheSkSLWorks) {
   // Create a temp dir to store the persistent cache
   fml::ScopedTemporaryDirectory dir;
@@ -95,6 +120,9 @@ TEST_F(ShellTest, CacheSkSLWorks) {
   shell = CreateShell(settings);
   PlatformViewNotifyCreated(shell.get());
   RunEngine(shell.get(), std::move(normal_config));
+  // Precompilation happens between frames, so wait for it to finish before
+  // drawing the frame that needs the shaders.
+  WaitForShaderPrecompilation(shell.get());
   firstFrameLatch.Reset();
   PumpOneFrame(shell.get(), 100, 100, builder);
   firstFrameLatch.Wait();
@@ -307,5 +335,247 @@ TEST_F(ShellTest, PurgeAllowsFutureSkSLCache) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, LoadsSkSLsInTheOrderTheyWereStored) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+
+  auto settings = CreateSettingsForFixture();
+  settings.cache_sksl = true;
+  auto config = RunConfiguration::InferFromSettings(settings);
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  RunEngine(shell.get(), std::move(config));
+
+  // Store the shaders out of alphabetical order, so that the order in which
+  // the directory happens to list them is unlikely to match.
+  const std::vector<std::string> keys = {"c", "a", "d", "b"};
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  for (const auto& key : keys) {
+    StorePersistentCache(persistent_cache,
+                         *SkData::MakeWithCString(key.c_str()),
+                         *SkData::MakeWithCString("value"));
+  }
+  WaitForIO(shell.get());
+
+  auto check_order = [&keys]() {
+    auto shaders = PersistentCache::GetCacheForProcess()->LoadSkSLs();
+    ASSERT_EQ(shaders.size(), keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+      EXPECT_STREQ(static_cast<const char*>(shaders[i].first->data()),
+                   keys[i].c_str());
+    }
+  };
+  check_order();
+
+  // The order survives the cache being opened again, as in the next launch.
+  PersistentCache::ResetCacheForProcess();
+  check_order();
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+  DestroyShell(std::move(shell));
+}
+
+static std::string ToString(const sk_sp<SkData>& data) {
+  return std::string(static_cast<const char*>(data->data()), data->size());
+}
+
+TEST(PackedShaderCacheTest, StoresAndReloadsEntriesInOrder) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = std::make_shared<fml::UniqueFD>(
+      fml::OpenDirectory(dir.path().c_str(), false,
+                         fml::FilePermission::kReadWrite));
+  {
+    PackedShaderCache cache(directory, "test.pack");
+    ASSERT_EQ(cache.GetEntryCount(), 0u);
+    cache.Store(*SkData::MakeWithCString("b"), *SkData::MakeWithCString("1"),
+                nullptr);
+    cache.Store(*SkData::MakeWithCString("a"), *SkData::MakeWithCString("2"),
+                nullptr);
+    // Storing a key again replaces its value but keeps its place.
+    cache.Store(*SkData::MakeWithCString("b"), *SkData::MakeWithCString("3"),
+                nullptr);
+    ASSERT_EQ(cache.GetEntryCount(), 2u);
+    EXPECT_EQ(ToString(cache.Load(*SkData::MakeWithCString("b"), nullptr)),
+              std::string("3", 2));
+    EXPECT_EQ(cache.Load(*SkData::MakeWithCString("c"), nullptr), nullptr);
+  }
+
+  PackedShaderCache reopened(directory, "test.pack");
+  auto entries = reopened.LoadAll();
+  ASSERT_EQ(entries.size(), 2u);
+  EXPECT_EQ(ToString(entries[0].first), std::string("b", 2));
+  EXPECT_EQ(ToString(entries[0].second), std::string("3", 2));
+  EXPECT_EQ(ToString(entries[1].first), std::string("a", 2));
+  EXPECT_EQ(ToString(entries[1].second), std::string("2", 2));
+}
+
+TEST(PackedShaderCacheTest, RewritesDamagedFile) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = std::make_shared<fml::UniqueFD>(
+      fml::OpenDirectory(dir.path().c_str(), false,
+                         fml::FilePermission::kReadWrite));
+  sk_sp<SkData> key = SkData::MakeWithCString("key");
+  sk_sp<SkData> value = SkData::MakeWithCString("value");
+  auto bytes = PackedShaderCache::Pack({{key, value}});
+  // Cut the record short, as if the process died while appending it.
+  bytes.resize(bytes.size() - 1);
+  ASSERT_TRUE(fml::WriteAtomically(*directory, "test.pack",
+                                   fml::DataMapping(std::move(bytes))));
+
+  {
+    PackedShaderCache cache(directory, "test.pack");
+    ASSERT_EQ(cache.GetEntryCount(), 0u);
+    cache.Store(*key, *value, nullptr);
+  }
+
+  PackedShaderCache reopened(directory, "test.pack");
+  ASSERT_EQ(reopened.GetEntryCount(), 1u);
+  EXPECT_EQ(ToString(reopened.Load(*key, nullptr)), ToString(value));
+}
+
+TEST(PackedShaderCacheTest, RewritesFileWhileLoadedEntriesAreInUse) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = std::make_shared<fml::UniqueFD>(
+      fml::OpenDirectory(dir.path().c_str(), false,
+                         fml::FilePermission::kReadWrite));
+  sk_sp<SkData> key = SkData::MakeWithCString("key");
+  sk_sp<SkData> value = SkData::MakeWithCString("value");
+  auto bytes = PackedShaderCache::Pack(
+      {{key, value}, {SkData::MakeWithCString("cut"), value}});
+  // Damage the file, so that the next store rewrites it.
+  bytes.resize(bytes.size() - 1);
+  ASSERT_TRUE(fml::WriteAtomically(*directory, "test.pack",
+                                   fml::DataMapping(std::move(bytes))));
+
+  sk_sp<SkData> loaded;
+  {
+    PackedShaderCache cache(directory, "test.pack");
+    // Hold on to a loaded entry, as Skia may, while the file is rewritten.
+    loaded = cache.Load(*key, nullptr);
+    ASSERT_NE(loaded, nullptr);
+    cache.Store(*SkData::MakeWithCString("new"), *value, nullptr);
+  }
+  EXPECT_EQ(ToString(loaded), ToString(value));
+
+  PackedShaderCache reopened(directory, "test.pack");
+  ASSERT_EQ(reopened.GetEntryCount(), 2u);
+  EXPECT_EQ(ToString(reopened.Load(*SkData::MakeWithCString("new"), nullptr)),
+            ToString(value));
+}
+
+TEST(PackedShaderCacheTest, RejectsUnknownFormat) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = std::make_shared<fml::UniqueFD>(
+      fml::OpenDirectory(dir.path().c_str(), false,
+                         fml::FilePermission::kReadWrite));
+  ASSERT_TRUE(fml::WriteAtomically(
+      *directory, "test.pack", fml::DataMapping(std::string("not a pack"))));
+  PackedShaderCache cache(directory, "test.pack");
+  EXPECT_EQ(cache.GetEntryCount(), 0u);
+}
+
+TEST(PackedShaderCacheTest, EvictsLeastRecentlyUsedEntries) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = std::make_shared<fml::UniqueFD>(
+      fml::OpenDirectory(dir.path().c_str(), false,
+                         fml::FilePermission::kReadWrite));
+  int64_t now = 1000;
+  PackedShaderCache cache(directory, "test.pack");
+  cache.SetClockForTesting([&now]() { return now; });
+
+  const std::string value(100, 'x');
+  auto store = [&cache, &value](const char* key) {
+    cache.Store(*SkData::MakeWithCString(key),
+                *SkData::MakeWithCopy(value.data(), value.size()), nullptr);
+  };
+  store("a");
+  now++;
+  store("b");
+  now++;
+  store("c");
+  now++;
+  // Using "a" makes "b" the least recently used entry.
+  ASSERT_NE(cache.Load(*SkData::MakeWithCString("a"), nullptr), nullptr);
+
+  // Leave room for three entries, so that storing a fourth evicts one.
+  cache.SetMaxSize(cache.GetSize() + cache.GetSize() / 6);
+  now++;
+  store("d");
+  ASSERT_EQ(cache.GetEntryCount(), 3u);
+  EXPECT_EQ(cache.Load(*SkData::MakeWithCString("b"), nullptr), nullptr);
+
+  PackedShaderCache reopened(directory, "test.pack");
+  auto usage = reopened.GetUsage();
+  ASSERT_EQ(usage.size(), 3u);
+  EXPECT_EQ(ToString(usage[0].key), std::string("a", 2));
+  EXPECT_EQ(usage[0].hit_count, 1u);
+  EXPECT_EQ(usage[0].last_use, 1003);
+  EXPECT_EQ(ToString(usage[1].key), std::string("c", 2));
+  EXPECT_EQ(usage[1].hit_count, 0u);
+  EXPECT_EQ(usage[1].last_use, 1002);
+  EXPECT_EQ(ToString(usage[2].key), std::string("d", 2));
+  EXPECT_EQ(usage[2].last_use, 1004);
+}
+
+TEST_F(ShellTest, ReportsShaderUsage) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+
+  auto settings = CreateSettingsForFixture();
+  settings.persistent_cache_size_limit = 1024 * 1024;
+  auto config = RunConfiguration::InferFromSettings(settings);
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  RunEngine(shell.get(), std::move(config));
+
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  sk_sp<SkData> key = SkData::MakeWithCString("key");
+  StorePersistentCache(persistent_cache, *key,
+                       *SkData::MakeWithCString("value"));
+  // Stores of the same shader are only reported once.
+  StorePersistentCache(persistent_cache, *key,
+                       *SkData::MakeWithCString("value"));
+  ASSERT_NE(persistent_cache->load(*key), nullptr);
+  WaitForIO(shell.get());
+
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetShaderUsage,
+                    shell->GetTaskRunners().GetIOTaskRunner(), {}, &document);
+  const std::string encoded_key = PersistentCache::SkKeyToFilePath(*key);
+  ASSERT_EQ(document["storedThisSession"].Size(), 1u);
+  EXPECT_EQ(document["storedThisSession"][0].GetString(), encoded_key);
+  EXPECT_EQ(document["cacheLimitBytes"].GetUint64(), 1024u * 1024u);
+  EXPECT_GT(document["cacheBytes"].GetUint64(), 0u);
+  ASSERT_TRUE(document["shaders"].HasMember(encoded_key.c_str()));
+  EXPECT_EQ(document["shaders"][encoded_key.c_str()]["hits"].GetUint64(), 1u);
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, LargestPersistentCacheSizeLimitApplies) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  persistent_cache->RaiseSizeLimit(0);
+  EXPECT_EQ(persistent_cache->GetSizeLimit(), 0u);
+  persistent_cache->RaiseSizeLimit(2048);
+  EXPECT_EQ(persistent_cache->GetSizeLimit(), 2048u);
+  persistent_cache->RaiseSizeLimit(1024);
+  EXPECT_EQ(persistent_cache->GetSizeLimit(), 2048u);
+  persistent_cache->RaiseSizeLimit(0);
+  EXPECT_EQ(persistent_cache->GetSizeLimit(), 2048u);
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -7,6 +7,8 @@
 #include <utility>
 
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/common/startup_report.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/serialization_callbacks.h"
@@ -36,6 +38,9 @@ namespace flutter {
 // used within this interval.
 static constexpr std::chrono::milliseconds kSkiaCleanupExpiration(15000);
 
+// The fraction of each frame interval that may be spent precompiling shaders.
+static constexpr double kShaderPrecompileFrameBudgetFraction = 0.25;
+
 Rasterizer::Rasterizer(Delegate& delegate)
     : delegate_(delegate),
       compositor_context_(std::make_unique<flutter::CompositorContext>(
@@ -76,6 +81,7 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
                              user_override_resource_cache_bytes_);
   }
   compositor_context_->OnGrContextCreated();
+  StartShaderPrecompilation();
   if (external_view_embedder_ &&
       external_view_embedder_->SupportsDynamicThreadMerging() &&
       !raster_thread_merger_) {
@@ -98,6 +104,8 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
 
 void Rasterizer::Teardown() {
   compositor_context_->OnGrContextDestroyed();
+  // Compiled programs belong to the context, so a new surface starts over.
+  shader_precompiler_.reset();
   surface_.reset();
   last_layer_tree_.reset();
 
@@ -109,6 +117,75 @@ void Rasterizer::Teardown() {
   }
 }
 
+void Rasterizer::StartShaderPrecompilation() {
+  if (!surface_ || !surface_->GetContext()) {
+    return;
+  }
+  // Reading the shaders is file IO, so keep it off the raster task runner.
+  const auto& task_runners = delegate_.GetTaskRunners();
+  task_runners.GetIOTaskRunner()->PostTask(
+      [weak_this = weak_factory_.GetWeakPtr(),
+       raster_task_runner = task_runners.GetRasterTaskRunner()]() {
+        auto shaders = PersistentCache::GetCacheForProcess()->LoadSkSLs();
+        raster_task_runner->PostTask(fml::MakeCopyable(
+            [weak_this, shaders = std::move(shaders)]() mutable {
+              if (!weak_this || !weak_this->surface_ ||
+                  weak_this->shader_precompiler_) {
+                return;
+              }
+              weak_this->shader_precompiler_ =
+                  std::make_unique<ShaderPrecompiler>(std::move(shaders));
+              weak_this->PrecompileShaders();
+            }));
+      });
+}
+
+void Rasterizer::PrecompileShaders() {
+  if (!surface_ || !shader_precompiler_ || shader_precompiler_->IsDone()) {
+    return;
+  }
+  GrDirectContext* context = surface_->GetContext();
+  if (!context) {
+    return;
+  }
+
+  StartupReport::ScopedPhase shader_compilation(
+      StartupReport::Phase::kShaderCompilation);
+  const double frame_budget_millis = delegate_.GetFrameBudget().count();
+  delegate_.GetIsGpuDisabledSyncSwitch()->Execute(
+      fml::SyncSwitch::Handlers().SetIfFalse([&] {
+        auto context_switch = surface_->MakeRenderContextCurrent();
+        if (!context_switch->GetResult()) {
+          return;
+        }
+        const auto deadline =
+            fml::TimePoint::Now() +
+            fml::TimeDelta::FromMillisecondsF(
+                frame_budget_millis * kShaderPrecompileFrameBudgetFraction);
+        shader_precompiler_->PrecompileUntil(
+            deadline, [context](const SkData& key, const SkData& sksl) {
+              return context->precompileShader(key, sksl);
+            });
+      }));
+
+  if (shader_precompiler_->IsDone()) {
+    FML_LOG(INFO) << "Found " << shader_precompiler_->total_count()
+                  << " SkSL shaders; precompiled "
+                  << shader_precompiler_->compiled_count();
+    return;
+  }
+
+  // Frames are produced at most once per interval, so waiting an interval
+  // between slices leaves them room to run.
+  delegate_.GetTaskRunners().GetRasterTaskRunner()->PostDelayedTask(
+      [weak_this = weak_factory_.GetWeakPtr()]() {
+        if (weak_this) {
+          weak_this->PrecompileShaders();
+        }
+      },
+      fml::TimeDelta::FromMillisecondsF(frame_budget_millis));
+}
+
 void Rasterizer::EnableThreadMergerIfNeeded() {
   if (raster_thread_merger_) {
     raster_thread_merger_->Enable();
@@ -140,6 +217,11 @@ flutter::TextureRegistry* Rasterizer::GetTextureRegistry() {
   return &compositor_context_->texture_registry();
 }
 
+void Rasterizer::SetTileTaskRunner(
+    std::shared_ptr<fml::ConcurrentTaskRunner> task_runner) {
+  compositor_context_->SetTileTaskRunner(std::move(task_runner));
+}
+
 flutter::LayerTree* Rasterizer::GetLastLayerTree() {
   return last_layer_tree_.get();
 }
@@ -292,6 +374,14 @@ sk_sp<SkImage> Rasterizer::MakeRasterSnapshot(sk_sp<SkPicture> picture,
                               });
 }
 
+sk_sp<SkImage> Rasterizer::MakeRasterSnapshot(sk_sp<DisplayList> display_list,
+                                              SkISize picture_size) {
+  return DoMakeRasterSnapshot(
+      picture_size, [display_list = std::move(display_list)](SkCanvas* canvas) {
+        display_list->RenderTo(canvas);
+      });
+}
+
 sk_sp<SkImage> Rasterizer::ConvertToRasterImage(sk_sp<SkImage> image) {
   TRACE_EVENT0("flutter", __FUNCTION__);
 
@@ -356,6 +446,9 @@ RasterStatus Rasterizer::DoDraw(
   // for Fuchsia to capture SceneUpdateContext::ExecutePaintTasks.
   const auto raster_finish_time = fml::TimePoint::Now();
   timing.Set(FrameTiming::kRasterFinish, raster_finish_time);
+  StartupReport::GetReportForProcess()->RecordPhase(
+      StartupReport::Phase::kRasterizerDraw,
+      timing.Get(FrameTiming::kRasterStart), raster_finish_time);
   delegate_.OnFrameRasterized(timing);
 
 // SceneDisplayLag events are disabled on Fuchsia.
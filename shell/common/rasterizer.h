@@ -23,6 +23,7 @@
 #include "flutter/fml/time/time_point.h"
 #include "flutter/lib/ui/snapshot_delegate.h"
 #include "flutter/shell/common/pipeline.h"
+#include "flutter/shell/common/shader_precompiler.h"
 
 namespace flutter {
 
@@ -208,6 +209,18 @@ class Rasterizer final : public SnapshotDelegate {
   ///
   flutter::TextureRegistry* GetTextureRegistry();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Lets the workers of the given task runner help paint frames
+  ///             into surfaces backed by CPU memory, by splitting each frame
+  ///             into tiles that are painted in parallel. Frames rendered by
+  ///             the GPU are not affected.
+  ///
+  /// @param[in]  task_runner  The task runner for the workers, or null to
+  ///                          paint frames on the raster thread alone.
+  ///
+  void SetTileTaskRunner(
+      std::shared_ptr<fml::ConcurrentTaskRunner> task_runner);
+
   using LayerTreeDiscardCallback = std::function<bool(flutter::LayerTree&)>;
 
   //----------------------------------------------------------------------------
@@ -410,6 +423,24 @@ class Rasterizer final : public SnapshotDelegate {
   ///
   std::optional<size_t> GetResourceCacheMaxBytes() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The precompiler working through the cached SkSL shaders for
+  ///             the current surface's context, if any.
+  ///
+  ///             Rather than compiling every cached shader before the context
+  ///             is used, the rasterizer loads them on the IO task runner once
+  ///             a surface is set up, and compiles them in priority order in
+  ///             slices of at most a quarter of the frame budget, once per
+  ///             frame interval, so that frames are only ever delayed by one
+  ///             slice.
+  ///
+  /// @return     The shader precompiler, or `nullptr` if the shaders have not
+  ///             been loaded yet or there is no GPU context.
+  ///
+  const ShaderPrecompiler* GetShaderPrecompiler() const {
+    return shader_precompiler_.get();
+  }
+
   //----------------------------------------------------------------------------
   /// @brief      Enables the thread merger if the external view embedder
   ///             supports dynamic thread merging.
@@ -460,11 +491,16 @@ class Rasterizer final : public SnapshotDelegate {
   fml::TaskRunnerAffineWeakPtrFactory<Rasterizer> weak_factory_;
   std::shared_ptr<ExternalViewEmbedder> external_view_embedder_;
   bool shared_engine_block_thread_merging_ = false;
+  std::unique_ptr<ShaderPrecompiler> shader_precompiler_;
 
   // |SnapshotDelegate|
   sk_sp<SkImage> MakeRasterSnapshot(sk_sp<SkPicture> picture,
                                     SkISize picture_size) override;
 
+  // |SnapshotDelegate|
+  sk_sp<SkImage> MakeRasterSnapshot(sk_sp<DisplayList> display_list,
+                                    SkISize picture_size) override;
+
   // |SnapshotDelegate|
   sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) override;
 
@@ -484,6 +520,10 @@ class Rasterizer final : public SnapshotDelegate {
 
   void FireNextFrameCallbackIfPresent();
 
+  void StartShaderPrecompilation();
+
+  void PrecompileShaders();
+
   static bool NoDiscard(const flutter::LayerTree& layer_tree) { return false; }
 
   FML_DISALLOW_COPY_AND_ASSIGN(Rasterizer);
@@ -7,27 +7,41 @@
 #include <sstream>
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/assets/packed_asset_bundle.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/common/startup_report.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/runtime/dart_vm.h"
 
 namespace flutter {
 
+static void PushBackAssetBundle(AssetManager& asset_manager,
+                                fml::UniqueFD directory) {
+  // Assets in a packed archive are resolved without opening their files, so
+  // the archive goes in front of the directory. Invalid resolvers, like that
+  // of a missing archive, are not added.
+  asset_manager.PushBack(std::make_unique<PackedAssetBundle>(
+      fml::FileMapping::CreateReadOnly(directory, PackedAssetBundle::kFileName),
+      true));
+  asset_manager.PushBack(
+      std::make_unique<DirectoryAssetBundle>(std::move(directory), true));
+}
+
 RunConfiguration RunConfiguration::InferFromSettings(
     const Settings& settings,
     fml::RefPtr<fml::TaskRunner> io_worker) {
+  StartupReport::ScopedPhase asset_manager_creation(
+      StartupReport::Phase::kAssetManagerCreation);
   auto asset_manager = std::make_shared<AssetManager>();
 
   if (fml::UniqueFD::traits_type::IsValid(settings.assets_dir)) {
-    asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
-        fml::Duplicate(settings.assets_dir), true));
+    PushBackAssetBundle(*asset_manager, fml::Duplicate(settings.assets_dir));
   }
 
-  asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
-      fml::OpenDirectory(settings.assets_path.c_str(), false,
-                         fml::FilePermission::kRead),
-      true));
+  PushBackAssetBundle(*asset_manager,
+                      fml::OpenDirectory(settings.assets_path.c_str(), false,
+                                         fml::FilePermission::kRead));
 
   return {IsolateConfiguration::InferFromSettings(settings, asset_manager,
                                                   io_worker),
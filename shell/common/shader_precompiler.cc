@@ -0,0 +1,37 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/shader_precompiler.h"
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+ShaderPrecompiler::ShaderPrecompiler(
+    std::vector<PersistentCache::SkSLCache> shaders)
+    : shaders_(std::move(shaders)) {}
+
+ShaderPrecompiler::~ShaderPrecompiler() = default;
+
+size_t ShaderPrecompiler::PrecompileUntil(fml::TimePoint deadline,
+                                          const CompileCallback& compile) {
+  TRACE_EVENT0("flutter", "ShaderPrecompiler::PrecompileUntil");
+  const size_t first = next_;
+  while (!IsDone()) {
+    const auto& shader = shaders_[next_++];
+    if (compile(*shader.first, *shader.second)) {
+      compiled_count_++;
+    }
+    if (fml::TimePoint::Now() >= deadline) {
+      break;
+    }
+  }
+  FML_TRACE_COUNTER("flutter", "ShaderPrecompiler",
+                    reinterpret_cast<int64_t>(this),  //
+                    "Attempted", next_,               //
+                    "Remaining", shaders_.size() - next_);
+  return next_ - first;
+}
+
+}  // namespace flutter
@@ -0,0 +1,69 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_SHADER_PRECOMPILER_H_
+#define SHELL_COMMON_SHADER_PRECOMPILER_H_
+
+#include <functional>
+#include <vector>
+
+#include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Compiles a list of cached SkSL shaders a few at a time, so that the work
+/// can be spread over the idle time between frames instead of delaying the
+/// first frame until all of them are compiled.
+///
+/// Shaders are compiled in the order given. For shaders cached on this device,
+/// |PersistentCache::LoadSkSLs| returns them in the order in which they were
+/// first compiled.
+///
+class ShaderPrecompiler {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Compiles one shader, returning whether it was compiled. On
+  ///             the raster task runner this calls
+  ///             |GrDirectContext::precompileShader|.
+  ///
+  using CompileCallback =
+      std::function<bool(const SkData& key, const SkData& sksl)>;
+
+  explicit ShaderPrecompiler(std::vector<PersistentCache::SkSLCache> shaders);
+
+  ~ShaderPrecompiler();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Compiles shaders with |compile| until they have all been
+  ///             attempted or |deadline| has passed. At least one shader is
+  ///             attempted per call, so that precompilation makes progress
+  ///             however small the budget.
+  ///
+  /// @return     The number of shaders attempted.
+  ///
+  size_t PrecompileUntil(fml::TimePoint deadline,
+                         const CompileCallback& compile);
+
+  bool IsDone() const { return next_ == shaders_.size(); }
+
+  size_t total_count() const { return shaders_.size(); }
+
+  size_t attempted_count() const { return next_; }
+
+  size_t compiled_count() const { return compiled_count_; }
+
+ private:
+  std::vector<PersistentCache::SkSLCache> shaders_;
+  size_t next_ = 0;
+  size_t compiled_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ShaderPrecompiler);
+};
+
+}  // namespace flutter
+
+#endif  // SHELL_COMMON_SHADER_PRECOMPILER_H_
@@ -0,0 +1,79 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/shader_precompiler.h"
+
+#include <string>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+std::vector<PersistentCache::SkSLCache> MakeShaders(size_t count) {
+  std::vector<PersistentCache::SkSLCache> shaders;
+  for (size_t i = 0; i < count; i++) {
+    const std::string key = std::to_string(i);
+    shaders.push_back({SkData::MakeWithCString(key.c_str()),
+                       SkData::MakeWithCString("sksl")});
+  }
+  return shaders;
+}
+
+}  // namespace
+
+TEST(ShaderPrecompilerTest, CompilesInOrderUntilDone) {
+  ShaderPrecompiler precompiler(MakeShaders(3));
+  std::vector<std::string> compiled;
+  auto compile = [&compiled](const SkData& key, const SkData& sksl) {
+    compiled.push_back(static_cast<const char*>(key.data()));
+    return compiled.size() != 2;
+  };
+
+  const auto far_future =
+      fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(60);
+  EXPECT_EQ(precompiler.PrecompileUntil(far_future, compile), 3u);
+  EXPECT_EQ(compiled, std::vector<std::string>({"0", "1", "2"}));
+  EXPECT_TRUE(precompiler.IsDone());
+  EXPECT_EQ(precompiler.total_count(), 3u);
+  EXPECT_EQ(precompiler.attempted_count(), 3u);
+  EXPECT_EQ(precompiler.compiled_count(), 2u);
+
+  // Nothing is left to compile.
+  EXPECT_EQ(precompiler.PrecompileUntil(far_future, compile), 0u);
+  EXPECT_EQ(compiled.size(), 3u);
+}
+
+TEST(ShaderPrecompilerTest, CompilesOneShaderPerCallOncePastTheDeadline) {
+  ShaderPrecompiler precompiler(MakeShaders(3));
+  size_t compile_count = 0;
+  auto compile = [&compile_count](const SkData& key, const SkData& sksl) {
+    compile_count++;
+    return true;
+  };
+
+  const auto past = fml::TimePoint::Now();
+  EXPECT_EQ(precompiler.PrecompileUntil(past, compile), 1u);
+  EXPECT_FALSE(precompiler.IsDone());
+  EXPECT_EQ(precompiler.PrecompileUntil(past, compile), 1u);
+  EXPECT_EQ(precompiler.PrecompileUntil(past, compile), 1u);
+  EXPECT_TRUE(precompiler.IsDone());
+  EXPECT_EQ(compile_count, 3u);
+  EXPECT_EQ(precompiler.compiled_count(), 3u);
+}
+
+TEST(ShaderPrecompilerTest, EmptyPrecompilerIsDone) {
+  ShaderPrecompiler precompiler({});
+  EXPECT_TRUE(precompiler.IsDone());
+  EXPECT_EQ(precompiler.PrecompileUntil(
+                fml::TimePoint::Now(),
+                [](const SkData& key, const SkData& sksl) { return true; }),
+            0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
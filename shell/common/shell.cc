@@ -5,12 +5,14 @@
 #define RAPIDJSON_HAS_STDSTRING 1
 #include "flutter/shell/common/shell.h"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 #include <vector>
 
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/common/startup_report.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/icu_util.h"
 #include "flutter/fml/log_settings.h"
@@ -18,6 +20,7 @@
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/runtime/dart_vm.h"
@@ -98,6 +101,13 @@ void PerformInitializationTasks(Settings& settings) {
       settings.engine_start_timestamp =
           std::chrono::microseconds(Dart_TimelineGetMicros());
     }
+    // The embedder may have started the engine well before this, on the clock
+    // of the Dart timeline.
+    const int64_t micros_since_engine_start =
+        Dart_TimelineGetMicros() - settings.engine_start_timestamp.count();
+    StartupReport::GetReportForProcess()->SetStartTime(
+        fml::TimePoint::Now() -
+        fml::TimeDelta::FromMicroseconds(micros_since_engine_start));
 
     tonic::SetLogHandler(
         [](const char* message) { FML_LOG(ERROR) << message; });
@@ -119,10 +129,20 @@ void PerformInitializationTasks(Settings& settings) {
     }
 
     if (settings.icu_initialization_required) {
+      StartupReport::ScopedPhase icu_initialization(
+          StartupReport::Phase::kICUInitialization);
       if (settings.icu_data_path.size() != 0) {
-        fml::icu::InitializeICU(settings.icu_data_path);
+        if (settings.icu_lazy_initialization) {
+          fml::icu::InitializeICULazily(settings.icu_data_path);
+        } else {
+          fml::icu::InitializeICU(settings.icu_data_path);
+        }
       } else if (settings.icu_mapper) {
-        fml::icu::InitializeICUFromMapping(settings.icu_mapper());
+        if (settings.icu_lazy_initialization) {
+          fml::icu::InitializeICUFromMappingLazily(settings.icu_mapper);
+        } else {
+          fml::icu::InitializeICUFromMapping(settings.icu_mapper());
+        }
       } else {
         FML_DLOG(WARNING) << "Skipping ICU initialization in the shell.";
       }
@@ -132,6 +152,60 @@ void PerformInitializationTasks(Settings& settings) {
   PersistentCache::SetCacheSkSL(settings.cache_sksl);
 }
 
+// Fills |document| with the startup report of the process. Times are in
+// microseconds since the engine was started.
+void GetStartupReport(rapidjson::Document* document) {
+  StartupReport* report = StartupReport::GetReportForProcess();
+  const auto start = report->GetStartTime().value_or(fml::TimePoint::Now());
+  const auto first_frame = report->GetFirstFrameTime();
+  auto& allocator = document->GetAllocator();
+  document->SetObject();
+  document->AddMember("type", "StartupReport", allocator);
+  document->AddMember("complete", first_frame.has_value(), allocator);
+  if (first_frame.has_value()) {
+    document->AddMember<int64_t>(
+        "firstFrameMicros", (first_frame.value() - start).ToMicroseconds(),
+        allocator);
+  }
+
+  // Ordered by start, which makes the gaps between the phases the time on the
+  // way to the first frame that none of them account for.
+  rapidjson::Value phases_json(rapidjson::kArrayType);
+  fml::TimeDelta unaccounted;
+  fml::TimePoint last_end = start;
+  for (const auto& timing : report->GetPhaseTimings()) {
+    rapidjson::Value phase_json(rapidjson::kObjectType);
+    phase_json.AddMember(
+        "name", rapidjson::StringRef(StartupReport::GetPhaseName(timing.phase)),
+        allocator);
+    phase_json.AddMember<int64_t>(
+        "startMicros", (timing.start - start).ToMicroseconds(), allocator);
+    phase_json.AddMember<int64_t>("endMicros",
+                                  (timing.end - start).ToMicroseconds(),
+                                  allocator);
+    phase_json.AddMember<int64_t>(
+        "durationMicros", timing.duration.ToMicroseconds(), allocator);
+    phase_json.AddMember<uint64_t>("count", timing.count, allocator);
+    phase_json.AddMember<int64_t>(
+        "gapBeforeMicros", timing.gap_before.ToMicroseconds(), allocator);
+    phases_json.PushBack(phase_json, allocator);
+    unaccounted = unaccounted + timing.gap_before;
+    last_end = std::max(last_end, timing.end);
+  }
+  if (first_frame.has_value() && first_frame.value() > last_end) {
+    unaccounted = unaccounted + (first_frame.value() - last_end);
+  }
+  document->AddMember("phases", phases_json, allocator);
+  document->AddMember<int64_t>("unaccountedMicros",
+                               unaccounted.ToMicroseconds(), allocator);
+  if (const auto page_faults = report->GetPageFaults()) {
+    document->AddMember<int64_t>("minorPageFaults", page_faults->minor,
+                                 allocator);
+    document->AddMember<int64_t>("majorPageFaults", page_faults->major,
+                                 allocator);
+  }
+}
+
 }  // namespace
 
 std::unique_ptr<Shell> Shell::Create(
@@ -149,8 +223,31 @@ std::unique_ptr<Shell> Shell::Create(
   // Always use the `vm_snapshot` and `isolate_snapshot` provided by the
   // settings to launch the VM.  If the VM is already running, the snapshot
   // arguments are ignored.
-  auto vm_snapshot = DartSnapshot::VMSnapshotFromSettings(settings);
-  auto isolate_snapshot = DartSnapshot::IsolateSnapshotFromSettings(settings);
+  fml::RefPtr<const DartSnapshot> vm_snapshot;
+  fml::RefPtr<const DartSnapshot> isolate_snapshot;
+  {
+    StartupReport::ScopedPhase snapshot_mapping(
+        StartupReport::Phase::kSnapshotMapping);
+    vm_snapshot = DartSnapshot::VMSnapshotFromSettings(settings);
+    isolate_snapshot = DartSnapshot::IsolateSnapshotFromSettings(settings);
+  }
+  // The snapshots are only read for the first shell in the process, which
+  // launches the VM. Later shells find them resident already.
+  const bool prefetch_snapshots =
+      settings.prefetch_snapshots && !DartVMRef::IsInstanceRunning();
+  if (prefetch_snapshots) {
+    // The OS reads ahead while the VM is being initialized.
+    for (const auto& snapshot : {vm_snapshot, isolate_snapshot}) {
+      if (snapshot) {
+        snapshot->AdviseWillNeed();
+      }
+    }
+  }
+  if (settings.snapshot_huge_pages && isolate_snapshot &&
+      !isolate_snapshot->AdviseHugePagesForInstructions()) {
+    FML_DLOG(INFO) << "Could not back the isolate snapshot instructions with "
+                      "huge pages.";
+  }
   auto vm = DartVMRef::Create(settings, vm_snapshot, isolate_snapshot);
   FML_CHECK(vm) << "Must be able to initialize the VM.";
 
@@ -159,6 +256,14 @@ std::unique_ptr<Shell> Shell::Create(
   if (!isolate_snapshot) {
     isolate_snapshot = vm->GetVMData()->GetIsolateSnapshot();
   }
+
+  // The isolate snapshot isn't used until the root isolate is created on the
+  // UI thread, after the rest of the shell is set up. Fault it in on a worker
+  // in the meantime.
+  if (prefetch_snapshots && isolate_snapshot) {
+    vm->GetConcurrentWorkerTaskRunner()->PostTask(
+        [snapshot = isolate_snapshot]() { snapshot->Prefetch(); });
+  }
   return CreateWithSnapshot(std::move(platform_data),            //
                             std::move(task_runners),             //
                             std::move(settings),                 //
@@ -204,20 +309,21 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
+        if (shell->GetSettings().enable_tiled_software_rendering) {
+          rasterizer->SetTileTaskRunner(
+              shell->GetDartVM()->GetConcurrentWorkerTaskRunner());
+        }
         snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
 
   // Create the platform view on the platform thread (this thread).
-  auto platform_view = on_create_platform_view(*shell.get());
-  if (!platform_view || !platform_view->GetWeakPtr()) {
-    return nullptr;
+  std::unique_ptr<PlatformView> platform_view;
+  {
+    TRACE_EVENT0("flutter", "ShellSetupPlatformSubsystem");
+    platform_view = on_create_platform_view(*shell.get());
   }
-
-  // Ask the platform view for the vsync waiter. This will be used by the engine
-  // to create the animator.
-  auto vsync_waiter = platform_view->CreateVSyncWaiter();
-  if (!vsync_waiter) {
+  if (!platform_view || !platform_view->GetWeakPtr()) {
     return nullptr;
   }
 
@@ -257,6 +363,34 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
         io_manager_promise.set_value(std::move(io_manager));
       });
 
+  // Ask the platform view for the vsync waiter. This will be used by the engine
+  // to create the animator. The IO manager is already being set up by now,
+  // since it only needs the platform view.
+  auto vsync_waiter = platform_view->CreateVSyncWaiter();
+  if (!vsync_waiter) {
+    // The subsystems set up so far are torn down on their own threads, as they
+    // are when the shell is destroyed. Getting them also waits for the tasks
+    // that refer to the promises on this stack. The platform view must outlive
+    // the release of its resource context.
+    fml::AutoResetWaitableEvent io_latch;
+    fml::TaskRunner::RunNowOrPostTask(
+        io_task_runner,
+        fml::MakeCopyable([io_manager = io_manager_future.get(),
+                           platform_view = platform_view.get(),
+                           &io_latch]() mutable {
+          io_manager.reset();
+          platform_view->ReleaseResourceContext();
+          io_latch.Signal();
+        }));
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners.GetRasterTaskRunner(),
+        fml::MakeCopyable([rasterizer = rasterizer_future.get()]() mutable {
+          rasterizer.reset();
+        }));
+    io_latch.Wait();
+    return nullptr;
+  }
+
   // Send dispatcher_maker to the engine constructor because shell won't have
   // platform_view set until Shell::Setup is called later.
   auto dispatcher_maker = platform_view->GetDispatcherMaker();
@@ -299,10 +433,20 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                              shell->volatile_path_tracker_));
       }));
 
+  std::unique_ptr<Engine> engine;
+  std::unique_ptr<Rasterizer> rasterizer;
+  std::unique_ptr<ShellIOManager> io_manager;
+  {
+    TRACE_EVENT0("flutter", "ShellSetupWaitForSubsystems");
+    engine = engine_future.get();
+    rasterizer = rasterizer_future.get();
+    io_manager = io_manager_future.get();
+  }
+
   if (!shell->Setup(std::move(platform_view),  //
-                    engine_future.get(),       //
-                    rasterizer_future.get(),   //
-                    io_manager_future.get())   //
+                    std::move(engine),         //
+                    std::move(rasterizer),     //
+                    std::move(io_manager))     //
   ) {
     return nullptr;
   }
@@ -427,6 +571,20 @@ Shell::Shell(DartVMRef vm,
           task_runners_.GetRasterTaskRunner(),
           std::bind(&Shell::OnServiceProtocolEstimateRasterCacheMemory, this,
                     std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetShaderPrecompileProgressExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetShaderPrecompileProgress, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetShaderUsageExtensionName] = {
+      task_runners_.GetIOTaskRunner(),
+      std::bind(&Shell::OnServiceProtocolGetShaderUsage, this,
+                std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetStartupReportExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetStartupReport, this,
+                    std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
@@ -435,39 +593,54 @@ Shell::~Shell() {
 
   vm_->GetServiceProtocol()->RemoveHandler(this);
 
-  fml::AutoResetWaitableEvent ui_latch, gpu_latch, platform_latch, io_latch;
+  TRACE_EVENT0("flutter", "Shell::~Shell");
+
+  fml::AutoResetWaitableEvent ui_latch, platform_latch;
 
+  // The engine goes first, because the objects it hands out to Dart code
+  // reference the rasterizer and the IO manager.
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetUITaskRunner(),
       fml::MakeCopyable([engine = std::move(engine_), &ui_latch]() mutable {
+        TRACE_EVENT0("flutter", "ShellTeardownUISubsystem");
         engine.reset();
         ui_latch.Signal();
       }));
   ui_latch.Wait();
 
+  // No platform messages are sent once the engine is gone. Handlers of
+  // background channels may reference embedder state that goes away with the
+  // shell, so make sure none of them run from here on.
+  CancelBackgroundPlatformMessages();
+
+  // The rasterizer and the IO manager do not depend on each other, so they are
+  // torn down at the same time.
+  fml::CountDownLatch gpu_and_io_latch(2);
+
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetRasterTaskRunner(),
-      fml::MakeCopyable(
-          [this, rasterizer = std::move(rasterizer_), &gpu_latch]() mutable {
-            rasterizer.reset();
-            this->weak_factory_gpu_.reset();
-            gpu_latch.Signal();
-          }));
-  gpu_latch.Wait();
+      fml::MakeCopyable([this, rasterizer = std::move(rasterizer_),
+                         &gpu_and_io_latch]() mutable {
+        TRACE_EVENT0("flutter", "ShellTeardownGPUSubsystem");
+        rasterizer.reset();
+        this->weak_factory_gpu_.reset();
+        gpu_and_io_latch.CountDown();
+      }));
 
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetIOTaskRunner(),
       fml::MakeCopyable([io_manager = std::move(io_manager_),
                          platform_view = platform_view_.get(),
-                         &io_latch]() mutable {
+                         &gpu_and_io_latch]() mutable {
+        TRACE_EVENT0("flutter", "ShellTeardownIOSubsystem");
         io_manager.reset();
         if (platform_view) {
           platform_view->ReleaseResourceContext();
         }
-        io_latch.Signal();
+        gpu_and_io_latch.CountDown();
       }));
 
-  io_latch.Wait();
+  gpu_and_io_latch.Wait();
 
   // The platform view must go last because it may be holding onto platform side
   // counterparts to resources owned by subsystems running on other threads. For
@@ -476,6 +649,7 @@ Shell::~Shell() {
       task_runners_.GetPlatformTaskRunner(),
       fml::MakeCopyable([platform_view = std::move(platform_view_),
                          &platform_latch]() mutable {
+        TRACE_EVENT0("flutter", "ShellTeardownPlatformSubsystem");
         platform_view.reset();
         platform_latch.Signal();
       }));
@@ -661,6 +835,13 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
                                       }
                                     });
 
+  // With lazy ICU initialization, map the ICU data in the background so that
+  // it is usually ready by the time the first paragraph is built.
+  if (settings_.icu_lazy_initialization) {
+    vm_->GetConcurrentWorkerTaskRunner()->PostTask(
+        [] { fml::icu::EnsureICUInitialized(); });
+  }
+
   is_setup_ = true;
 
   PersistentCache::GetCacheForProcess()->AddWorkerTaskRunner(
@@ -673,6 +854,9 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
     PersistentCache::GetCacheForProcess()->Purge();
   }
 
+  PersistentCache::GetCacheForProcess()->RaiseSizeLimit(
+      settings_.persistent_cache_size_limit);
+
   return true;
 }
 
@@ -704,6 +888,10 @@ fml::WeakPtr<ShellIOManager> Shell::GetIOManager() {
   return io_manager_->GetWeakPtr();
 }
 
+fml::WeakPtr<Shell> Shell::GetWeakPtr() const {
+  return weak_factory_.GetWeakPtr();
+}
+
 DartVM* Shell::GetDartVM() {
   return &vm_;
 }
@@ -953,12 +1141,119 @@ void Shell::OnPlatformViewDispatchPlatformMessage(
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
-  task_runners_.GetUITaskRunner()->PostTask(
-      [engine = engine_->GetWeakPtr(), message = std::move(message)] {
+  std::vector<fml::RefPtr<PlatformMessage>> flushed;
+  {
+    std::scoped_lock lock(platform_message_batches_mutex_);
+    auto found = platform_message_batches_.find(message->channel());
+    if (found != platform_message_batches_.end()) {
+      auto& batch = found->second;
+      if (!message->response()) {
+        batch.pending.push_back(std::move(message));
+        if (!batch.flush_scheduled) {
+          batch.flush_scheduled = true;
+          // The engine is collected on the UI thread before the shell, so the
+          // shell is alive for as long as the engine is.
+          task_runners_.GetUITaskRunner()->PostDelayedTask(
+              [shell = this, engine = weak_engine_, channel = found->first]() {
+                if (engine) {
+                  shell->FlushPlatformMessageBatch(channel);
+                }
+              },
+              batch.window);
+        }
+        return;
+      }
+      // The response to this message may depend on the messages before it, so
+      // the pending ones are delivered first.
+      flushed = std::move(batch.pending);
+      batch.pending.clear();
+    }
+  }
+
+  task_runners_.GetUITaskRunner()->PostTask(fml::MakeCopyable(
+      [engine = engine_->GetWeakPtr(), message = std::move(message),
+       flushed = std::move(flushed)]() mutable {
         if (engine) {
+          if (!flushed.empty()) {
+            engine->DispatchPlatformMessageBatch(message->channel(),
+                                                 std::move(flushed));
+          }
           engine->DispatchPlatformMessage(std::move(message));
         }
-      });
+      }));
+}
+
+void Shell::SetPlatformMessageBatchWindow(const std::string& channel,
+                                          fml::TimeDelta window) {
+  std::scoped_lock lock(platform_message_batches_mutex_);
+  auto found = platform_message_batches_.find(channel);
+  if (window > fml::TimeDelta::Zero()) {
+    if (found == platform_message_batches_.end()) {
+      platform_message_batches_[channel].window = window;
+    } else {
+      found->second.window = window;
+    }
+    return;
+  }
+
+  if (found == platform_message_batches_.end()) {
+    return;
+  }
+  auto pending = std::move(found->second.pending);
+  platform_message_batches_.erase(found);
+  if (pending.empty()) {
+    return;
+  }
+  task_runners_.GetUITaskRunner()->PostTask(fml::MakeCopyable(
+      [engine = weak_engine_, channel, pending = std::move(pending)]() mutable {
+        if (engine) {
+          engine->DispatchPlatformMessageBatch(channel, std::move(pending));
+        }
+      }));
+}
+
+void Shell::FlushPlatformMessageBatch(const std::string& channel) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+
+  std::vector<fml::RefPtr<PlatformMessage>> pending;
+  {
+    std::scoped_lock lock(platform_message_batches_mutex_);
+    auto found = platform_message_batches_.find(channel);
+    if (found == platform_message_batches_.end()) {
+      return;
+    }
+    pending = std::move(found->second.pending);
+    found->second.pending.clear();
+    found->second.flush_scheduled = false;
+  }
+
+  if (engine_ && !pending.empty()) {
+    TRACE_EVENT0("flutter", "Shell::FlushPlatformMessageBatch");
+    engine_->DispatchPlatformMessageBatch(channel, std::move(pending));
+  }
+}
+
+void Shell::FlushPlatformMessageBatches() {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+
+  std::vector<std::pair<std::string, std::vector<fml::RefPtr<PlatformMessage>>>>
+      batches;
+  {
+    std::scoped_lock lock(platform_message_batches_mutex_);
+    for (auto& [channel, batch] : platform_message_batches_) {
+      if (!batch.pending.empty()) {
+        batches.emplace_back(channel, std::move(batch.pending));
+        batch.pending.clear();
+      }
+    }
+  }
+
+  if (!engine_) {
+    return;
+  }
+  for (auto& [channel, pending] : batches) {
+    engine_->DispatchPlatformMessageBatch(channel, std::move(pending));
+  }
 }
 
 // |PlatformView::Delegate|
@@ -1121,6 +1416,11 @@ void Shell::OnAnimatorBeginFrame(fml::TimePoint frame_target_time) {
     std::scoped_lock time_recorder_lock(time_recorder_mutex_);
     latest_frame_target_time_.emplace(frame_target_time);
   }
+
+  // Batched platform messages are delivered at the latest before the frame
+  // that follows them.
+  FlushPlatformMessageBatches();
+
   if (engine_) {
     engine_->BeginFrame(frame_target_time);
   }
@@ -1212,6 +1512,25 @@ void Shell::OnEngineHandlePlatformMessage(
     return;
   }
 
+  {
+    std::scoped_lock lock(background_platform_message_channels_mutex_);
+    auto found = background_platform_message_channels_.find(message->channel());
+    if (found != background_platform_message_channels_.end() &&
+        found->second.handler) {
+      // The task holds on to the handler, so a handler that is replaced lives
+      // until the messages queued for it have been handled.
+      found->second.task_runner->PostTask(
+          [handler = found->second.handler,
+           cancelled = background_platform_messages_cancelled_,
+           message = std::move(message)]() {
+            if (!cancelled->load()) {
+              (*handler)(std::move(message));
+            }
+          });
+      return;
+    }
+  }
+
   task_runners_.GetPlatformTaskRunner()->PostTask(
       [view = platform_view_->GetWeakPtr(), message = std::move(message)]() {
         if (view) {
@@ -1220,11 +1539,49 @@ void Shell::OnEngineHandlePlatformMessage(
       });
 }
 
+void Shell::SetBackgroundPlatformMessageHandler(
+    const std::string& channel,
+    PlatformMessageHandler handler) {
+  std::shared_ptr<PlatformMessageHandler> retired_handler;
+  {
+    std::scoped_lock lock(background_platform_message_channels_mutex_);
+    auto& entry = background_platform_message_channels_[channel];
+    if (!entry.task_runner) {
+      entry.task_runner = fml::SerialTaskRunner::Create(
+          vm_->GetConcurrentWorkerTaskRunner());
+    }
+    retired_handler = std::move(entry.handler);
+    entry.handler =
+        handler ? std::make_shared<PlatformMessageHandler>(std::move(handler))
+                : nullptr;
+  }
+  // Unless messages are still queued for it, the retired handler is destroyed
+  // here, outside of the lock.
+}
+
+void Shell::CancelBackgroundPlatformMessages() {
+  std::unordered_map<std::string, BackgroundPlatformMessageChannel> channels;
+  {
+    std::scoped_lock lock(background_platform_message_channels_mutex_);
+    channels.swap(background_platform_message_channels_);
+  }
+  background_platform_messages_cancelled_->store(true);
+
+  // Tasks on a serial task runner run in order, so once these have run, no
+  // handler is running or will run again.
+  fml::CountDownLatch latch(channels.size());
+  for (const auto& channel : channels) {
+    channel.second.task_runner->PostTask([&latch]() { latch.CountDown(); });
+  }
+  latch.Wait();
+}
+
 void Shell::HandleEngineSkiaMessage(fml::RefPtr<PlatformMessage> message) {
   const auto& data = message->data();
 
   rapidjson::Document document;
-  document.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  document.Parse(reinterpret_cast<const char*>(data.GetMapping()),
+                 data.GetSize());
   if (document.HasParseError() || !document.IsObject())
     return;
   auto root = document.GetObject();
@@ -1361,6 +1718,18 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
 
+  if (StartupReport::GetReportForProcess()->MarkFirstFrameRasterized(
+          timing.Get(FrameTiming::kRasterFinish)) &&
+      settings_.trace_startup) {
+    rapidjson::Document report;
+    GetStartupReport(&report);
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    report.Accept(writer);
+    PersistentCache::GetCacheForProcess()->DumpStartupReport(
+        buffer.GetString());
+  }
+
   // The C++ callback defined in settings.h and set by Flutter runner. This is
   // independent of the timings report to the Dart side.
   if (settings_.frame_rasterized_callback) {
@@ -1680,6 +2049,77 @@ bool Shell::OnServiceProtocolEstimateRasterCacheMemory(
   return true;
 }
 
+bool Shell::OnServiceProtocolGetShaderPrecompileProgress(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  const ShaderPrecompiler* precompiler =
+      rasterizer_ ? rasterizer_->GetShaderPrecompiler() : nullptr;
+  response->SetObject();
+  response->AddMember("type", "ShaderPrecompileProgress",
+                      response->GetAllocator());
+  // Before the shaders have been loaded there is nothing to report, and
+  // without a GPU context there never will be.
+  response->AddMember("started", precompiler != nullptr,
+                      response->GetAllocator());
+  response->AddMember<uint64_t>("total",
+                                precompiler ? precompiler->total_count() : 0,
+                                response->GetAllocator());
+  response->AddMember<uint64_t>(
+      "attempted", precompiler ? precompiler->attempted_count() : 0,
+      response->GetAllocator());
+  response->AddMember<uint64_t>(
+      "compiled", precompiler ? precompiler->compiled_count() : 0,
+      response->GetAllocator());
+  response->AddMember("done", precompiler && precompiler->IsDone(),
+                      response->GetAllocator());
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetShaderUsage(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  PersistentCache* persistent_cache = PersistentCache::GetCacheForProcess();
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "ShaderUsage", allocator);
+  response->AddMember<uint64_t>("cacheBytes", persistent_cache->GetSize(),
+                                allocator);
+  response->AddMember<uint64_t>("cacheLimitBytes",
+                                persistent_cache->GetSizeLimit(), allocator);
+
+  // Shaders the application had to compile while running, for example because
+  // they were missing from the bundled SkSLs.
+  rapidjson::Value stored_json(rapidjson::kArrayType);
+  for (const auto& key : persistent_cache->GetShadersStoredThisSession()) {
+    stored_json.PushBack(rapidjson::Value(key, allocator), allocator);
+  }
+  response->AddMember("storedThisSession", stored_json, allocator);
+
+  rapidjson::Value shaders_json(rapidjson::kObjectType);
+  for (const auto& usage : persistent_cache->GetShaderUsage()) {
+    rapidjson::Value usage_json(rapidjson::kObjectType);
+    usage_json.AddMember<uint64_t>("bytes", usage.size, allocator);
+    usage_json.AddMember<uint64_t>("hits", usage.hit_count, allocator);
+    usage_json.AddMember<int64_t>("lastUse", usage.last_use, allocator);
+    shaders_json.AddMember(
+        rapidjson::Value(PersistentCache::SkKeyToFilePath(*usage.key),
+                         allocator),
+        usage_json, allocator);
+  }
+  response->AddMember("shaders", shaders_json, allocator);
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetStartupReport(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  GetStartupReport(response);
+  return true;
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolSetAssetBundlePath(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
@@ -5,6 +5,7 @@
 #ifndef SHELL_COMMON_SHELL_H_
 #define SHELL_COMMON_SHELL_H_
 
+#include <atomic>
 #include <functional>
 #include <mutex>
 #include <string_view>
@@ -20,6 +21,7 @@
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/fml/memory/thread_checker.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/serial_task_runner.h"
 #include "flutter/fml/status.h"
 #include "flutter/fml/synchronization/sync_switch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -247,6 +249,14 @@ class Shell final : public PlatformView::Delegate,
   ///
   fml::WeakPtr<ShellIOManager> GetIOManager();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Shells may only be accessed on the platform task runner, which
+  ///             is also where they are destroyed.
+  ///
+  /// @return     A weak pointer to this shell.
+  ///
+  fml::WeakPtr<Shell> GetWeakPtr() const;
+
   // Embedders should call this under low memory conditions to free up
   // internal caches used.
   //
@@ -346,6 +356,66 @@ class Shell final : public PlatformView::Delegate,
   ///
   double GetMainDisplayRefreshRate();
 
+  //----------------------------------------------------------------------------
+  /// @brief      A handler for platform messages sent by the framework on a
+  ///             channel that is serviced off the platform thread.
+  ///
+  using PlatformMessageHandler =
+      std::function<void(fml::RefPtr<PlatformMessage>)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Routes platform messages sent by the framework on the given
+  ///             channel to a handler invoked on a background thread instead
+  ///             of to the platform view on the platform thread. Channels
+  ///             whose handlers are expensive (decoding large payloads, file
+  ///             or database access) can use this to avoid stalling the
+  ///             platform thread.
+  ///
+  ///             Each channel gets a serial task runner, owned by the shell
+  ///             and backed by the concurrent worker pool of the Dart VM, so
+  ///             messages on a channel are handled one at a time and in
+  ///             order. The runner is kept when the handler is replaced, so
+  ///             messages already queued are handled by the previous handler
+  ///             before any are handled by the new one. A handler is
+  ///             destroyed once it has been replaced and its queued messages
+  ///             have been handled, or when the shell is destroyed.
+  ///
+  ///             Messages that have not been handled by the time the shell
+  ///             is destroyed are dropped. The shell waits for handlers that
+  ///             are running to return, so handlers must not block on the
+  ///             platform thread.
+  ///
+  ///             This method may be called on any thread.
+  ///
+  /// @param[in]  channel      The channel to route.
+  /// @param[in]  handler      The handler. If this is empty, messages on the
+  ///                          channel are once again delivered to the platform
+  ///                          view.
+  ///
+  void SetBackgroundPlatformMessageHandler(const std::string& channel,
+                                           PlatformMessageHandler handler);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Enables or disables batching of the platform messages sent by
+  ///             the embedder to the framework on the given channel. Messages
+  ///             that don't expect a response are coalesced and delivered to
+  ///             the framework in a single invocation at the start of the next
+  ///             frame or once the window has elapsed, whichever comes first.
+  ///             This amortizes the per-message dispatch overhead for high
+  ///             frequency channels like sensor streams. Messages expecting a
+  ///             response flush the pending batch and are delivered
+  ///             immediately afterwards.
+  ///
+  ///             This method may be called on any thread.
+  ///
+  /// @param[in]  channel  The channel to batch messages on.
+  /// @param[in]  window   The maximum time a message may be held back. If this
+  ///                      is zero, batching is disabled and pending messages
+  ///                      are delivered.
+  ///
+  void SetPlatformMessageBatchWindow(const std::string& channel,
+                                     fml::TimeDelta window);
+
  private:
   using ServiceProtocolHandler =
       std::function<bool(const ServiceProtocol::Handler::ServiceProtocolMap&,
@@ -375,6 +445,32 @@ class Shell final : public PlatformView::Delegate,
                                                         // pair
                      >
       service_protocol_handlers_;
+  // Channels whose platform messages are not delivered to the platform view.
+  // The handler is empty once it has been unregistered, but the task runner
+  // is kept so that the channel's messages stay in order if another handler
+  // is registered. Set on any thread and read on the UI thread.
+  struct BackgroundPlatformMessageChannel {
+    fml::RefPtr<fml::SerialTaskRunner> task_runner;
+    std::shared_ptr<PlatformMessageHandler> handler;
+  };
+  std::mutex background_platform_message_channels_mutex_;
+  std::unordered_map<std::string, BackgroundPlatformMessageChannel>
+      background_platform_message_channels_;
+  // Set while the shell is destroyed, after which queued background messages
+  // are dropped instead of handled.
+  std::shared_ptr<std::atomic_bool> background_platform_messages_cancelled_ =
+      std::make_shared<std::atomic_bool>(false);
+  // Platform messages held back on channels for which batching is enabled.
+  struct PlatformMessageBatch {
+    fml::TimeDelta window;
+    std::vector<fml::RefPtr<PlatformMessage>> pending;
+    bool flush_scheduled = false;
+  };
+  // Set on any thread, appended to on the platform thread and flushed on the
+  // UI thread.
+  std::mutex platform_message_batches_mutex_;
+  std::unordered_map<std::string, PlatformMessageBatch>
+      platform_message_batches_;
   bool is_setup_ = false;
   bool is_added_to_service_protocol_ = false;
   uint64_t next_pointer_flow_id_ = 0;
@@ -447,6 +543,14 @@ class Shell final : public PlatformView::Delegate,
 
   void ReportTimings();
 
+  // Takes the messages pending in the batch for |channel| and dispatches them
+  // to the engine. Must be called on the UI task runner.
+  void FlushPlatformMessageBatch(const std::string& channel);
+
+  // Flushes the pending messages of all batched channels. Must be called on
+  // the UI task runner.
+  void FlushPlatformMessageBatches();
+
   // |PlatformView::Delegate|
   void OnPlatformViewCreated(std::unique_ptr<Surface> surface) override;
 
@@ -532,6 +636,10 @@ class Shell final : public PlatformView::Delegate,
   void OnEngineHandlePlatformMessage(
       fml::RefPtr<PlatformMessage> message) override;
 
+  // Drops the platform messages queued for background handlers and waits
+  // for the handlers that are running to return.
+  void CancelBackgroundPlatformMessages();
+
   void HandleEngineSkiaMessage(fml::RefPtr<PlatformMessage> message);
 
   // |Engine::Delegate|
@@ -619,6 +727,30 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Reports how many of the cached SkSL shaders have been precompiled so far.
+  bool OnServiceProtocolGetShaderPrecompileProgress(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Reports the shaders compiled while the application was running, and how
+  // often and how recently each shader in the persistent cache was used. The
+  // keys are Base32 encoded, as in |OnServiceProtocolGetSkSLs|.
+  bool OnServiceProtocolGetShaderUsage(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Reports where the time went between the engine being started and the
+  // first frame being rasterized. See |StartupReport|.
+  bool OnServiceProtocolGetStartupReport(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Creates an asset bundle from the original settings asset path or
   // directory.
   std::unique_ptr<DirectoryAssetBundle> RestoreOriginalAssetResolver();
@@ -13,13 +13,20 @@
 
 namespace flutter {
 
+// With |single_thread|, all of the shell's task runners share the platform
+// thread, so that none of the subsystems can be set up or torn down in
+// parallel. Comparing against it shows how much the shell gains from doing
+// so.
 static void StartupAndShutdownShell(benchmark::State& state,
                                     bool measure_startup,
-                                    bool measure_shutdown) {
+                                    bool measure_shutdown,
+                                    bool single_thread = false) {
   auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
                                        fml::FilePermission::kRead);
   std::unique_ptr<Shell> shell;
   std::unique_ptr<ThreadHost> thread_host;
+  fml::RefPtr<fml::TaskRunner> platform_task_runner;
+  fml::RefPtr<fml::TaskRunner> ui_task_runner;
   testing::ELFAOTSymbols aot_symbols;
 
   {
@@ -43,15 +50,21 @@ static void StartupAndShutdownShell(benchmark::State& state,
     }
 
     thread_host = std::make_unique<ThreadHost>(
-        "io.flutter.bench.", ThreadHost::Type::Platform |
-                                 ThreadHost::Type::RASTER |
-                                 ThreadHost::Type::IO | ThreadHost::Type::UI);
-
-    TaskRunners task_runners("test",
-                             thread_host->platform_thread->GetTaskRunner(),
-                             thread_host->raster_thread->GetTaskRunner(),
-                             thread_host->ui_thread->GetTaskRunner(),
-                             thread_host->io_thread->GetTaskRunner());
+        "io.flutter.bench.",
+        single_thread ? ThreadHost::Type::Platform
+                      : ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                            ThreadHost::Type::IO | ThreadHost::Type::UI);
+
+    platform_task_runner = thread_host->platform_thread->GetTaskRunner();
+    ui_task_runner = single_thread ? platform_task_runner
+                                   : thread_host->ui_thread->GetTaskRunner();
+    TaskRunners task_runners(
+        "test", platform_task_runner,
+        single_thread ? platform_task_runner
+                      : thread_host->raster_thread->GetTaskRunner(),
+        ui_task_runner,
+        single_thread ? platform_task_runner
+                      : thread_host->io_thread->GetTaskRunner());
 
     shell = Shell::Create(
         flutter::PlatformData(), std::move(task_runners), settings,
@@ -73,7 +86,7 @@ static void StartupAndShutdownShell(benchmark::State& state,
     benchmarking::ScopedPauseTiming pause(
         state, !measure_shutdown || !measure_startup);
     fml::AutoResetWaitableEvent latch;
-    fml::TaskRunner::RunNowOrPostTask(thread_host->ui_thread->GetTaskRunner(),
+    fml::TaskRunner::RunNowOrPostTask(ui_task_runner,
                                       [&latch]() { latch.Signal(); });
     latch.Wait();
   }
@@ -83,8 +96,7 @@ static void StartupAndShutdownShell(benchmark::State& state,
     // Shutdown must occur synchronously on the platform thread.
     fml::AutoResetWaitableEvent latch;
     fml::TaskRunner::RunNowOrPostTask(
-        thread_host->platform_thread->GetTaskRunner(),
-        [&shell, &latch]() mutable {
+        platform_task_runner, [&shell, &latch]() mutable {
           shell.reset();
           latch.Signal();
         });
@@ -119,4 +131,20 @@ static void BM_ShellInitializationAndShutdown(benchmark::State& state) {
 
 BENCHMARK(BM_ShellInitializationAndShutdown);
 
+static void BM_ShellInitializationOnOneThread(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    StartupAndShutdownShell(state, true, false, true);
+  }
+}
+
+BENCHMARK(BM_ShellInitializationOnOneThread);
+
+static void BM_ShellShutdownOnOneThread(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    StartupAndShutdownShell(state, false, true, true);
+  }
+}
+
+BENCHMARK(BM_ShellShutdownOnOneThread);
+
 }  // namespace flutter
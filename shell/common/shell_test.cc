@@ -253,6 +253,16 @@ void ShellTest::OnServiceProtocol(
           case ServiceProtocolEnum::kEstimateRasterCacheMemory:
             shell->OnServiceProtocolEstimateRasterCacheMemory(params, response);
             break;
+          case ServiceProtocolEnum::kGetShaderPrecompileProgress:
+            shell->OnServiceProtocolGetShaderPrecompileProgress(params,
+                                                               response);
+            break;
+          case ServiceProtocolEnum::kGetShaderUsage:
+            shell->OnServiceProtocolGetShaderUsage(params, response);
+            break;
+          case ServiceProtocolEnum::kGetStartupReport:
+            shell->OnServiceProtocolGetStartupReport(params, response);
+            break;
           case ServiceProtocolEnum::kSetAssetBundlePath:
             shell->OnServiceProtocolSetAssetBundlePath(params, response);
             break;
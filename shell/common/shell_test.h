@@ -96,6 +96,9 @@ class ShellTest : public FixtureTest {
   enum ServiceProtocolEnum {
     kGetSkSLs,
     kEstimateRasterCacheMemory,
+    kGetShaderPrecompileProgress,
+    kGetShaderUsage,
+    kGetStartupReport,
     kSetAssetBundlePath,
     kRunInView,
   };
@@ -5,14 +5,19 @@
 #define FML_USED_ON_EMBEDDER
 
 #include <algorithm>
+#include <chrono>
 #include <ctime>
 #include <functional>
 #include <future>
 #include <memory>
+#include <thread>
 #include <vector>
 
 #include "assets/directory_asset_bundle.h"
+#include "flutter/assets/asset_index.h"
+#include "flutter/assets/packed_asset_bundle.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/common/startup_report.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/layers/picture_layer.h"
 #include "flutter/flow/layers/transform_layer.h"
@@ -31,6 +36,7 @@
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/shell/common/vsync_waiter_fallback.h"
+#include "flutter/shell/common/warm_shell_pool.h"
 #include "flutter/shell/version/version.h"
 #include "flutter/testing/testing.h"
 #include "gmock/gmock.h"
@@ -1397,6 +1403,59 @@ TEST_F(ShellTest, WaitForFirstFrame) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, ReportsStartupUntilFirstFrame) {
+  StartupReport::GetReportForProcess()->ResetForTesting();
+  auto settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+  PumpOneFrame(shell.get());
+  ASSERT_TRUE(
+      shell->WaitForFirstFrame(fml::TimeDelta::FromMilliseconds(1000)).ok());
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetStartupReport,
+                    shell->GetTaskRunners().GetIOTaskRunner(), empty_params,
+                    &document);
+  ASSERT_TRUE(document["complete"].GetBool());
+  const int64_t first_frame = document["firstFrameMicros"].GetInt64();
+
+  std::vector<std::string> phases;
+  int64_t last_start = 0;
+  for (const auto& phase : document["phases"].GetArray()) {
+    phases.push_back(phase["name"].GetString());
+    ASSERT_GE(phase["startMicros"].GetInt64(), last_start);
+    ASSERT_LE(phase["endMicros"].GetInt64(), first_frame);
+    last_start = phase["startMicros"].GetInt64();
+  }
+  if (document.HasMember("minorPageFaults")) {
+    ASSERT_GE(document["minorPageFaults"].GetInt64(), 0);
+    ASSERT_GE(document["majorPageFaults"].GetInt64(), 0);
+  }
+  // The VM may have been started by an earlier test.
+  for (const char* phase :
+       {"snapshotMapping", "assetManagerCreation", "isolateCreation",
+        "rootIsolateMain", "beginFrame", "rasterizerDraw"}) {
+    EXPECT_NE(std::find(phases.begin(), phases.end(), phase), phases.end())
+        << phase;
+  }
+
+  // Frames after the first are not part of the report.
+  PumpOneFrame(shell.get());
+  rapidjson::Document later_document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetStartupReport,
+                    shell->GetTaskRunners().GetIOTaskRunner(), empty_params,
+                    &later_document);
+  ASSERT_EQ(later_document["phases"].Size(), document["phases"].Size());
+  ASSERT_EQ(later_document["firstFrameMicros"].GetInt64(), first_frame);
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, WaitForFirstFrameZeroSizeFrame) {
   auto settings = CreateSettingsForFixture();
   std::unique_ptr<Shell> shell = CreateShell(settings);
@@ -2456,6 +2515,114 @@ TEST_F(ShellTest, AssetManagerMulti) {
   }
 }
 
+TEST_F(ShellTest, AssetManagerUsesAssetIndex) {
+  fml::ScopedTemporaryDirectory asset_dir;
+  fml::UniqueFD asset_dir_fd = fml::OpenDirectory(
+      asset_dir.path().c_str(), false, fml::FilePermission::kRead);
+
+  std::vector<std::string> filenames = {
+      "indexed0",
+      "indexed1",
+      "unindexed",
+  };
+
+  for (auto filename : filenames) {
+    bool success = fml::WriteAtomically(asset_dir_fd, filename.c_str(),
+                                        fml::DataMapping(filename));
+    ASSERT_TRUE(success);
+  }
+
+  auto index = AssetIndex::Serialize({"indexed0", "indexed1", "missing"});
+  ASSERT_TRUE(fml::WriteAtomically(asset_dir_fd, AssetIndex::kFileName,
+                                   fml::DataMapping(std::move(index))));
+
+  AssetManager asset_manager;
+  asset_manager.PushBack(
+      std::make_unique<DirectoryAssetBundle>(std::move(asset_dir_fd), false));
+
+  ASSERT_NE(asset_manager.GetAsMapping("indexed0"), nullptr);
+  // Assets that aren't in the index are not looked for.
+  ASSERT_EQ(asset_manager.GetAsMapping("unindexed"), nullptr);
+  ASSERT_EQ(asset_manager.GetAsMapping("missing"), nullptr);
+
+  auto mappings = asset_manager.GetAsMappings("(.*)");
+  ASSERT_EQ(mappings.size(), 2u);
+  mappings = asset_manager.GetAsMappings("(.*)1");
+  ASSERT_EQ(mappings.size(), 1u);
+  std::string result(reinterpret_cast<const char*>(mappings[0]->GetMapping()),
+                     mappings[0]->GetSize());
+  ASSERT_EQ(result, "indexed1");
+
+  // Another bundle on the same directory shares the index and the mappings.
+  std::unique_ptr<AssetResolver> reopened =
+      std::make_unique<DirectoryAssetBundle>(
+          fml::OpenDirectory(asset_dir.path().c_str(), false,
+                             fml::FilePermission::kRead),
+          false);
+  auto first = asset_manager.GetAsMapping("indexed1");
+  auto second = reopened->GetAsMapping("indexed1");
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  ASSERT_EQ(first->GetMapping(), second->GetMapping());
+  ASSERT_EQ(reopened->GetAsMapping("unindexed"), nullptr);
+}
+
+TEST_F(ShellTest, PackedAssetBundleResolvesSlicesOfTheArchive) {
+  fml::ScopedTemporaryDirectory asset_dir;
+  fml::UniqueFD asset_dir_fd = fml::OpenDirectory(
+      asset_dir.path().c_str(), false, fml::FilePermission::kRead);
+
+  std::vector<PackedAssetBundle::Asset> assets = {
+      {"fonts/good.ttf", {'f', 'o', 'n', 't'}, PackedAssetBundle::kPrefetch},
+      {"good", {'g', 'o', 'o', 'd'}},
+      {"bad", {'b', 'a', 'd'}},
+  };
+  ASSERT_TRUE(fml::WriteAtomically(
+      asset_dir_fd, PackedAssetBundle::kFileName,
+      fml::DataMapping(PackedAssetBundle::Pack(std::move(assets)))));
+
+  auto bundle = std::make_unique<PackedAssetBundle>(
+      fml::FileMapping::CreateReadOnly(asset_dir_fd,
+                                       PackedAssetBundle::kFileName),
+      false);
+  ASSERT_TRUE(bundle->Prefetch("good"));
+  ASSERT_FALSE(bundle->Prefetch("missing"));
+
+  auto asset_manager = std::make_unique<AssetManager>();
+  asset_manager->PushBack(std::move(bundle));
+
+  auto mapping = asset_manager->GetAsMapping("fonts/good.ttf");
+  ASSERT_NE(mapping, nullptr);
+  ASSERT_EQ(asset_manager->GetAsMapping("good.ttf"), nullptr);
+  ASSERT_EQ(asset_manager->GetAsMapping("missing"), nullptr);
+  ASSERT_EQ(asset_manager->GetAsMappings("(.*)").size(), 3u);
+  ASSERT_EQ(asset_manager->GetAsMappings("good(.*)").size(), 2u);
+
+  // Mappings keep the archive mapped after the bundle is gone.
+  asset_manager.reset();
+  std::string result(reinterpret_cast<const char*>(mapping->GetMapping()),
+                     mapping->GetSize());
+  ASSERT_EQ(result, "font");
+}
+
+TEST_F(ShellTest, PackedAssetBundleRejectsDamagedArchive) {
+  auto archive = PackedAssetBundle::Pack({{"good", {'g', 'o', 'o', 'd'}}});
+  archive.resize(archive.size() - 1);
+
+  fml::ScopedTemporaryDirectory asset_dir;
+  fml::UniqueFD asset_dir_fd = fml::OpenDirectory(
+      asset_dir.path().c_str(), false, fml::FilePermission::kRead);
+  ASSERT_TRUE(fml::WriteAtomically(asset_dir_fd, PackedAssetBundle::kFileName,
+                                   fml::DataMapping(std::move(archive))));
+
+  AssetManager asset_manager;
+  asset_manager.PushBack(std::make_unique<PackedAssetBundle>(
+      fml::FileMapping::CreateReadOnly(asset_dir_fd,
+                                       PackedAssetBundle::kFileName),
+      false));
+  ASSERT_EQ(asset_manager.GetAsMapping("good"), nullptr);
+}
+
 TEST_F(ShellTest, Spawn) {
   auto settings = CreateSettingsForFixture();
   auto shell = CreateShell(settings);
@@ -2541,6 +2708,74 @@ TEST_F(ShellTest, Spawn) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, WarmShellPoolHandsOutRunningShells) {
+  auto settings = CreateSettingsForFixture();
+  auto shell = CreateShell(settings);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  ASSERT_TRUE(configuration.IsValid());
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+
+  MockPlatformViewDelegate platform_view_delegate;
+  auto create_platform_view = [&platform_view_delegate](Shell& shell) {
+    auto result = std::make_unique<MockPlatformView>(platform_view_delegate,
+                                                     shell.GetTaskRunners());
+    ON_CALL(*result, CreateRenderingSurface())
+        .WillByDefault(
+            ::testing::Invoke([] { return std::make_unique<MockSurface>(); }));
+    return result;
+  };
+  auto create_configuration = [&settings]() {
+    auto configuration = RunConfiguration::InferFromSettings(settings);
+    configuration.SetEntrypoint("testCanLaunchSecondaryIsolate");
+    return configuration;
+  };
+  AddNativeCallback("NotifyNative", CREATE_NATIVE_ENTRY([](auto args) {}));
+
+  auto platform_task_runner = shell->GetTaskRunners().GetPlatformTaskRunner();
+  std::unique_ptr<WarmShellPool> pool;
+  PostSync(platform_task_runner, [&]() {
+    pool = std::make_unique<WarmShellPool>(
+        *shell, 2, create_configuration, create_platform_view,
+        [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+    // The pool is filled in the background.
+    ASSERT_EQ(pool->GetWarmShellCount(), 0u);
+  });
+  auto wait_for_warm_shells = [&](size_t count) {
+    while (true) {
+      size_t warm_shell_count = 0;
+      PostSync(platform_task_runner, [&]() {
+        warm_shell_count = pool->GetWarmShellCount();
+      });
+      if (warm_shell_count == count) {
+        return;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  };
+  wait_for_warm_shells(2);
+
+  PostSync(platform_task_runner, [&]() {
+    auto warm_shell = pool->Take();
+    ASSERT_NE(warm_shell, nullptr);
+    ASSERT_TRUE(ValidateShell(warm_shell.get()));
+    ASSERT_EQ(pool->GetWarmShellCount(), 1u);
+    PostSync(warm_shell->GetTaskRunners().GetUITaskRunner(), [&warm_shell] {
+      ASSERT_EQ("testCanLaunchSecondaryIsolate",
+                warm_shell->GetEngine()->GetLastEntrypoint());
+    });
+    DestroyShell(std::move(warm_shell));
+  });
+  // The taken shell is replaced.
+  wait_for_warm_shells(2);
+  PostSync(platform_task_runner, [&]() { pool.reset(); });
+
+  DestroyShell(std::move(shell));
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+}
+
 TEST_F(ShellTest, UpdateAssetResolverByTypeReplaces) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
   Settings settings = CreateSettingsForFixture();
@@ -280,6 +280,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_software_rendering =
       command_line.HasOption(FlagForSwitch(Switch::EnableSoftwareRendering));
 
+  settings.enable_tiled_software_rendering = command_line.HasOption(
+      FlagForSwitch(Switch::EnableTiledSoftwareRendering));
+
   settings.endless_trace_buffer =
       command_line.HasOption(FlagForSwitch(Switch::EndlessTraceBuffer));
 
@@ -352,12 +355,19 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
         {snapshot_asset_path, isolate_snapshot_instr_filename});
   }
 
+  settings.prefetch_snapshots =
+      command_line.HasOption(FlagForSwitch(Switch::PrefetchSnapshots));
+  settings.snapshot_huge_pages =
+      command_line.HasOption(FlagForSwitch(Switch::SnapshotHugePages));
+
   command_line.GetOptionValue(FlagForSwitch(Switch::CacheDirPath),
                               &settings.temp_directory_path);
 
   if (settings.icu_initialization_required) {
     command_line.GetOptionValue(FlagForSwitch(Switch::ICUDataFilePath),
                                 &settings.icu_data_path);
+    settings.icu_lazy_initialization =
+        command_line.HasOption(FlagForSwitch(Switch::ICULazyInitialization));
     if (command_line.HasOption(FlagForSwitch(Switch::ICUSymbolPrefix))) {
       std::string icu_symbol_prefix, native_lib_path;
       command_line.GetOptionValue(FlagForSwitch(Switch::ICUSymbolPrefix),
@@ -381,6 +391,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_skparagraph =
       command_line.HasOption(FlagForSwitch(Switch::EnableSkParagraph));
 
+  settings.enable_display_list =
+      command_line.HasOption(FlagForSwitch(Switch::EnableDisplayList));
+
   std::string all_dart_flags;
   if (command_line.GetOptionValue(FlagForSwitch(Switch::DartFlags),
                                   &all_dart_flags)) {
@@ -409,6 +422,13 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.purge_persistent_cache =
       command_line.HasOption(FlagForSwitch(Switch::PurgePersistentCache));
 
+  if (command_line.HasOption(FlagForSwitch(Switch::PersistentCacheSizeLimit))) {
+    std::string size_limit;
+    command_line.GetOptionValue(FlagForSwitch(Switch::PersistentCacheSizeLimit),
+                                &size_limit);
+    settings.persistent_cache_size_limit = std::stoull(size_limit);
+  }
+
   if (command_line.HasOption(FlagForSwitch(Switch::OldGenHeapSize))) {
     std::string old_gen_heap_size;
     command_line.GetOptionValue(FlagForSwitch(Switch::OldGenHeapSize),
@@ -49,12 +49,24 @@ DEF_SWITCH(IsolateSnapshotInstructions,
            "isolate-snapshot-instr",
            "The isolate instructions snapshot that will be memory mapped as "
            "read and executable. SnapshotAssetPath must be present.")
+DEF_SWITCH(PrefetchSnapshots,
+           "prefetch-snapshots",
+           "Read the VM and isolate snapshots ahead of their first use, in "
+           "the background while the shell is being set up.")
+DEF_SWITCH(SnapshotHugePages,
+           "snapshot-huge-pages",
+           "Ask for the snapshot instructions to be backed by transparent huge "
+           "pages, where the platform and file system allow it.")
 DEF_SWITCH(CacheDirPath,
            "cache-dir-path",
            "Path to the cache directory. "
            "This is different from the persistent_cache_path in embedder.h, "
            "which is used for Skia shader cache.")
 DEF_SWITCH(ICUDataFilePath, "icu-data-file-path", "Path to the ICU data file.")
+DEF_SWITCH(ICULazyInitialization,
+           "icu-lazy-initialization",
+           "Map the ICU data in the background or on first use instead of "
+           "while the shell is created, keeping it off the startup path.")
 DEF_SWITCH(ICUSymbolPrefix,
            "icu-symbol-prefix",
            "Prefix for the symbols representing ICU data linked into the "
@@ -101,6 +113,11 @@ DEF_SWITCH(EnableSoftwareRendering,
            "Enable rendering using the Skia software backend. This is useful "
            "when testing Flutter on emulators. By default, Flutter will "
            "attempt to either use OpenGL, Metal, or Vulkan.")
+DEF_SWITCH(EnableTiledSoftwareRendering,
+           "enable-tiled-software-rendering",
+           "Split frames that are rendered in software into tiles, and paint "
+           "them in parallel on the concurrent worker threads. This speeds up "
+           "large frames on devices that render without a GPU.")
 DEF_SWITCH(SkiaDeterministicRendering,
            "skia-deterministic-rendering",
            "Skips the call to SkGraphics::Init(), thus avoiding swapping out "
@@ -126,7 +143,8 @@ DEF_SWITCH(EnableCheckedMode, "enable-checked-mode", "Enable checked mode.")
 DEF_SWITCH(TraceStartup,
            "trace-startup",
            "Trace early application lifecycle. Automatically switches to an "
-           "endless trace buffer.")
+           "endless trace buffer, and writes a report of the time to the first "
+           "frame to the persistent cache directory.")
 DEF_SWITCH(TraceSkia,
            "trace-skia",
            "Trace Skia calls. This is useful when debugging the GPU threed."
@@ -155,6 +173,11 @@ DEF_SWITCH(PurgePersistentCache,
            "purge-persistent-cache",
            "Remove all existing persistent cache. This is mainly for debugging "
            "purposes such as reproducing the shader compilation jank.")
+DEF_SWITCH(PersistentCacheSizeLimit,
+           "persistent-cache-size-limit",
+           "The size limit in bytes for the shaders in the persistent cache. "
+           "Once the cache grows past it, the least recently used shaders are "
+           "evicted. By default, the cache is not limited.")
 DEF_SWITCH(
     TraceSystrace,
     "trace-systrace",
@@ -205,6 +228,10 @@ DEF_SWITCH(OldGenHeapSize,
 DEF_SWITCH(EnableSkParagraph,
            "enable-skparagraph",
            "Selects the SkParagraph implementation of the text layout engine.")
+DEF_SWITCH(EnableDisplayList,
+           "enable-display-list",
+           "Records pictures into the engine's own display lists instead of "
+           "SkPictures.")
 
 DEF_SWITCHES_END
 
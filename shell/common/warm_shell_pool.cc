@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/warm_shell_pool.h"
+
+#include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+WarmShellPool::WarmShellPool(
+    Shell& spawner,
+    size_t capacity,
+    ConfigurationCallback on_create_configuration,
+    Shell::CreateCallback<PlatformView> on_create_platform_view,
+    Shell::CreateCallback<Rasterizer> on_create_rasterizer)
+    : spawner_(spawner.GetWeakPtr()),
+      platform_task_runner_(
+          spawner.GetTaskRunners().GetPlatformTaskRunner()),
+      refill_task_runner_(
+          spawner.GetDartVM()->GetConcurrentWorkerTaskRunner()),
+      capacity_(capacity),
+      on_create_configuration_(std::move(on_create_configuration)),
+      on_create_platform_view_(std::move(on_create_platform_view)),
+      on_create_rasterizer_(std::move(on_create_rasterizer)),
+      weak_factory_(this) {
+  FML_DCHECK(platform_task_runner_->RunsTasksOnCurrentThread());
+  ScheduleRefill();
+}
+
+WarmShellPool::~WarmShellPool() {
+  FML_DCHECK(platform_task_runner_->RunsTasksOnCurrentThread());
+}
+
+std::unique_ptr<Shell> WarmShellPool::Take() {
+  FML_DCHECK(platform_task_runner_->RunsTasksOnCurrentThread());
+  std::unique_ptr<Shell> shell;
+  if (shells_.empty()) {
+    FML_DLOG(INFO) << "The warm shell pool is empty. Spawning a shell.";
+    shell = SpawnShell(on_create_configuration_());
+  } else {
+    shell = std::move(shells_.front());
+    shells_.pop_front();
+  }
+  ScheduleRefill();
+  return shell;
+}
+
+std::unique_ptr<Shell> WarmShellPool::SpawnShell(
+    RunConfiguration configuration) {
+  TRACE_EVENT0("flutter", "WarmShellPool::SpawnShell");
+  if (!spawner_) {
+    return nullptr;
+  }
+  if (!configuration.IsValid()) {
+    FML_LOG(ERROR) << "Could not create a configuration for a warm shell.";
+    return nullptr;
+  }
+  return spawner_->Spawn(std::move(configuration), on_create_platform_view_,
+                         on_create_rasterizer_);
+}
+
+void WarmShellPool::ScheduleRefill() {
+  if (refill_pending_ || shells_.size() >= capacity_ || !spawner_) {
+    return;
+  }
+  refill_pending_ = true;
+  refill_task_runner_->PostTask(
+      [platform_task_runner = platform_task_runner_,
+       on_create_configuration = on_create_configuration_,
+       pool = weak_factory_.GetWeakPtr()]() {
+        TRACE_EVENT0("flutter", "WarmShellPool::CreateConfiguration");
+        platform_task_runner->PostTask(fml::MakeCopyable(
+            [pool, configuration = on_create_configuration()]() mutable {
+              if (pool) {
+                pool->Refill(std::move(configuration));
+              }
+            }));
+      });
+}
+
+void WarmShellPool::Refill(RunConfiguration configuration) {
+  refill_pending_ = false;
+  if (shells_.size() >= capacity_) {
+    return;
+  }
+  auto shell = SpawnShell(std::move(configuration));
+  if (!shell) {
+    // Don't keep trying if spawning fails. The next |Take| tries again.
+    return;
+  }
+  shells_.push_back(std::move(shell));
+  ScheduleRefill();
+}
+
+}  // namespace flutter
@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_WARM_SHELL_POOL_H_
+#define SHELL_COMMON_WARM_SHELL_POOL_H_
+
+#include <deque>
+#include <functional>
+#include <memory>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/shell/common/run_configuration.h"
+#include "flutter/shell/common/shell.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Keeps a number of shells spawned from a running shell with |Shell::Spawn|,
+/// so that a new view can be given one whose isolate is already running
+/// instead of waiting for a shell to be created.
+///
+/// The warm shells have their platform view, rasterizer, IO manager and engine
+/// set up, and their engine running the entrypoint of the configuration, but
+/// no surface. A shell taken from the pool is attached to its view by
+/// notifying its platform view that the surface has been created, which
+/// schedules its first frame.
+///
+/// The pool is refilled from the VM's concurrent worker task runner, which
+/// creates the configuration of each shell. Only the part of spawning that
+/// must run on the platform task runner, creating the platform view and
+/// launching the engine, is posted there, one shell at a time, so that other
+/// platform tasks, like those of the view that just took a shell, run in
+/// between.
+///
+/// The pool must only be used on the platform task runner of the spawner. It
+/// holds the spawner weakly: once the spawner is destroyed, the pool stops
+/// refilling and |Take| only hands out the shells it already has.
+///
+class WarmShellPool {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the configuration each warm shell is run with. It
+  ///             must be in the same snapshot or AOT as the spawner's. Called
+  ///             on a worker thread when the pool is refilled, so it must be
+  ///             thread-safe.
+  ///
+  using ConfigurationCallback = std::function<RunConfiguration()>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a pool of up to |capacity| shells spawned from
+  ///             |spawner|, and starts filling it. The platform view and
+  ///             rasterizer callbacks are called once for every shell, so
+  ///             each call must create new objects.
+  ///
+  WarmShellPool(Shell& spawner,
+                size_t capacity,
+                ConfigurationCallback on_create_configuration,
+                Shell::CreateCallback<PlatformView> on_create_platform_view,
+                Shell::CreateCallback<Rasterizer> on_create_rasterizer);
+
+  ~WarmShellPool();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Takes the shell that has been warm the longest, or spawns one
+  ///             right away if the pool is empty, and schedules a shell to
+  ///             take its place.
+  ///
+  /// @return     A running shell, or nullptr if one could not be spawned,
+  ///             such as after the spawner has been destroyed.
+  ///
+  std::unique_ptr<Shell> Take();
+
+  size_t GetWarmShellCount() const { return shells_.size(); }
+
+  size_t GetCapacity() const { return capacity_; }
+
+ private:
+  const fml::WeakPtr<Shell> spawner_;
+  const fml::RefPtr<fml::TaskRunner> platform_task_runner_;
+  const std::shared_ptr<fml::ConcurrentTaskRunner> refill_task_runner_;
+  const size_t capacity_;
+  const ConfigurationCallback on_create_configuration_;
+  const Shell::CreateCallback<PlatformView> on_create_platform_view_;
+  const Shell::CreateCallback<Rasterizer> on_create_rasterizer_;
+  std::deque<std::unique_ptr<Shell>> shells_;
+  bool refill_pending_ = false;
+  fml::WeakPtrFactory<WarmShellPool> weak_factory_;  // Must be the last member.
+
+  std::unique_ptr<Shell> SpawnShell(RunConfiguration configuration);
+
+  void ScheduleRefill();
+
+  void Refill(RunConfiguration configuration);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(WarmShellPool);
+};
+
+}  // namespace flutter
+
+#endif  // SHELL_COMMON_WARM_SHELL_POOL_H_
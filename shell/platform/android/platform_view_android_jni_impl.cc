@@ -16,6 +16,7 @@
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/settings.h"
 #include "flutter/fml/file.h"
+#include "flutter/fml/icu_util.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/native_library.h"
 #include "flutter/fml/platform/android/jni_util.h"
@@ -520,30 +521,35 @@ static void NotifyLowMemoryWarning(JNIEnv* env,
 static jboolean FlutterTextUtilsIsEmoji(JNIEnv* env,
                                         jobject obj,
                                         jint codePoint) {
+  fml::icu::EnsureICUInitialized();
   return u_hasBinaryProperty(codePoint, UProperty::UCHAR_EMOJI);
 }
 
 static jboolean FlutterTextUtilsIsEmojiModifier(JNIEnv* env,
                                                 jobject obj,
                                                 jint codePoint) {
+  fml::icu::EnsureICUInitialized();
   return u_hasBinaryProperty(codePoint, UProperty::UCHAR_EMOJI_MODIFIER);
 }
 
 static jboolean FlutterTextUtilsIsEmojiModifierBase(JNIEnv* env,
                                                     jobject obj,
                                                     jint codePoint) {
+  fml::icu::EnsureICUInitialized();
   return u_hasBinaryProperty(codePoint, UProperty::UCHAR_EMOJI_MODIFIER_BASE);
 }
 
 static jboolean FlutterTextUtilsIsVariationSelector(JNIEnv* env,
                                                     jobject obj,
                                                     jint codePoint) {
+  fml::icu::EnsureICUInitialized();
   return u_hasBinaryProperty(codePoint, UProperty::UCHAR_VARIATION_SELECTOR);
 }
 
 static jboolean FlutterTextUtilsIsRegionalIndicator(JNIEnv* env,
                                                     jobject obj,
                                                     jint codePoint) {
+  fml::icu::EnsureICUInitialized();
   return u_hasBinaryProperty(codePoint, UProperty::UCHAR_REGIONAL_INDICATOR);
 }
 
@@ -1108,10 +1114,10 @@ void PlatformViewAndroidJNIImpl::FlutterViewHandlePlatformMessage(
 
   if (message->hasData()) {
     fml::jni::ScopedJavaLocalRef<jbyteArray> message_array(
-        env, env->NewByteArray(message->data().size()));
+        env, env->NewByteArray(message->data().GetSize()));
     env->SetByteArrayRegion(
-        message_array.obj(), 0, message->data().size(),
-        reinterpret_cast<const jbyte*>(message->data().data()));
+        message_array.obj(), 0, message->data().GetSize(),
+        reinterpret_cast<const jbyte*>(message->data().GetMapping()));
     env->CallVoidMethod(java_object.obj(), g_handle_platform_message_method,
                         java_channel.obj(), message_array.obj(), responseId);
   } else {
@@ -36,6 +36,11 @@ class BinaryMessengerImpl : public BinaryMessenger {
   void SetMessageHandler(const std::string& channel,
                          BinaryMessageHandler handler) override;
 
+  // |flutter::BinaryMessenger|
+  void SetMessageHandlerOnBackgroundThread(
+      const std::string& channel,
+      BinaryMessageHandler handler) override;
+
  private:
   // Handle for interacting with the C API.
   FlutterDesktopMessengerRef messenger_;
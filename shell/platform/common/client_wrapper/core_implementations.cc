@@ -111,6 +111,23 @@ void BinaryMessengerImpl::SetMessageHandler(const std::string& channel,
                                      ForwardToHandler, message_handler);
 }
 
+void BinaryMessengerImpl::SetMessageHandlerOnBackgroundThread(
+    const std::string& channel,
+    BinaryMessageHandler handler) {
+  if (!handler) {
+    FlutterDesktopMessengerSetBackgroundCallback(messenger_, channel.c_str(),
+                                                 nullptr, nullptr, nullptr);
+    return;
+  }
+  // The engine owns the handler from here on, and releases it once no
+  // background thread can still be running it.
+  FlutterDesktopMessengerSetBackgroundCallback(
+      messenger_, channel.c_str(), ForwardToHandler,
+      new BinaryMessageHandler(std::move(handler)), [](void* user_data) {
+        delete static_cast<BinaryMessageHandler*>(user_data);
+      });
+}
+
 // ========== engine_method_result.h ==========
 
 namespace internal {
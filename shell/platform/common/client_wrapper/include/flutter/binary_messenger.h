@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <string>
+#include <utility>
 
 namespace flutter {
 
@@ -45,6 +46,22 @@ class BinaryMessenger {
   // existing handler.
   virtual void SetMessageHandler(const std::string& channel,
                                  BinaryMessageHandler handler) = 0;
+
+  // Registers a message handler for incoming binary messages from the Flutter
+  // side on the specified channel that is called on a background thread rather
+  // than on the platform thread. Messages are delivered one at a time, in
+  // order, and |reply| may be called from any thread.
+  //
+  // Replaces any existing handler. Provide a null handler to unregister the
+  // existing handler.
+  //
+  // Messengers that can't dispatch messages off the platform thread register
+  // the handler with SetMessageHandler instead.
+  virtual void SetMessageHandlerOnBackgroundThread(
+      const std::string& channel,
+      BinaryMessageHandler handler) {
+    SetMessageHandler(channel, std::move(handler));
+  }
 };
 
 }  // namespace flutter
@@ -0,0 +1,417 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_CODEC_STREAM_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_CODEC_STREAM_H_
+
+// Allocation-free access to the standard codec binary representation.
+//
+// StandardCodecSerializer materializes every message as an EncodableValue
+// tree. For large payloads (e.g., typed lists of sensor or image data) or
+// very frequent messages, the classes here can be used instead to read values
+// in place from the message buffer and to write them directly into a reusable
+// buffer. The encoding is identical, so they interoperate with
+// StandardMessageCodec and StandardMethodCodec on either side.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace flutter {
+
+// The type discriminator written before each value in the standard codec.
+//
+// The order/values here must match the constants in message_codecs.dart.
+enum class StandardCodecType : uint8_t {
+  kNull = 0,
+  kTrue,
+  kFalse,
+  kInt32,
+  kInt64,
+  kLargeInt,  // No longer used. If encountered, treat as kString.
+  kFloat64,
+  kString,
+  kUInt8List,
+  kInt32List,
+  kInt64List,
+  kFloat64List,
+  kList,
+  kMap,
+};
+
+// A read-only view of the elements of a typed list inside a message buffer.
+//
+// Elements are aligned relative to the start of the message, but the message
+// buffer itself may not be suitably aligned for T, so elements are accessed by
+// copy rather than by pointer.
+template <typename T>
+class StandardCodecListView {
+ public:
+  StandardCodecListView() = default;
+  StandardCodecListView(const uint8_t* bytes, size_t size)
+      : bytes_(bytes), size_(size) {}
+
+  // The number of elements in the list.
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  // Returns the element at |index|, which must be less than size().
+  T operator[](size_t index) const {
+    T value;
+    std::memcpy(&value, bytes_ + index * sizeof(T), sizeof(T));
+    return value;
+  }
+
+  // The raw little-endian bytes of the list; size() * sizeof(T) long.
+  const uint8_t* bytes() const { return bytes_; }
+
+  // Returns the elements as a pointer if the underlying bytes happen to be
+  // aligned for T, or nullptr otherwise.
+  const T* aligned_data() const {
+    return reinterpret_cast<uintptr_t>(bytes_) % alignof(T) == 0
+               ? reinterpret_cast<const T*>(bytes_)
+               : nullptr;
+  }
+
+  // Copies the elements to |out|, which must have room for size() elements.
+  void CopyTo(T* out) const {
+    if (size_ > 0) {
+      std::memcpy(out, bytes_, size_ * sizeof(T));
+    }
+  }
+
+ private:
+  const uint8_t* bytes_ = nullptr;
+  size_t size_ = 0;
+};
+
+// A single value read by StandardCodecReader.
+//
+// Only the members relevant to |type| are set. Strings and typed lists point
+// into the message buffer, which must outlive them.
+struct StandardCodecToken {
+  StandardCodecType type = StandardCodecType::kNull;
+
+  // For kInt32 and kInt64.
+  int64_t int_value = 0;
+
+  // For kFloat64.
+  double double_value = 0;
+
+  // For kString (and kLargeInt).
+  std::string_view string_value;
+
+  // For kList and kMap, the number of elements (or key/value pairs) that
+  // follow. For typed lists, the number of elements.
+  size_t size = 0;
+
+  // For typed lists, the first byte of the elements.
+  const uint8_t* list_bytes = nullptr;
+
+  bool bool_value() const { return type == StandardCodecType::kTrue; }
+
+  // Returns a view of the elements of a typed list. T must match the list
+  // type: uint8_t, int32_t, int64_t or double.
+  template <typename T>
+  StandardCodecListView<T> list() const {
+    return StandardCodecListView<T>(list_bytes, size);
+  }
+};
+
+// A pull-style reader of the standard codec binary representation that
+// doesn't allocate or copy.
+//
+// Each call to Next() reads one value. Lists and maps are read as a token
+// carrying their size, followed by their elements in order (keys and values
+// alternating for maps); Skip() can be used to step over a value with all its
+// children.
+class StandardCodecReader {
+ public:
+  // Creates a reader for |bytes|, which must have a length of |size| and
+  // remain valid for the lifetime of this object and any tokens read from it.
+  StandardCodecReader(const uint8_t* bytes, size_t size)
+      : bytes_(bytes), size_(size) {}
+
+  // Reads the next value into |token|. Returns false at the end of the
+  // buffer or if the data is malformed, after which has_error() is set.
+  bool Next(StandardCodecToken* token) {
+    if (error_ || position_ >= size_) {
+      error_ = true;
+      return false;
+    }
+    token->type = static_cast<StandardCodecType>(bytes_[position_++]);
+    switch (token->type) {
+      case StandardCodecType::kNull:
+      case StandardCodecType::kTrue:
+      case StandardCodecType::kFalse:
+        return true;
+      case StandardCodecType::kInt32: {
+        int32_t value;
+        if (!ReadRaw(&value, sizeof(value))) {
+          return false;
+        }
+        token->int_value = value;
+        return true;
+      }
+      case StandardCodecType::kInt64:
+        return ReadRaw(&token->int_value, sizeof(token->int_value));
+      case StandardCodecType::kFloat64:
+        Align(8);
+        return ReadRaw(&token->double_value, sizeof(token->double_value));
+      case StandardCodecType::kLargeInt:
+      case StandardCodecType::kString: {
+        const uint8_t* data;
+        if (!ReadSize(&token->size) || !ReadView(token->size, &data)) {
+          return false;
+        }
+        token->string_value =
+            std::string_view(reinterpret_cast<const char*>(data), token->size);
+        return true;
+      }
+      case StandardCodecType::kUInt8List:
+        return ReadList(1, token);
+      case StandardCodecType::kInt32List:
+        return ReadList(4, token);
+      case StandardCodecType::kInt64List:
+      case StandardCodecType::kFloat64List:
+        return ReadList(8, token);
+      case StandardCodecType::kList:
+      case StandardCodecType::kMap:
+        return ReadSize(&token->size);
+    }
+    error_ = true;
+    return false;
+  }
+
+  // Reads and discards the next value, including all elements of a list or
+  // map.
+  bool Skip() {
+    size_t remaining = 1;
+    StandardCodecToken token;
+    while (remaining > 0) {
+      if (!Next(&token)) {
+        return false;
+      }
+      remaining--;
+      if (token.type == StandardCodecType::kList) {
+        remaining += token.size;
+      } else if (token.type == StandardCodecType::kMap) {
+        remaining += token.size * 2;
+      }
+    }
+    return true;
+  }
+
+  // Whether a read failed because the data was malformed or exhausted.
+  bool has_error() const { return error_; }
+
+  // Whether all bytes of the buffer have been read.
+  bool AtEnd() const { return position_ >= size_; }
+
+  // The current read position, relative to the start of the buffer.
+  size_t position() const { return position_; }
+
+ private:
+  bool ReadRaw(void* out, size_t length) {
+    const uint8_t* data;
+    if (!ReadView(length, &data)) {
+      return false;
+    }
+    std::memcpy(out, data, length);
+    return true;
+  }
+
+  bool ReadView(size_t length, const uint8_t** data) {
+    if (length > size_ - position_) {
+      error_ = true;
+      return false;
+    }
+    *data = bytes_ + position_;
+    position_ += length;
+    return true;
+  }
+
+  // Like the Dart codec, this doesn't fail when the padding runs past the end
+  // of the buffer; the following read does, unless it is empty.
+  void Align(size_t alignment) {
+    size_t mod = position_ % alignment;
+    if (mod) {
+      position_ = std::min(position_ + alignment - mod, size_);
+    }
+  }
+
+  bool ReadSize(size_t* size) {
+    uint8_t byte;
+    if (!ReadRaw(&byte, 1)) {
+      return false;
+    }
+    if (byte < 254) {
+      *size = byte;
+    } else if (byte == 254) {
+      uint16_t value;
+      if (!ReadRaw(&value, 2)) {
+        return false;
+      }
+      *size = value;
+    } else {
+      uint32_t value;
+      if (!ReadRaw(&value, 4)) {
+        return false;
+      }
+      *size = value;
+    }
+    return true;
+  }
+
+  bool ReadList(size_t element_size, StandardCodecToken* token) {
+    if (!ReadSize(&token->size)) {
+      return false;
+    }
+    if (element_size > 1) {
+      Align(element_size);
+    }
+    if (token->size > (size_ - position_) / element_size) {
+      error_ = true;
+      return false;
+    }
+    return ReadView(token->size * element_size, &token->list_bytes);
+  }
+
+  const uint8_t* bytes_;
+  size_t size_;
+  size_t position_ = 0;
+  bool error_ = false;
+};
+
+// A writer of the standard codec binary representation that appends directly
+// to a byte vector, without virtual calls or intermediate EncodableValues.
+//
+// The same buffer can be reused for several messages with Reset(), which keeps
+// its capacity so that steady-state encoding doesn't allocate.
+class StandardCodecWriter {
+ public:
+  // Creates a writer that appends to |buffer|, which must outlive it. Values
+  // are aligned relative to the start of |buffer|, so it should be empty or
+  // hold only the preceding parts of the same message.
+  explicit StandardCodecWriter(std::vector<uint8_t>* buffer)
+      : buffer_(buffer) {}
+
+  // Clears the buffer, keeping its capacity.
+  void Reset() { buffer_->clear(); }
+
+  // Ensures that |size| more bytes can be written without reallocating.
+  void Reserve(size_t size) { buffer_->reserve(buffer_->size() + size); }
+
+  void WriteNull() { WriteType(StandardCodecType::kNull); }
+
+  void WriteBool(bool value) {
+    WriteType(value ? StandardCodecType::kTrue : StandardCodecType::kFalse);
+  }
+
+  void WriteInt32(int32_t value) {
+    WriteType(StandardCodecType::kInt32);
+    WriteRaw(&value, sizeof(value));
+  }
+
+  void WriteInt64(int64_t value) {
+    WriteType(StandardCodecType::kInt64);
+    WriteRaw(&value, sizeof(value));
+  }
+
+  void WriteDouble(double value) {
+    WriteType(StandardCodecType::kFloat64);
+    WriteAlignment(8);
+    WriteRaw(&value, sizeof(value));
+  }
+
+  void WriteString(std::string_view value) {
+    WriteType(StandardCodecType::kString);
+    WriteSize(value.size());
+    WriteRaw(value.data(), value.size());
+  }
+
+  void WriteUInt8List(const uint8_t* data, size_t count) {
+    WriteList(StandardCodecType::kUInt8List, data, count);
+  }
+
+  void WriteInt32List(const int32_t* data, size_t count) {
+    WriteList(StandardCodecType::kInt32List, data, count);
+  }
+
+  void WriteInt64List(const int64_t* data, size_t count) {
+    WriteList(StandardCodecType::kInt64List, data, count);
+  }
+
+  void WriteFloat64List(const double* data, size_t count) {
+    WriteList(StandardCodecType::kFloat64List, data, count);
+  }
+
+  // Starts a list of |size| elements, which must be written next.
+  void BeginList(size_t size) {
+    WriteType(StandardCodecType::kList);
+    WriteSize(size);
+  }
+
+  // Starts a map of |size| entries, whose keys and values must be written
+  // next, alternating.
+  void BeginMap(size_t size) {
+    WriteType(StandardCodecType::kMap);
+    WriteSize(size);
+  }
+
+ private:
+  void WriteType(StandardCodecType type) {
+    buffer_->push_back(static_cast<uint8_t>(type));
+  }
+
+  void WriteRaw(const void* data, size_t length) {
+    if (length == 0) {
+      return;
+    }
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    buffer_->insert(buffer_->end(), bytes, bytes + length);
+  }
+
+  void WriteAlignment(size_t alignment) {
+    size_t mod = buffer_->size() % alignment;
+    if (mod) {
+      buffer_->resize(buffer_->size() + alignment - mod, 0);
+    }
+  }
+
+  void WriteSize(size_t size) {
+    if (size < 254) {
+      buffer_->push_back(static_cast<uint8_t>(size));
+    } else if (size <= 0xffff) {
+      buffer_->push_back(254);
+      uint16_t value = static_cast<uint16_t>(size);
+      WriteRaw(&value, 2);
+    } else {
+      buffer_->push_back(255);
+      uint32_t value = static_cast<uint32_t>(size);
+      WriteRaw(&value, 4);
+    }
+  }
+
+  template <typename T>
+  void WriteList(StandardCodecType type, const T* data, size_t count) {
+    WriteType(type);
+    WriteSize(count);
+    // Unlike StandardCodecSerializer, this aligns empty lists too, as the Dart
+    // codec does.
+    if (sizeof(T) > 1) {
+      WriteAlignment(sizeof(T));
+    }
+    WriteRaw(data, count * sizeof(T));
+  }
+
+  std::vector<uint8_t>* buffer_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_CODEC_STREAM_H_
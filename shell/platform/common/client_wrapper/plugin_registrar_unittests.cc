@@ -40,6 +40,16 @@ class TestApi : public testing::StubFlutterApi {
     last_message_callback_set_ = callback;
   }
 
+  void MessengerSetBackgroundCallback(const char* channel,
+                                      FlutterDesktopMessageCallback callback,
+                                      void* user_data,
+                                      FlutterDesktopMessageCallbackRelease
+                                          release) override {
+    last_background_callback_set_ = callback;
+    last_background_user_data_set_ = user_data;
+    last_background_release_set_ = release;
+  }
+
   void PluginRegistrarSetDestructionHandler(
       FlutterDesktopOnPluginRegistrarDestroyed callback) override {
     last_destruction_callback_set_ = callback;
@@ -49,6 +59,15 @@ class TestApi : public testing::StubFlutterApi {
   FlutterDesktopMessageCallback last_message_callback_set() {
     return last_message_callback_set_;
   }
+  FlutterDesktopMessageCallback last_background_callback_set() {
+    return last_background_callback_set_;
+  }
+  void* last_background_user_data_set() {
+    return last_background_user_data_set_;
+  }
+  FlutterDesktopMessageCallbackRelease last_background_release_set() {
+    return last_background_release_set_;
+  }
   FlutterDesktopOnPluginRegistrarDestroyed last_destruction_callback_set() {
     return last_destruction_callback_set_;
   }
@@ -56,6 +75,9 @@ class TestApi : public testing::StubFlutterApi {
  private:
   const uint8_t* last_data_sent_ = nullptr;
   FlutterDesktopMessageCallback last_message_callback_set_ = nullptr;
+  FlutterDesktopMessageCallback last_background_callback_set_ = nullptr;
+  void* last_background_user_data_set_ = nullptr;
+  FlutterDesktopMessageCallbackRelease last_background_release_set_ = nullptr;
   FlutterDesktopOnPluginRegistrarDestroyed last_destruction_callback_set_ =
       nullptr;
 };
@@ -155,6 +177,50 @@ TEST(PluginRegistrarTest, MessengerSetMessageHandler) {
   EXPECT_EQ(test_api->last_message_callback_set(), nullptr);
 }
 
+// Tests that background message handlers are registered with the background
+// callback API and forwarded messages reach the handler.
+TEST(PluginRegistrarTest, MessengerSetMessageHandlerOnBackgroundThread) {
+  testing::ScopedStubFlutterApi scoped_api_stub(std::make_unique<TestApi>());
+  auto test_api = static_cast<TestApi*>(scoped_api_stub.stub());
+
+  auto dummy_registrar_handle =
+      reinterpret_cast<FlutterDesktopPluginRegistrarRef>(1);
+  PluginRegistrar registrar(dummy_registrar_handle);
+  BinaryMessenger* messenger = registrar.messenger();
+  const std::string channel_name("foo");
+
+  // Register.
+  size_t received_size = 0;
+  BinaryMessageHandler binary_handler =
+      [&received_size](const uint8_t* message, const size_t message_size,
+                       BinaryReply reply) { received_size = message_size; };
+  messenger->SetMessageHandlerOnBackgroundThread(channel_name,
+                                                 std::move(binary_handler));
+  ASSERT_NE(test_api->last_background_callback_set(), nullptr);
+  EXPECT_EQ(test_api->last_message_callback_set(), nullptr);
+
+  const uint8_t data[] = {1, 2, 3};
+  FlutterDesktopMessage message = {};
+  message.struct_size = sizeof(message);
+  message.channel = channel_name.c_str();
+  message.message = data;
+  message.message_size = sizeof(data);
+  test_api->last_background_callback_set()(
+      nullptr, &message, test_api->last_background_user_data_set());
+  EXPECT_EQ(received_size, sizeof(data));
+
+  // Unregister.
+  void* registered_user_data = test_api->last_background_user_data_set();
+  FlutterDesktopMessageCallbackRelease release =
+      test_api->last_background_release_set();
+  ASSERT_NE(release, nullptr);
+  messenger->SetMessageHandlerOnBackgroundThread(channel_name, nullptr);
+  EXPECT_EQ(test_api->last_background_callback_set(), nullptr);
+
+  // The engine owns the handler once registered; release it as it would.
+  release(registered_user_data);
+}
+
 // Tests that the registrar manager returns the same instance when getting
 // the wrapper for the same reference.
 TEST(PluginRegistrarTest, ManagerSameInstance) {
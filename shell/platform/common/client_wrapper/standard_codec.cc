@@ -16,6 +16,7 @@
 
 #include "byte_buffer_streams.h"
 #include "include/flutter/standard_codec_serializer.h"
+#include "include/flutter/standard_codec_stream.h"
 #include "include/flutter/standard_message_codec.h"
 #include "include/flutter/standard_method_codec.h"
 
@@ -25,23 +26,7 @@ namespace flutter {
 
 namespace {
 
-// The order/values here must match the constants in message_codecs.dart.
-enum class EncodedType {
-  kNull = 0,
-  kTrue,
-  kFalse,
-  kInt32,
-  kInt64,
-  kLargeInt,  // No longer used. If encountered, treat as kString.
-  kFloat64,
-  kString,
-  kUInt8List,
-  kInt32List,
-  kInt64List,
-  kFloat64List,
-  kList,
-  kMap,
-};
+using EncodedType = StandardCodecType;
 
 // Returns the encoded type that should be written when serializing |value|.
 EncodedType EncodedTypeForValue(const EncodableValue& value) {
@@ -0,0 +1,172 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_codec_stream.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+
+namespace flutter {
+namespace {
+
+// A message shaped like a sensor or image plugin payload: a map with a large
+// Float64List, a Uint8List and a few scalars.
+EncodableValue CreateTypedListMessage(size_t count) {
+  std::vector<double> values(count);
+  for (size_t i = 0; i < count; i++) {
+    values[i] = i * 0.25;
+  }
+  std::vector<uint8_t> bytes(count);
+  for (size_t i = 0; i < count; i++) {
+    bytes[i] = static_cast<uint8_t>(i);
+  }
+  return EncodableValue(EncodableMap{
+      {EncodableValue("timestamp"), EncodableValue(INT64_C(1234567890123))},
+      {EncodableValue("sensor"), EncodableValue("accelerometer")},
+      {EncodableValue("values"), EncodableValue(std::move(values))},
+      {EncodableValue("bytes"), EncodableValue(std::move(bytes))},
+  });
+}
+
+// A message with many small values, which stresses per-value overhead.
+EncodableValue CreateNestedMessage(size_t count) {
+  EncodableList list;
+  for (size_t i = 0; i < count; i++) {
+    list.push_back(EncodableValue(EncodableMap{
+        {EncodableValue("id"), EncodableValue(static_cast<int32_t>(i))},
+        {EncodableValue("x"), EncodableValue(i * 0.5)},
+        {EncodableValue("name"), EncodableValue("item")},
+    }));
+  }
+  return EncodableValue(std::move(list));
+}
+
+// Sums the numeric contents of a message read with StandardCodecReader so
+// that the work can't be optimized away.
+double SumWithReader(const std::vector<uint8_t>& encoded) {
+  StandardCodecReader reader(encoded.data(), encoded.size());
+  StandardCodecToken token;
+  double sum = 0;
+  while (!reader.AtEnd() && reader.Next(&token)) {
+    switch (token.type) {
+      case StandardCodecType::kInt32:
+      case StandardCodecType::kInt64:
+        sum += token.int_value;
+        break;
+      case StandardCodecType::kFloat64:
+        sum += token.double_value;
+        break;
+      case StandardCodecType::kString:
+        sum += token.string_value.size();
+        break;
+      case StandardCodecType::kFloat64List: {
+        auto list = token.list<double>();
+        for (size_t i = 0; i < list.size(); i++) {
+          sum += list[i];
+        }
+        break;
+      }
+      case StandardCodecType::kUInt8List: {
+        auto list = token.list<uint8_t>();
+        for (size_t i = 0; i < list.size(); i++) {
+          sum += list[i];
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  return sum;
+}
+
+void WriteTypedListMessage(StandardCodecWriter* writer,
+                           const std::vector<double>& values,
+                           const std::vector<uint8_t>& bytes) {
+  writer->BeginMap(4);
+  writer->WriteString("timestamp");
+  writer->WriteInt64(INT64_C(1234567890123));
+  writer->WriteString("sensor");
+  writer->WriteString("accelerometer");
+  writer->WriteString("values");
+  writer->WriteFloat64List(values.data(), values.size());
+  writer->WriteString("bytes");
+  writer->WriteUInt8List(bytes.data(), bytes.size());
+}
+
+}  // namespace
+
+static void BM_StandardCodecDecodeTypedLists(
+    benchmark::State& state) {  // NOLINT
+  const auto& codec = StandardMessageCodec::GetInstance();
+  auto encoded = codec.EncodeMessage(CreateTypedListMessage(state.range(0)));
+  while (state.KeepRunning()) {
+    auto decoded = codec.DecodeMessage(*encoded);
+    benchmark::DoNotOptimize(decoded);
+  }
+  state.SetBytesProcessed(state.iterations() * encoded->size());
+}
+
+static void BM_StandardCodecReaderTypedLists(
+    benchmark::State& state) {  // NOLINT
+  const auto& codec = StandardMessageCodec::GetInstance();
+  auto encoded = codec.EncodeMessage(CreateTypedListMessage(state.range(0)));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(SumWithReader(*encoded));
+  }
+  state.SetBytesProcessed(state.iterations() * encoded->size());
+}
+
+static void BM_StandardCodecDecodeNested(benchmark::State& state) {  // NOLINT
+  const auto& codec = StandardMessageCodec::GetInstance();
+  auto encoded = codec.EncodeMessage(CreateNestedMessage(state.range(0)));
+  while (state.KeepRunning()) {
+    auto decoded = codec.DecodeMessage(*encoded);
+    benchmark::DoNotOptimize(decoded);
+  }
+  state.SetBytesProcessed(state.iterations() * encoded->size());
+}
+
+static void BM_StandardCodecReaderNested(benchmark::State& state) {  // NOLINT
+  const auto& codec = StandardMessageCodec::GetInstance();
+  auto encoded = codec.EncodeMessage(CreateNestedMessage(state.range(0)));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(SumWithReader(*encoded));
+  }
+  state.SetBytesProcessed(state.iterations() * encoded->size());
+}
+
+static void BM_StandardCodecEncodeTypedLists(
+    benchmark::State& state) {  // NOLINT
+  const auto& codec = StandardMessageCodec::GetInstance();
+  auto message = CreateTypedListMessage(state.range(0));
+  while (state.KeepRunning()) {
+    auto encoded = codec.EncodeMessage(message);
+    benchmark::DoNotOptimize(encoded);
+  }
+}
+
+static void BM_StandardCodecWriterTypedLists(
+    benchmark::State& state) {  // NOLINT
+  std::vector<double> values(state.range(0), 0.25);
+  std::vector<uint8_t> bytes(state.range(0), 1);
+  std::vector<uint8_t> buffer;
+  StandardCodecWriter writer(&buffer);
+  while (state.KeepRunning()) {
+    writer.Reset();
+    WriteTypedListMessage(&writer, values, bytes);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+}
+
+BENCHMARK(BM_StandardCodecDecodeTypedLists)->Range(64, 64 << 10);
+BENCHMARK(BM_StandardCodecReaderTypedLists)->Range(64, 64 << 10);
+BENCHMARK(BM_StandardCodecDecodeNested)->Range(8, 4 << 10);
+BENCHMARK(BM_StandardCodecReaderNested)->Range(8, 4 << 10);
+BENCHMARK(BM_StandardCodecEncodeTypedLists)->Range(64, 64 << 10);
+BENCHMARK(BM_StandardCodecWriterTypedLists)->Range(64, 64 << 10);
+
+}  // namespace flutter
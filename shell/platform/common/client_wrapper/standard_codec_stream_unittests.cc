@@ -0,0 +1,155 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_codec_stream.h"
+
+#include <string>
+#include <vector>
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+namespace {
+
+std::vector<uint8_t> EncodeWithCodec(const EncodableValue& value) {
+  return *StandardMessageCodec::GetInstance().EncodeMessage(value);
+}
+
+}  // namespace
+
+TEST(StandardCodecStream, WriterMatchesSerializer) {
+  std::vector<double> doubles = {1.0, -2.5, 3.25};
+  std::vector<int32_t> ints = {1, 2, 3, 4, 5};
+
+  std::vector<uint8_t> buffer;
+  StandardCodecWriter writer(&buffer);
+  writer.BeginList(7);
+  writer.WriteNull();
+  writer.WriteBool(true);
+  writer.WriteInt32(-7);
+  writer.WriteInt64(INT64_C(1) << 40);
+  writer.WriteString("hello");
+  writer.WriteFloat64List(doubles.data(), doubles.size());
+  writer.BeginMap(1);
+  writer.WriteString("ints");
+  writer.WriteInt32List(ints.data(), ints.size());
+
+  EncodableValue value(EncodableList{
+      EncodableValue(),
+      EncodableValue(true),
+      EncodableValue(-7),
+      EncodableValue(INT64_C(1) << 40),
+      EncodableValue("hello"),
+      EncodableValue(doubles),
+      EncodableValue(EncodableMap{
+          {EncodableValue("ints"), EncodableValue(ints)},
+      }),
+  });
+  EXPECT_EQ(buffer, EncodeWithCodec(value));
+
+  // Reusing the buffer keeps its storage.
+  const uint8_t* storage = buffer.data();
+  writer.Reset();
+  writer.WriteDouble(0.5);
+  EXPECT_EQ(buffer.data(), storage);
+  EXPECT_EQ(buffer, EncodeWithCodec(EncodableValue(0.5)));
+}
+
+TEST(StandardCodecStream, ReaderReadsInPlace) {
+  std::vector<double> doubles(300);
+  for (size_t i = 0; i < doubles.size(); i++) {
+    doubles[i] = i * 0.5;
+  }
+  std::vector<uint8_t> bytes = {1, 2, 3};
+  EncodableValue value(EncodableMap{
+      {EncodableValue("values"), EncodableValue(doubles)},
+      {EncodableValue("raw"), EncodableValue(bytes)},
+      {EncodableValue("count"), EncodableValue(42)},
+  });
+  std::vector<uint8_t> encoded = EncodeWithCodec(value);
+
+  StandardCodecReader reader(encoded.data(), encoded.size());
+  StandardCodecToken token;
+  ASSERT_TRUE(reader.Next(&token));
+  ASSERT_EQ(token.type, StandardCodecType::kMap);
+  ASSERT_EQ(token.size, 3u);
+
+  size_t entries = token.size;
+  for (size_t i = 0; i < entries; i++) {
+    ASSERT_TRUE(reader.Next(&token));
+    ASSERT_EQ(token.type, StandardCodecType::kString);
+    std::string key(token.string_value);
+    // String views point into the message.
+    EXPECT_GE(reinterpret_cast<const uint8_t*>(token.string_value.data()),
+              encoded.data());
+    EXPECT_LT(reinterpret_cast<const uint8_t*>(token.string_value.data()),
+              encoded.data() + encoded.size());
+
+    ASSERT_TRUE(reader.Next(&token));
+    if (key == "values") {
+      ASSERT_EQ(token.type, StandardCodecType::kFloat64List);
+      auto list = token.list<double>();
+      ASSERT_EQ(list.size(), doubles.size());
+      for (size_t j = 0; j < doubles.size(); j++) {
+        EXPECT_EQ(list[j], doubles[j]);
+      }
+    } else if (key == "raw") {
+      ASSERT_EQ(token.type, StandardCodecType::kUInt8List);
+      auto list = token.list<uint8_t>();
+      std::vector<uint8_t> copy(list.size());
+      list.CopyTo(copy.data());
+      EXPECT_EQ(copy, bytes);
+    } else {
+      ASSERT_EQ(key, "count");
+      ASSERT_EQ(token.type, StandardCodecType::kInt32);
+      EXPECT_EQ(token.int_value, 42);
+    }
+  }
+  EXPECT_TRUE(reader.AtEnd());
+  EXPECT_FALSE(reader.has_error());
+}
+
+TEST(StandardCodecStream, ReaderSkipsNestedValues) {
+  EncodableValue value(EncodableList{
+      EncodableValue(EncodableList{EncodableValue(1), EncodableValue("two"),
+                                   EncodableValue(EncodableMap{
+                                       {EncodableValue(3), EncodableValue()},
+                                   })}),
+      EncodableValue(2.5),
+  });
+  std::vector<uint8_t> encoded = EncodeWithCodec(value);
+
+  StandardCodecReader reader(encoded.data(), encoded.size());
+  StandardCodecToken token;
+  ASSERT_TRUE(reader.Next(&token));
+  ASSERT_EQ(token.type, StandardCodecType::kList);
+  ASSERT_TRUE(reader.Skip());
+  ASSERT_TRUE(reader.Next(&token));
+  ASSERT_EQ(token.type, StandardCodecType::kFloat64);
+  EXPECT_EQ(token.double_value, 2.5);
+  EXPECT_TRUE(reader.AtEnd());
+}
+
+TEST(StandardCodecStream, ReaderRejectsTruncatedData) {
+  std::vector<int64_t> values = {1, 2, 3};
+  std::vector<uint8_t> encoded = EncodeWithCodec(EncodableValue(values));
+  encoded.pop_back();
+
+  StandardCodecReader reader(encoded.data(), encoded.size());
+  StandardCodecToken token;
+  EXPECT_FALSE(reader.Next(&token));
+  EXPECT_TRUE(reader.has_error());
+
+  // A list claiming more elements than the buffer holds.
+  std::vector<uint8_t> oversized = {
+      static_cast<uint8_t>(StandardCodecType::kFloat64List), 0xff, 0xff, 0xff,
+      0xff, 0x7f};
+  StandardCodecReader oversized_reader(oversized.data(), oversized.size());
+  EXPECT_FALSE(oversized_reader.Next(&token));
+  EXPECT_TRUE(oversized_reader.has_error());
+}
+
+}  // namespace flutter
@@ -0,0 +1,32 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_JSON_BYTE_STREAM_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_JSON_BYTE_STREAM_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace flutter {
+
+// A rapidjson output stream that appends to a byte vector, so that encoders
+// can write straight into the buffer handed to the messenger instead of
+// copying out of a rapidjson::StringBuffer.
+class JsonByteStream {
+ public:
+  typedef char Ch;
+
+  explicit JsonByteStream(std::vector<uint8_t>* buffer) : buffer_(buffer) {}
+
+  void Put(Ch c) { buffer_->push_back(static_cast<uint8_t>(c)); }
+
+  void Flush() {}
+
+ private:
+  std::vector<uint8_t>* buffer_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_JSON_BYTE_STREAM_H_
@@ -0,0 +1,155 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/method_result_functions.h"
+#include "flutter/shell/platform/common/json_message_codec.h"
+#include "flutter/shell/platform/common/json_method_codec.h"
+
+namespace flutter {
+namespace {
+
+// A TextInput.setEditingState call as sent by the framework on every edit,
+// for a field holding |length| characters.
+std::vector<uint8_t> CreateEditingStateMessage(size_t length) {
+  std::string text;
+  for (size_t i = 0; i < length; i++) {
+    text += static_cast<char>('a' + i % 26);
+  }
+  std::string message = R"({"method":"TextInput.setEditingState","args":{)"
+                        R"("text":")" +
+                        text +
+                        R"(","selectionBase":)" + std::to_string(length) +
+                        R"(,"selectionExtent":)" + std::to_string(length) +
+                        R"(,"selectionAffinity":"TextAffinity.downstream",)"
+                        R"("selectionIsDirectional":false,"composingBase":-1,)"
+                        R"("composingExtent":-1}})";
+  return std::vector<uint8_t>(message.begin(), message.end());
+}
+
+// A success envelope for a platform method that returns |length| characters,
+// such as Clipboard.getData.
+std::vector<uint8_t> CreateStringResponse(size_t length) {
+  std::string text;
+  for (size_t i = 0; i < length; i++) {
+    text += static_cast<char>('a' + i % 26);
+  }
+  std::string message = R"([{"text":")" + text + R"("}])";
+  return std::vector<uint8_t>(message.begin(), message.end());
+}
+
+// A key event as sent to the framework on every key press.
+std::vector<uint8_t> CreateKeyEventMessage() {
+  std::string message =
+      R"({"keyCode":65,"scanCode":30,"characterCodePoint":97,)"
+      R"("keymap":"windows","modifiers":0,"type":"keydown"})";
+  return std::vector<uint8_t>(message.begin(), message.end());
+}
+
+}  // namespace
+
+static void BM_JsonMethodCodecDecodeEditingState(
+    benchmark::State& state) {  // NOLINT
+  const auto& codec = JsonMethodCodec::GetInstance();
+  std::vector<uint8_t> message = CreateEditingStateMessage(state.range(0));
+  while (state.KeepRunning()) {
+    auto call = codec.DecodeMethodCall(message);
+    benchmark::DoNotOptimize(call);
+  }
+  state.SetBytesProcessed(state.iterations() * message.size());
+}
+
+// Decodes with a copying rapidjson parse, as the codecs did before parsing in
+// situ, for comparison with BM_JsonMessageCodecDecodeEditingState.
+static void BM_JsonDocumentParseEditingState(
+    benchmark::State& state) {  // NOLINT
+  std::vector<uint8_t> message = CreateEditingStateMessage(state.range(0));
+  while (state.KeepRunning()) {
+    auto document = std::make_unique<rapidjson::Document>();
+    document->Parse(reinterpret_cast<const char*>(message.data()),
+                    message.size());
+    benchmark::DoNotOptimize(document);
+  }
+  state.SetBytesProcessed(state.iterations() * message.size());
+}
+
+static void BM_JsonMessageCodecDecodeEditingState(
+    benchmark::State& state) {  // NOLINT
+  const auto& codec = JsonMessageCodec::GetInstance();
+  std::vector<uint8_t> message = CreateEditingStateMessage(state.range(0));
+  while (state.KeepRunning()) {
+    auto document = codec.DecodeMessage(message);
+    benchmark::DoNotOptimize(document);
+  }
+  state.SetBytesProcessed(state.iterations() * message.size());
+}
+
+// Decodes a response the way the method codec did before responses were
+// parsed in situ into a reused pool, for comparison with
+// BM_JsonMethodCodecDecodeResponse.
+static void BM_JsonDocumentDecodeResponse(benchmark::State& state) {  // NOLINT
+  std::vector<uint8_t> message = CreateStringResponse(state.range(0));
+  while (state.KeepRunning()) {
+    auto response = std::make_unique<rapidjson::Document>();
+    response->Parse(reinterpret_cast<const char*>(message.data()),
+                    message.size());
+    auto value = std::make_unique<rapidjson::Document>();
+    response->Swap((*response)[0]);
+    value->Swap(*response);
+    benchmark::DoNotOptimize(value);
+  }
+  state.SetBytesProcessed(state.iterations() * message.size());
+}
+
+static void BM_JsonMethodCodecDecodeResponse(
+    benchmark::State& state) {  // NOLINT
+  const auto& codec = JsonMethodCodec::GetInstance();
+  std::vector<uint8_t> message = CreateStringResponse(state.range(0));
+  MethodResultFunctions<rapidjson::Document> result(
+      [](const rapidjson::Document* value) {
+        benchmark::DoNotOptimize(value);
+      },
+      nullptr, nullptr);
+  while (state.KeepRunning()) {
+    codec.DecodeAndProcessResponseEnvelope(message.data(), message.size(),
+                                           &result);
+  }
+  state.SetBytesProcessed(state.iterations() * message.size());
+}
+
+static void BM_JsonMethodCodecEncodeEditingState(
+    benchmark::State& state) {  // NOLINT
+  const auto& codec = JsonMethodCodec::GetInstance();
+  std::vector<uint8_t> message = CreateEditingStateMessage(state.range(0));
+  auto call = codec.DecodeMethodCall(message);
+  while (state.KeepRunning()) {
+    auto encoded = codec.EncodeMethodCall(*call);
+    benchmark::DoNotOptimize(encoded);
+  }
+}
+
+static void BM_JsonMessageCodecKeyEventRoundTrip(
+    benchmark::State& state) {  // NOLINT
+  const auto& codec = JsonMessageCodec::GetInstance();
+  std::vector<uint8_t> message = CreateKeyEventMessage();
+  while (state.KeepRunning()) {
+    auto decoded = codec.DecodeMessage(message);
+    auto encoded = codec.EncodeMessage(*decoded);
+    benchmark::DoNotOptimize(encoded);
+  }
+}
+
+BENCHMARK(BM_JsonMethodCodecDecodeEditingState)->Range(16, 16 << 10);
+BENCHMARK(BM_JsonDocumentParseEditingState)->Range(16, 16 << 10);
+BENCHMARK(BM_JsonMessageCodecDecodeEditingState)->Range(16, 16 << 10);
+BENCHMARK(BM_JsonDocumentDecodeResponse)->Range(16, 16 << 10);
+BENCHMARK(BM_JsonMethodCodecDecodeResponse)->Range(16, 16 << 10);
+BENCHMARK(BM_JsonMethodCodecEncodeEditingState)->Range(16, 16 << 10);
+BENCHMARK(BM_JsonMessageCodecKeyEventRoundTrip);
+
+}  // namespace flutter
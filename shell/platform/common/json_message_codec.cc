@@ -4,11 +4,12 @@
 
 #include "flutter/shell/platform/common/json_message_codec.h"
 
+#include <cstring>
 #include <iostream>
 #include <string>
 
+#include "flutter/shell/platform/common/json_byte_stream.h"
 #include "rapidjson/error/en.h"
-#include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 
 namespace flutter {
@@ -21,30 +22,50 @@ const JsonMessageCodec& JsonMessageCodec::GetInstance() {
 
 std::unique_ptr<std::vector<uint8_t>> JsonMessageCodec::EncodeMessageInternal(
     const rapidjson::Document& message) const {
-  // TODO: Look into alternate writers that would avoid the buffer copy.
-  rapidjson::StringBuffer buffer;
-  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  auto encoded = std::make_unique<std::vector<uint8_t>>();
+  JsonByteStream stream(encoded.get());
+  rapidjson::Writer<JsonByteStream> writer(stream);
   message.Accept(writer);
-  const char* buffer_start = buffer.GetString();
-  return std::make_unique<std::vector<uint8_t>>(
-      buffer_start, buffer_start + buffer.GetSize());
+  return encoded;
 }
 
 std::unique_ptr<rapidjson::Document> JsonMessageCodec::DecodeMessageInternal(
     const uint8_t* binary_message,
     const size_t message_size) const {
-  auto raw_message = reinterpret_cast<const char*>(binary_message);
   auto json_message = std::make_unique<rapidjson::Document>();
-  rapidjson::ParseResult result =
-      json_message->Parse(raw_message, message_size);
+  if (!ParseInsitu(binary_message, message_size, json_message.get())) {
+    return nullptr;
+  }
+  return json_message;
+}
+
+// static
+bool JsonMessageCodec::ParseInsitu(const uint8_t* binary_message,
+                                   size_t message_size,
+                                   rapidjson::Document* document) {
+  // The in-situ parser treats NUL as the end of the input, so anything after
+  // an embedded NUL would otherwise be silently ignored.
+  if (message_size > 0 &&
+      std::memchr(binary_message, '\0', message_size) != nullptr) {
+    std::cerr << "Unable to parse JSON message:" << std::endl
+              << "Message contains a NUL character." << std::endl;
+    return false;
+  }
+  auto raw_message =
+      static_cast<char*>(document->GetAllocator().Malloc(message_size + 1));
+  if (message_size > 0) {
+    std::memcpy(raw_message, binary_message, message_size);
+  }
+  raw_message[message_size] = '\0';
+  rapidjson::ParseResult result = document->ParseInsitu(raw_message);
   bool parsing_successful =
       result == rapidjson::ParseErrorCode::kParseErrorNone;
   if (!parsing_successful) {
     std::cerr << "Unable to parse JSON message:" << std::endl
               << rapidjson::GetParseError_En(result.Code()) << std::endl;
-    return nullptr;
+    return false;
   }
-  return json_message;
+  return true;
 }
 
 }  // namespace flutter
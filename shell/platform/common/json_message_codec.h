@@ -24,6 +24,16 @@ class JsonMessageCodec : public MessageCodec<rapidjson::Document> {
   JsonMessageCodec(JsonMessageCodec const&) = delete;
   JsonMessageCodec& operator=(JsonMessageCodec const&) = delete;
 
+  // Parses |binary_message| into |document| with rapidjson's in-situ parser.
+  //
+  // The message is copied once into memory from |document|'s allocator and
+  // parsed in place, so string values point into that copy instead of each
+  // being allocated separately. The document stays valid for as long as its
+  // allocator does. Returns false if the message isn't valid JSON.
+  static bool ParseInsitu(const uint8_t* binary_message,
+                          size_t message_size,
+                          rapidjson::Document* document);
+
  protected:
   // Instances should be obtained via GetInstance.
   JsonMessageCodec() = default;
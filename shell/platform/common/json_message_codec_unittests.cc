@@ -6,6 +6,8 @@
 
 #include <limits>
 #include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -43,4 +45,23 @@ TEST(JsonMessageCodec, EncodeDecode) {
   CheckEncodeDecode(array);
 }
 
+// Tests that decoded strings outlive the message they were parsed from.
+TEST(JsonMessageCodec, DecodedStringsOutliveMessage) {
+  const JsonMessageCodec& codec = JsonMessageCodec::GetInstance();
+  auto message = std::make_unique<std::vector<uint8_t>>();
+  std::string text = R"({"key":"escaped \"value\""})";
+  message->assign(text.begin(), text.end());
+  auto decoded = codec.DecodeMessage(*message);
+  message.reset();
+  ASSERT_TRUE(decoded);
+  EXPECT_STREQ((*decoded)["key"].GetString(), "escaped \"value\"");
+}
+
+// Tests that a message with an embedded NUL is rejected rather than truncated.
+TEST(JsonMessageCodec, RejectsEmbeddedNul) {
+  const JsonMessageCodec& codec = JsonMessageCodec::GetInstance();
+  std::vector<uint8_t> message = {'[', '1', ']', '\0', '[', '2', ']'};
+  EXPECT_FALSE(codec.DecodeMessage(message));
+}
+
 }  // namespace flutter
@@ -4,7 +4,11 @@
 
 #include "flutter/shell/platform/common/json_method_codec.h"
 
+#include <algorithm>
+
+#include "flutter/shell/platform/common/json_byte_stream.h"
 #include "flutter/shell/platform/common/json_message_codec.h"
+#include "rapidjson/writer.h"
 
 namespace flutter {
 
@@ -14,6 +18,9 @@ namespace {
 constexpr char kMessageMethodKey[] = "method";
 constexpr char kMessageArgumentsKey[] = "args";
 
+// The size of the first chunk of a thread's response pool.
+constexpr size_t kInitialResponsePoolCapacity = 4096;
+
 // Returns a new document containing only |element|, which must be an element
 // in |document|. This is a move rather than a copy, so it is efficient but
 // destructive to the data in |document|.
@@ -25,11 +32,126 @@ std::unique_ptr<rapidjson::Document> ExtractElement(
   document->Swap(*subtree);
   // Swap the entire document into |extracted|. Unlike the swap above this moves
   // the allocator ownership, so the data won't be deleted when |document| is
-  // destroyed.
+  // destroyed. Documents are parsed in situ, so this also carries over the
+  // copy of the message that their strings point into.
   extracted->Swap(*document);
   return extracted;
 }
 
+// Moves |subtree| into |extracted| without copying it. |extracted| must use
+// the allocator of the document |subtree| belongs to, and so is only valid
+// while that allocator is.
+void ExtractElement(rapidjson::Value* subtree, rapidjson::Document* extracted) {
+  extracted->Swap(*subtree);
+}
+
+// Memory for decoding response envelopes, which are only needed while the
+// result handler runs.
+//
+// The first chunk of the pool is owned by it and survives Clear(), and it is
+// regrown whenever a response overflows it, so once a thread has seen its
+// largest response, responses are parsed without touching the heap.
+class ResponsePool {
+ public:
+  // Returns the calling thread's pool.
+  static ResponsePool& GetForCurrentThread() {
+    thread_local ResponsePool pool;
+    return pool;
+  }
+
+  // Returns the allocator to decode a response with, or nullptr if the pool
+  // is already in use further up the stack, e.g. by a result handler that
+  // synchronously receives another response.
+  rapidjson::MemoryPoolAllocator<>* Acquire() {
+    if (in_use_) {
+      return nullptr;
+    }
+    in_use_ = true;
+    return allocator_.get();
+  }
+
+  // Recycles the pool's memory. Nothing allocated from it may be used after
+  // this.
+  void Release() {
+    if (allocator_->Capacity() > capacity_) {
+      Reset(std::max(capacity_ * 2, allocator_->Size()));
+    } else {
+      allocator_->Clear();
+    }
+    in_use_ = false;
+  }
+
+ private:
+  ResponsePool() { Reset(kInitialResponsePoolCapacity); }
+
+  void Reset(size_t capacity) {
+    allocator_.reset();
+    capacity_ = capacity;
+    buffer_ = std::make_unique<char[]>(capacity);
+    // Chunks allocated on overflow are the same size as the owned one, so the
+    // pool can be regrown to roughly what a response needed.
+    allocator_ = std::make_unique<rapidjson::MemoryPoolAllocator<>>(
+        buffer_.get(), capacity, capacity);
+  }
+
+  size_t capacity_ = 0;
+  std::unique_ptr<char[]> buffer_;
+  std::unique_ptr<rapidjson::MemoryPoolAllocator<>> allocator_;
+  bool in_use_ = false;
+};
+
+// Decodes |response| into a document backed by |allocator|, which may be
+// nullptr to give the document its own, and passes it to |result|.
+bool ProcessResponseEnvelope(const uint8_t* response,
+                             size_t response_size,
+                             rapidjson::MemoryPoolAllocator<>* allocator,
+                             MethodResult<rapidjson::Document>* result) {
+  rapidjson::Document json_response(allocator);
+  if (!JsonMessageCodec::ParseInsitu(response, response_size,
+                                     &json_response)) {
+    return false;
+  }
+  if (!json_response.IsArray()) {
+    return false;
+  }
+  switch (json_response.Size()) {
+    case 1: {
+      rapidjson::Document value(&json_response.GetAllocator());
+      ExtractElement(&json_response[0], &value);
+      if (value.IsNull()) {
+        result->Success();
+      } else {
+        result->Success(value);
+      }
+      return true;
+    }
+    case 3: {
+      std::string code = json_response[0].GetString();
+      std::string message = json_response[1].GetString();
+      rapidjson::Document details(&json_response.GetAllocator());
+      ExtractElement(&json_response[2], &details);
+      if (details.IsNull()) {
+        result->Error(code, message);
+      } else {
+        result->Error(code, message, details);
+      }
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+// Writes |value| to |writer|, or null if there is no value.
+void WriteOptionalValue(rapidjson::Writer<JsonByteStream>& writer,
+                        const rapidjson::Document* value) {
+  if (value) {
+    value->Accept(writer);
+  } else {
+    writer.Null();
+  }
+}
+
 }  // namespace
 
 // static
@@ -66,34 +188,32 @@ JsonMethodCodec::DecodeMethodCallInternal(const uint8_t* message,
 
 std::unique_ptr<std::vector<uint8_t>> JsonMethodCodec::EncodeMethodCallInternal(
     const MethodCall<rapidjson::Document>& method_call) const {
-  // TODO: Consider revisiting the codec APIs to avoid the need to copy
-  // everything when doing encoding (e.g., by having a version that takes
-  // owership of the object to encode, so that it can be moved instead).
-  rapidjson::Document message(rapidjson::kObjectType);
-  auto& allocator = message.GetAllocator();
-  rapidjson::Value name(method_call.method_name(), allocator);
-  rapidjson::Value arguments;
-  if (method_call.arguments()) {
-    arguments.CopyFrom(*method_call.arguments(), allocator);
-  }
-  message.AddMember(kMessageMethodKey, name, allocator);
-  message.AddMember(kMessageArgumentsKey, arguments, allocator);
-
-  return JsonMessageCodec::GetInstance().EncodeMessage(message);
+  // Envelopes are written field by field rather than assembled into a new
+  // document, so that the arguments don't have to be deep-copied.
+  auto encoded = std::make_unique<std::vector<uint8_t>>();
+  JsonByteStream stream(encoded.get());
+  rapidjson::Writer<JsonByteStream> writer(stream);
+  const std::string& method_name = method_call.method_name();
+  writer.StartObject();
+  writer.Key(kMessageMethodKey);
+  writer.String(method_name.c_str(),
+                static_cast<rapidjson::SizeType>(method_name.size()));
+  writer.Key(kMessageArgumentsKey);
+  WriteOptionalValue(writer, method_call.arguments());
+  writer.EndObject();
+  return encoded;
 }
 
 std::unique_ptr<std::vector<uint8_t>>
 JsonMethodCodec::EncodeSuccessEnvelopeInternal(
     const rapidjson::Document* result) const {
-  rapidjson::Document envelope;
-  envelope.SetArray();
-  rapidjson::Value result_value;
-  if (result) {
-    result_value.CopyFrom(*result, envelope.GetAllocator());
-  }
-  envelope.PushBack(result_value, envelope.GetAllocator());
-
-  return JsonMessageCodec::GetInstance().EncodeMessage(envelope);
+  auto encoded = std::make_unique<std::vector<uint8_t>>();
+  JsonByteStream stream(encoded.get());
+  rapidjson::Writer<JsonByteStream> writer(stream);
+  writer.StartArray();
+  WriteOptionalValue(writer, result);
+  writer.EndArray();
+  return encoded;
 }
 
 std::unique_ptr<std::vector<uint8_t>>
@@ -101,57 +221,31 @@ JsonMethodCodec::EncodeErrorEnvelopeInternal(
     const std::string& error_code,
     const std::string& error_message,
     const rapidjson::Document* error_details) const {
-  rapidjson::Document envelope(rapidjson::kArrayType);
-  auto& allocator = envelope.GetAllocator();
-  envelope.PushBack(rapidjson::Value(error_code, allocator), allocator);
-  envelope.PushBack(rapidjson::Value(error_message, allocator), allocator);
-  rapidjson::Value details_value;
-  if (error_details) {
-    details_value.CopyFrom(*error_details, allocator);
-  }
-  envelope.PushBack(details_value, allocator);
-
-  return JsonMessageCodec::GetInstance().EncodeMessage(envelope);
+  auto encoded = std::make_unique<std::vector<uint8_t>>();
+  JsonByteStream stream(encoded.get());
+  rapidjson::Writer<JsonByteStream> writer(stream);
+  writer.StartArray();
+  writer.String(error_code.c_str(),
+                static_cast<rapidjson::SizeType>(error_code.size()));
+  writer.String(error_message.c_str(),
+                static_cast<rapidjson::SizeType>(error_message.size()));
+  WriteOptionalValue(writer, error_details);
+  writer.EndArray();
+  return encoded;
 }
 
 bool JsonMethodCodec::DecodeAndProcessResponseEnvelopeInternal(
     const uint8_t* response,
     size_t response_size,
     MethodResult<rapidjson::Document>* result) const {
-  std::unique_ptr<rapidjson::Document> json_response =
-      JsonMessageCodec::GetInstance().DecodeMessage(response, response_size);
-  if (!json_response) {
-    return false;
-  }
-  if (!json_response->IsArray()) {
-    return false;
-  }
-  switch (json_response->Size()) {
-    case 1: {
-      std::unique_ptr<rapidjson::Document> value =
-          ExtractElement(json_response.get(), &((*json_response)[0]));
-      if (value->IsNull()) {
-        result->Success();
-      } else {
-        result->Success(*value);
-      }
-      return true;
-    }
-    case 3: {
-      std::string code = (*json_response)[0].GetString();
-      std::string message = (*json_response)[1].GetString();
-      std::unique_ptr<rapidjson::Document> details =
-          ExtractElement(json_response.get(), &((*json_response)[2]));
-      if (details->IsNull()) {
-        result->Error(code, message);
-      } else {
-        result->Error(code, message, *details);
-      }
-      return true;
-    }
-    default:
-      return false;
+  ResponsePool& pool = ResponsePool::GetForCurrentThread();
+  rapidjson::MemoryPoolAllocator<>* allocator = pool.Acquire();
+  bool processed =
+      ProcessResponseEnvelope(response, response_size, allocator, result);
+  if (allocator) {
+    pool.Release();
   }
+  return processed;
 }
 
 }  // namespace flutter
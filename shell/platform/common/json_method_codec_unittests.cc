@@ -157,4 +157,32 @@ TEST(JsonMethodCodec, HandlesErrorEnvelopesWithDetails) {
   EXPECT_TRUE(decoded_successfully);
 }
 
+TEST(JsonMethodCodec, HandlesResponsesReceivedWhileHandlingAResponse) {
+  const JsonMethodCodec& codec = JsonMethodCodec::GetInstance();
+  std::vector<uint8_t> outer = {'[', '"', 'o', 'u', 't', 'e', 'r', '"', ']'};
+  std::vector<uint8_t> inner = {'[', '"', 'i', 'n', 'n', 'e', 'r', '"', ']'};
+
+  bool inner_decoded = false;
+  MethodResultFunctions<rapidjson::Document> inner_handler(
+      [&inner_decoded](const rapidjson::Document* result) {
+        inner_decoded = true;
+        EXPECT_STREQ(result->GetString(), "inner");
+      },
+      nullptr, nullptr);
+  bool outer_decoded = false;
+  MethodResultFunctions<rapidjson::Document> outer_handler(
+      [&](const rapidjson::Document* result) {
+        codec.DecodeAndProcessResponseEnvelope(inner.data(), inner.size(),
+                                               &inner_handler);
+        // The nested response must not have recycled this one's memory.
+        outer_decoded = true;
+        EXPECT_STREQ(result->GetString(), "outer");
+      },
+      nullptr, nullptr);
+  codec.DecodeAndProcessResponseEnvelope(outer.data(), outer.size(),
+                                         &outer_handler);
+  EXPECT_TRUE(inner_decoded);
+  EXPECT_TRUE(outer_decoded);
+}
+
 }  // namespace flutter
@@ -50,6 +50,10 @@ typedef void (*FlutterDesktopMessageCallback)(
     const FlutterDesktopMessage* /* message*/,
     void* /* user data */);
 
+// Function pointer type called with the user data of a background message
+// callback once the callback will no longer be called.
+typedef void (*FlutterDesktopMessageCallbackRelease)(void* /* user data */);
+
 // Sends a binary message to the Flutter side on the specified channel.
 FLUTTER_EXPORT bool FlutterDesktopMessengerSend(
     FlutterDesktopMessengerRef messenger,
@@ -87,6 +91,32 @@ FLUTTER_EXPORT void FlutterDesktopMessengerSetCallback(
     FlutterDesktopMessageCallback callback,
     void* user_data);
 
+// Registers a callback function for incoming binary messages from the Flutter
+// side on the specified channel that is called on a background thread rather
+// than on the platform thread. Messages on the channel are delivered one at a
+// time and in order, but not necessarily on the same thread. The response may
+// be sent with FlutterDesktopMessengerSendResponse from any thread.
+//
+// Use this for channels whose handlers are slow (e.g., decoding large payloads
+// or doing file I/O) so that they don't block the platform thread. Callbacks
+// must not wait on the platform thread.
+//
+// Must be called while the engine is running. Takes precedence over any
+// callback set with FlutterDesktopMessengerSetCallback for the same channel.
+// Provide a null handler to unregister the existing callback. Messages already
+// queued for a replaced callback are still delivered to it, in order. Messages
+// not yet delivered when the engine shuts down are dropped.
+//
+// If |user_data| is provided, it will be passed in |callback| calls. If
+// |release| is provided, it is called with |user_data| from any thread once
+// |callback| will no longer be called, so that |user_data| can be freed.
+FLUTTER_EXPORT void FlutterDesktopMessengerSetBackgroundCallback(
+    FlutterDesktopMessengerRef messenger,
+    const char* channel,
+    FlutterDesktopMessageCallback callback,
+    void* user_data,
+    FlutterDesktopMessageCallbackRelease release);
+
 #if defined(__cplusplus)
 }  // extern "C"
 #endif
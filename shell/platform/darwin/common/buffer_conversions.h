@@ -19,6 +19,8 @@ NSData* GetNSDataFromVector(const std::vector<uint8_t>& buffer);
 
 std::unique_ptr<fml::Mapping> GetMappingFromNSData(NSData* data);
 
+// Wraps |mapping| in an NSData without copying it. The mapping is released
+// when the NSData is.
 NSData* GetNSDataFromMapping(std::unique_ptr<fml::Mapping> mapping);
 
 }  // namespace flutter
@@ -20,7 +20,14 @@ std::unique_ptr<fml::Mapping> GetMappingFromNSData(NSData* data) {
 }
 
 NSData* GetNSDataFromMapping(std::unique_ptr<fml::Mapping> mapping) {
-  return [NSData dataWithBytes:mapping->GetMapping() length:mapping->GetSize()];
+  // Blocks can't capture a std::unique_ptr, so the deallocator takes over the
+  // raw pointer and the NSData owns the mapping from here on.
+  fml::Mapping* raw_mapping = mapping.release();
+  return [NSData dataWithBytesNoCopy:const_cast<uint8_t*>(raw_mapping->GetMapping())
+                              length:raw_mapping->GetSize()
+                         deallocator:^(void* bytes, NSUInteger length) {
+                           delete raw_mapping;
+                         }];
 }
 
 }  // namespace flutter
@@ -44,9 +44,11 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/ring_buffer/ring_buffer.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/embedder/embedder_buffer_pool.h"
 #include "flutter/shell/platform/embedder/embedder_engine.h"
 #include "flutter/shell/platform/embedder/embedder_external_texture_resolver.h"
 #include "flutter/shell/platform/embedder/embedder_platform_message_response.h"
@@ -176,14 +178,15 @@ static void* DefaultGLProcResolver(const char* name) {
 }
 #endif  // OS_LINUX || OS_WIN
 
-static flutter::Shell::CreateCallback<flutter::PlatformView>
-InferOpenGLPlatformViewCreationCallback(
+using EmbedderSurfaceFactory =
+    flutter::PlatformViewEmbedder::EmbedderSurfaceFactory;
+
+using ExternalViewEmbedderFactory =
+    std::function<std::unique_ptr<flutter::EmbedderExternalViewEmbedder>()>;
+
+static EmbedderSurfaceFactory InferOpenGLEmbedderSurfaceFactory(
     const FlutterRendererConfig* config,
-    void* user_data,
-    flutter::PlatformViewEmbedder::PlatformDispatchTable
-        platform_dispatch_table,
-    std::unique_ptr<flutter::EmbedderExternalViewEmbedder>
-        external_view_embedder) {
+    void* user_data) {
 #ifdef SHELL_ENABLE_GL
   if (config->type != kOpenGL) {
     return nullptr;
@@ -248,13 +251,6 @@ InferOpenGLPlatformViewCreationCallback(
                                    transformation.pers2    //
           );
         };
-
-    // If there is an external view embedder, ask it to apply the surface
-    // transformation to its surfaces as well.
-    if (external_view_embedder) {
-      external_view_embedder->SetSurfaceTransformationCallback(
-          gl_surface_transformation_callback);
-    }
   }
 
   flutter::GPUSurfaceGLDelegate::GLProcResolver gl_proc_resolver = nullptr;
@@ -282,32 +278,31 @@ InferOpenGLPlatformViewCreationCallback(
       gl_proc_resolver,                    // gl_proc_resolver
   };
 
-  return fml::MakeCopyable(
-      [gl_dispatch_table, fbo_reset_after_present, platform_dispatch_table,
-       external_view_embedder =
-           std::move(external_view_embedder)](flutter::Shell& shell) mutable {
-        return std::make_unique<flutter::PlatformViewEmbedder>(
-            shell,                    // delegate
-            shell.GetTaskRunners(),   // task runners
-            gl_dispatch_table,        // embedder GL dispatch table
-            fbo_reset_after_present,  // fbo reset after present
-            platform_dispatch_table,  // embedder platform dispatch table
-            std::move(external_view_embedder)  // external view embedder
-        );
-      });
+  return [gl_dispatch_table, fbo_reset_after_present](
+             std::shared_ptr<flutter::EmbedderExternalViewEmbedder>
+                 external_view_embedder)
+             -> std::unique_ptr<flutter::EmbedderSurface> {
+    // If there is an external view embedder, ask it to apply the surface
+    // transformation to its surfaces as well.
+    if (external_view_embedder &&
+        gl_dispatch_table.gl_surface_transformation_callback) {
+      external_view_embedder->SetSurfaceTransformationCallback(
+          gl_dispatch_table.gl_surface_transformation_callback);
+    }
+    return std::make_unique<flutter::EmbedderSurfaceGL>(
+        gl_dispatch_table,                 // embedder GL dispatch table
+        fbo_reset_after_present,           // fbo reset after present
+        std::move(external_view_embedder)  // external view embedder
+    );
+  };
 #else
   return nullptr;
 #endif
 }
 
-static flutter::Shell::CreateCallback<flutter::PlatformView>
-InferMetalPlatformViewCreationCallback(
+static EmbedderSurfaceFactory InferMetalEmbedderSurfaceFactory(
     const FlutterRendererConfig* config,
-    void* user_data,
-    flutter::PlatformViewEmbedder::PlatformDispatchTable
-        platform_dispatch_table,
-    std::unique_ptr<flutter::EmbedderExternalViewEmbedder>
-        external_view_embedder) {
+    void* user_data) {
   if (config->type != kMetal) {
     return nullptr;
   }
@@ -342,40 +337,26 @@ InferMetalPlatformViewCreationCallback(
       .get_texture = metal_get_texture,
   };
 
-  std::shared_ptr<flutter::EmbedderExternalViewEmbedder> view_embedder =
-      std::move(external_view_embedder);
-
-  std::unique_ptr<flutter::EmbedderSurfaceMetal> embedder_surface =
-      std::make_unique<flutter::EmbedderSurfaceMetal>(
-          const_cast<flutter::GPUMTLDeviceHandle>(config->metal.device),
-          const_cast<flutter::GPUMTLCommandQueueHandle>(
+  return [device = const_cast<flutter::GPUMTLDeviceHandle>(
+              config->metal.device),
+          command_queue = const_cast<flutter::GPUMTLCommandQueueHandle>(
               config->metal.present_command_queue),
-          metal_dispatch_table, view_embedder);
-
-  return fml::MakeCopyable(
-      [embedder_surface = std::move(embedder_surface), platform_dispatch_table,
-       external_view_embedder = view_embedder](flutter::Shell& shell) mutable {
-        return std::make_unique<flutter::PlatformViewEmbedder>(
-            shell,                             // delegate
-            shell.GetTaskRunners(),            // task runners
-            std::move(embedder_surface),       // embedder surface
-            platform_dispatch_table,           // platform dispatch table
-            std::move(external_view_embedder)  // external view embedder
-        );
-      });
+          metal_dispatch_table](
+             std::shared_ptr<flutter::EmbedderExternalViewEmbedder>
+                 external_view_embedder)
+             -> std::unique_ptr<flutter::EmbedderSurface> {
+    return std::make_unique<flutter::EmbedderSurfaceMetal>(
+        device, command_queue, metal_dispatch_table,
+        std::move(external_view_embedder));
+  };
 #else
   return nullptr;
 #endif
 }
 
-static flutter::Shell::CreateCallback<flutter::PlatformView>
-InferSoftwarePlatformViewCreationCallback(
+static EmbedderSurfaceFactory InferSoftwareEmbedderSurfaceFactory(
     const FlutterRendererConfig* config,
-    void* user_data,
-    flutter::PlatformViewEmbedder::PlatformDispatchTable
-        platform_dispatch_table,
-    std::unique_ptr<flutter::EmbedderExternalViewEmbedder>
-        external_view_embedder) {
+    void* user_data) {
   if (config->type != kSoftware) {
     return nullptr;
   }
@@ -391,51 +372,120 @@ InferSoftwarePlatformViewCreationCallback(
           software_present_backing_store,  // required
       };
 
-  return fml::MakeCopyable(
-      [software_dispatch_table, platform_dispatch_table,
-       external_view_embedder =
-           std::move(external_view_embedder)](flutter::Shell& shell) mutable {
-        return std::make_unique<flutter::PlatformViewEmbedder>(
-            shell,                             // delegate
-            shell.GetTaskRunners(),            // task runners
-            software_dispatch_table,           // software dispatch table
-            platform_dispatch_table,           // platform dispatch table
-            std::move(external_view_embedder)  // external view embedder
-        );
-      });
+  return [software_dispatch_table](
+             std::shared_ptr<flutter::EmbedderExternalViewEmbedder>
+                 external_view_embedder)
+             -> std::unique_ptr<flutter::EmbedderSurface> {
+    return std::make_unique<flutter::EmbedderSurfaceSoftware>(
+        software_dispatch_table, std::move(external_view_embedder));
+  };
 }
 
-static flutter::Shell::CreateCallback<flutter::PlatformView>
-InferPlatformViewCreationCallback(
+// Infers how to create the surfaces of the renderer described by |config|.
+// The factory may be called any number of times, each time creating a new
+// surface.
+static EmbedderSurfaceFactory InferEmbedderSurfaceFactory(
     const FlutterRendererConfig* config,
-    void* user_data,
-    flutter::PlatformViewEmbedder::PlatformDispatchTable
-        platform_dispatch_table,
-    std::unique_ptr<flutter::EmbedderExternalViewEmbedder>
-        external_view_embedder) {
+    void* user_data) {
   if (config == nullptr) {
     return nullptr;
   }
 
   switch (config->type) {
     case kOpenGL:
-      return InferOpenGLPlatformViewCreationCallback(
-          config, user_data, platform_dispatch_table,
-          std::move(external_view_embedder));
+      return InferOpenGLEmbedderSurfaceFactory(config, user_data);
     case kSoftware:
-      return InferSoftwarePlatformViewCreationCallback(
-          config, user_data, platform_dispatch_table,
-          std::move(external_view_embedder));
+      return InferSoftwareEmbedderSurfaceFactory(config, user_data);
     case kMetal:
-      return InferMetalPlatformViewCreationCallback(
-          config, user_data, platform_dispatch_table,
-          std::move(external_view_embedder));
+      return InferMetalEmbedderSurfaceFactory(config, user_data);
     default:
       return nullptr;
   }
   return nullptr;
 }
 
+// Each platform view gets its own external view embedder, and a surface made
+// by |surface_factory|. A null factory creates platform views whose surface
+// is set later.
+static flutter::Shell::CreateCallback<flutter::PlatformView>
+InferPlatformViewCreationCallback(
+    EmbedderSurfaceFactory surface_factory,
+    flutter::PlatformViewEmbedder::PlatformDispatchTable
+        platform_dispatch_table,
+    ExternalViewEmbedderFactory external_view_embedder_factory) {
+  return [surface_factory, platform_dispatch_table,
+          external_view_embedder_factory](flutter::Shell& shell) {
+    std::shared_ptr<flutter::EmbedderExternalViewEmbedder>
+        external_view_embedder = external_view_embedder_factory
+                                     ? external_view_embedder_factory()
+                                     : nullptr;
+    return std::make_unique<flutter::PlatformViewEmbedder>(
+        shell,                             // delegate
+        shell.GetTaskRunners(),            // task runners
+        surface_factory,                   // embedder surface factory
+        platform_dispatch_table,           // platform dispatch table
+        std::move(external_view_embedder)  // external view embedder
+    );
+  };
+}
+
+static std::unique_ptr<flutter::EmbedderExternalTextureResolver>
+InferExternalTextureResolver(const FlutterRendererConfig* config,
+                             void* user_data) {
+  using ExternalTextureResolver = flutter::EmbedderExternalTextureResolver;
+  std::unique_ptr<ExternalTextureResolver> external_texture_resolver;
+  external_texture_resolver = std::make_unique<ExternalTextureResolver>();
+
+#ifdef SHELL_ENABLE_GL
+  flutter::EmbedderExternalTextureGL::ExternalTextureCallback
+      external_texture_callback;
+  if (config->type == kOpenGL) {
+    const FlutterOpenGLRendererConfig* open_gl_config = &config->open_gl;
+    if (SAFE_ACCESS(open_gl_config, gl_external_texture_frame_callback,
+                    nullptr) != nullptr) {
+      external_texture_callback =
+          [ptr = open_gl_config->gl_external_texture_frame_callback, user_data](
+              int64_t texture_identifier, size_t width,
+              size_t height) -> std::unique_ptr<FlutterOpenGLTexture> {
+        std::unique_ptr<FlutterOpenGLTexture> texture =
+            std::make_unique<FlutterOpenGLTexture>();
+        if (!ptr(user_data, texture_identifier, width, height, texture.get())) {
+          return nullptr;
+        }
+        return texture;
+      };
+    }
+  }
+  external_texture_resolver =
+      std::make_unique<ExternalTextureResolver>(external_texture_callback);
+#endif
+#ifdef SHELL_ENABLE_METAL
+  flutter::EmbedderExternalTextureMetal::ExternalTextureCallback
+      external_texture_metal_callback;
+  if (config->type == kMetal) {
+    const FlutterMetalRendererConfig* metal_config = &config->metal;
+    if (SAFE_ACCESS(metal_config, external_texture_frame_callback, nullptr)) {
+      external_texture_metal_callback =
+          [ptr = metal_config->external_texture_frame_callback, user_data](
+              int64_t texture_identifier, size_t width,
+              size_t height) -> std::unique_ptr<FlutterMetalExternalTexture> {
+        std::unique_ptr<FlutterMetalExternalTexture> texture =
+            std::make_unique<FlutterMetalExternalTexture>();
+        texture->struct_size = sizeof(FlutterMetalExternalTexture);
+        if (!ptr(user_data, texture_identifier, width, height, texture.get())) {
+          return nullptr;
+        }
+        return texture;
+      };
+    }
+  }
+  external_texture_resolver = std::make_unique<ExternalTextureResolver>(
+      external_texture_metal_callback);
+#endif
+
+  return external_texture_resolver;
+}
+
 static sk_sp<SkSurface> MakeSkSurfaceFromBackingStore(
     GrDirectContext* context,
     const FlutterBackingStoreConfig& config,
@@ -634,7 +684,7 @@ CreateEmbedderRenderTarget(const FlutterCompositor* compositor,
       backing_store, std::move(render_surface), collect_callback.Release());
 }
 
-static std::pair<std::unique_ptr<flutter::EmbedderExternalViewEmbedder>,
+static std::pair<ExternalViewEmbedderFactory,
                  bool /* halt engine launch if true */>
 InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor) {
   if (compositor == nullptr) {
@@ -674,9 +724,12 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor) {
             user_data);
       };
 
-  return {std::make_unique<flutter::EmbedderExternalViewEmbedder>(
-              avoid_backing_store_cache, create_render_target_callback,
-              present_callback),
+  return {[avoid_backing_store_cache, create_render_target_callback,
+           present_callback]() {
+            return std::make_unique<flutter::EmbedderExternalViewEmbedder>(
+                avoid_backing_store_cache, create_render_target_callback,
+                present_callback);
+          },
           false};
 }
 
@@ -695,6 +748,7 @@ struct LoadedElfDeleter {
 using UniqueLoadedElf = std::unique_ptr<Dart_LoadedElf, LoadedElfDeleter>;
 
 struct _FlutterEngineAOTData {
+  std::string elf_path;
   UniqueLoadedElf loaded_elf = nullptr;
   const uint8_t* vm_snapshot_data = nullptr;
   const uint8_t* vm_snapshot_instrs = nullptr;
@@ -744,6 +798,7 @@ FlutterEngineResult FlutterEngineCreateAOTData(
         return LOG_EMBEDDER_ERROR(kInvalidArguments, error);
       }
 
+      aot_data->elf_path = source->elf_path;
       aot_data->loaded_elf.reset(loaded_elf);
 
       *data_out = aot_data.release();
@@ -791,6 +846,17 @@ void PopulateSnapshotMappingCallbacks(
 
       settings.isolate_snapshot_instr =
           make_mapping_callback(args->aot_data->vm_isolate_instrs, 0);
+
+      // The ELF loader doesn't say how large the snapshots are, so the file
+      // they are loaded from is read ahead instead.
+      if (settings.prefetch_snapshots) {
+        fml::UniqueFD elf = fml::OpenFile(args->aot_data->elf_path.c_str(),
+                                          false, fml::FilePermission::kRead);
+        if (!elf.is_valid() || !fml::ReadAhead(elf)) {
+          FML_DLOG(WARNING) << "Could not prefetch the AOT snapshots in "
+                            << args->aot_data->elf_path;
+        }
+      }
     }
 
     if (SAFE_ACCESS(args, vm_snapshot_data, nullptr) != nullptr) {
@@ -1049,8 +1115,8 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
           const FlutterPlatformMessage incoming_message = {
               sizeof(FlutterPlatformMessage),  // struct_size
               message->channel().c_str(),      // channel
-              message->data().data(),          // message
-              message->data().size(),          // message_size
+              message->data().GetMapping(),    // message
+              message->data().GetSize(),       // message_size
               handle,                          // response_handle
           };
           handle->message = std::move(message);
@@ -1129,71 +1195,30 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
           compute_platform_resolved_locale_callback,  //
       };
 
-  auto on_create_platform_view = InferPlatformViewCreationCallback(
-      config, user_data, platform_dispatch_table,
-      std::move(external_view_embedder_result.first));
+  auto surface_factory = InferEmbedderSurfaceFactory(config, user_data);
 
-  if (!on_create_platform_view) {
+  if (!surface_factory) {
     return LOG_EMBEDDER_ERROR(
         kInternalInconsistency,
         "Could not infer platform view creation callback.");
   }
 
+  auto on_create_platform_view = InferPlatformViewCreationCallback(
+      surface_factory, platform_dispatch_table,
+      external_view_embedder_result.first);
+
+  // Engines spawned for warm engine pools get their renderer when they are
+  // taken from the pool.
+  auto on_create_spawned_platform_view = InferPlatformViewCreationCallback(
+      nullptr, platform_dispatch_table, external_view_embedder_result.first);
+
   flutter::Shell::CreateCallback<flutter::Rasterizer> on_create_rasterizer =
       [](flutter::Shell& shell) {
         return std::make_unique<flutter::Rasterizer>(shell);
       };
 
-  using ExternalTextureResolver = flutter::EmbedderExternalTextureResolver;
-  std::unique_ptr<ExternalTextureResolver> external_texture_resolver;
-  external_texture_resolver = std::make_unique<ExternalTextureResolver>();
-
-#ifdef SHELL_ENABLE_GL
-  flutter::EmbedderExternalTextureGL::ExternalTextureCallback
-      external_texture_callback;
-  if (config->type == kOpenGL) {
-    const FlutterOpenGLRendererConfig* open_gl_config = &config->open_gl;
-    if (SAFE_ACCESS(open_gl_config, gl_external_texture_frame_callback,
-                    nullptr) != nullptr) {
-      external_texture_callback =
-          [ptr = open_gl_config->gl_external_texture_frame_callback, user_data](
-              int64_t texture_identifier, size_t width,
-              size_t height) -> std::unique_ptr<FlutterOpenGLTexture> {
-        std::unique_ptr<FlutterOpenGLTexture> texture =
-            std::make_unique<FlutterOpenGLTexture>();
-        if (!ptr(user_data, texture_identifier, width, height, texture.get())) {
-          return nullptr;
-        }
-        return texture;
-      };
-    }
-  }
-  external_texture_resolver =
-      std::make_unique<ExternalTextureResolver>(external_texture_callback);
-#endif
-#ifdef SHELL_ENABLE_METAL
-  flutter::EmbedderExternalTextureMetal::ExternalTextureCallback
-      external_texture_metal_callback;
-  if (config->type == kMetal) {
-    const FlutterMetalRendererConfig* metal_config = &config->metal;
-    if (SAFE_ACCESS(metal_config, external_texture_frame_callback, nullptr)) {
-      external_texture_metal_callback =
-          [ptr = metal_config->external_texture_frame_callback, user_data](
-              int64_t texture_identifier, size_t width,
-              size_t height) -> std::unique_ptr<FlutterMetalExternalTexture> {
-        std::unique_ptr<FlutterMetalExternalTexture> texture =
-            std::make_unique<FlutterMetalExternalTexture>();
-        texture->struct_size = sizeof(FlutterMetalExternalTexture);
-        if (!ptr(user_data, texture_identifier, width, height, texture.get())) {
-          return nullptr;
-        }
-        return texture;
-      };
-    }
-  }
-  external_texture_resolver = std::make_unique<ExternalTextureResolver>(
-      external_texture_metal_callback);
-#endif
+  auto external_texture_resolver =
+      InferExternalTextureResolver(config, user_data);
 
   auto thread_host =
       flutter::EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
@@ -1249,6 +1274,7 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
       std::move(settings),                  //
       std::move(run_configuration),         //
       on_create_platform_view,              //
+      on_create_spawned_platform_view,      //
       on_create_rasterizer,                 //
       std::move(external_texture_resolver)  //
   );
@@ -1573,10 +1599,29 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
     response = response_handle->message->response();
   }
 
+  VoidCallback release_callback =
+      SAFE_ACCESS(flutter_message, message_release_callback, nullptr);
+  void* release_user_data =
+      SAFE_ACCESS(flutter_message, message_release_user_data, nullptr);
+
   fml::RefPtr<flutter::PlatformMessage> message;
   if (message_size == 0) {
     message = fml::MakeRefCounted<flutter::PlatformMessage>(
         flutter_message->channel, response);
+    if (release_callback) {
+      release_callback(release_user_data);
+    }
+  } else if (release_callback) {
+    // The embedder has transferred ownership of the buffer. Avoid the copy.
+    message = fml::MakeRefCounted<flutter::PlatformMessage>(
+        flutter_message->channel,
+        std::make_unique<fml::NonOwnedMapping>(
+            message_data, message_size,
+            [release_callback, release_user_data](const uint8_t* data,
+                                                  size_t size) {
+              release_callback(release_user_data);
+            }),
+        response);
   } else {
     message = fml::MakeRefCounted<flutter::PlatformMessage>(
         flutter_message->channel,
@@ -1969,50 +2014,32 @@ bool FlutterEngineRunsAOTCompiledDartCode(void) {
   return flutter::DartVM::IsRunningPrecompiledCode();
 }
 
-FlutterEngineResult FlutterEnginePostDartObject(
-    FLUTTER_API_SYMBOL(FlutterEngine) engine,
-    FlutterEngineDartPort port,
-    const FlutterEngineDartObject* object) {
-  if (engine == nullptr) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
-  }
-
-  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)->IsValid()) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine not running.");
-  }
-
-  if (port == ILLEGAL_PORT) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments,
-                              "Attempted to post to an illegal port.");
-  }
-
-  if (object == nullptr) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments,
-                              "Invalid Dart object to post.");
-  }
-
-  Dart_CObject dart_object = {};
-  fml::ScopedCleanupClosure typed_data_finalizer;
-
+// Describes |object| as a |Dart_CObject|. Anything allocated to do so is
+// collected by |typed_data_finalizer| unless it is released once the object
+// has been posted.
+static FlutterEngineResult InitializeDartCObject(
+    const FlutterEngineDartObject* object,
+    Dart_CObject* dart_object,
+    fml::ScopedCleanupClosure* typed_data_finalizer) {
   switch (object->type) {
     case kFlutterEngineDartObjectTypeNull:
-      dart_object.type = Dart_CObject_kNull;
+      dart_object->type = Dart_CObject_kNull;
       break;
     case kFlutterEngineDartObjectTypeBool:
-      dart_object.type = Dart_CObject_kBool;
-      dart_object.value.as_bool = object->bool_value;
+      dart_object->type = Dart_CObject_kBool;
+      dart_object->value.as_bool = object->bool_value;
       break;
     case kFlutterEngineDartObjectTypeInt32:
-      dart_object.type = Dart_CObject_kInt32;
-      dart_object.value.as_int32 = object->int32_value;
+      dart_object->type = Dart_CObject_kInt32;
+      dart_object->value.as_int32 = object->int32_value;
       break;
     case kFlutterEngineDartObjectTypeInt64:
-      dart_object.type = Dart_CObject_kInt64;
-      dart_object.value.as_int64 = object->int64_value;
+      dart_object->type = Dart_CObject_kInt64;
+      dart_object->value.as_int64 = object->int64_value;
       break;
     case kFlutterEngineDartObjectTypeDouble:
-      dart_object.type = Dart_CObject_kDouble;
-      dart_object.value.as_double = object->double_value;
+      dart_object->type = Dart_CObject_kDouble;
+      dart_object->value.as_double = object->double_value;
       break;
     case kFlutterEngineDartObjectTypeString:
       if (object->string_value == nullptr) {
@@ -2020,8 +2047,8 @@ FlutterEngineResult FlutterEnginePostDartObject(
                                   "kFlutterEngineDartObjectTypeString must be "
                                   "a null terminated string but was null.");
       }
-      dart_object.type = Dart_CObject_kString;
-      dart_object.value.as_string = const_cast<char*>(object->string_value);
+      dart_object->type = Dart_CObject_kString;
+      dart_object->value.as_string = const_cast<char*>(object->string_value);
       break;
     case kFlutterEngineDartObjectTypeBuffer: {
       auto* buffer = SAFE_ACCESS(object->buffer_value, buffer, nullptr);
@@ -2035,14 +2062,50 @@ FlutterEngineResult FlutterEnginePostDartObject(
           SAFE_ACCESS(object->buffer_value, buffer_collect_callback, nullptr);
       auto user_data = SAFE_ACCESS(object->buffer_value, user_data, nullptr);
 
-      // The user has provided a callback, let them manage the lifecycle of
-      // the underlying data. If not, copy it out from the provided buffer.
+      auto pool = SAFE_ACCESS(object->buffer_value, pool, nullptr);
+
+      // Pooled buffers are handed to Dart as they are and go back to the pool
+      // once collected. Otherwise, if the user has provided a callback, let
+      // them manage the lifecycle of the underlying data. If not, copy it out
+      // from the provided buffer.
 
-      if (callback == nullptr) {
-        dart_object.type = Dart_CObject_kTypedData;
-        dart_object.value.as_typed_data.type = Dart_TypedData_kUint8;
-        dart_object.value.as_typed_data.length = buffer_size;
-        dart_object.value.as_typed_data.values = buffer;
+      if (pool != nullptr) {
+        if (buffer_size > pool->pool->GetBufferSize()) {
+          return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                    "The size of a pooled buffer must not "
+                                    "exceed the buffer size of its pool.");
+        }
+        if (!pool->pool->IsOutstanding(buffer)) {
+          return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                    "The buffer was not acquired from the "
+                                    "specified pool.");
+        }
+        struct PooledTypedDataPeer {
+          std::shared_ptr<flutter::EmbedderBufferPool> pool;
+          uint8_t* buffer = nullptr;
+        };
+        auto peer = new PooledTypedDataPeer();
+        peer->pool = pool->pool;
+        peer->buffer = buffer;
+        // As with embedder collected buffers, the embedder keeps the buffer
+        // if the post fails.
+        typed_data_finalizer->SetClosure([peer]() { delete peer; });
+        dart_object->type = Dart_CObject_kExternalTypedData;
+        dart_object->value.as_external_typed_data.type = Dart_TypedData_kUint8;
+        dart_object->value.as_external_typed_data.length = buffer_size;
+        dart_object->value.as_external_typed_data.data = buffer;
+        dart_object->value.as_external_typed_data.peer = peer;
+        dart_object->value.as_external_typed_data.callback =
+            +[](void* unused_isolate_callback_data, void* peer) {
+              auto typed_peer = reinterpret_cast<PooledTypedDataPeer*>(peer);
+              typed_peer->pool->Recycle(typed_peer->buffer);
+              delete typed_peer;
+            };
+      } else if (callback == nullptr) {
+        dart_object->type = Dart_CObject_kTypedData;
+        dart_object->value.as_typed_data.type = Dart_TypedData_kUint8;
+        dart_object->value.as_typed_data.length = buffer_size;
+        dart_object->value.as_typed_data.values = buffer;
       } else {
         struct ExternalTypedDataPeer {
           void* user_data = nullptr;
@@ -2052,23 +2115,23 @@ FlutterEngineResult FlutterEnginePostDartObject(
         peer->user_data = user_data;
         peer->trampoline = callback;
         // This finalizer is set so that in case of failure of the
-        // Dart_PostCObject below, we collect the peer. The embedder is still
-        // responsible for collecting the buffer in case of non-kSuccess
-        // returns from this method. This finalizer must be released in case
-        // of kSuccess returns from this method.
-        typed_data_finalizer.SetClosure([peer]() {
+        // Dart_PostCObject made by the caller, we collect the peer. The
+        // embedder is still responsible for collecting the buffer in case of
+        // non-kSuccess returns from the post. This finalizer must be released
+        // in case of kSuccess returns from the post.
+        typed_data_finalizer->SetClosure([peer]() {
           // This is the tiny object we use as the peer to the Dart call so
           // that we can attach the a trampoline to the embedder supplied
           // callback. In case of error, we need to collect this object lest
           // we introduce a tiny leak.
           delete peer;
         });
-        dart_object.type = Dart_CObject_kExternalTypedData;
-        dart_object.value.as_external_typed_data.type = Dart_TypedData_kUint8;
-        dart_object.value.as_external_typed_data.length = buffer_size;
-        dart_object.value.as_external_typed_data.data = buffer;
-        dart_object.value.as_external_typed_data.peer = peer;
-        dart_object.value.as_external_typed_data.callback =
+        dart_object->type = Dart_CObject_kExternalTypedData;
+        dart_object->value.as_external_typed_data.type = Dart_TypedData_kUint8;
+        dart_object->value.as_external_typed_data.length = buffer_size;
+        dart_object->value.as_external_typed_data.data = buffer;
+        dart_object->value.as_external_typed_data.peer = peer;
+        dart_object->value.as_external_typed_data.callback =
             +[](void* unused_isolate_callback_data, void* peer) {
               auto typed_peer = reinterpret_cast<ExternalTypedDataPeer*>(peer);
               typed_peer->trampoline(typed_peer->user_data);
@@ -2082,6 +2145,39 @@ FlutterEngineResult FlutterEnginePostDartObject(
           "Invalid FlutterEngineDartObjectType type specified.");
   }
 
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEnginePostDartObject(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineDartPort port,
+    const FlutterEngineDartObject* object) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine not running.");
+  }
+
+  if (port == ILLEGAL_PORT) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Attempted to post to an illegal port.");
+  }
+
+  if (object == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid Dart object to post.");
+  }
+
+  Dart_CObject dart_object = {};
+  fml::ScopedCleanupClosure typed_data_finalizer;
+  auto result =
+      InitializeDartCObject(object, &dart_object, &typed_data_finalizer);
+  if (result != kSuccess) {
+    return result;
+  }
+
   if (!Dart_PostCObject(port, &dart_object)) {
     return LOG_EMBEDDER_ERROR(kInternalInconsistency,
                               "Could not post the object to the Dart VM.");
@@ -2093,6 +2189,232 @@ FlutterEngineResult FlutterEnginePostDartObject(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEnginePostDartObjects(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineDartPort port,
+    const FlutterEngineDartObject* objects,
+    size_t objects_count) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine not running.");
+  }
+
+  if (port == ILLEGAL_PORT) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Attempted to post to an illegal port.");
+  }
+
+  if (objects == nullptr && objects_count > 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid Dart objects to post.");
+  }
+
+  std::vector<Dart_CObject> dart_objects(objects_count);
+  std::vector<Dart_CObject*> dart_object_pointers(objects_count);
+  // If any object is invalid or the post fails, the finalizers of the objects
+  // described so far collect what was allocated for them.
+  auto typed_data_finalizers =
+      std::make_unique<fml::ScopedCleanupClosure[]>(objects_count);
+  for (size_t i = 0; i < objects_count; i++) {
+    auto result = InitializeDartCObject(&objects[i], &dart_objects[i],
+                                        &typed_data_finalizers[i]);
+    if (result != kSuccess) {
+      return result;
+    }
+    dart_object_pointers[i] = &dart_objects[i];
+  }
+
+  Dart_CObject dart_array = {};
+  dart_array.type = Dart_CObject_kArray;
+  dart_array.value.as_array.length = objects_count;
+  dart_array.value.as_array.values = dart_object_pointers.data();
+
+  if (!Dart_PostCObject(port, &dart_array)) {
+    return LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                              "Could not post the objects to the Dart VM.");
+  }
+
+  // On a successful call, the VM takes ownership of and is responsible for
+  // invoking the finalizers.
+  for (size_t i = 0; i < objects_count; i++) {
+    typed_data_finalizers[i].Release();
+  }
+  return kSuccess;
+}
+
+struct _FlutterEngineDartBufferPool {
+  std::shared_ptr<flutter::EmbedderBufferPool> pool;
+};
+
+FlutterEngineResult FlutterEngineCreateDartBufferPool(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    size_t buffer_size,
+    FlutterEngineDartBufferPool* pool_out) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (buffer_size == 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Pooled buffers must not be empty.");
+  }
+
+  if (pool_out == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Null pool_out specified.");
+  }
+
+  // Collected in `FlutterEngineCollectDartBufferPool`.
+  *pool_out = new _FlutterEngineDartBufferPool{
+      std::make_shared<flutter::EmbedderBufferPool>(buffer_size)};
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineDartBufferPoolAcquire(
+    FlutterEngineDartBufferPool pool,
+    uint8_t** buffer_out) {
+  if (pool == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid buffer pool.");
+  }
+
+  if (buffer_out == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Null buffer_out specified.");
+  }
+
+  *buffer_out = pool->pool->Acquire();
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineDartBufferPoolRelease(
+    FlutterEngineDartBufferPool pool,
+    uint8_t* buffer) {
+  if (pool == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid buffer pool.");
+  }
+
+  if (buffer == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Null buffer specified.");
+  }
+
+  if (!pool->pool->Recycle(buffer)) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "The buffer was not acquired from the specified pool.");
+  }
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineCollectDartBufferPool(
+    FlutterEngineDartBufferPool pool) {
+  if (pool == nullptr) {
+    // Deleting a null object should be a no-op.
+    return kSuccess;
+  }
+
+  delete pool;
+  return kSuccess;
+}
+
+struct _FlutterEngineWarmEnginePool {
+  std::unique_ptr<flutter::WarmShellPool> pool;
+  flutter::EmbedderEngine::SpawnedEngineFactory make_engine;
+};
+
+FlutterEngineResult FlutterEngineCreateWarmEnginePool(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    size_t capacity,
+    const char* entrypoint,
+    FlutterEngineWarmEnginePool* pool_out) {
+  auto embedder_engine = reinterpret_cast<flutter::EmbedderEngine*>(engine);
+  if (embedder_engine == nullptr || !embedder_engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  if (pool_out == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Null pool_out specified.");
+  }
+
+  if (!embedder_engine->GetTaskRunners()
+           .GetPlatformTaskRunner()
+           ->RunsTasksOnCurrentThread()) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "Warm engine pools must be used on the platform thread.");
+  }
+
+  auto pool = embedder_engine->CreateWarmShellPool(
+      capacity, entrypoint == nullptr ? "" : entrypoint);
+  if (!pool) {
+    return LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                              "Could not create the warm engine pool.");
+  }
+
+  // Collected in `FlutterEngineCollectWarmEnginePool`.
+  *pool_out = new _FlutterEngineWarmEnginePool{
+      std::move(pool), embedder_engine->GetSpawnedEngineFactory()};
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineWarmEnginePoolTake(
+    FlutterEngineWarmEnginePool pool,
+    const FlutterRendererConfig* config,
+    void* user_data,
+    FLUTTER_API_SYMBOL(FlutterEngine) * engine_out) {
+  if (pool == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid warm engine pool.");
+  }
+
+  if (!IsRendererValid(config)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The renderer configuration was invalid.");
+  }
+
+  if (engine_out == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Null engine_out specified.");
+  }
+
+  auto surface_factory = InferEmbedderSurfaceFactory(config, user_data);
+  if (!surface_factory) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Could not infer a surface for the renderer.");
+  }
+
+  auto shell = pool->pool->Take();
+  if (!shell) {
+    return LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                              "Could not spawn an engine for the pool.");
+  }
+
+  // The platform views of spawned shells are created without a surface.
+  static_cast<flutter::PlatformViewEmbedder*>(shell->GetPlatformView().get())
+      ->SetEmbedderSurface(surface_factory);
+
+  auto embedder_engine = pool->make_engine(
+      std::move(shell), InferExternalTextureResolver(config, user_data));
+  if (!embedder_engine->NotifyCreated()) {
+    return LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                              "Could not create platform view components.");
+  }
+
+  // Release the ownership of the embedder engine to the caller.
+  *engine_out = reinterpret_cast<FLUTTER_API_SYMBOL(FlutterEngine)>(
+      embedder_engine.release());
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineCollectWarmEnginePool(
+    FlutterEngineWarmEnginePool pool) {
+  if (pool == nullptr) {
+    // Deleting a null object should be a no-op.
+    return kSuccess;
+  }
+
+  delete pool;
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineNotifyLowMemoryWarning(
     FLUTTER_API_SYMBOL(FlutterEngine) raw_engine) {
   auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
@@ -2195,6 +2517,163 @@ FlutterEngineResult FlutterEngineNotifyDisplayUpdate(
   }
 }
 
+FlutterEngineResult FlutterEngineSetPlatformMessageBackgroundCallback(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    const char* channel,
+    FlutterPlatformMessageCallback callback,
+    void* user_data,
+    VoidCallback release_user_data) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (channel == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid channel name.");
+  }
+
+  auto& shell = engine->GetShell();
+
+  if (callback == nullptr) {
+    shell.SetBackgroundPlatformMessageHandler(channel, nullptr);
+    return kSuccess;
+  }
+
+  // The shell destroys the handler once it won't invoke it again, and with it
+  // the last reference to the user data.
+  std::shared_ptr<void> baton(user_data, [release_user_data](void* user_data) {
+    if (release_user_data) {
+      release_user_data(user_data);
+    }
+  });
+
+  shell.SetBackgroundPlatformMessageHandler(
+      channel,
+      [callback, baton](fml::RefPtr<flutter::PlatformMessage> message) {
+        auto handle = new FlutterPlatformMessageResponseHandle();
+        const FlutterPlatformMessage incoming_message = {
+            sizeof(FlutterPlatformMessage),  // struct_size
+            message->channel().c_str(),      // channel
+            message->data().GetMapping(),    // message
+            message->data().GetSize(),       // message_size
+            handle,                          // response_handle
+        };
+        handle->message = std::move(message);
+        callback(&incoming_message, baton.get());
+      });
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineSetPlatformMessageBatchWindow(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    const char* channel,
+    uint64_t window_nanos) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (channel == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid channel name.");
+  }
+
+  engine->GetShell().SetPlatformMessageBatchWindow(
+      channel, fml::TimeDelta::FromNanoseconds(window_nanos));
+  return kSuccess;
+}
+
+struct _FlutterEngineRingBuffer {
+  std::shared_ptr<flutter::RingBuffer> ring_buffer;
+  int64_t identifier = 0;
+};
+
+// Ring buffers belong to the engine whose UI task queue they are registered
+// with, which is the one its isolates look them up by.
+static fml::TaskQueueId GetRingBufferOwner(flutter::EmbedderEngine* engine) {
+  return engine->GetShell()
+      .GetTaskRunners()
+      .GetUITaskRunner()
+      ->GetTaskQueueId();
+}
+
+FlutterEngineResult FlutterEngineCreateRingBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    size_t capacity,
+    FlutterEngineRingBuffer* ring_buffer_out,
+    int64_t* identifier_out) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (capacity == 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Ring buffer capacity must not be zero.");
+  }
+
+  if (capacity > flutter::RingBuffer::kMaxCapacity) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Ring buffer capacity was too large.");
+  }
+
+  if (ring_buffer_out == nullptr || identifier_out == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Ring buffer out parameters were null.");
+  }
+
+  auto handle = std::make_unique<_FlutterEngineRingBuffer>();
+  handle->ring_buffer = std::make_shared<flutter::RingBuffer>(capacity);
+  handle->identifier = flutter::RingBufferRegistry::GetInstance().Register(
+      GetRingBufferOwner(engine), handle->ring_buffer);
+  *identifier_out = handle->identifier;
+  // Released in `FlutterEngineCollectRingBuffer`.
+  *ring_buffer_out = handle.release();
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineRingBufferWrite(
+    FlutterEngineRingBuffer ring_buffer,
+    const uint8_t* data,
+    size_t size,
+    size_t* written_out) {
+  if (ring_buffer == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid ring buffer.");
+  }
+
+  if (data == nullptr && size > 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Data was null.");
+  }
+
+  if (written_out == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Written out was null.");
+  }
+
+  *written_out = ring_buffer->ring_buffer->Write(data, size);
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineCollectRingBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    FlutterEngineRingBuffer ring_buffer) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (ring_buffer == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid ring buffer.");
+  }
+
+  if (!flutter::RingBufferRegistry::GetInstance().Unregister(
+          GetRingBufferOwner(engine), ring_buffer->identifier)) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "The ring buffer was not created with this engine instance.");
+  }
+  delete ring_buffer;
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineGetProcAddresses(
     FlutterEngineProcTable* table) {
   if (!table) {
@@ -2245,6 +2724,21 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(PostCallbackOnAllNativeThreads,
            FlutterEnginePostCallbackOnAllNativeThreads);
   SET_PROC(NotifyDisplayUpdate, FlutterEngineNotifyDisplayUpdate);
+  SET_PROC(SetPlatformMessageBackgroundCallback,
+           FlutterEngineSetPlatformMessageBackgroundCallback);
+  SET_PROC(SetPlatformMessageBatchWindow,
+           FlutterEngineSetPlatformMessageBatchWindow);
+  SET_PROC(CreateRingBuffer, FlutterEngineCreateRingBuffer);
+  SET_PROC(RingBufferWrite, FlutterEngineRingBufferWrite);
+  SET_PROC(CollectRingBuffer, FlutterEngineCollectRingBuffer);
+  SET_PROC(PostDartObjects, FlutterEnginePostDartObjects);
+  SET_PROC(CreateDartBufferPool, FlutterEngineCreateDartBufferPool);
+  SET_PROC(DartBufferPoolAcquire, FlutterEngineDartBufferPoolAcquire);
+  SET_PROC(DartBufferPoolRelease, FlutterEngineDartBufferPoolRelease);
+  SET_PROC(CollectDartBufferPool, FlutterEngineCollectDartBufferPool);
+  SET_PROC(CreateWarmEnginePool, FlutterEngineCreateWarmEnginePool);
+  SET_PROC(WarmEnginePoolTake, FlutterEngineWarmEnginePoolTake);
+  SET_PROC(CollectWarmEnginePool, FlutterEngineCollectWarmEnginePool);
 #undef SET_PROC
 
   return kSuccess;
@@ -730,6 +730,22 @@ typedef struct {
   /// `FlutterEngineSendPlatformMessageResponse` will cause a memory leak. It is
   /// not safe to send multiple responses on a single response object.
   const FlutterPlatformMessageResponseHandle* response_handle;
+  /// Only used for messages sent to the engine via
+  /// `FlutterEngineSendPlatformMessage`, and ignored on messages received from
+  /// the engine.
+  ///
+  /// If this is null (the default), the engine copies `message` before
+  /// `FlutterEngineSendPlatformMessage` returns. If specified, the engine
+  /// instead takes ownership of the `message` buffer without copying it and
+  /// invokes this callback with `message_release_user_data` (on an internal
+  /// engine managed thread) once the buffer is no longer needed. Until then,
+  /// the buffer must remain valid. The buffer may be handed to the Dart
+  /// application directly and must therefore be writable. If
+  /// `FlutterEngineSendPlatformMessage` returns `kInvalidArguments`, ownership
+  /// of the buffer is not transferred and the callback is not invoked.
+  VoidCallback message_release_callback;
+  /// The baton passed to `message_release_callback`.
+  void* message_release_user_data;
 } FlutterPlatformMessage;
 
 typedef void (*FlutterPlatformMessageCallback)(
@@ -1173,6 +1189,14 @@ typedef enum {
   kFlutterEngineDartObjectTypeBuffer,
 } FlutterEngineDartObjectType;
 
+/// An opaque handle to a pool of buffers created with
+/// `FlutterEngineCreateDartBufferPool`.
+typedef struct _FlutterEngineDartBufferPool* FlutterEngineDartBufferPool;
+
+/// An opaque handle to a pool of engines created with
+/// `FlutterEngineCreateWarmEnginePool`.
+typedef struct _FlutterEngineWarmEnginePool* FlutterEngineWarmEnginePool;
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterEngineDartBuffer).
   size_t struct_size;
@@ -1208,6 +1232,20 @@ typedef struct {
   uint8_t* buffer;
   /// The size of the buffer.
   size_t buffer_size;
+  /// This is an optional field.
+  ///
+  /// When specified, `buffer` must have been acquired from this pool with
+  /// `FlutterEngineDartBufferPoolAcquire` and `buffer_size` must not exceed
+  /// the pool's buffer size. The buffer is made available to Dart without a
+  /// copy, and is returned to the pool for reuse once no isolate references
+  /// it. The `buffer_collect_callback` and `user_data` fields are ignored.
+  ///
+  /// @attention      As with `buffer_collect_callback`, the buffer is only
+  ///                 taken over by the engine when the
+  ///                 `FlutterEnginePostDartObject` method returns kSuccess.
+  ///                 Otherwise, the embedder must post it again or return it
+  ///                 to the pool with `FlutterEngineDartBufferPoolRelease`.
+  FlutterEngineDartBufferPool pool;
 } FlutterEngineDartBuffer;
 
 /// This struct specifies the native representation of a Dart object that can be
@@ -1257,6 +1295,10 @@ typedef enum {
 typedef void (*FlutterNativeThreadCallback)(FlutterNativeThreadType type,
                                             void* user_data);
 
+/// An opaque handle to a ring buffer created with
+/// `FlutterEngineCreateRingBuffer`.
+typedef struct _FlutterEngineRingBuffer* FlutterEngineRingBuffer;
+
 /// AOT data source type.
 typedef enum {
   kFlutterEngineAOTDataSourceTypeElfPath
@@ -2080,6 +2122,172 @@ FlutterEngineResult FlutterEnginePostDartObject(
     FlutterEngineDartPort port,
     const FlutterEngineDartObject* object);
 
+//------------------------------------------------------------------------------
+/// @brief      Posts a batch of Dart objects to the specified send port as a
+///             single message. The isolate with the receive port for the send
+///             port receives a `List` of the objects, in order. This wakes
+///             the receiving isolate once for the whole batch, rather than
+///             once per object as separate calls to
+///             `FlutterEnginePostDartObject` would.
+///
+///             The same threading and ownership rules as those of
+///             `FlutterEnginePostDartObject` apply. In particular, buffers
+///             in the batch are only taken over by the engine if the call
+///             returns kSuccess.
+///
+/// @param[in]  engine         A running engine instance.
+/// @param[in]  port           The send port to send the objects to.
+/// @param[in]  objects        The objects to send.
+/// @param[in]  objects_count  The number of objects in `objects`.
+///
+/// @return     If the batch was posted to the send port.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEnginePostDartObjects(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineDartPort port,
+    const FlutterEngineDartObject* objects,
+    size_t objects_count);
+
+//------------------------------------------------------------------------------
+/// @brief      Creates a pool of buffers that can be filled by the embedder
+///             and posted to Dart as `Uint8List`s without a copy. Instead of
+///             being freed once Dart no longer references them, posted
+///             buffers go back to the pool to be acquired again, so that
+///             streams of large buffers such as video frames don't allocate
+///             memory for each one. Only a few idle buffers are kept; any
+///             more are freed when they are returned.
+///
+/// @param[in]  engine       A running engine instance.
+/// @param[in]  buffer_size  The size in bytes of each buffer in the pool.
+/// @param[out] pool_out     The pool.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineCreateDartBufferPool(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    size_t buffer_size,
+    FlutterEngineDartBufferPool* pool_out);
+
+//------------------------------------------------------------------------------
+/// @brief      Acquires a buffer from the pool, reusing one that Dart is done
+///             with if there is one. This may be called on any thread. The
+///             buffer must then be posted in a `FlutterEngineDartBuffer`
+///             that specifies the pool, or handed back with
+///             `FlutterEngineDartBufferPoolRelease`.
+///
+/// @param[in]  pool        The pool to acquire a buffer from.
+/// @param[out] buffer_out  The buffer, which is the size the pool was created
+///                         with.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineDartBufferPoolAcquire(
+    FlutterEngineDartBufferPool pool,
+    uint8_t** buffer_out);
+
+//------------------------------------------------------------------------------
+/// @brief      Returns a buffer that was acquired from the pool but will not
+///             be posted. Fails if the buffer was not acquired from this
+///             pool, or has already been returned.
+///
+/// @param[in]  pool    The pool the buffer was acquired from.
+/// @param[in]  buffer  The buffer.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineDartBufferPoolRelease(
+    FlutterEngineDartBufferPool pool,
+    uint8_t* buffer);
+
+//------------------------------------------------------------------------------
+/// @brief      Collects the pool. Buffers that are still referenced by Dart
+///             remain valid, and are freed rather than recycled once Dart is
+///             done with them. Buffers that were acquired but neither posted
+///             nor released are freed. The handle must not be used after this
+///             call.
+///
+/// @param[in]  pool  The pool to collect.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineCollectDartBufferPool(
+    FlutterEngineDartBufferPool pool);
+
+//------------------------------------------------------------------------------
+/// @brief      Creates a pool of engines spawned from a running engine ahead
+///             of time, so that a new view can be given an engine whose root
+///             isolate is already running instead of waiting for one to be
+///             launched. The spawned engines share the VM and isolate group
+///             of `engine`, as well as its threads, compositor and platform
+///             callbacks. Each engine is given its own renderer when it is
+///             taken from the pool. The pool is refilled in the background as
+///             engines are taken from it.
+///
+///             The pool must only be used on the platform thread, and must be
+///             collected before `engine` is shut down. Once `engine` is shut
+///             down, the pool no longer spawns engines.
+///
+/// @param[in]  engine      A running engine instance.
+/// @param[in]  capacity    The number of engines to keep ready.
+/// @param[in]  entrypoint  The entrypoint of the project the spawned engines
+///                         run, or NULL to run `main`.
+/// @param[out] pool_out    The pool.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineCreateWarmEnginePool(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    size_t capacity,
+    const char* entrypoint,
+    FlutterEngineWarmEnginePool* pool_out);
+
+//------------------------------------------------------------------------------
+/// @brief      Takes the engine that has been ready the longest from the pool,
+///             or spawns one right away if the pool is empty, and gives it a
+///             surface that renders through `config`. The surface is created
+///             before this call returns, so the engine's first frame is
+///             scheduled right away. The engine must be shut down with
+///             `FlutterEngineShutdown` before the engine it was spawned from.
+///
+///             The renderer must be of the same type as the one of the engine
+///             the pool spawns from. Images are uploaded through the resource
+///             context of that engine, so an OpenGL renderer's contexts must
+///             share resources with it.
+///
+/// @param[in]  pool        The pool to take an engine from.
+/// @param[in]  config      The renderer the engine draws its frames and
+///                         external textures with.
+/// @param[in]  user_data   The user data passed to the callbacks of `config`.
+/// @param[out] engine_out  The running engine.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineWarmEnginePoolTake(
+    FlutterEngineWarmEnginePool pool,
+    const FlutterRendererConfig* config,
+    void* user_data,
+    FLUTTER_API_SYMBOL(FlutterEngine) * engine_out);
+
+//------------------------------------------------------------------------------
+/// @brief      Collects the pool and shuts down the engines in it. Engines
+///             already taken from the pool are not affected. The handle must
+///             not be used after this call.
+///
+/// @param[in]  pool  The pool to collect.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineCollectWarmEnginePool(
+    FlutterEngineWarmEnginePool pool);
+
 //------------------------------------------------------------------------------
 /// @brief      Posts a low memory notification to a running engine instance.
 ///             The engine will do its best to release non-critical resources in
@@ -2157,6 +2365,153 @@ FlutterEngineResult FlutterEngineNotifyDisplayUpdate(
     const FlutterEngineDisplay* displays,
     size_t display_count);
 
+//------------------------------------------------------------------------------
+/// @brief      Routes platform messages sent by the framework on the given
+///             channel to a callback invoked on a background thread instead of
+///             to the `platform_message_callback` specified in the project
+///             arguments. The callback is invoked on the engine managed
+///             worker threads (kFlutterNativeThreadTypeWorker), one message at
+///             a time and in the order the messages were sent, so that handlers
+///             which do expensive work (decoding large payloads, file or
+///             database access) don't stall the platform thread.
+///
+///             As with the `platform_message_callback`, the embedder must
+///             respond to each message exactly once using
+///             `FlutterEngineSendPlatformMessageResponse`. It may do so from
+///             any thread, including from within the callback.
+///
+///             Replacing the callback keeps the messages on the channel in
+///             order: messages already queued for the previous callback are
+///             delivered to it first. Messages that have not been delivered
+///             when the engine is shut down are dropped.
+///
+/// @attention  The worker threads are shared by all running engine instances
+///             and are also used for image decoding and shader compilation.
+///             The callback must not block waiting on the platform thread.
+///             Shutting down the engine waits for callbacks that are running
+///             to return.
+///
+/// @param[in]  engine     A running engine instance.
+/// @param[in]  channel    The channel whose messages are to be routed. The
+///                        string is copied.
+/// @param[in]  callback   The callback invoked with each message. If this is
+///                        NULL, messages on the channel are once again
+///                        delivered to the `platform_message_callback`.
+/// @param[in]  user_data  A baton passed by the engine to the callback. This
+///                        baton is not interpreted by the engine in any way.
+/// @param[in]  release_user_data  If not NULL, called with the `user_data`
+///                        once the engine will no longer invoke the
+///                        callback, which is after the callback has been
+///                        replaced and its queued messages delivered, or
+///                        when the engine is shut down. May be called on any
+///                        thread.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSetPlatformMessageBackgroundCallback(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* channel,
+    FlutterPlatformMessageCallback callback,
+    void* user_data,
+    VoidCallback release_user_data);
+
+//------------------------------------------------------------------------------
+/// @brief      Enables or disables batching of the platform messages sent to
+///             the framework on the given channel. When enabled, messages
+///             sent with `FlutterEngineSendPlatformMessage` that don't expect
+///             a response are held back and delivered to the framework
+///             together at the start of the next frame or once the window has
+///             elapsed, whichever comes first. This amortizes the overhead of
+///             dispatching each message for high frequency channels such as
+///             sensor streams. Messages that expect a response are never held
+///             back; they are delivered right after any pending batch.
+///
+/// @param[in]  engine        A running engine instance.
+/// @param[in]  channel       The channel on which to batch messages. The
+///                           string is copied.
+/// @param[in]  window_nanos  The maximum time in nanoseconds a message may be
+///                           held back. Zero disables batching and delivers
+///                           the pending messages.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSetPlatformMessageBatchWindow(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* channel,
+    uint64_t window_nanos);
+
+//------------------------------------------------------------------------------
+/// @brief      Creates a single-producer, single-consumer ring buffer through
+///             which the embedder can stream bytes into Dart code. Dart code
+///             opens the buffer by passing the identifier returned here to
+///             `RingBufferReader.open` in `dart:ui`, and reads the bytes in
+///             place rather than receiving a copy of each write.
+///
+///             Writes made while the reader is busy are coalesced into a
+///             single wakeup of the reader's isolate, so unlike platform
+///             messages, the cost of delivering data does not grow with the
+///             number of writes and no work is done on the platform thread.
+///
+///             The buffer belongs to this engine. Only the isolates of this
+///             engine can open it, and only this engine can collect it.
+///
+/// @param[in]  engine          A running engine instance.
+/// @param[in]  capacity        The minimum size of the buffer in bytes, at
+///                             most 1 GiB. It is rounded up to a power of two.
+/// @param[out] ring_buffer_out The handle to write to with
+///                             `FlutterEngineRingBufferWrite`.
+/// @param[out] identifier_out  The identifier Dart code opens the buffer by.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineCreateRingBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    size_t capacity,
+    FlutterEngineRingBuffer* ring_buffer_out,
+    int64_t* identifier_out);
+
+//------------------------------------------------------------------------------
+/// @brief      Appends bytes to a ring buffer, waking its reader if required.
+///             This may be called on any thread, but only on one thread at a
+///             time for a given buffer.
+///
+/// @param[in]  ring_buffer  The ring buffer to write to.
+/// @param[in]  data         The bytes to write.
+/// @param[in]  size         The number of bytes to write.
+/// @param[out] written_out  The number of bytes written. This is less than
+///                          `size` if the reader has not yet consumed enough
+///                          of the buffer to make room for all of them.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineRingBufferWrite(
+    FlutterEngineRingBuffer ring_buffer,
+    const uint8_t* data,
+    size_t size,
+    size_t* written_out);
+
+//------------------------------------------------------------------------------
+/// @brief      Unregisters a ring buffer. Readers that have it open see no
+///             further data, and the memory backing it is released once they
+///             have been garbage collected. The handle must not be used after
+///             this call.
+///
+/// @param[in]  engine       The running engine instance the ring buffer was
+///                          created with. The call fails, and the handle
+///                          stays valid, if it is any other engine.
+/// @param[in]  ring_buffer  The ring buffer to collect.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineCollectRingBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineRingBuffer ring_buffer);
+
 #endif  // !FLUTTER_ENGINE_NO_PROTOTYPES
 
 // Typedefs for the function pointers in FlutterEngineProcTable.
@@ -2262,6 +2617,35 @@ typedef FlutterEngineResult (*FlutterEnginePostDartObjectFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     FlutterEngineDartPort port,
     const FlutterEngineDartObject* object);
+typedef FlutterEngineResult (*FlutterEnginePostDartObjectsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineDartPort port,
+    const FlutterEngineDartObject* objects,
+    size_t objects_count);
+typedef FlutterEngineResult (*FlutterEngineCreateDartBufferPoolFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    size_t buffer_size,
+    FlutterEngineDartBufferPool* pool_out);
+typedef FlutterEngineResult (*FlutterEngineDartBufferPoolAcquireFnPtr)(
+    FlutterEngineDartBufferPool pool,
+    uint8_t** buffer_out);
+typedef FlutterEngineResult (*FlutterEngineDartBufferPoolReleaseFnPtr)(
+    FlutterEngineDartBufferPool pool,
+    uint8_t* buffer);
+typedef FlutterEngineResult (*FlutterEngineCollectDartBufferPoolFnPtr)(
+    FlutterEngineDartBufferPool pool);
+typedef FlutterEngineResult (*FlutterEngineCreateWarmEnginePoolFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    size_t capacity,
+    const char* entrypoint,
+    FlutterEngineWarmEnginePool* pool_out);
+typedef FlutterEngineResult (*FlutterEngineWarmEnginePoolTakeFnPtr)(
+    FlutterEngineWarmEnginePool pool,
+    const FlutterRendererConfig* config,
+    void* user_data,
+    FLUTTER_API_SYMBOL(FlutterEngine) * engine_out);
+typedef FlutterEngineResult (*FlutterEngineCollectWarmEnginePoolFnPtr)(
+    FlutterEngineWarmEnginePool pool);
 typedef FlutterEngineResult (*FlutterEngineNotifyLowMemoryWarningFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine);
 typedef FlutterEngineResult (*FlutterEnginePostCallbackOnAllNativeThreadsFnPtr)(
@@ -2273,6 +2657,30 @@ typedef FlutterEngineResult (*FlutterEngineNotifyDisplayUpdateFnPtr)(
     FlutterEngineDisplaysUpdateType update_type,
     const FlutterEngineDisplay* displays,
     size_t display_count);
+typedef FlutterEngineResult (
+    *FlutterEngineSetPlatformMessageBackgroundCallbackFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* channel,
+    FlutterPlatformMessageCallback callback,
+    void* user_data,
+    VoidCallback release_user_data);
+typedef FlutterEngineResult (*FlutterEngineSetPlatformMessageBatchWindowFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* channel,
+    uint64_t window_nanos);
+typedef FlutterEngineResult (*FlutterEngineCreateRingBufferFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    size_t capacity,
+    FlutterEngineRingBuffer* ring_buffer_out,
+    int64_t* identifier_out);
+typedef FlutterEngineResult (*FlutterEngineRingBufferWriteFnPtr)(
+    FlutterEngineRingBuffer ring_buffer,
+    const uint8_t* data,
+    size_t size,
+    size_t* written_out);
+typedef FlutterEngineResult (*FlutterEngineCollectRingBufferFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineRingBuffer ring_buffer);
 
 /// Function-pointer-based versions of the APIs above.
 typedef struct {
@@ -2317,6 +2725,20 @@ typedef struct {
   FlutterEnginePostCallbackOnAllNativeThreadsFnPtr
       PostCallbackOnAllNativeThreads;
   FlutterEngineNotifyDisplayUpdateFnPtr NotifyDisplayUpdate;
+  FlutterEngineSetPlatformMessageBackgroundCallbackFnPtr
+      SetPlatformMessageBackgroundCallback;
+  FlutterEngineSetPlatformMessageBatchWindowFnPtr SetPlatformMessageBatchWindow;
+  FlutterEngineCreateRingBufferFnPtr CreateRingBuffer;
+  FlutterEngineRingBufferWriteFnPtr RingBufferWrite;
+  FlutterEngineCollectRingBufferFnPtr CollectRingBuffer;
+  FlutterEnginePostDartObjectsFnPtr PostDartObjects;
+  FlutterEngineCreateDartBufferPoolFnPtr CreateDartBufferPool;
+  FlutterEngineDartBufferPoolAcquireFnPtr DartBufferPoolAcquire;
+  FlutterEngineDartBufferPoolReleaseFnPtr DartBufferPoolRelease;
+  FlutterEngineCollectDartBufferPoolFnPtr CollectDartBufferPool;
+  FlutterEngineCreateWarmEnginePoolFnPtr CreateWarmEnginePool;
+  FlutterEngineWarmEnginePoolTakeFnPtr WarmEnginePoolTake;
+  FlutterEngineCollectWarmEnginePoolFnPtr CollectWarmEnginePool;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
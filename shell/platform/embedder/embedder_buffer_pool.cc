@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_buffer_pool.h"
+
+namespace flutter {
+
+EmbedderBufferPool::EmbedderBufferPool(size_t buffer_size,
+                                       size_t max_idle_buffers)
+    : buffer_size_(buffer_size), max_idle_buffers_(max_idle_buffers) {}
+
+EmbedderBufferPool::~EmbedderBufferPool() {
+  for (const uint8_t* buffer : outstanding_buffers_) {
+    delete[] buffer;
+  }
+}
+
+uint8_t* EmbedderBufferPool::Acquire() {
+  std::scoped_lock lock(mutex_);
+  uint8_t* buffer = nullptr;
+  if (idle_buffers_.empty()) {
+    buffer = new uint8_t[buffer_size_];
+  } else {
+    buffer = idle_buffers_.back().release();
+    idle_buffers_.pop_back();
+  }
+  outstanding_buffers_.insert(buffer);
+  return buffer;
+}
+
+bool EmbedderBufferPool::Recycle(uint8_t* buffer) {
+  std::unique_ptr<uint8_t[]> released;
+  {
+    std::scoped_lock lock(mutex_);
+    if (outstanding_buffers_.erase(buffer) == 0) {
+      return false;
+    }
+    released.reset(buffer);
+    if (idle_buffers_.size() < max_idle_buffers_) {
+      idle_buffers_.push_back(std::move(released));
+    }
+  }
+  // A buffer the pool has no room to keep is freed here, outside the lock.
+  return true;
+}
+
+bool EmbedderBufferPool::IsOutstanding(const uint8_t* buffer) const {
+  std::scoped_lock lock(mutex_);
+  return outstanding_buffers_.count(buffer) > 0;
+}
+
+size_t EmbedderBufferPool::GetOutstandingBufferCount() const {
+  std::scoped_lock lock(mutex_);
+  return outstanding_buffers_.size();
+}
+
+size_t EmbedderBufferPool::GetIdleBufferCount() const {
+  std::scoped_lock lock(mutex_);
+  return idle_buffers_.size();
+}
+
+}  // namespace flutter
@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_BUFFER_POOL_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_BUFFER_POOL_H_
+
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A pool of equally sized buffers that the embedder fills and
+///             posts to Dart as external typed data. When Dart no longer
+///             references a posted buffer, it is returned to the pool to be
+///             handed out again instead of being freed, so that producers of
+///             a steady stream of large buffers, such as video frames, don't
+///             allocate for each one.
+///
+///             At most |max_idle_buffers| buffers are kept for reuse. Buffers
+///             returned beyond that, such as after a burst, are freed.
+///
+///             Posted buffers hold a reference to the pool, so the pool's
+///             memory stays valid for as long as Dart can reach it.
+///
+class EmbedderBufferPool {
+ public:
+  static constexpr size_t kDefaultMaxIdleBuffers = 4;
+
+  explicit EmbedderBufferPool(size_t buffer_size,
+                              size_t max_idle_buffers = kDefaultMaxIdleBuffers);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Frees all buffers, including any that were handed out and
+  ///             never returned.
+  ///
+  ~EmbedderBufferPool();
+
+  size_t GetBufferSize() const { return buffer_size_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Hands out an idle buffer, allocating one if there are none.
+  ///
+  uint8_t* Acquire();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a buffer previously handed out by |Acquire| to the
+  ///             pool.
+  ///
+  /// @return     False, leaving |buffer| alone, if it is not a buffer the
+  ///             pool has handed out and not yet had returned.
+  ///
+  bool Recycle(uint8_t* buffer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether |buffer| was handed out by |Acquire| and has not been
+  ///             returned to the pool.
+  ///
+  bool IsOutstanding(const uint8_t* buffer) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of buffers allocated by the pool that have not
+  ///             been returned to it.
+  ///
+  size_t GetOutstandingBufferCount() const;
+
+  size_t GetIdleBufferCount() const;
+
+ private:
+  const size_t buffer_size_;
+  const size_t max_idle_buffers_;
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<uint8_t[]>> idle_buffers_;
+  std::unordered_set<const uint8_t*> outstanding_buffers_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderBufferPool);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_BUFFER_POOL_H_
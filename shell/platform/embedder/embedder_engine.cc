@@ -27,6 +27,7 @@ EmbedderEngine::EmbedderEngine(
     flutter::Settings settings,
     RunConfiguration run_configuration,
     Shell::CreateCallback<PlatformView> on_create_platform_view,
+    Shell::CreateCallback<PlatformView> on_create_spawned_platform_view,
     Shell::CreateCallback<Rasterizer> on_create_rasterizer,
     std::unique_ptr<EmbedderExternalTextureResolver> external_texture_resolver)
     : thread_host_(std::move(thread_host)),
@@ -35,6 +36,21 @@ EmbedderEngine::EmbedderEngine(
       shell_args_(std::make_unique<ShellArgs>(std::move(settings),
                                               on_create_platform_view,
                                               on_create_rasterizer)),
+      on_create_spawned_platform_view_(
+          std::move(on_create_spawned_platform_view)),
+      on_create_rasterizer_(on_create_rasterizer),
+      external_texture_resolver_(std::move(external_texture_resolver)) {}
+
+EmbedderEngine::EmbedderEngine(
+    std::shared_ptr<EmbedderThreadHost> thread_host,
+    TaskRunners task_runners,
+    std::unique_ptr<EmbedderExternalTextureResolver> external_texture_resolver,
+    std::unique_ptr<Shell> shell)
+    : thread_host_(std::move(thread_host)),
+      task_runners_(std::move(task_runners)),
+      // The shell is already running.
+      run_configuration_(nullptr),
+      shell_(std::move(shell)),
       external_texture_resolver_(std::move(external_texture_resolver)) {}
 
 EmbedderEngine::~EmbedderEngine() = default;
@@ -294,4 +310,35 @@ Shell& EmbedderEngine::GetShell() {
   return *shell_.get();
 }
 
+std::unique_ptr<WarmShellPool> EmbedderEngine::CreateWarmShellPool(
+    size_t capacity,
+    std::string entrypoint) {
+  if (!IsValid()) {
+    return nullptr;
+  }
+  auto on_create_configuration = [settings = shell_->GetSettings(),
+                                  entrypoint = std::move(entrypoint)]() {
+    auto configuration = RunConfiguration::InferFromSettings(settings);
+    if (!entrypoint.empty()) {
+      configuration.SetEntrypoint(entrypoint);
+    }
+    return configuration;
+  };
+  return std::make_unique<WarmShellPool>(
+      *shell_, capacity, std::move(on_create_configuration),
+      on_create_spawned_platform_view_, on_create_rasterizer_);
+}
+
+EmbedderEngine::SpawnedEngineFactory EmbedderEngine::GetSpawnedEngineFactory()
+    const {
+  return [thread_host = thread_host_, task_runners = task_runners_](
+             std::unique_ptr<Shell> shell,
+             std::unique_ptr<EmbedderExternalTextureResolver>
+                 external_texture_resolver) {
+    return std::make_unique<EmbedderEngine>(
+        thread_host, task_runners, std::move(external_texture_resolver),
+        std::move(shell));
+  };
+}
+
 }  // namespace flutter
@@ -5,12 +5,14 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_ENGINE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_ENGINE_H_
 
+#include <functional>
 #include <memory>
 #include <unordered_map>
 
 #include "flutter/fml/macros.h"
 #include "flutter/shell/common/shell.h"
 #include "flutter/shell/common/thread_host.h"
+#include "flutter/shell/common/warm_shell_pool.h"
 #include "flutter/shell/platform/embedder/embedder.h"
 #include "flutter/shell/platform/embedder/embedder_external_texture_resolver.h"
 #include "flutter/shell/platform/embedder/embedder_thread_host.h"
@@ -27,12 +29,33 @@ class EmbedderEngine {
                  Settings settings,
                  RunConfiguration run_configuration,
                  Shell::CreateCallback<PlatformView> on_create_platform_view,
+                 Shell::CreateCallback<PlatformView>
+                     on_create_spawned_platform_view,
                  Shell::CreateCallback<Rasterizer> on_create_rasterizer,
                  std::unique_ptr<EmbedderExternalTextureResolver>
                      external_texture_resolver);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Wraps a running |shell| spawned from the shell of another
+  ///             engine, sharing that engine's threads.
+  ///
+  EmbedderEngine(std::shared_ptr<EmbedderThreadHost> thread_host,
+                 TaskRunners task_runners,
+                 std::unique_ptr<EmbedderExternalTextureResolver>
+                     external_texture_resolver,
+                 std::unique_ptr<Shell> shell);
+
   ~EmbedderEngine();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Wraps a shell taken from a pool created by
+  ///             |CreateWarmShellPool| in an engine. It may outlive this
+  ///             engine.
+  ///
+  using SpawnedEngineFactory = std::function<std::unique_ptr<EmbedderEngine>(
+      std::unique_ptr<Shell>,
+      std::unique_ptr<EmbedderExternalTextureResolver>)>;
+
   bool LaunchShell();
 
   bool CollectShell();
@@ -99,11 +122,27 @@ class EmbedderEngine {
 
   Shell& GetShell();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a pool of up to |capacity| shells spawned from this
+  ///             engine's running shell, which run |entrypoint| of the same
+  ///             project. Their platform views have no surface until the
+  ///             shell is taken from the pool and given a renderer. Must be
+  ///             called on the platform task runner.
+  ///
+  std::unique_ptr<WarmShellPool> CreateWarmShellPool(size_t capacity,
+                                                     std::string entrypoint);
+
+  SpawnedEngineFactory GetSpawnedEngineFactory() const;
+
  private:
-  const std::unique_ptr<EmbedderThreadHost> thread_host_;
+  const std::shared_ptr<EmbedderThreadHost> thread_host_;
   TaskRunners task_runners_;
   RunConfiguration run_configuration_;
   std::unique_ptr<ShellArgs> shell_args_;
+  // Kept after the shell is launched, to spawn warm shells with. Their
+  // platform views have no surface until they are taken from the pool.
+  Shell::CreateCallback<PlatformView> on_create_spawned_platform_view_;
+  Shell::CreateCallback<Rasterizer> on_create_rasterizer_;
   std::unique_ptr<Shell> shell_;
   std::unique_ptr<EmbedderExternalTextureResolver> external_texture_resolver_;
 
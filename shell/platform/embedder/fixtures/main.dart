@@ -257,6 +257,86 @@ void platform_messages_no_response() {
   signalNativeTest();
 }
 
+@pragma('vm:entry-point')
+void platform_messages_background_channel() {
+  PlatformDispatcher.instance.onPlatformMessage = (String name, ByteData? data, PlatformMessageResponseCallback? callback) {
+    // Forward the message to the channel serviced off the platform thread and
+    // report each response back to the test.
+    for (int i = 0; i < 3; i++) {
+      final Uint8List message = Uint8List.fromList(<int>[i]);
+      PlatformDispatcher.instance.sendPlatformMessage('background_channel', message.buffer.asByteData(), (ByteData? reply) {
+        signalNativeMessage(reply!.getUint8(0).toString());
+      });
+    }
+    callback!(data);
+  };
+  signalNativeTest();
+}
+
+@pragma('vm:entry-point')
+void platform_messages_batched() {
+  // Messages delivered in a single batch all arrive before the microtask queue
+  // is drained.
+  final List<String> received = <String>[];
+  PlatformDispatcher.instance.onPlatformMessage = (String name, ByteData? data, PlatformMessageResponseCallback? callback) {
+    if (received.isEmpty) {
+      scheduleMicrotask(() {
+        signalNativeMessage(received.join(','));
+        received.clear();
+      });
+    }
+    received.add(utf8.decode(data!.buffer.asUint8List(data.offsetInBytes, data.lengthInBytes)));
+    callback!(null);
+  };
+  signalNativeTest();
+}
+
+@pragma('vm:entry-point')
+void ring_buffer_can_be_read() {
+  // The embedder sends the identifier of the ring buffer, then streams bytes
+  // counting up from zero through it.
+  const int expectedLength = 4096;
+  final RawReceivePort port = RawReceivePort();
+  port.handler = (dynamic identifier) {
+    port.close();
+    final List<int> received = <int>[];
+    RingBufferReader.open(identifier as int, (RingBufferReader reader) {
+      reader.read((Uint8List data) => received.addAll(data));
+      if (received.length < expectedLength) {
+        return;
+      }
+      reader.close();
+      for (int i = 0; i < received.length; i++) {
+        if (received[i] != i % 256) {
+          signalNativeMessage('mismatch at $i');
+          return;
+        }
+      }
+      signalNativeMessage('received ${received.length}');
+    });
+  };
+  signalNativeCount(port.sendPort.nativePort);
+}
+
+@pragma('vm:entry-point')
+void platform_channel_benchmarks() {
+  PlatformDispatcher.instance.onPlatformMessage = (String name, ByteData? data, PlatformMessageResponseCallback? callback) {
+    if (name.startsWith('benchmark/sink')) {
+      callback!(null);
+    } else if (name == 'benchmark/request') {
+      // The request holds the size of the message to send to the embedder,
+      // and is answered once the embedder has responded to that message.
+      final int size = data!.getUint64(0, Endian.little);
+      PlatformDispatcher.instance.sendPlatformMessage('benchmark/source', ByteData(size), (ByteData? reply) {
+        callback!(null);
+      });
+    } else {
+      callback!(data);
+    }
+  };
+  signalNativeTest();
+}
+
 @pragma('vm:entry-point')
 void null_platform_messages() {
   PlatformDispatcher.instance.onPlatformMessage =
@@ -9,48 +9,24 @@ namespace flutter {
 PlatformViewEmbedder::PlatformViewEmbedder(
     PlatformView::Delegate& delegate,
     flutter::TaskRunners task_runners,
-    EmbedderSurfaceSoftware::SoftwareDispatchTable software_dispatch_table,
+    const EmbedderSurfaceFactory& surface_factory,
     PlatformDispatchTable platform_dispatch_table,
     std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
     : PlatformView(delegate, std::move(task_runners)),
       external_view_embedder_(external_view_embedder),
-      embedder_surface_(
-          std::make_unique<EmbedderSurfaceSoftware>(software_dispatch_table,
-                                                    external_view_embedder_)),
+      embedder_surface_(surface_factory
+                            ? surface_factory(external_view_embedder_)
+                            : nullptr),
       platform_dispatch_table_(platform_dispatch_table) {}
 
-#ifdef SHELL_ENABLE_GL
-PlatformViewEmbedder::PlatformViewEmbedder(
-    PlatformView::Delegate& delegate,
-    flutter::TaskRunners task_runners,
-    EmbedderSurfaceGL::GLDispatchTable gl_dispatch_table,
-    bool fbo_reset_after_present,
-    PlatformDispatchTable platform_dispatch_table,
-    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
-    : PlatformView(delegate, std::move(task_runners)),
-      external_view_embedder_(external_view_embedder),
-      embedder_surface_(
-          std::make_unique<EmbedderSurfaceGL>(gl_dispatch_table,
-                                              fbo_reset_after_present,
-                                              external_view_embedder_)),
-      platform_dispatch_table_(platform_dispatch_table) {}
-#endif
-
-#ifdef SHELL_ENABLE_METAL
-PlatformViewEmbedder::PlatformViewEmbedder(
-    PlatformView::Delegate& delegate,
-    flutter::TaskRunners task_runners,
-    std::unique_ptr<EmbedderSurfaceMetal> embedder_surface,
-    PlatformDispatchTable platform_dispatch_table,
-    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
-    : PlatformView(delegate, std::move(task_runners)),
-      external_view_embedder_(external_view_embedder),
-      embedder_surface_(std::move(embedder_surface)),
-      platform_dispatch_table_(platform_dispatch_table) {}
-#endif
-
 PlatformViewEmbedder::~PlatformViewEmbedder() = default;
 
+void PlatformViewEmbedder::SetEmbedderSurface(
+    const EmbedderSurfaceFactory& surface_factory) {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  embedder_surface_ = surface_factory(external_view_embedder_);
+}
+
 void PlatformViewEmbedder::UpdateSemantics(
     flutter::SemanticsNodeUpdates update,
     flutter::CustomAccessibilityActionUpdates actions) {
@@ -99,7 +75,8 @@ PlatformViewEmbedder::CreateExternalViewEmbedder() {
 // |PlatformView|
 sk_sp<GrDirectContext> PlatformViewEmbedder::CreateResourceContext() const {
   if (embedder_surface_ == nullptr) {
-    FML_LOG(ERROR) << "Embedder surface was null.";
+    // Spawned engines whose surface is set later share the resource context
+    // of the engine they were spawned from.
     return nullptr;
   }
   return embedder_surface_->CreateResourceContext();
@@ -48,37 +48,36 @@ class PlatformViewEmbedder final : public PlatformView {
         compute_platform_resolved_locale_callback;
   };
 
-  // Create a platform view that sets up a software rasterizer.
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the surface a platform view renders to, for the
+  ///             external view embedder of that platform view.
+  ///
+  using EmbedderSurfaceFactory =
+      std::function<std::unique_ptr<EmbedderSurface>(
+          std::shared_ptr<EmbedderExternalViewEmbedder>)>;
+
+  // Creates a platform view that renders to the surface made by
+  // |surface_factory|. If it is null, the surface must be set with
+  // |SetEmbedderSurface| before the platform view is notified that it was
+  // created.
   PlatformViewEmbedder(
       PlatformView::Delegate& delegate,
       flutter::TaskRunners task_runners,
-      EmbedderSurfaceSoftware::SoftwareDispatchTable software_dispatch_table,
+      const EmbedderSurfaceFactory& surface_factory,
       PlatformDispatchTable platform_dispatch_table,
       std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
 
-#ifdef SHELL_ENABLE_GL
-  // Creates a platform view that sets up an OpenGL rasterizer.
-  PlatformViewEmbedder(
-      PlatformView::Delegate& delegate,
-      flutter::TaskRunners task_runners,
-      EmbedderSurfaceGL::GLDispatchTable gl_dispatch_table,
-      bool fbo_reset_after_present,
-      PlatformDispatchTable platform_dispatch_table,
-      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
-#endif
-
-#ifdef SHELL_ENABLE_METAL
-  // Creates a platform view that sets up an metal rasterizer.
-  PlatformViewEmbedder(
-      PlatformView::Delegate& delegate,
-      flutter::TaskRunners task_runners,
-      std::unique_ptr<EmbedderSurfaceMetal> embedder_surface,
-      PlatformDispatchTable platform_dispatch_table,
-      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
-#endif
-
   ~PlatformViewEmbedder() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Replaces the surface this platform view renders to with one
+  ///             made by |surface_factory|. Used for engines spawned ahead
+  ///             of time, which only get a renderer once they are put to
+  ///             use. Must be called on the platform task runner while the
+  ///             platform view has no rendering surface.
+  ///
+  void SetEmbedderSurface(const EmbedderSurfaceFactory& surface_factory);
+
   // |PlatformView|
   void UpdateSemantics(
       flutter::SemanticsNodeUpdates update,
@@ -0,0 +1,296 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures platform channel round trips between the embedder and Dart code
+// running the |platform_channel_benchmarks| entrypoint of the fixture. Each
+// benchmark reports the rate of messages and bytes sent along with the 50th,
+// 90th and 99th percentile round trip latencies, in microseconds.
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/closure.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+#include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/embedder/tests/embedder_config_builder.h"
+#include "flutter/shell/platform/embedder/tests/embedder_test_context_software.h"
+#include "flutter/testing/testing.h"
+#include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Dart echoes messages on this channel back as the response.
+constexpr char kEchoChannel[] = "benchmark/echo";
+// Dart responds to messages on channels starting with this prefix without a
+// payload.
+constexpr char kSinkChannelPrefix[] = "benchmark/sink";
+// Dart responds to messages on this channel once it has sent a message of the
+// requested size to the embedder and received the embedder's response.
+constexpr char kRequestChannel[] = "benchmark/request";
+
+using ResponseCallback = std::function<void(const uint8_t* data, size_t size)>;
+
+// An engine running the benchmark entrypoint. Its platform task runner is a
+// dedicated thread, so that the benchmark thread can block while messages and
+// their responses are processed.
+class ChannelBenchmarkEngine {
+ public:
+  ChannelBenchmarkEngine() : platform_thread_("platform") {
+    fml::AutoResetWaitableEvent ready;
+    context_.AddNativeCallback(
+        "SignalNativeTest",
+        CREATE_NATIVE_ENTRY(
+            [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+    // Messages from Dart arrive on the platform thread.
+    context_.SetPlatformMessageCallback(
+        [this](const FlutterPlatformMessage* message) {
+          if (message->response_handle != nullptr) {
+            FlutterEngineSendPlatformMessageResponse(
+                engine_.get(), message->response_handle, nullptr, 0);
+          }
+        });
+    RunOnPlatformThread([this]() {
+      EmbedderConfigBuilder builder(context_);
+      builder.SetSoftwareRendererConfig();
+      builder.SetDartEntrypoint("platform_channel_benchmarks");
+      engine_ = builder.LaunchEngine();
+      FML_CHECK(engine_.is_valid());
+    });
+    ready.Wait();
+  }
+
+  ~ChannelBenchmarkEngine() {
+    RunOnPlatformThread([this]() { engine_.reset(); });
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sends |message| on each of |channels| at once, and waits for
+  ///             all the responses. |on_response| is invoked with each
+  ///             response on the platform thread.
+  ///
+  void Send(const std::vector<std::string>& channels,
+            const std::vector<uint8_t>& message,
+            const ResponseCallback& on_response = nullptr) {
+    struct PendingResponse {
+      fml::CountDownLatch* latch;
+      const ResponseCallback* on_response;
+    };
+    fml::CountDownLatch latch(channels.size());
+    PendingResponse pending = {&latch, &on_response};
+    platform_thread_.GetTaskRunner()->PostTask([&]() {
+      for (const auto& channel : channels) {
+        FlutterPlatformMessageResponseHandle* response_handle = nullptr;
+        FlutterPlatformMessageCreateResponseHandle(
+            engine_.get(),
+            [](const uint8_t* data, size_t size, void* user_data) {
+              auto pending = reinterpret_cast<PendingResponse*>(user_data);
+              if (*pending->on_response) {
+                (*pending->on_response)(data, size);
+              }
+              pending->latch->CountDown();
+            },
+            &pending, &response_handle);
+        FlutterPlatformMessage platform_message = {};
+        platform_message.struct_size = sizeof(FlutterPlatformMessage);
+        platform_message.channel = channel.c_str();
+        platform_message.message = message.data();
+        platform_message.message_size = message.size();
+        platform_message.response_handle = response_handle;
+        FlutterEngineSendPlatformMessage(engine_.get(), &platform_message);
+        FlutterPlatformMessageReleaseResponseHandle(engine_.get(),
+                                                    response_handle);
+      }
+    });
+    latch.Wait();
+  }
+
+ private:
+  fml::Thread platform_thread_;
+  EmbedderTestContextSoftware context_{GetFixturesPath()};
+  UniqueEngine engine_;
+
+  void RunOnPlatformThread(const fml::closure& closure) {
+    fml::AutoResetWaitableEvent latch;
+    platform_thread_.GetTaskRunner()->PostTask([&]() {
+      closure();
+      latch.Signal();
+    });
+    latch.Wait();
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ChannelBenchmarkEngine);
+};
+
+// Times each iteration of a benchmark, and reports the rates and latency
+// percentiles once the benchmark is done.
+class RoundTripRecorder {
+ public:
+  RoundTripRecorder(benchmark::State& state,
+                    size_t messages_per_iteration,
+                    size_t bytes_per_iteration)
+      : state_(state),
+        messages_per_iteration_(messages_per_iteration),
+        bytes_per_iteration_(bytes_per_iteration) {}
+
+  ~RoundTripRecorder() {
+    state_.SetItemsProcessed(state_.iterations() * messages_per_iteration_);
+    state_.SetBytesProcessed(state_.iterations() * bytes_per_iteration_);
+    if (latencies_.empty()) {
+      return;
+    }
+    std::sort(latencies_.begin(), latencies_.end());
+    auto percentile = [this](double fraction) {
+      size_t index = static_cast<size_t>(fraction * latencies_.size());
+      return latencies_[std::min(index, latencies_.size() - 1)];
+    };
+    state_.counters["p50_us"] = percentile(0.5);
+    state_.counters["p90_us"] = percentile(0.9);
+    state_.counters["p99_us"] = percentile(0.99);
+  }
+
+  template <typename Iteration>
+  void Run(const Iteration& iteration) {
+    while (state_.KeepRunning()) {
+      const auto start = fml::TimePoint::Now();
+      iteration();
+      latencies_.push_back((fml::TimePoint::Now() - start).ToMicrosecondsF());
+    }
+  }
+
+ private:
+  benchmark::State& state_;
+  const size_t messages_per_iteration_;
+  const size_t bytes_per_iteration_;
+  std::vector<double> latencies_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RoundTripRecorder);
+};
+
+}  // namespace
+
+// Messages of the given size sent from the embedder to Dart.
+static void BM_PlatformChannelEmbedderToDart(
+    benchmark::State& state) {  // NOLINT
+  ChannelBenchmarkEngine engine;
+  const std::vector<std::string> channels = {kSinkChannelPrefix};
+  std::vector<uint8_t> message(state.range(0), 0xA5);
+  RoundTripRecorder recorder(state, 1, message.size());
+  recorder.Run([&]() { engine.Send(channels, message); });
+}
+
+// Messages of the given size sent from Dart to the embedder. Each round trip
+// is started by a small request from the embedder.
+static void BM_PlatformChannelDartToEmbedder(
+    benchmark::State& state) {  // NOLINT
+  ChannelBenchmarkEngine engine;
+  const std::vector<std::string> channels = {kRequestChannel};
+  const uint64_t size = state.range(0);
+  std::vector<uint8_t> request(sizeof(size));
+  memcpy(request.data(), &size, sizeof(size));
+  RoundTripRecorder recorder(state, 1, size);
+  recorder.Run([&]() { engine.Send(channels, request); });
+}
+
+// Maps holding a byte buffer of the given size, encoded by the embedder with
+// the standard codec, echoed by Dart, and decoded again.
+static void BM_PlatformChannelStandardCodecRoundTrip(
+    benchmark::State& state) {  // NOLINT
+  ChannelBenchmarkEngine engine;
+  const std::vector<std::string> channels = {kEchoChannel};
+  const auto& codec = StandardMessageCodec::GetInstance();
+  EncodableValue value(EncodableMap{
+      {EncodableValue("data"),
+       EncodableValue(std::vector<uint8_t>(state.range(0), 0xA5))},
+  });
+  ResponseCallback decode = [&codec](const uint8_t* data, size_t size) {
+    auto decoded = codec.DecodeMessage(data, size);
+    FML_CHECK(decoded);
+  };
+  RoundTripRecorder recorder(state, 1, state.range(0));
+  recorder.Run([&]() {
+    auto message = codec.EncodeMessage(value);
+    engine.Send(channels, *message, decode);
+  });
+}
+
+// Objects holding a string of the given length, encoded by the embedder as
+// JSON, echoed by Dart, and parsed again.
+static void BM_PlatformChannelJsonCodecRoundTrip(
+    benchmark::State& state) {  // NOLINT
+  ChannelBenchmarkEngine engine;
+  const std::vector<std::string> channels = {kEchoChannel};
+  rapidjson::Document document;
+  document.SetObject();
+  std::string text(state.range(0), 'a');
+  document.AddMember("data", rapidjson::StringRef(text.data(), text.size()),
+                     document.GetAllocator());
+  ResponseCallback decode = [](const uint8_t* data, size_t size) {
+    rapidjson::Document decoded;
+    decoded.Parse(reinterpret_cast<const char*>(data), size);
+    FML_CHECK(!decoded.HasParseError());
+  };
+  RoundTripRecorder recorder(state, 1, state.range(0));
+  recorder.Run([&]() {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    document.Accept(writer);
+    const auto* bytes = reinterpret_cast<const uint8_t*>(buffer.GetString());
+    std::vector<uint8_t> message(bytes, bytes + buffer.GetSize());
+    engine.Send(channels, message, decode);
+  });
+}
+
+// One message of the given size in flight on each of several channels at
+// once.
+static void BM_PlatformChannelConcurrentChannels(
+    benchmark::State& state) {  // NOLINT
+  ChannelBenchmarkEngine engine;
+  std::vector<std::string> channels;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    channels.push_back(std::string(kSinkChannelPrefix) + "/" +
+                       std::to_string(i));
+  }
+  std::vector<uint8_t> message(state.range(1), 0xA5);
+  RoundTripRecorder recorder(state, channels.size(),
+                             channels.size() * message.size());
+  recorder.Run([&]() { engine.Send(channels, message); });
+}
+
+BENCHMARK(BM_PlatformChannelEmbedderToDart)
+    ->RangeMultiplier(16)
+    ->Range(16, 16 << 20)
+    ->UseRealTime();
+BENCHMARK(BM_PlatformChannelDartToEmbedder)
+    ->RangeMultiplier(16)
+    ->Range(16, 16 << 20)
+    ->UseRealTime();
+BENCHMARK(BM_PlatformChannelStandardCodecRoundTrip)
+    ->RangeMultiplier(16)
+    ->Range(16, 16 << 20)
+    ->UseRealTime();
+BENCHMARK(BM_PlatformChannelJsonCodecRoundTrip)
+    ->RangeMultiplier(16)
+    ->Range(16, 16 << 20)
+    ->UseRealTime();
+BENCHMARK(BM_PlatformChannelConcurrentChannels)
+    ->RangeMultiplier(4)
+    ->Ranges({{1, 16}, {16, 64 << 10}})
+    ->UseRealTime();
+
+}  // namespace testing
+}  // namespace flutter
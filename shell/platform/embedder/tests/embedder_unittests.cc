@@ -4,7 +4,10 @@
 
 #define FML_USED_ON_EMBEDDER
 
+#include <limits>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "embedder.h"
@@ -387,6 +390,554 @@ TEST_F(EmbedderTest, PlatformMessagesCanBeSentWithoutResponseHandles) {
   message.Wait();
 }
 
+//------------------------------------------------------------------------------
+/// Tests that the engine takes ownership of a platform message buffer when a
+/// release callback is specified, and releases it once the message has been
+/// delivered.
+///
+TEST_F(EmbedderTest, PlatformMessageBuffersCanBeTransferredToTheEngine) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("platform_messages_no_response");
+
+  const std::string message_data = "Hello from a buffer owned by the engine.";
+
+  fml::AutoResetWaitableEvent ready, message, released;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+  context.AddNativeCallback(
+      "SignalNativeMessage",
+      CREATE_NATIVE_ENTRY(
+          ([&message, &message_data](Dart_NativeArguments args) {
+            auto received_message = tonic::DartConverter<std::string>::FromDart(
+                Dart_GetNativeArgument(args, 0));
+            ASSERT_EQ(received_message, message_data);
+            message.Signal();
+          })));
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+  ready.Wait();
+
+  auto buffer = new std::vector<uint8_t>(message_data.begin(),
+                                         message_data.end());
+  struct Release {
+    std::vector<uint8_t>* buffer;
+    fml::AutoResetWaitableEvent* released;
+  } release = {buffer, &released};
+
+  FlutterPlatformMessage platform_message = {};
+  platform_message.struct_size = sizeof(FlutterPlatformMessage);
+  platform_message.channel = "test_channel";
+  platform_message.message = buffer->data();
+  platform_message.message_size = buffer->size();
+  platform_message.response_handle = nullptr;  // No response needed.
+  platform_message.message_release_callback = [](void* user_data) {
+    auto release = reinterpret_cast<Release*>(user_data);
+    delete release->buffer;
+    release->released->Signal();
+  };
+  platform_message.message_release_user_data = &release;
+
+  auto result =
+      FlutterEngineSendPlatformMessage(engine.get(), &platform_message);
+  ASSERT_EQ(result, kSuccess);
+  message.Wait();
+
+  // The buffer is released either once it has been copied into the Dart heap
+  // or, for large messages, when Dart collects it. Shutting down the engine
+  // guarantees the latter.
+  engine.reset();
+  released.Wait();
+}
+
+//------------------------------------------------------------------------------
+/// Tests that platform messages on channels with a background callback are
+/// delivered in order off the platform thread and can be responded to.
+///
+TEST_F(EmbedderTest, PlatformMessagesCanBeHandledOnBackgroundThreads) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("platform_messages_background_channel");
+  builder.SetPlatformMessageCallback(
+      [](const FlutterPlatformMessage* message) {
+        ASSERT_NE(strcmp(message->channel, "background_channel"), 0);
+      });
+
+  fml::AutoResetWaitableEvent ready;
+  fml::CountDownLatch replies(3);
+  std::mutex replies_mutex;
+  std::vector<std::string> reply_order;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+  context.AddNativeCallback(
+      "SignalNativeMessage",
+      CREATE_NATIVE_ENTRY(([&](Dart_NativeArguments args) {
+        std::scoped_lock lock(replies_mutex);
+        reply_order.push_back(tonic::DartConverter<std::string>::FromDart(
+            Dart_GetNativeArgument(args, 0)));
+        replies.CountDown();
+      })));
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+  ready.Wait();
+
+  struct Handler {
+    FLUTTER_API_SYMBOL(FlutterEngine) engine;
+    std::vector<uint8_t> received;
+    fml::AutoResetWaitableEvent released;
+  } handler = {engine.get(), {}, {}};
+
+  auto result = FlutterEngineSetPlatformMessageBackgroundCallback(
+      engine.get(), "background_channel",
+      [](const FlutterPlatformMessage* message, void* user_data) {
+        auto handler = reinterpret_cast<Handler*>(user_data);
+        ASSERT_EQ(message->message_size, 1u);
+        handler->received.push_back(message->message[0]);
+        FlutterEngineSendPlatformMessageResponse(
+            handler->engine, message->response_handle, message->message,
+            message->message_size);
+      },
+      &handler,
+      [](void* user_data) {
+        reinterpret_cast<Handler*>(user_data)->released.Signal();
+      });
+  ASSERT_EQ(result, kSuccess);
+
+  FlutterPlatformMessage platform_message = {};
+  platform_message.struct_size = sizeof(FlutterPlatformMessage);
+  platform_message.channel = "test_channel";
+  platform_message.message = nullptr;
+  platform_message.message_size = 0;
+  platform_message.response_handle = nullptr;
+  result = FlutterEngineSendPlatformMessage(engine.get(), &platform_message);
+  ASSERT_EQ(result, kSuccess);
+  replies.Wait();
+
+  ASSERT_EQ(handler.received, (std::vector<uint8_t>{0, 1, 2}));
+  ASSERT_EQ(reply_order, (std::vector<std::string>{"0", "1", "2"}));
+
+  ASSERT_FALSE(handler.released.IsSignaledForTest());
+  result = FlutterEngineSetPlatformMessageBackgroundCallback(
+      engine.get(), "background_channel", nullptr, nullptr, nullptr);
+  ASSERT_EQ(result, kSuccess);
+  // All messages have been handled, so nothing else holds on to the user data.
+  handler.released.Wait();
+}
+
+//------------------------------------------------------------------------------
+/// Tests that the user data of a background callback is released by the time
+/// the engine has shut down.
+///
+TEST_F(EmbedderTest, BackgroundPlatformMessageCallbacksAreReleasedOnShutdown) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  bool released = false;
+  auto result = FlutterEngineSetPlatformMessageBackgroundCallback(
+      engine.get(), "background_channel",
+      [](const FlutterPlatformMessage* message, void* user_data) {},
+      &released,
+      [](void* user_data) { *reinterpret_cast<bool*>(user_data) = true; });
+  ASSERT_EQ(result, kSuccess);
+  ASSERT_FALSE(released);
+
+  engine.reset();
+  ASSERT_TRUE(released);
+}
+
+//------------------------------------------------------------------------------
+/// Tests that messages on a channel with batching enabled are delivered to the
+/// framework together.
+///
+TEST_F(EmbedderTest, PlatformMessagesCanBeBatched) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("platform_messages_batched");
+
+  fml::AutoResetWaitableEvent ready, message;
+  std::string received;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+  context.AddNativeCallback(
+      "SignalNativeMessage",
+      CREATE_NATIVE_ENTRY(([&](Dart_NativeArguments args) {
+        received = tonic::DartConverter<std::string>::FromDart(
+            Dart_GetNativeArgument(args, 0));
+        message.Signal();
+      })));
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+  ready.Wait();
+
+  auto result = FlutterEngineSetPlatformMessageBatchWindow(
+      engine.get(), "test_channel",
+      fml::TimeDelta::FromMilliseconds(50).ToNanoseconds());
+  ASSERT_EQ(result, kSuccess);
+
+  for (const std::string payload : {"a", "b", "c"}) {
+    FlutterPlatformMessage platform_message = {};
+    platform_message.struct_size = sizeof(FlutterPlatformMessage);
+    platform_message.channel = "test_channel";
+    platform_message.message =
+        reinterpret_cast<const uint8_t*>(payload.data());
+    platform_message.message_size = payload.size();
+    platform_message.response_handle = nullptr;
+    result = FlutterEngineSendPlatformMessage(engine.get(), &platform_message);
+    ASSERT_EQ(result, kSuccess);
+  }
+
+  message.Wait();
+  ASSERT_EQ(received, "a,b,c");
+
+  result = FlutterEngineSetPlatformMessageBatchWindow(engine.get(),
+                                                      "test_channel", 0);
+  ASSERT_EQ(result, kSuccess);
+}
+
+//------------------------------------------------------------------------------
+/// Tests that bytes written to a ring buffer reach Dart code intact, including
+/// when the writer has to wait for the reader to make room.
+///
+TEST_F(EmbedderTest, RingBuffersCanBeReadFromDart) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("ring_buffer_can_be_read");
+
+  fml::AutoResetWaitableEvent ready, message;
+  FlutterEngineDartPort port = 0;
+  std::string received;
+  context.AddNativeCallback(
+      "SignalNativeCount",
+      CREATE_NATIVE_ENTRY(([&](Dart_NativeArguments args) {
+        port = tonic::DartConverter<int64_t>::FromDart(
+            Dart_GetNativeArgument(args, 0));
+        ready.Signal();
+      })));
+  context.AddNativeCallback(
+      "SignalNativeMessage",
+      CREATE_NATIVE_ENTRY(([&](Dart_NativeArguments args) {
+        received = tonic::DartConverter<std::string>::FromDart(
+            Dart_GetNativeArgument(args, 0));
+        message.Signal();
+      })));
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+  ready.Wait();
+
+  // Much smaller than the data written, so that the buffer wraps around and
+  // fills up.
+  FlutterEngineRingBuffer ring_buffer = nullptr;
+  int64_t identifier = 0;
+  auto result = FlutterEngineCreateRingBuffer(
+      engine.get(), std::numeric_limits<size_t>::max(), &ring_buffer,
+      &identifier);
+  ASSERT_EQ(result, kInvalidArguments);
+  result = FlutterEngineCreateRingBuffer(engine.get(), 100, &ring_buffer,
+                                         &identifier);
+  ASSERT_EQ(result, kSuccess);
+  ASSERT_NE(ring_buffer, nullptr);
+
+  FlutterEngineDartObject object = {};
+  object.type = kFlutterEngineDartObjectTypeInt64;
+  object.int64_value = identifier;
+  ASSERT_EQ(FlutterEnginePostDartObject(engine.get(), port, &object),
+            kSuccess);
+
+  std::vector<uint8_t> data(4096);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = i % 256;
+  }
+  size_t offset = 0;
+  while (offset < data.size()) {
+    const size_t size = std::min<size_t>(48, data.size() - offset);
+    size_t written = 0;
+    result = FlutterEngineRingBufferWrite(ring_buffer, data.data() + offset,
+                                          size, &written);
+    ASSERT_EQ(result, kSuccess);
+    if (written == 0) {
+      std::this_thread::yield();
+    }
+    offset += written;
+  }
+
+  message.Wait();
+  ASSERT_EQ(received, "received 4096");
+
+  result = FlutterEngineCollectRingBuffer(engine.get(), ring_buffer);
+  ASSERT_EQ(result, kSuccess);
+}
+
+//------------------------------------------------------------------------------
+/// Tests that a batch of objects posted to a port arrives as a single list.
+///
+TEST_F(EmbedderTest, ObjectsCanBePostedToPortsInBatches) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("objects_can_be_posted");
+
+  FlutterEngineDartPort port = 0;
+  fml::AutoResetWaitableEvent ready, received;
+  context.AddNativeCallback(
+      "SignalNativeCount", CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+        port = tonic::DartConverter<int64_t>::FromDart(
+            Dart_GetNativeArgument(args, 0));
+        ready.Signal();
+      }));
+  context.AddNativeCallback(
+      "SendObjectToNativeCode",
+      CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+        Dart_Handle handle = Dart_GetNativeArgument(args, 0);
+        ASSERT_TRUE(Dart_IsList(handle));
+        intptr_t length = 0;
+        Dart_ListLength(handle, &length);
+        ASSERT_EQ(length, 3);
+        ASSERT_EQ(
+            tonic::DartConverter<int64_t>::FromDart(Dart_ListGetAt(handle, 0)),
+            42);
+        ASSERT_EQ(tonic::DartConverter<std::string>::FromDart(
+                      Dart_ListGetAt(handle, 1)),
+                  "Hello");
+        intptr_t buffer_length = 0;
+        Dart_ListLength(Dart_ListGetAt(handle, 2), &buffer_length);
+        ASSERT_EQ(buffer_length, 16);
+        received.Signal();
+      }));
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+  ready.Wait();
+
+  std::vector<uint8_t> message(16, 7);
+  FlutterEngineDartBuffer buffer = {};
+  buffer.struct_size = sizeof(buffer);
+  buffer.buffer = message.data();
+  buffer.buffer_size = message.size();
+
+  FlutterEngineDartObject objects[3] = {};
+  objects[0].type = kFlutterEngineDartObjectTypeInt64;
+  objects[0].int64_value = 42;
+  objects[1].type = kFlutterEngineDartObjectTypeString;
+  objects[1].string_value = "Hello";
+  objects[2].type = kFlutterEngineDartObjectTypeBuffer;
+  objects[2].buffer_value = &buffer;
+  ASSERT_EQ(FlutterEnginePostDartObjects(engine.get(), port, objects, 3),
+            kSuccess);
+  received.Wait();
+
+  // An invalid object fails the whole batch.
+  objects[1].string_value = nullptr;
+  ASSERT_EQ(FlutterEnginePostDartObjects(engine.get(), port, objects, 3),
+            kInvalidArguments);
+}
+
+// A software renderer that signals the |fml::AutoResetWaitableEvent| it is
+// given as user data for every frame it presents.
+static FlutterRendererConfig MakeSignalingSoftwareRendererConfig() {
+  FlutterRendererConfig config = {};
+  config.type = kSoftware;
+  config.software.struct_size = sizeof(FlutterSoftwareRendererConfig);
+  config.software.surface_present_callback =
+      [](void* user_data, const void* allocation, size_t row_bytes,
+         size_t height) {
+        reinterpret_cast<fml::AutoResetWaitableEvent*>(user_data)->Signal();
+        return true;
+      };
+  return config;
+}
+
+//------------------------------------------------------------------------------
+/// Tests that engines can be taken from a warm pool, even before the pool has
+/// been filled.
+///
+TEST_F(EmbedderTest, WarmEnginePoolHandsOutRunningEngines) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterEngineWarmEnginePool pool = nullptr;
+  ASSERT_EQ(FlutterEngineCreateWarmEnginePool(nullptr, 1, nullptr, &pool),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineCreateWarmEnginePool(engine.get(), 1, nullptr, &pool),
+            kSuccess);
+  ASSERT_NE(pool, nullptr);
+
+  // The pool is filled by tasks this thread has not run yet, so the engine is
+  // spawned right away.
+  FlutterRendererConfig renderer_config = MakeSignalingSoftwareRendererConfig();
+  fml::AutoResetWaitableEvent presented;
+  FLUTTER_API_SYMBOL(FlutterEngine) warm_engine = nullptr;
+  ASSERT_EQ(
+      FlutterEngineWarmEnginePoolTake(pool, nullptr, nullptr, &warm_engine),
+      kInvalidArguments);
+  ASSERT_EQ(FlutterEngineWarmEnginePoolTake(pool, &renderer_config, &presented,
+                                            &warm_engine),
+            kSuccess);
+  ASSERT_NE(warm_engine, nullptr);
+  ASSERT_EQ(FlutterEngineShutdown(warm_engine), kSuccess);
+
+  ASSERT_EQ(FlutterEngineWarmEnginePoolTake(nullptr, &renderer_config,
+                                            &presented, &warm_engine),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineCollectWarmEnginePool(pool), kSuccess);
+  engine.reset();
+}
+
+//------------------------------------------------------------------------------
+/// Tests that each engine taken from a warm pool renders through the renderer
+/// it was taken with.
+///
+TEST_F(EmbedderTest, WarmEnginePoolEnginesRenderThroughTheirOwnRenderer) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterEngineWarmEnginePool pool = nullptr;
+  ASSERT_EQ(FlutterEngineCreateWarmEnginePool(
+                engine.get(), 2, "can_render_scene_without_custom_compositor",
+                &pool),
+            kSuccess);
+
+  // Both engines are spawned right away, as the pool is filled by tasks this
+  // thread has not run yet. Each gets its own view embedder and surface.
+  FlutterRendererConfig renderer_config = MakeSignalingSoftwareRendererConfig();
+  constexpr size_t kEngineCount = 2;
+  fml::AutoResetWaitableEvent presented[kEngineCount];
+  FLUTTER_API_SYMBOL(FlutterEngine) warm_engines[kEngineCount] = {};
+  for (size_t i = 0; i < kEngineCount; i++) {
+    ASSERT_EQ(FlutterEngineWarmEnginePoolTake(pool, &renderer_config,
+                                              &presented[i], &warm_engines[i]),
+              kSuccess);
+    FlutterWindowMetricsEvent event = {};
+    event.struct_size = sizeof(event);
+    event.width = 800;
+    event.height = 600;
+    event.pixel_ratio = 1.0;
+    ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(warm_engines[i], &event),
+              kSuccess);
+  }
+
+  for (size_t i = 0; i < kEngineCount; i++) {
+    presented[i].Wait();
+    ASSERT_EQ(FlutterEngineShutdown(warm_engines[i]), kSuccess);
+  }
+
+  ASSERT_EQ(FlutterEngineCollectWarmEnginePool(pool), kSuccess);
+  engine.reset();
+}
+
+//------------------------------------------------------------------------------
+/// Tests that buffers from a pool reach Dart without being copied, and that
+/// the pool hands out buffers it got back again.
+///
+TEST_F(EmbedderTest, PooledBuffersCanBePostedWithoutCopies) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("objects_can_be_posted");
+
+  FlutterEngineDartPort port = 0;
+  fml::AutoResetWaitableEvent ready, received;
+  void* received_data = nullptr;
+  intptr_t received_length = 0;
+  context.AddNativeCallback(
+      "SignalNativeCount", CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+        port = tonic::DartConverter<int64_t>::FromDart(
+            Dart_GetNativeArgument(args, 0));
+        ready.Signal();
+      }));
+  context.AddNativeCallback(
+      "SendObjectToNativeCode",
+      CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+        Dart_Handle handle = Dart_GetNativeArgument(args, 0);
+        Dart_TypedData_Type type = Dart_TypedData_kInvalid;
+        ASSERT_FALSE(Dart_IsError(Dart_TypedDataAcquireData(
+            handle, &type, &received_data, &received_length)));
+        Dart_TypedDataReleaseData(handle);
+        received.Signal();
+      }));
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+  ready.Wait();
+
+  FlutterEngineDartBufferPool pool = nullptr;
+  ASSERT_EQ(FlutterEngineCreateDartBufferPool(engine.get(), 1024, &pool),
+            kSuccess);
+
+  // Buffers that are released rather than posted are handed out again.
+  uint8_t* released = nullptr;
+  ASSERT_EQ(FlutterEngineDartBufferPoolAcquire(pool, &released), kSuccess);
+  ASSERT_EQ(FlutterEngineDartBufferPoolRelease(pool, released), kSuccess);
+  uint8_t* posted = nullptr;
+  ASSERT_EQ(FlutterEngineDartBufferPoolAcquire(pool, &posted), kSuccess);
+  ASSERT_EQ(posted, released);
+
+  FlutterEngineDartBuffer buffer = {};
+  buffer.struct_size = sizeof(buffer);
+  buffer.buffer = posted;
+  buffer.buffer_size = 512;
+  buffer.pool = pool;
+  FlutterEngineDartObject object = {};
+  object.type = kFlutterEngineDartObjectTypeBuffer;
+  object.buffer_value = &buffer;
+
+  // Pooled buffers can't be larger than those in the pool.
+  buffer.buffer_size = 2048;
+  ASSERT_EQ(FlutterEnginePostDartObject(engine.get(), port, &object),
+            kInvalidArguments);
+
+  // Only buffers acquired from the pool may be posted through it.
+  uint8_t foreign[512] = {};
+  buffer.buffer = foreign;
+  buffer.buffer_size = 512;
+  ASSERT_EQ(FlutterEnginePostDartObject(engine.get(), port, &object),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineDartBufferPoolRelease(pool, foreign),
+            kInvalidArguments);
+
+  buffer.buffer = posted;
+  ASSERT_EQ(FlutterEnginePostDartObject(engine.get(), port, &object),
+            kSuccess);
+  received.Wait();
+  ASSERT_EQ(received_data, posted);
+  ASSERT_EQ(received_length, 512);
+
+  // A buffer that Dart may still reference is not handed out again.
+  uint8_t* other = nullptr;
+  ASSERT_EQ(FlutterEngineDartBufferPoolAcquire(pool, &other), kSuccess);
+  ASSERT_NE(other, posted);
+  ASSERT_EQ(FlutterEngineDartBufferPoolRelease(pool, other), kSuccess);
+  ASSERT_EQ(FlutterEngineDartBufferPoolRelease(pool, other),
+            kInvalidArguments);
+
+  // Buffers posted to Dart outlive the pool.
+  ASSERT_EQ(FlutterEngineCollectDartBufferPool(pool), kSuccess);
+  engine.reset();
+}
+
 //------------------------------------------------------------------------------
 /// Tests that a null platform message can be sent.
 ///
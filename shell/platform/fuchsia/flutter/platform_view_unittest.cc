@@ -752,8 +752,9 @@ TEST_F(PlatformViewTests, ViewEventsTest) {
   session_listener->OnScenicEvent(std::move(events));
   RunLoopUntilIdle();
 
-  auto data = delegate.message()->data();
-  auto call = std::string(data.begin(), data.end());
+  const fml::Mapping* data = &delegate.message()->data();
+  auto call = std::string(reinterpret_cast<const char*>(data->GetMapping()),
+                          data->GetSize());
   std::string expected = "{\"method\":\"View.viewConnected\",\"args\":null}";
   EXPECT_EQ(expected, call);
 
@@ -767,8 +768,9 @@ TEST_F(PlatformViewTests, ViewEventsTest) {
   session_listener->OnScenicEvent(std::move(events));
   RunLoopUntilIdle();
 
-  data = delegate.message()->data();
-  call = std::string(data.begin(), data.end());
+  data = &delegate.message()->data();
+  call = std::string(reinterpret_cast<const char*>(data->GetMapping()),
+                     data->GetSize());
   expected = "{\"method\":\"View.viewDisconnected\",\"args\":null}";
   EXPECT_EQ(expected, call);
 
@@ -786,8 +788,9 @@ TEST_F(PlatformViewTests, ViewEventsTest) {
   session_listener->OnScenicEvent(std::move(events));
   RunLoopUntilIdle();
 
-  data = delegate.message()->data();
-  call = std::string(data.begin(), data.end());
+  data = &delegate.message()->data();
+  call = std::string(reinterpret_cast<const char*>(data->GetMapping()),
+                     data->GetSize());
   expected = "{\"method\":\"View.viewStateChanged\",\"args\":{\"state\":true}}";
   EXPECT_EQ(expected, call);
 }
@@ -999,8 +1002,10 @@ TEST_F(PlatformViewTests, OnKeyEvent) {
           key_event_status = status;
         });
     RunLoopUntilIdle();
-    const std::vector<uint8_t> data = delegate.message()->data();
-    const std::string message = std::string(data.begin(), data.end());
+    const fml::Mapping& data = delegate.message()->data();
+    const std::string message =
+        std::string(reinterpret_cast<const char*>(data.GetMapping()),
+                    data.GetSize());
 
     EXPECT_EQ(event.expected_platform_message, message);
     EXPECT_EQ(key_event_status, event.expected_key_event_status);
@@ -12,6 +12,7 @@
 #include <cstdlib>
 #include <filesystem>
 #include <iostream>
+#include <vector>
 
 #include "flutter/shell/platform/common/client_wrapper/include/flutter/plugin_registrar.h"
 #include "flutter/shell/platform/common/incoming_message_dispatcher.h"
@@ -107,6 +108,16 @@ struct AOTDataDeleter {
 
 using UniqueAotDataPtr = std::unique_ptr<_FlutterEngineAOTData, AOTDataDeleter>;
 
+// A callback registered with FlutterDesktopMessengerSetBackgroundCallback.
+// Owned by the engine, which releases it once the callback won't be called
+// again.
+struct BackgroundMessageCallback {
+  FlutterDesktopMessengerRef messenger;
+  FlutterDesktopMessageCallback callback;
+  void* user_data;
+  FlutterDesktopMessageCallbackRelease release;
+};
+
 // Struct for storing state of a Flutter engine instance.
 struct FlutterDesktopEngineState {
   // The handle to the Flutter engine instance.
@@ -1101,6 +1112,37 @@ void FlutterDesktopMessengerSetCallback(FlutterDesktopMessengerRef messenger,
                                                             user_data);
 }
 
+void FlutterDesktopMessengerSetBackgroundCallback(
+    FlutterDesktopMessengerRef messenger,
+    const char* channel,
+    FlutterDesktopMessageCallback callback,
+    void* user_data,
+    FlutterDesktopMessageCallbackRelease release) {
+  FlutterDesktopEngineState* engine_state = messenger->engine;
+  if (!callback) {
+    FlutterEngineSetPlatformMessageBackgroundCallback(
+        engine_state->flutter_engine, channel, nullptr, nullptr, nullptr);
+    return;
+  }
+
+  FlutterEngineSetPlatformMessageBackgroundCallback(
+      engine_state->flutter_engine, channel,
+      [](const FlutterPlatformMessage* engine_message, void* user_data) {
+        auto registration = static_cast<BackgroundMessageCallback*>(user_data);
+        auto message = ConvertToDesktopMessage(*engine_message);
+        registration->callback(registration->messenger, &message,
+                               registration->user_data);
+      },
+      new BackgroundMessageCallback{messenger, callback, user_data, release},
+      [](void* user_data) {
+        auto registration = static_cast<BackgroundMessageCallback*>(user_data);
+        if (registration->release) {
+          registration->release(registration->user_data);
+        }
+        delete registration;
+      });
+}
+
 FlutterDesktopTextureRegistrarRef FlutterDesktopRegistrarGetTextureRegistrar(
     FlutterDesktopPluginRegistrarRef registrar) {
   std::cerr << "GLFW Texture support is not implemented yet." << std::endl;
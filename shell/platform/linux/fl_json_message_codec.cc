@@ -8,6 +8,7 @@
 
 #include <cstring>
 
+#include "flutter/shell/platform/linux/fl_value_private.h"
 #include "rapidjson/reader.h"
 #include "rapidjson/writer.h"
 
@@ -15,6 +16,11 @@ G_DEFINE_QUARK(fl_json_message_codec_error_quark, fl_json_message_codec_error)
 
 struct _FlJsonMessageCodec {
   FlMessageCodec parent_instance;
+
+  // Kept between messages so that the small messages sent on every key press
+  // reuse their storage rather than reallocating it.
+  rapidjson::StringBuffer* buffer;
+  rapidjson::Reader* reader;
 };
 
 G_DEFINE_TYPE(FlJsonMessageCodec,
@@ -122,11 +128,12 @@ static gboolean write_value(rapidjson::Writer<rapidjson::StringBuffer>& writer,
 
 // Handler to parse JSON using rapidjson in SAX mode.
 struct FlValueHandler {
+  FlValueArena* arena;
   GPtrArray* stack;
   FlValue* key;
   GError* error;
 
-  FlValueHandler() {
+  explicit FlValueHandler(FlValueArena* arena) : arena(arena) {
     stack = g_ptr_array_new_with_free_func(
         reinterpret_cast<GDestroyNotify>(fl_value_unref));
     key = nullptr;
@@ -184,26 +191,26 @@ struct FlValueHandler {
 
   // The following implements the rapidjson SAX API.
 
-  bool Null() { return add(fl_value_new_null()); }
+  bool Null() { return add(fl_value_arena_new_null(arena)); }
 
-  bool Bool(bool b) { return add(fl_value_new_bool(b)); }
+  bool Bool(bool b) { return add(fl_value_arena_new_bool(arena, b)); }
 
-  bool Int(int i) { return add(fl_value_new_int(i)); }
+  bool Int(int i) { return add(fl_value_arena_new_int(arena, i)); }
 
-  bool Uint(unsigned i) { return add(fl_value_new_int(i)); }
+  bool Uint(unsigned i) { return add(fl_value_arena_new_int(arena, i)); }
 
-  bool Int64(int64_t i) { return add(fl_value_new_int(i)); }
+  bool Int64(int64_t i) { return add(fl_value_arena_new_int(arena, i)); }
 
   bool Uint64(uint64_t i) {
     // For some reason (bug in rapidjson?) this is not returned in Int64.
     if (i == G_MAXINT64) {
-      return add(fl_value_new_int(i));
+      return add(fl_value_arena_new_int(arena, i));
     } else {
-      return add(fl_value_new_float(i));
+      return add(fl_value_arena_new_float(arena, i));
     }
   }
 
-  bool Double(double d) { return add(fl_value_new_float(d)); }
+  bool Double(double d) { return add(fl_value_arena_new_float(arena, d)); }
 
   bool RawNumber(const char* str, rapidjson::SizeType length, bool copy) {
     g_set_error(&error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED,
@@ -212,17 +219,17 @@ struct FlValueHandler {
   }
 
   bool String(const char* str, rapidjson::SizeType length, bool copy) {
-    FlValue* v = fl_value_new_string_sized(str, length);
+    FlValue* v = fl_value_arena_new_string_sized(arena, str, length);
     return add(v);
   }
 
-  bool StartObject() { return add(fl_value_new_map()); }
+  bool StartObject() { return add(fl_value_arena_new_map(arena, 0)); }
 
   bool Key(const char* str, rapidjson::SizeType length, bool copy) {
     if (key != nullptr) {
       fl_value_unref(key);
     }
-    key = fl_value_new_string_sized(str, length);
+    key = fl_value_arena_new_string_sized(arena, str, length);
     return true;
   }
 
@@ -231,7 +238,7 @@ struct FlValueHandler {
     return true;
   }
 
-  bool StartArray() { return add(fl_value_new_list()); }
+  bool StartArray() { return add(fl_value_arena_new_list(arena, 0)); }
 
   bool EndArray(rapidjson::SizeType elementCount) {
     pop();
@@ -239,25 +246,34 @@ struct FlValueHandler {
   }
 };
 
+// Encodes |value| into the codec's reused buffer.
+static gboolean encode_to_buffer(FlJsonMessageCodec* self,
+                                 FlValue* value,
+                                 GError** error) {
+  self->buffer->Clear();
+  rapidjson::Writer<rapidjson::StringBuffer> writer(*self->buffer);
+  return write_value(writer, value, error);
+}
+
 // Implements FlMessageCodec:encode_message.
 static GBytes* fl_json_message_codec_encode_message(FlMessageCodec* codec,
                                                     FlValue* message,
                                                     GError** error) {
-  rapidjson::StringBuffer buffer;
-  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  FlJsonMessageCodec* self = FL_JSON_CODEC(codec);
 
-  if (!write_value(writer, message, error)) {
+  if (!encode_to_buffer(self, message, error)) {
     return nullptr;
   }
 
-  const gchar* text = buffer.GetString();
-  return g_bytes_new(text, strlen(text));
+  return g_bytes_new(self->buffer->GetString(), self->buffer->GetSize());
 }
 
 // Implements FlMessageCodec:decode_message.
 static FlValue* fl_json_message_codec_decode_message(FlMessageCodec* codec,
                                                      GBytes* message,
                                                      GError** error) {
+  FlJsonMessageCodec* self = FL_JSON_CODEC(codec);
+
   gsize data_length;
   const gchar* data =
       static_cast<const char*>(g_bytes_get_data(message, &data_length));
@@ -268,10 +284,13 @@ static FlValue* fl_json_message_codec_decode_message(FlMessageCodec* codec,
     return nullptr;
   }
 
-  FlValueHandler handler;
-  rapidjson::Reader reader;
+  // Strings are unescaped into the arena, so it can't reference the message.
+  // Counting values up front would mean parsing twice, so the arena starts
+  // small and grows with the values actually decoded.
+  g_autoptr(FlValueArena) arena = fl_value_arena_new(nullptr, 0);
+  FlValueHandler handler(arena);
   rapidjson::MemoryStream ss(data, data_length);
-  if (!reader.Parse(ss, handler)) {
+  if (!self->reader->Parse(ss, handler)) {
     if (handler.error != nullptr) {
       g_propagate_error(error, handler.error);
       handler.error = nullptr;
@@ -294,14 +313,33 @@ static FlValue* fl_json_message_codec_decode_message(FlMessageCodec* codec,
   return fl_value_ref(value);
 }
 
+static void fl_json_message_codec_dispose(GObject* object) {
+  FlJsonMessageCodec* self = FL_JSON_CODEC(object);
+
+  if (self->buffer != nullptr) {
+    delete self->buffer;
+    self->buffer = nullptr;
+  }
+  if (self->reader != nullptr) {
+    delete self->reader;
+    self->reader = nullptr;
+  }
+
+  G_OBJECT_CLASS(fl_json_message_codec_parent_class)->dispose(object);
+}
+
 static void fl_json_message_codec_class_init(FlJsonMessageCodecClass* klass) {
+  G_OBJECT_CLASS(klass)->dispose = fl_json_message_codec_dispose;
   FL_MESSAGE_CODEC_CLASS(klass)->encode_message =
       fl_json_message_codec_encode_message;
   FL_MESSAGE_CODEC_CLASS(klass)->decode_message =
       fl_json_message_codec_decode_message;
 }
 
-static void fl_json_message_codec_init(FlJsonMessageCodec* self) {}
+static void fl_json_message_codec_init(FlJsonMessageCodec* self) {
+  self->buffer = new rapidjson::StringBuffer();
+  self->reader = new rapidjson::Reader();
+}
 
 G_MODULE_EXPORT FlJsonMessageCodec* fl_json_message_codec_new() {
   return static_cast<FlJsonMessageCodec*>(
@@ -313,14 +351,11 @@ G_MODULE_EXPORT gchar* fl_json_message_codec_encode(FlJsonMessageCodec* codec,
                                                     GError** error) {
   g_return_val_if_fail(FL_IS_JSON_CODEC(codec), nullptr);
 
-  rapidjson::StringBuffer buffer;
-  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-
-  if (!write_value(writer, value, error)) {
+  if (!encode_to_buffer(codec, value, error)) {
     return nullptr;
   }
 
-  return g_strdup(buffer.GetString());
+  return g_strndup(codec->buffer->GetString(), codec->buffer->GetSize());
 }
 
 G_MODULE_EXPORT FlValue* fl_json_message_codec_decode(FlJsonMessageCodec* codec,
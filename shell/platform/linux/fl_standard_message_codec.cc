@@ -160,13 +160,14 @@ static gboolean read_uint32(GBytes* buffer,
 // error.
 static FlValue* read_int32_value(GBytes* buffer,
                                  size_t* offset,
+                                 FlValueArena* arena,
                                  GError** error) {
   if (!check_size(buffer, *offset, sizeof(int32_t), error)) {
     return nullptr;
   }
 
-  FlValue* value = fl_value_new_int(
-      reinterpret_cast<const int32_t*>(get_data(buffer, offset))[0]);
+  FlValue* value = fl_value_arena_new_int(
+      arena, reinterpret_cast<const int32_t*>(get_data(buffer, offset))[0]);
   *offset += sizeof(int32_t);
   return value;
 }
@@ -176,13 +177,14 @@ static FlValue* read_int32_value(GBytes* buffer,
 // error.
 static FlValue* read_int64_value(GBytes* buffer,
                                  size_t* offset,
+                                 FlValueArena* arena,
                                  GError** error) {
   if (!check_size(buffer, *offset, sizeof(int64_t), error)) {
     return nullptr;
   }
 
-  FlValue* value = fl_value_new_int(
-      reinterpret_cast<const int64_t*>(get_data(buffer, offset))[0]);
+  FlValue* value = fl_value_arena_new_int(
+      arena, reinterpret_cast<const int64_t*>(get_data(buffer, offset))[0]);
   *offset += sizeof(int64_t);
   return value;
 }
@@ -192,6 +194,7 @@ static FlValue* read_int64_value(GBytes* buffer,
 // error.
 static FlValue* read_float64_value(GBytes* buffer,
                                    size_t* offset,
+                                   FlValueArena* arena,
                                    GError** error) {
   if (!read_align(buffer, offset, 8, error)) {
     return nullptr;
@@ -200,8 +203,8 @@ static FlValue* read_float64_value(GBytes* buffer,
     return nullptr;
   }
 
-  FlValue* value = fl_value_new_float(
-      reinterpret_cast<const double*>(get_data(buffer, offset))[0]);
+  FlValue* value = fl_value_arena_new_float(
+      arena, reinterpret_cast<const double*>(get_data(buffer, offset))[0]);
   *offset += sizeof(double);
   return value;
 }
@@ -212,6 +215,7 @@ static FlValue* read_float64_value(GBytes* buffer,
 static FlValue* read_string_value(FlStandardMessageCodec* self,
                                   GBytes* buffer,
                                   size_t* offset,
+                                  FlValueArena* arena,
                                   GError** error) {
   uint32_t length;
   if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
@@ -221,8 +225,8 @@ static FlValue* read_string_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_string_sized(
-      reinterpret_cast<const gchar*>(get_data(buffer, offset)), length);
+  FlValue* value = fl_value_arena_new_string_sized(
+      arena, reinterpret_cast<const gchar*>(get_data(buffer, offset)), length);
   *offset += length;
   return value;
 }
@@ -233,6 +237,7 @@ static FlValue* read_string_value(FlStandardMessageCodec* self,
 static FlValue* read_uint8_list_value(FlStandardMessageCodec* self,
                                       GBytes* buffer,
                                       size_t* offset,
+                                      FlValueArena* arena,
                                       GError** error) {
   uint32_t length;
   if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
@@ -242,7 +247,8 @@ static FlValue* read_uint8_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(uint8_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_uint8_list(get_data(buffer, offset), length);
+  FlValue* value =
+      fl_value_arena_new_uint8_list(arena, get_data(buffer, offset), length);
   *offset += length;
   return value;
 }
@@ -253,6 +259,7 @@ static FlValue* read_uint8_list_value(FlStandardMessageCodec* self,
 static FlValue* read_int32_list_value(FlStandardMessageCodec* self,
                                       GBytes* buffer,
                                       size_t* offset,
+                                      FlValueArena* arena,
                                       GError** error) {
   uint32_t length;
   if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
@@ -265,8 +272,9 @@ static FlValue* read_int32_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(int32_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_int32_list(
-      reinterpret_cast<const int32_t*>(get_data(buffer, offset)), length);
+  FlValue* value = fl_value_arena_new_int32_list(
+      arena, reinterpret_cast<const int32_t*>(get_data(buffer, offset)),
+      length);
   *offset += sizeof(int32_t) * length;
   return value;
 }
@@ -277,6 +285,7 @@ static FlValue* read_int32_list_value(FlStandardMessageCodec* self,
 static FlValue* read_int64_list_value(FlStandardMessageCodec* self,
                                       GBytes* buffer,
                                       size_t* offset,
+                                      FlValueArena* arena,
                                       GError** error) {
   uint32_t length;
   if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
@@ -289,8 +298,9 @@ static FlValue* read_int64_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(int64_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_int64_list(
-      reinterpret_cast<const int64_t*>(get_data(buffer, offset)), length);
+  FlValue* value = fl_value_arena_new_int64_list(
+      arena, reinterpret_cast<const int64_t*>(get_data(buffer, offset)),
+      length);
   *offset += sizeof(int64_t) * length;
   return value;
 }
@@ -301,6 +311,7 @@ static FlValue* read_int64_list_value(FlStandardMessageCodec* self,
 static FlValue* read_float64_list_value(FlStandardMessageCodec* self,
                                         GBytes* buffer,
                                         size_t* offset,
+                                        FlValueArena* arena,
                                         GError** error) {
   uint32_t length;
   if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
@@ -313,8 +324,9 @@ static FlValue* read_float64_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(double) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_float_list(
-      reinterpret_cast<const double*>(get_data(buffer, offset)), length);
+  FlValue* value = fl_value_arena_new_float_list(
+      arena, reinterpret_cast<const double*>(get_data(buffer, offset)),
+      length);
   *offset += sizeof(double) * length;
   return value;
 }
@@ -325,6 +337,7 @@ static FlValue* read_float64_list_value(FlStandardMessageCodec* self,
 static FlValue* read_list_value(FlStandardMessageCodec* self,
                                 GBytes* buffer,
                                 size_t* offset,
+                                FlValueArena* arena,
                                 GError** error) {
   uint32_t length;
   if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
@@ -332,10 +345,14 @@ static FlValue* read_list_value(FlStandardMessageCodec* self,
     return nullptr;
   }
 
-  g_autoptr(FlValue) list = fl_value_new_list();
+  // Only reserve space up front for as many children as the remaining data
+  // could hold, so a corrupt length can't trigger a huge allocation.
+  size_t remaining = g_bytes_get_size(buffer) - *offset;
+  g_autoptr(FlValue) list =
+      fl_value_arena_new_list(arena, MIN(length, remaining));
   for (size_t i = 0; i < length; i++) {
-    g_autoptr(FlValue) child =
-        fl_standard_message_codec_read_value(self, buffer, offset, error);
+    g_autoptr(FlValue) child = fl_standard_message_codec_read_value(
+        self, buffer, offset, arena, error);
     if (child == nullptr) {
       return nullptr;
     }
@@ -351,6 +368,7 @@ static FlValue* read_list_value(FlStandardMessageCodec* self,
 static FlValue* read_map_value(FlStandardMessageCodec* self,
                                GBytes* buffer,
                                size_t* offset,
+                               FlValueArena* arena,
                                GError** error) {
   uint32_t length;
   if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
@@ -358,15 +376,17 @@ static FlValue* read_map_value(FlStandardMessageCodec* self,
     return nullptr;
   }
 
-  g_autoptr(FlValue) map = fl_value_new_map();
+  size_t remaining = g_bytes_get_size(buffer) - *offset;
+  g_autoptr(FlValue) map =
+      fl_value_arena_new_map(arena, MIN(length, remaining / 2));
   for (size_t i = 0; i < length; i++) {
-    g_autoptr(FlValue) key =
-        fl_standard_message_codec_read_value(self, buffer, offset, error);
+    g_autoptr(FlValue) key = fl_standard_message_codec_read_value(
+        self, buffer, offset, arena, error);
     if (key == nullptr) {
       return nullptr;
     }
-    g_autoptr(FlValue) value =
-        fl_standard_message_codec_read_value(self, buffer, offset, error);
+    g_autoptr(FlValue) value = fl_standard_message_codec_read_value(
+        self, buffer, offset, arena, error);
     if (value == nullptr) {
       return nullptr;
     }
@@ -376,6 +396,77 @@ static FlValue* read_map_value(FlStandardMessageCodec* self,
   return fl_value_ref(map);
 }
 
+// What decoding a message allocates, used to size the arena it is decoded into.
+typedef struct {
+  size_t value_count;
+  size_t child_count;
+  size_t string_count;
+  size_t string_length;
+} ArenaUsage;
+
+// Skips @length bytes of @buffer. Returns FALSE if there is not enough data.
+static gboolean skip_bytes(GBytes* buffer, size_t* offset, size_t length) {
+  if (!check_size(buffer, *offset, length, nullptr)) {
+    return FALSE;
+  }
+  *offset += length;
+  return TRUE;
+}
+
+// Walks the value at @offset in @buffer without decoding it, adding what
+// decoding it would allocate to @usage. Returns FALSE if the data is invalid.
+static gboolean measure_value(FlStandardMessageCodec* self,
+                              GBytes* buffer,
+                              size_t* offset,
+                              ArenaUsage* usage) {
+  uint8_t type;
+  if (!read_uint8(buffer, offset, &type, nullptr)) {
+    return FALSE;
+  }
+  usage->value_count++;
+
+  if (type == kValueNull || type == kValueTrue || type == kValueFalse) {
+    return TRUE;
+  } else if (type == kValueInt32) {
+    return skip_bytes(buffer, offset, sizeof(int32_t));
+  } else if (type == kValueInt64) {
+    return skip_bytes(buffer, offset, sizeof(int64_t));
+  } else if (type == kValueFloat64) {
+    return read_align(buffer, offset, 8, nullptr) &&
+           skip_bytes(buffer, offset, sizeof(double));
+  }
+
+  uint32_t length;
+  if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
+                                           nullptr)) {
+    return FALSE;
+  }
+  if (type == kValueString) {
+    usage->string_count++;
+    usage->string_length += length;
+    return skip_bytes(buffer, offset, length);
+  } else if (type == kValueUint8List) {
+    return skip_bytes(buffer, offset, sizeof(uint8_t) * length);
+  } else if (type == kValueInt32List) {
+    return read_align(buffer, offset, 4, nullptr) &&
+           skip_bytes(buffer, offset, sizeof(int32_t) * length);
+  } else if (type == kValueInt64List || type == kValueFloat64List) {
+    return read_align(buffer, offset, 8, nullptr) &&
+           skip_bytes(buffer, offset, sizeof(int64_t) * length);
+  } else if (type == kValueList || type == kValueMap) {
+    size_t child_count = type == kValueMap ? length * size_t{2} : length;
+    for (size_t i = 0; i < child_count; i++) {
+      if (!measure_value(self, buffer, offset, usage)) {
+        return FALSE;
+      }
+      usage->child_count++;
+    }
+    return TRUE;
+  }
+
+  return FALSE;
+}
+
 // Implements FlMessageCodec::encode_message.
 static GBytes* fl_standard_message_codec_encode_message(FlMessageCodec* codec,
                                                         FlValue* message,
@@ -398,9 +489,12 @@ static FlValue* fl_standard_message_codec_decode_message(FlMessageCodec* codec,
   FlStandardMessageCodec* self =
       reinterpret_cast<FlStandardMessageCodec*>(codec);
 
+  // Decode the whole message into one arena.
+  g_autoptr(FlValueArena) arena =
+      fl_standard_message_codec_new_arena(self, message, 0);
   size_t offset = 0;
-  g_autoptr(FlValue) value =
-      fl_standard_message_codec_read_value(self, message, &offset, error);
+  g_autoptr(FlValue) value = fl_standard_message_codec_read_value(
+      self, message, &offset, arena, error);
   if (value == nullptr) {
     return nullptr;
   }
@@ -590,9 +684,26 @@ gboolean fl_standard_message_codec_write_value(FlStandardMessageCodec* self,
   return FALSE;
 }
 
+FlValueArena* fl_standard_message_codec_new_arena(FlStandardMessageCodec* self,
+                                                  GBytes* buffer,
+                                                  size_t offset) {
+  // If the message turns out to be invalid, size the arena for the values
+  // before the error; decoding stops there too.
+  ArenaUsage usage = {};
+  while (offset < g_bytes_get_size(buffer)) {
+    if (!measure_value(self, buffer, &offset, &usage)) {
+      break;
+    }
+  }
+  return fl_value_arena_new(
+      buffer, fl_value_arena_size_for(usage.value_count, usage.child_count,
+                                      usage.string_count, usage.string_length));
+}
+
 FlValue* fl_standard_message_codec_read_value(FlStandardMessageCodec* self,
                                               GBytes* buffer,
                                               size_t* offset,
+                                              FlValueArena* arena,
                                               GError** error) {
   uint8_t type;
   if (!read_uint8(buffer, offset, &type, error)) {
@@ -601,31 +712,31 @@ FlValue* fl_standard_message_codec_read_value(FlStandardMessageCodec* self,
 
   g_autoptr(FlValue) value = nullptr;
   if (type == kValueNull) {
-    return fl_value_new_null();
+    return fl_value_arena_new_null(arena);
   } else if (type == kValueTrue) {
-    return fl_value_new_bool(TRUE);
+    return fl_value_arena_new_bool(arena, TRUE);
   } else if (type == kValueFalse) {
-    return fl_value_new_bool(FALSE);
+    return fl_value_arena_new_bool(arena, FALSE);
   } else if (type == kValueInt32) {
-    value = read_int32_value(buffer, offset, error);
+    value = read_int32_value(buffer, offset, arena, error);
   } else if (type == kValueInt64) {
-    value = read_int64_value(buffer, offset, error);
+    value = read_int64_value(buffer, offset, arena, error);
   } else if (type == kValueFloat64) {
-    value = read_float64_value(buffer, offset, error);
+    value = read_float64_value(buffer, offset, arena, error);
   } else if (type == kValueString) {
-    value = read_string_value(self, buffer, offset, error);
+    value = read_string_value(self, buffer, offset, arena, error);
   } else if (type == kValueUint8List) {
-    value = read_uint8_list_value(self, buffer, offset, error);
+    value = read_uint8_list_value(self, buffer, offset, arena, error);
   } else if (type == kValueInt32List) {
-    value = read_int32_list_value(self, buffer, offset, error);
+    value = read_int32_list_value(self, buffer, offset, arena, error);
   } else if (type == kValueInt64List) {
-    value = read_int64_list_value(self, buffer, offset, error);
+    value = read_int64_list_value(self, buffer, offset, arena, error);
   } else if (type == kValueFloat64List) {
-    value = read_float64_list_value(self, buffer, offset, error);
+    value = read_float64_list_value(self, buffer, offset, arena, error);
   } else if (type == kValueList) {
-    value = read_list_value(self, buffer, offset, error);
+    value = read_list_value(self, buffer, offset, arena, error);
   } else if (type == kValueMap) {
-    value = read_map_value(self, buffer, offset, error);
+    value = read_map_value(self, buffer, offset, arena, error);
   } else {
     g_set_error(error, FL_MESSAGE_CODEC_ERROR,
                 FL_MESSAGE_CODEC_ERROR_UNSUPPORTED_TYPE,
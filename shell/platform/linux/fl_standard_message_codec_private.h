@@ -7,6 +7,8 @@
 
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_standard_message_codec.h"
 
+#include "flutter/shell/platform/linux/fl_value_private.h"
+
 G_BEGIN_DECLS
 
 /**
@@ -57,12 +59,27 @@ gboolean fl_standard_message_codec_write_value(FlStandardMessageCodec* codec,
                                                FlValue* value,
                                                GError** error);
 
+/**
+ * fl_standard_message_codec_new_arena:
+ * @codec: an #FlStandardMessageCodec.
+ * @buffer: message to be decoded.
+ * @offset: position in @buffer decoding will start at.
+ *
+ * Creates an arena sized to hold all of the values encoded in @buffer from
+ * @offset onwards.
+ *
+ * Returns: a new #FlValueArena.
+ */
+FlValueArena* fl_standard_message_codec_new_arena(FlStandardMessageCodec* codec,
+                                                  GBytes* buffer,
+                                                  size_t offset);
+
 /**
  * fl_standard_message_codec_read_value:
  * @codec: an #FlStandardMessageCodec.
  * @buffer: buffer to read from.
  * @offset: (inout): read position in @buffer.
- * @value: location to read size.
+ * @arena: (allow-none): arena to allocate the value in, or %NULL.
  * @error: (allow-none): #GError location to store the error occurring, or
  * %NULL.
  *
@@ -73,6 +90,7 @@ gboolean fl_standard_message_codec_write_value(FlStandardMessageCodec* codec,
 FlValue* fl_standard_message_codec_read_value(FlStandardMessageCodec* codec,
                                               GBytes* buffer,
                                               size_t* offset,
+                                              FlValueArena* arena,
                                               GError** error);
 
 G_END_DECLS
@@ -561,6 +561,24 @@ TEST(FlStandardMessageCodecTest, DecodeFloatList) {
   EXPECT_FLOAT_EQ(data[4], 0.00625);
 }
 
+TEST(FlStandardMessageCodecTest, DecodeFloatListReferencesMessage) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(GBytes) data = hex_string_to_bytes(
+      "0b020000000000000000000000000000000000000000e0bf");
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(FlValue) value =
+      fl_message_codec_decode_message(FL_MESSAGE_CODEC(codec), data, &error);
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(error, nullptr);
+
+  // The list points into the message rather than a copy of it.
+  const uint8_t* message =
+      static_cast<const uint8_t*>(g_bytes_get_data(data, nullptr));
+  EXPECT_EQ(reinterpret_cast<const uint8_t*>(fl_value_get_float_list(value)),
+            message + 8);
+  EXPECT_FLOAT_EQ(fl_value_get_float_list(value)[1], -0.5);
+}
+
 TEST(FlStandardMessageCodecTest, DecodeFloatListNoData) {
   decode_error_value("0b", FL_MESSAGE_CODEC_ERROR,
                      FL_MESSAGE_CODEC_ERROR_OUT_OF_DATA);
@@ -65,9 +65,11 @@ static gboolean fl_standard_method_codec_decode_method_call(
     GError** error) {
   FlStandardMethodCodec* self = FL_STANDARD_METHOD_CODEC(codec);
 
+  g_autoptr(FlValueArena) arena =
+      fl_standard_message_codec_new_arena(self->codec, message, 0);
   size_t offset = 0;
   g_autoptr(FlValue) name_value = fl_standard_message_codec_read_value(
-      self->codec, message, &offset, error);
+      self->codec, message, &offset, arena, error);
   if (name_value == nullptr) {
     return FALSE;
   }
@@ -78,7 +80,7 @@ static gboolean fl_standard_method_codec_decode_method_call(
   }
 
   g_autoptr(FlValue) args_value = fl_standard_message_codec_read_value(
-      self->codec, message, &offset, error);
+      self->codec, message, &offset, arena, error);
   if (args_value == nullptr) {
     return FALSE;
   }
@@ -165,10 +167,13 @@ static FlMethodResponse* fl_standard_method_codec_decode_response(
   guint8 type = data[0];
   size_t offset = 1;
 
+  g_autoptr(FlValueArena) arena =
+      fl_standard_message_codec_new_arena(self->codec, message, offset);
+
   g_autoptr(FlMethodResponse) response = nullptr;
   if (type == kEnvelopeTypeError) {
     g_autoptr(FlValue) code = fl_standard_message_codec_read_value(
-        self->codec, message, &offset, error);
+        self->codec, message, &offset, arena, error);
     if (code == nullptr) {
       return nullptr;
     }
@@ -179,7 +184,7 @@ static FlMethodResponse* fl_standard_method_codec_decode_response(
     }
 
     g_autoptr(FlValue) error_message = fl_standard_message_codec_read_value(
-        self->codec, message, &offset, error);
+        self->codec, message, &offset, arena, error);
     if (error_message == nullptr) {
       return nullptr;
     }
@@ -191,7 +196,7 @@ static FlMethodResponse* fl_standard_method_codec_decode_response(
     }
 
     g_autoptr(FlValue) details = fl_standard_message_codec_read_value(
-        self->codec, message, &offset, error);
+        self->codec, message, &offset, arena, error);
     if (details == nullptr) {
       return nullptr;
     }
@@ -204,7 +209,7 @@ static FlMethodResponse* fl_standard_method_codec_decode_response(
         fl_value_get_type(details) != FL_VALUE_TYPE_NULL ? details : nullptr));
   } else if (type == kEnvelopeTypeSuccess) {
     g_autoptr(FlValue) result = fl_standard_message_codec_read_value(
-        self->codec, message, &offset, error);
+        self->codec, message, &offset, arena, error);
 
     if (result == nullptr) {
       return nullptr;
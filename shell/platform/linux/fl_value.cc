@@ -8,9 +8,16 @@
 
 #include <cstring>
 
+#include "flutter/shell/platform/linux/fl_value_private.h"
+
 struct _FlValue {
   FlValueType type;
   int ref_count;
+
+  // Arena this value was allocated in, or %NULL if it was allocated on its own.
+  // Values in an arena are reference counted like any other, but their memory
+  // is only returned when the whole arena is freed.
+  FlValueArena* arena;
 };
 
 typedef struct {
@@ -37,37 +44,135 @@ typedef struct {
   FlValue parent;
   uint8_t* values;
   size_t values_length;
+  // Message @values points into, or %NULL if they are owned by this value.
+  GBytes* bytes;
 } FlValueUint8List;
 
 typedef struct {
   FlValue parent;
   int32_t* values;
   size_t values_length;
+  // Message @values points into, or %NULL if they are owned by this value.
+  GBytes* bytes;
 } FlValueInt32List;
 
 typedef struct {
   FlValue parent;
   int64_t* values;
   size_t values_length;
+  // Message @values points into, or %NULL if they are owned by this value.
+  GBytes* bytes;
 } FlValueInt64List;
 
 typedef struct {
   FlValue parent;
   double* values;
   size_t values_length;
+  // Message @values points into, or %NULL if they are owned by this value.
+  GBytes* bytes;
 } FlValueFloatList;
 
 typedef struct {
   FlValue parent;
-  GPtrArray* values;
+  FlValue** values;
+  size_t values_length;
+  size_t values_capacity;
 } FlValueList;
 
 typedef struct {
   FlValue parent;
-  GPtrArray* keys;
-  GPtrArray* values;
+  FlValue** keys;
+  FlValue** values;
+  size_t values_length;
+  size_t values_capacity;
 } FlValueMap;
 
+// A block of memory allocated once the arena's initial block is full.
+typedef struct _FlValueArenaBlock {
+  struct _FlValueArenaBlock* next;
+} FlValueArenaBlock;
+
+struct _FlValueArena {
+  // The reference returned by fl_value_arena_new() plus one for each value in
+  // the arena that is still alive.
+  int ref_count;
+
+  // Message values are being decoded from. Only held until the reference
+  // returned by fl_value_arena_new() is dropped; typed lists that point into
+  // it take their own reference.
+  GBytes* source;
+
+  // Unused space in the current block.
+  uint8_t* next;
+  uint8_t* end;
+
+  size_t block_size;
+  FlValueArenaBlock* blocks;
+};
+
+// Allocations in an arena are aligned to suit any of the value types.
+static constexpr size_t kArenaAlignment = 8;
+
+static constexpr size_t kArenaMinimumSize = 64;
+
+// Space taken in an arena by the largest value type.
+static constexpr size_t kArenaValueSize =
+    (MAX(sizeof(FlValueMap), sizeof(FlValueFloatList)) + kArenaAlignment - 1) &
+    ~(kArenaAlignment - 1);
+
+// Initial space for children in lists and maps that grow.
+static constexpr size_t kInitialChildrenCapacity = 4;
+
+static size_t arena_align(size_t size) {
+  return (size + kArenaAlignment - 1) & ~(kArenaAlignment - 1);
+}
+
+// Allocates @size bytes from @arena.
+static void* arena_alloc(FlValueArena* arena, size_t size) {
+  size = arena_align(size);
+  if (static_cast<size_t>(arena->end - arena->next) < size) {
+    arena->block_size = MAX(arena->block_size * 2, size);
+    size_t header_size = arena_align(sizeof(FlValueArenaBlock));
+    FlValueArenaBlock* block = static_cast<FlValueArenaBlock*>(
+        g_malloc(header_size + arena->block_size));
+    block->next = arena->blocks;
+    arena->blocks = block;
+    arena->next = reinterpret_cast<uint8_t*>(block) + header_size;
+    arena->end = arena->next + arena->block_size;
+  }
+
+  void* data = arena->next;
+  arena->next += size;
+  return data;
+}
+
+// Returns @data if it lies within the source bytes of @arena, and sets @bytes
+// to a new reference on them. Otherwise returns a copy of @data allocated from
+// @arena and sets @bytes to %NULL.
+static void* arena_reference_or_copy(FlValueArena* arena,
+                                     const void* data,
+                                     size_t size,
+                                     size_t alignment,
+                                     GBytes** bytes) {
+  if (arena->source != nullptr) {
+    gsize source_length;
+    const uint8_t* source = static_cast<const uint8_t*>(
+        g_bytes_get_data(arena->source, &source_length));
+    const uint8_t* d = static_cast<const uint8_t*>(data);
+    if (source != nullptr && d >= source &&
+        d + size <= source + source_length &&
+        reinterpret_cast<uintptr_t>(d) % alignment == 0) {
+      *bytes = g_bytes_ref(arena->source);
+      return const_cast<uint8_t*>(d);
+    }
+  }
+
+  *bytes = nullptr;
+  void* copy = arena_alloc(arena, size);
+  memcpy(copy, data, size);
+  return copy;
+}
+
 static FlValue* fl_value_new(FlValueType type, size_t size) {
   FlValue* self = static_cast<FlValue*>(g_malloc0(size));
   self->type = type;
@@ -75,9 +180,66 @@ static FlValue* fl_value_new(FlValueType type, size_t size) {
   return self;
 }
 
-// Helper function to match GDestroyNotify type.
-static void fl_value_destroy(gpointer value) {
-  fl_value_unref(static_cast<FlValue*>(value));
+// Creates a value in @arena, or on its own if @arena is %NULL.
+static FlValue* fl_value_new_in(FlValueArena* arena,
+                                FlValueType type,
+                                size_t size) {
+  if (arena == nullptr) {
+    return fl_value_new(type, size);
+  }
+
+  FlValue* self = static_cast<FlValue*>(arena_alloc(arena, size));
+  memset(self, 0, size);
+  self->type = type;
+  self->ref_count = 1;
+  self->arena = arena;
+  arena->ref_count++;
+  return self;
+}
+
+// Resizes the array of children @values of the list or map @self to
+// @capacity. Arrays in an arena are reallocated from it.
+static FlValue** resize_children(FlValue* self,
+                                 FlValue** values,
+                                 size_t length,
+                                 size_t capacity) {
+  if (self->arena == nullptr) {
+    return g_renew(FlValue*, values, capacity);
+  }
+
+  FlValue** resized = static_cast<FlValue**>(
+      arena_alloc(self->arena, sizeof(FlValue*) * capacity));
+  if (length > 0) {
+    memcpy(resized, values, sizeof(FlValue*) * length);
+  }
+  return resized;
+}
+
+// Drops a reference on @arena, freeing it once it is no longer used.
+static void arena_release(FlValueArena* arena) {
+  g_return_if_fail(arena->ref_count > 0);
+  arena->ref_count--;
+  if (arena->ref_count != 0) {
+    return;
+  }
+
+  FlValueArenaBlock* block = arena->blocks;
+  while (block != nullptr) {
+    FlValueArenaBlock* next = block->next;
+    g_free(block);
+    block = next;
+  }
+  g_free(arena);
+}
+
+// Frees the data of typed list @self, which is in @values unless it points
+// into @bytes or lies in the arena.
+static void free_typed_list_values(FlValue* self, void* values, GBytes* bytes) {
+  if (bytes != nullptr) {
+    g_bytes_unref(bytes);
+  } else if (self->arena == nullptr) {
+    g_free(values);
+  }
 }
 
 // Finds the index of a key in a FlValueMap.
@@ -308,10 +470,7 @@ G_MODULE_EXPORT FlValue* fl_value_new_float_list(const double* data,
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_list() {
-  FlValueList* self = reinterpret_cast<FlValueList*>(
-      fl_value_new(FL_VALUE_TYPE_LIST, sizeof(FlValueList)));
-  self->values = g_ptr_array_new_with_free_func(fl_value_destroy);
-  return reinterpret_cast<FlValue*>(self);
+  return fl_value_arena_new_list(nullptr, 0);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_list_from_strv(
@@ -325,11 +484,7 @@ G_MODULE_EXPORT FlValue* fl_value_new_list_from_strv(
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_map() {
-  FlValueMap* self = reinterpret_cast<FlValueMap*>(
-      fl_value_new(FL_VALUE_TYPE_MAP, sizeof(FlValueMap)));
-  self->keys = g_ptr_array_new_with_free_func(fl_value_destroy);
-  self->values = g_ptr_array_new_with_free_func(fl_value_destroy);
-  return reinterpret_cast<FlValue*>(self);
+  return fl_value_arena_new_map(nullptr, 0);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_ref(FlValue* self) {
@@ -349,38 +504,51 @@ G_MODULE_EXPORT void fl_value_unref(FlValue* self) {
   switch (self->type) {
     case FL_VALUE_TYPE_STRING: {
       FlValueString* v = reinterpret_cast<FlValueString*>(self);
-      g_free(v->value);
+      if (self->arena == nullptr) {
+        g_free(v->value);
+      }
       break;
     }
     case FL_VALUE_TYPE_UINT8_LIST: {
       FlValueUint8List* v = reinterpret_cast<FlValueUint8List*>(self);
-      g_free(v->values);
+      free_typed_list_values(self, v->values, v->bytes);
       break;
     }
     case FL_VALUE_TYPE_INT32_LIST: {
       FlValueInt32List* v = reinterpret_cast<FlValueInt32List*>(self);
-      g_free(v->values);
+      free_typed_list_values(self, v->values, v->bytes);
       break;
     }
     case FL_VALUE_TYPE_INT64_LIST: {
       FlValueInt64List* v = reinterpret_cast<FlValueInt64List*>(self);
-      g_free(v->values);
+      free_typed_list_values(self, v->values, v->bytes);
       break;
     }
     case FL_VALUE_TYPE_FLOAT_LIST: {
       FlValueFloatList* v = reinterpret_cast<FlValueFloatList*>(self);
-      g_free(v->values);
+      free_typed_list_values(self, v->values, v->bytes);
       break;
     }
     case FL_VALUE_TYPE_LIST: {
       FlValueList* v = reinterpret_cast<FlValueList*>(self);
-      g_ptr_array_unref(v->values);
+      for (size_t i = 0; i < v->values_length; i++) {
+        fl_value_unref(v->values[i]);
+      }
+      if (self->arena == nullptr) {
+        g_free(v->values);
+      }
       break;
     }
     case FL_VALUE_TYPE_MAP: {
       FlValueMap* v = reinterpret_cast<FlValueMap*>(self);
-      g_ptr_array_unref(v->keys);
-      g_ptr_array_unref(v->values);
+      for (size_t i = 0; i < v->values_length; i++) {
+        fl_value_unref(v->keys[i]);
+        fl_value_unref(v->values[i]);
+      }
+      if (self->arena == nullptr) {
+        g_free(v->keys);
+        g_free(v->values);
+      }
       break;
     }
     case FL_VALUE_TYPE_NULL:
@@ -389,7 +557,12 @@ G_MODULE_EXPORT void fl_value_unref(FlValue* self) {
     case FL_VALUE_TYPE_FLOAT:
       break;
   }
-  g_free(self);
+
+  if (self->arena != nullptr) {
+    arena_release(self->arena);
+  } else {
+    g_free(self);
+  }
 }
 
 G_MODULE_EXPORT FlValueType fl_value_get_type(FlValue* self) {
@@ -517,7 +690,12 @@ G_MODULE_EXPORT void fl_value_append_take(FlValue* self, FlValue* value) {
   g_return_if_fail(value != nullptr);
 
   FlValueList* v = reinterpret_cast<FlValueList*>(self);
-  g_ptr_array_add(v->values, value);
+  if (v->values_length == v->values_capacity) {
+    v->values_capacity = MAX(v->values_capacity * 2, kInitialChildrenCapacity);
+    v->values = resize_children(self, v->values, v->values_length,
+                                v->values_capacity);
+  }
+  v->values[v->values_length++] = value;
 }
 
 G_MODULE_EXPORT void fl_value_set(FlValue* self, FlValue* key, FlValue* value) {
@@ -540,14 +718,21 @@ G_MODULE_EXPORT void fl_value_set_take(FlValue* self,
   FlValueMap* v = reinterpret_cast<FlValueMap*>(self);
   ssize_t index = fl_value_lookup_index(self, key);
   if (index < 0) {
-    g_ptr_array_add(v->keys, key);
-    g_ptr_array_add(v->values, value);
+    if (v->values_length == v->values_capacity) {
+      v->values_capacity =
+          MAX(v->values_capacity * 2, kInitialChildrenCapacity);
+      v->keys = resize_children(self, v->keys, v->values_length,
+                                v->values_capacity);
+      v->values = resize_children(self, v->values, v->values_length,
+                                  v->values_capacity);
+    }
+    index = v->values_length++;
   } else {
-    fl_value_destroy(v->keys->pdata[index]);
-    v->keys->pdata[index] = key;
-    fl_value_destroy(v->values->pdata[index]);
-    v->values->pdata[index] = value;
+    fl_value_unref(v->keys[index]);
+    fl_value_unref(v->values[index]);
   }
+  v->keys[index] = key;
+  v->values[index] = value;
 }
 
 G_MODULE_EXPORT void fl_value_set_string(FlValue* self,
@@ -657,11 +842,11 @@ G_MODULE_EXPORT size_t fl_value_get_length(FlValue* self) {
     }
     case FL_VALUE_TYPE_LIST: {
       FlValueList* v = reinterpret_cast<FlValueList*>(self);
-      return v->values->len;
+      return v->values_length;
     }
     case FL_VALUE_TYPE_MAP: {
       FlValueMap* v = reinterpret_cast<FlValueMap*>(self);
-      return v->keys->len;
+      return v->values_length;
     }
     case FL_VALUE_TYPE_NULL:
     case FL_VALUE_TYPE_BOOL:
@@ -679,7 +864,7 @@ G_MODULE_EXPORT FlValue* fl_value_get_list_value(FlValue* self, size_t index) {
   g_return_val_if_fail(self->type == FL_VALUE_TYPE_LIST, nullptr);
 
   FlValueList* v = reinterpret_cast<FlValueList*>(self);
-  return static_cast<FlValue*>(g_ptr_array_index(v->values, index));
+  return v->values[index];
 }
 
 G_MODULE_EXPORT FlValue* fl_value_get_map_key(FlValue* self, size_t index) {
@@ -687,7 +872,7 @@ G_MODULE_EXPORT FlValue* fl_value_get_map_key(FlValue* self, size_t index) {
   g_return_val_if_fail(self->type == FL_VALUE_TYPE_MAP, nullptr);
 
   FlValueMap* v = reinterpret_cast<FlValueMap*>(self);
-  return static_cast<FlValue*>(g_ptr_array_index(v->keys, index));
+  return v->keys[index];
 }
 
 G_MODULE_EXPORT FlValue* fl_value_get_map_value(FlValue* self, size_t index) {
@@ -695,7 +880,7 @@ G_MODULE_EXPORT FlValue* fl_value_get_map_value(FlValue* self, size_t index) {
   g_return_val_if_fail(self->type == FL_VALUE_TYPE_MAP, nullptr);
 
   FlValueMap* v = reinterpret_cast<FlValueMap*>(self);
-  return static_cast<FlValue*>(g_ptr_array_index(v->values, index));
+  return v->values[index];
 }
 
 G_MODULE_EXPORT FlValue* fl_value_lookup(FlValue* self, FlValue* key) {
@@ -725,3 +910,158 @@ G_MODULE_EXPORT gchar* fl_value_to_string(FlValue* value) {
   value_to_string(value, buffer);
   return g_string_free(buffer, FALSE);
 }
+
+FlValueArena* fl_value_arena_new(GBytes* source, size_t size) {
+  size = MAX(arena_align(size), kArenaMinimumSize);
+  size_t header_size = arena_align(sizeof(FlValueArena));
+  // The arena lives at the start of its first block.
+  FlValueArena* arena =
+      static_cast<FlValueArena*>(g_malloc(header_size + size));
+  arena->ref_count = 1;
+  arena->source = source != nullptr ? g_bytes_ref(source) : nullptr;
+  arena->next = reinterpret_cast<uint8_t*>(arena) + header_size;
+  arena->end = arena->next + size;
+  arena->block_size = size;
+  arena->blocks = nullptr;
+  return arena;
+}
+
+size_t fl_value_arena_size_for(size_t value_count,
+                               size_t child_count,
+                               size_t string_count,
+                               size_t string_length) {
+  return value_count * kArenaValueSize + child_count * sizeof(FlValue*) +
+         string_count * kArenaAlignment + string_length;
+}
+
+void fl_value_arena_unref(FlValueArena* arena) {
+  g_return_if_fail(arena != nullptr);
+  g_clear_pointer(&arena->source, g_bytes_unref);
+  arena_release(arena);
+}
+
+FlValue* fl_value_arena_new_null(FlValueArena* arena) {
+  return fl_value_new_in(arena, FL_VALUE_TYPE_NULL, sizeof(FlValue));
+}
+
+FlValue* fl_value_arena_new_bool(FlValueArena* arena, bool value) {
+  FlValueBool* self = reinterpret_cast<FlValueBool*>(
+      fl_value_new_in(arena, FL_VALUE_TYPE_BOOL, sizeof(FlValueBool)));
+  self->value = value ? true : false;
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_int(FlValueArena* arena, int64_t value) {
+  FlValueInt* self = reinterpret_cast<FlValueInt*>(
+      fl_value_new_in(arena, FL_VALUE_TYPE_INT, sizeof(FlValueInt)));
+  self->value = value;
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_float(FlValueArena* arena, double value) {
+  FlValueDouble* self = reinterpret_cast<FlValueDouble*>(
+      fl_value_new_in(arena, FL_VALUE_TYPE_FLOAT, sizeof(FlValueDouble)));
+  self->value = value;
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_string_sized(FlValueArena* arena,
+                                         const gchar* value,
+                                         size_t value_length) {
+  if (arena == nullptr) {
+    return fl_value_new_string_sized(value, value_length);
+  }
+
+  FlValueString* self = reinterpret_cast<FlValueString*>(
+      fl_value_new_in(arena, FL_VALUE_TYPE_STRING, sizeof(FlValueString)));
+  self->value = static_cast<gchar*>(arena_alloc(arena, value_length + 1));
+  memcpy(self->value, value, value_length);
+  self->value[value_length] = '\0';
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_uint8_list(FlValueArena* arena,
+                                       const uint8_t* data,
+                                       size_t data_length) {
+  if (arena == nullptr) {
+    return fl_value_new_uint8_list(data, data_length);
+  }
+
+  FlValueUint8List* self = reinterpret_cast<FlValueUint8List*>(fl_value_new_in(
+      arena, FL_VALUE_TYPE_UINT8_LIST, sizeof(FlValueUint8List)));
+  self->values_length = data_length;
+  self->values = static_cast<uint8_t*>(
+      arena_reference_or_copy(arena, data, sizeof(uint8_t) * data_length,
+                              alignof(uint8_t), &self->bytes));
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_int32_list(FlValueArena* arena,
+                                       const int32_t* data,
+                                       size_t data_length) {
+  if (arena == nullptr) {
+    return fl_value_new_int32_list(data, data_length);
+  }
+
+  FlValueInt32List* self = reinterpret_cast<FlValueInt32List*>(fl_value_new_in(
+      arena, FL_VALUE_TYPE_INT32_LIST, sizeof(FlValueInt32List)));
+  self->values_length = data_length;
+  self->values = static_cast<int32_t*>(
+      arena_reference_or_copy(arena, data, sizeof(int32_t) * data_length,
+                              alignof(int32_t), &self->bytes));
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_int64_list(FlValueArena* arena,
+                                       const int64_t* data,
+                                       size_t data_length) {
+  if (arena == nullptr) {
+    return fl_value_new_int64_list(data, data_length);
+  }
+
+  FlValueInt64List* self = reinterpret_cast<FlValueInt64List*>(fl_value_new_in(
+      arena, FL_VALUE_TYPE_INT64_LIST, sizeof(FlValueInt64List)));
+  self->values_length = data_length;
+  self->values = static_cast<int64_t*>(
+      arena_reference_or_copy(arena, data, sizeof(int64_t) * data_length,
+                              alignof(int64_t), &self->bytes));
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_float_list(FlValueArena* arena,
+                                       const double* data,
+                                       size_t data_length) {
+  if (arena == nullptr) {
+    return fl_value_new_float_list(data, data_length);
+  }
+
+  FlValueFloatList* self = reinterpret_cast<FlValueFloatList*>(fl_value_new_in(
+      arena, FL_VALUE_TYPE_FLOAT_LIST, sizeof(FlValueFloatList)));
+  self->values_length = data_length;
+  self->values = static_cast<double*>(
+      arena_reference_or_copy(arena, data, sizeof(double) * data_length,
+                              alignof(double), &self->bytes));
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_list(FlValueArena* arena, size_t capacity) {
+  FlValue* self =
+      fl_value_new_in(arena, FL_VALUE_TYPE_LIST, sizeof(FlValueList));
+  FlValueList* v = reinterpret_cast<FlValueList*>(self);
+  if (capacity > 0) {
+    v->values = resize_children(self, nullptr, 0, capacity);
+    v->values_capacity = capacity;
+  }
+  return self;
+}
+
+FlValue* fl_value_arena_new_map(FlValueArena* arena, size_t capacity) {
+  FlValue* self = fl_value_new_in(arena, FL_VALUE_TYPE_MAP, sizeof(FlValueMap));
+  FlValueMap* v = reinterpret_cast<FlValueMap*>(self);
+  if (capacity > 0) {
+    v->keys = resize_children(self, nullptr, 0, capacity);
+    v->values = resize_children(self, nullptr, 0, capacity);
+    v->values_capacity = capacity;
+  }
+  return self;
+}
@@ -0,0 +1,126 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_value.h"
+
+G_BEGIN_DECLS
+
+/**
+ * FlValueArena:
+ *
+ * #FlValueArena allocates #FlValue trees from a single block of memory, so
+ * decoding a message costs one allocation rather than one per value.
+ *
+ * Values allocated in an arena behave like any other #FlValue: each has its
+ * own reference count and releases its children when it is freed. Only their
+ * memory is shared, and it is returned once every value in the arena has been
+ * freed. A value that is kept after the rest of its message is released keeps
+ * the arena's memory allocated, but not the message or any other value, so
+ * arenas should be sized to the values decoded into them with
+ * fl_value_arena_size_for().
+ *
+ * All of the fl_value_arena_new_*() functions accept a %NULL arena, in which
+ * case they allocate the value on its own as the matching fl_value_new_*()
+ * function would.
+ */
+typedef struct _FlValueArena FlValueArena;
+
+/**
+ * fl_value_arena_new:
+ * @source: (allow-none): the message values will be decoded from, or %NULL.
+ * Typed lists that lie within @source point into it and hold a reference on it
+ * rather than being copied.
+ * @size: number of bytes to allocate up front. The arena grows if required.
+ *
+ * Creates an arena to allocate values in.
+ *
+ * Returns: a new #FlValueArena.
+ */
+FlValueArena* fl_value_arena_new(GBytes* source, size_t size);
+
+/**
+ * fl_value_arena_size_for:
+ * @value_count: number of values to be allocated.
+ * @child_count: total number of list elements, map keys and map values.
+ * @string_count: number of strings to be allocated.
+ * @string_length: total length of those strings in bytes.
+ *
+ * Works out how large an arena must be to hold values without growing. Typed
+ * lists that can't point into the arena's source aren't included.
+ *
+ * Returns: a size to pass to fl_value_arena_new().
+ */
+size_t fl_value_arena_size_for(size_t value_count,
+                               size_t child_count,
+                               size_t string_count,
+                               size_t string_length);
+
+/**
+ * fl_value_arena_unref:
+ * @arena: an #FlValueArena.
+ *
+ * Drops the reference returned by fl_value_arena_new(), and with it the
+ * arena's reference on its source. The arena remains allocated while any of
+ * its values are alive.
+ */
+void fl_value_arena_unref(FlValueArena* arena);
+
+FlValue* fl_value_arena_new_null(FlValueArena* arena);
+
+FlValue* fl_value_arena_new_bool(FlValueArena* arena, bool value);
+
+FlValue* fl_value_arena_new_int(FlValueArena* arena, int64_t value);
+
+FlValue* fl_value_arena_new_float(FlValueArena* arena, double value);
+
+FlValue* fl_value_arena_new_string_sized(FlValueArena* arena,
+                                         const gchar* value,
+                                         size_t value_length);
+
+FlValue* fl_value_arena_new_uint8_list(FlValueArena* arena,
+                                       const uint8_t* data,
+                                       size_t data_length);
+
+FlValue* fl_value_arena_new_int32_list(FlValueArena* arena,
+                                       const int32_t* data,
+                                       size_t data_length);
+
+FlValue* fl_value_arena_new_int64_list(FlValueArena* arena,
+                                       const int64_t* data,
+                                       size_t data_length);
+
+FlValue* fl_value_arena_new_float_list(FlValueArena* arena,
+                                       const double* data,
+                                       size_t data_length);
+
+/**
+ * fl_value_arena_new_list:
+ * @arena: (allow-none): an #FlValueArena or %NULL.
+ * @capacity: number of children to reserve space for.
+ *
+ * Creates an empty list, as fl_value_new_list() does.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_arena_new_list(FlValueArena* arena, size_t capacity);
+
+/**
+ * fl_value_arena_new_map:
+ * @arena: (allow-none): an #FlValueArena or %NULL.
+ * @capacity: number of entries to reserve space for.
+ *
+ * Creates an empty map, as fl_value_new_map() does.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_arena_new_map(FlValueArena* arena, size_t capacity);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(FlValueArena, fl_value_arena_unref)
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
@@ -6,6 +6,7 @@
 
 #include <gmodule.h>
 
+#include "flutter/shell/platform/linux/fl_value_private.h"
 #include "gtest/gtest.h"
 
 TEST(FlDartProjectTest, Null) {
@@ -938,3 +939,87 @@ TEST(FlValueTest, ListMapNotEqual) {
   g_autoptr(FlValue) value2 = fl_value_new_map();
   EXPECT_FALSE(fl_value_equal(value1, value2));
 }
+
+TEST(FlValueTest, ArenaValues) {
+  g_autoptr(FlValueArena) arena = fl_value_arena_new(nullptr, 0);
+  g_autoptr(FlValue) value = fl_value_arena_new_map(arena, 1);
+  fl_value_set_take(value, fl_value_arena_new_string_sized(arena, "list", 4),
+                    fl_value_arena_new_list(arena, 0));
+  FlValue* list = fl_value_lookup_string(value, "list");
+  // Grow the list past its initial capacity.
+  for (int i = 0; i < 100; i++) {
+    fl_value_append_take(list, fl_value_arena_new_int(arena, i));
+  }
+  fl_value_set_take(value, fl_value_arena_new_string_sized(arena, "null", 4),
+                    fl_value_arena_new_null(arena));
+
+  g_autoptr(FlValue) expected = fl_value_new_map();
+  g_autoptr(FlValue) expected_list = fl_value_new_list();
+  for (int i = 0; i < 100; i++) {
+    fl_value_append_take(expected_list, fl_value_new_int(i));
+  }
+  fl_value_set_string(expected, "list", expected_list);
+  fl_value_set_string_take(expected, "null", fl_value_new_null());
+  EXPECT_TRUE(fl_value_equal(value, expected));
+}
+
+TEST(FlValueTest, ArenaValueOutlivesArena) {
+  FlValueArena* arena = fl_value_arena_new(nullptr, 0);
+  FlValue* value = fl_value_arena_new_list(arena, 2);
+  fl_value_append_take(value, fl_value_arena_new_string_sized(arena, "a", 1));
+  fl_value_append_take(value, fl_value_arena_new_string_sized(arena, "b", 1));
+  fl_value_arena_unref(arena);
+
+  // Values have their own references, so a child can outlive its parent.
+  g_autoptr(FlValue) child = fl_value_ref(fl_value_get_list_value(value, 1));
+  fl_value_unref(value);
+  EXPECT_STREQ(fl_value_get_string(child), "b");
+}
+
+TEST(FlValueTest, ArenaListHoldsOtherValues) {
+  g_autoptr(FlValue) other = fl_value_new_string("other");
+  {
+    g_autoptr(FlValueArena) arena = fl_value_arena_new(nullptr, 0);
+    g_autoptr(FlValue) value = fl_value_arena_new_list(arena, 0);
+    fl_value_append(value, other);
+    g_autoptr(FlValue) map = fl_value_arena_new_map(arena, 0);
+    fl_value_set_string(map, "other", other);
+    // Replacing a value releases the old one.
+    fl_value_set_string_take(map, "other", fl_value_new_int(42));
+  }
+  EXPECT_STREQ(fl_value_get_string(other), "other");
+}
+
+TEST(FlValueTest, ArenaTypedListReferencesSource) {
+  double data[] = {1.0, 2.0, 3.0};
+  g_autoptr(GBytes) source = g_bytes_new(data, sizeof(data));
+  const double* source_data =
+      static_cast<const double*>(g_bytes_get_data(source, nullptr));
+
+  g_autoptr(FlValueArena) arena = fl_value_arena_new(source, 0);
+  g_autoptr(FlValue) referenced =
+      fl_value_arena_new_float_list(arena, source_data, 3);
+  EXPECT_EQ(fl_value_get_float_list(referenced), source_data);
+
+  // Data from outside the source is copied.
+  g_autoptr(FlValue) copied = fl_value_arena_new_float_list(arena, data, 3);
+  EXPECT_NE(fl_value_get_float_list(copied), data);
+  EXPECT_TRUE(fl_value_equal(referenced, copied));
+}
+
+TEST(FlValueTest, ArenaTypedListOutlivesSource) {
+  double data[] = {1.0, 2.0, 3.0};
+  GBytes* source = g_bytes_new(data, sizeof(data));
+  const double* source_data =
+      static_cast<const double*>(g_bytes_get_data(source, nullptr));
+
+  FlValueArena* arena = fl_value_arena_new(source, 0);
+  g_autoptr(FlValue) value =
+      fl_value_arena_new_float_list(arena, source_data, 3);
+  fl_value_arena_unref(arena);
+  g_bytes_unref(source);
+
+  // The list holds its own reference on the data it points into.
+  EXPECT_EQ(fl_value_get_float_list(value), source_data);
+  EXPECT_EQ(fl_value_get_float_list(value)[2], 3.0);
+}
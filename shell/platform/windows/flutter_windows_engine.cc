@@ -354,6 +354,36 @@ void FlutterWindowsEngine::HandlePlatformMessage(
       message, [this] {}, [this] {});
 }
 
+void FlutterWindowsEngine::SetBackgroundMessageCallback(
+    const std::string& channel,
+    FlutterDesktopMessageCallback callback,
+    void* user_data,
+    FlutterDesktopMessageCallbackRelease release) {
+  if (!callback) {
+    embedder_api_.SetPlatformMessageBackgroundCallback(
+        engine_, channel.c_str(), nullptr, nullptr, nullptr);
+    return;
+  }
+
+  embedder_api_.SetPlatformMessageBackgroundCallback(
+      engine_, channel.c_str(),
+      [](const FlutterPlatformMessage* engine_message, void* user_data) {
+        auto registration = static_cast<BackgroundMessageCallback*>(user_data);
+        auto message = ConvertToDesktopMessage(*engine_message);
+        registration->callback(registration->messenger, &message,
+                               registration->user_data);
+      },
+      new BackgroundMessageCallback{messenger_.get(), callback, user_data,
+                                    release},
+      [](void* user_data) {
+        auto registration = static_cast<BackgroundMessageCallback*>(user_data);
+        if (registration->release) {
+          registration->release(registration->user_data);
+        }
+        delete registration;
+      });
+}
+
 void FlutterWindowsEngine::ReloadSystemFonts() {
   embedder_api_.ReloadSystemFonts(engine_);
 }
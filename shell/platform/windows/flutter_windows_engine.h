@@ -8,6 +8,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 
 #include "flutter/shell/platform/common/client_wrapper/binary_messenger_impl.h"
@@ -120,6 +121,14 @@ class FlutterWindowsEngine {
   // messages.
   void HandlePlatformMessage(const FlutterPlatformMessage*);
 
+  // Registers |callback| to be called on a background thread for messages on
+  // |channel|. See FlutterDesktopMessengerSetBackgroundCallback.
+  void SetBackgroundMessageCallback(
+      const std::string& channel,
+      FlutterDesktopMessageCallback callback,
+      void* user_data,
+      FlutterDesktopMessageCallbackRelease release);
+
   // Informs the engine that the system font list has changed.
   void ReloadSystemFonts();
 
@@ -168,6 +177,15 @@ class FlutterWindowsEngine {
   // Message dispatch manager for messages from engine_.
   std::unique_ptr<IncomingMessageDispatcher> message_dispatcher_;
 
+  // A callback registered with SetBackgroundMessageCallback. Owned by the
+  // engine, which releases it once the callback won't be called again.
+  struct BackgroundMessageCallback {
+    FlutterDesktopMessengerRef messenger;
+    FlutterDesktopMessageCallback callback;
+    void* user_data;
+    FlutterDesktopMessageCallbackRelease release;
+  };
+
   // The plugin registrar handle given to API clients.
   std::unique_ptr<FlutterDesktopPluginRegistrar> plugin_registrar_;
 
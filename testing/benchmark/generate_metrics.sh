@@ -11,6 +11,11 @@ set -ex
 
 ./txt_benchmarks --benchmark_format=json > txt_benchmarks.json
 ./fml_benchmarks --benchmark_format=json > fml_benchmarks.json
+./flow_benchmarks --benchmark_format=json > flow_benchmarks.json
 ./shell_benchmarks --benchmark_format=json > shell_benchmarks.json
 ./ui_benchmarks --benchmark_format=json > ui_benchmarks.json
+./image_decoder_benchmarks --benchmark_format=json > image_decoder_benchmarks.json
+./client_wrapper_benchmarks --benchmark_format=json > client_wrapper_benchmarks.json
+./common_cpp_benchmarks --benchmark_format=json > common_cpp_benchmarks.json
+./embedder_channel_benchmarks --benchmark_format=json > embedder_channel_benchmarks.json
 
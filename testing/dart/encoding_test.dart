@@ -58,6 +58,34 @@ void main() {
         final List<int> expected = await readFile('square.png');
         expect(Uint8List.view(data.buffer), expected);
       });
+
+      test('honors the compression level', () async {
+        final Image image = await Square4x4Image.image;
+        final ByteData fastest = await image.toByteData(format: ImageByteFormat.png, quality: 0);
+        final ByteData smallest = await image.toByteData(format: ImageByteFormat.png, quality: 9);
+        expect(Uint8List.view(fastest.buffer).sublist(1, 4), 'PNG'.codeUnits);
+        expect(fastest.lengthInBytes, greaterThanOrEqualTo(smallest.lengthInBytes));
+      });
+    });
+
+    group('JPEG format', () {
+      test('works with simple image', () async {
+        final Image image = await Square4x4Image.image;
+        final ByteData data = await image.toByteData(format: ImageByteFormat.jpeg, quality: 90);
+        final Uint8List bytes = Uint8List.view(data.buffer);
+        // JPEG SOI marker.
+        expect(bytes.sublist(0, 2), <int>[0xFF, 0xD8]);
+      });
+    });
+
+    group('WebP format', () {
+      test('works with simple image', () async {
+        final Image image = await Square4x4Image.image;
+        final ByteData data = await image.toByteData(format: ImageByteFormat.webp);
+        final Uint8List bytes = Uint8List.view(data.buffer);
+        expect(bytes.sublist(0, 4), 'RIFF'.codeUnits);
+        expect(bytes.sublist(8, 12), 'WEBP'.codeUnits);
+      });
     });
   });
 }
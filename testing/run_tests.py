@@ -65,6 +65,18 @@ def IsWindows():
 def ExecutableSuffix():
   return '.exe' if IsWindows() else ''
 
+def IsDesktopEmbeddingsEnabled(build_dir):
+  # Mirrors the enable_desktop_embeddings GN argument, which defaults to true.
+  args_path = os.path.join(build_dir, 'args.gn')
+  if not os.path.exists(args_path):
+    return True
+  with open(args_path) as args_file:
+    for line in args_file:
+      if re.match(r'\s*enable_desktop_embeddings\s*=\s*false', line):
+        return False
+  return True
+
+
 def FindExecutablePath(path):
   if os.path.exists(path):
     return path
@@ -175,8 +187,19 @@ def RunEngineBenchmarks(build_dir, filter):
 
   RunEngineExecutable(build_dir, 'fml_benchmarks', filter)
 
+  RunEngineExecutable(build_dir, 'flow_benchmarks', filter)
+
   RunEngineExecutable(build_dir, 'ui_benchmarks', filter)
 
+  RunEngineExecutable(build_dir, 'image_decoder_benchmarks', filter)
+
+  # These are only built along with the desktop embeddings.
+  if IsDesktopEmbeddingsEnabled(build_dir):
+    RunEngineExecutable(build_dir, 'client_wrapper_benchmarks', filter)
+    RunEngineExecutable(build_dir, 'common_cpp_benchmarks', filter)
+
+  RunEngineExecutable(build_dir, 'embedder_channel_benchmarks', filter)
+
   if IsLinux():
     RunEngineExecutable(build_dir, 'txt_benchmarks', filter)
 
@@ -0,0 +1,50 @@
+#!/usr/bin/env python
+# Copyright 2013 The Flutter Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+"""Writes the asset index of a built asset bundle.
+
+The format is read by flutter/assets/asset_index.h. Bundles that are updated
+in place, like those of applications being hot reloaded, must not have an
+index, since assets missing from it are not looked for.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+INDEX_FILE_NAME = 'io.flutter.assets.index'
+MAGIC = 0x58494146  # "FAIX"
+VERSION = 1
+
+
+def ListAssets(bundle_dir):
+  names = []
+  for root, _, files in os.walk(bundle_dir):
+    for file_name in files:
+      path = os.path.relpath(os.path.join(root, file_name), bundle_dir)
+      name = path.replace(os.sep, '/')
+      if name != INDEX_FILE_NAME:
+        names.append(name)
+  return sorted(names)
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__)
+  parser.add_argument('--bundle', type=str, required=True,
+                      help='The asset bundle directory to index.')
+  args = parser.parse_args()
+
+  names = [name.encode('utf-8') for name in ListAssets(args.bundle)]
+  with open(os.path.join(args.bundle, INDEX_FILE_NAME), 'wb') as index:
+    index.write(struct.pack('<III', MAGIC, VERSION, len(names)))
+    for name in names:
+      index.write(struct.pack('<I', len(name)))
+      index.write(name)
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
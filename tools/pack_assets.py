@@ -0,0 +1,85 @@
+#!/usr/bin/env python
+# Copyright 2013 The Flutter Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+"""Packs the assets of a built asset bundle into a single archive.
+
+The format is read by flutter/assets/packed_asset_bundle.h. The archive is
+written as io.flutter.assets.pack, and the packed assets no longer need to be
+deployed as separate files.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+ARCHIVE_FILE_NAME = 'io.flutter.assets.pack'
+MAGIC = 0x4B415046  # "FPAK"
+VERSION = 1
+ALIGNMENT = 4096
+HEADER_SIZE = 16
+ENTRY_SIZE = 32
+FLAG_PREFETCH = 1 << 0
+
+
+def AlignUp(offset):
+  return (offset + ALIGNMENT - 1) // ALIGNMENT * ALIGNMENT
+
+
+def ListAssets(bundle_dir):
+  names = []
+  for root, _, files in os.walk(bundle_dir):
+    for file_name in files:
+      path = os.path.relpath(os.path.join(root, file_name), bundle_dir)
+      name = path.replace(os.sep, '/')
+      if name != ARCHIVE_FILE_NAME:
+        names.append(name)
+  # The engine looks assets up by comparing the bytes of their names.
+  return sorted(names, key=lambda name: name.encode('utf-8'))
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__)
+  parser.add_argument('--bundle', type=str, required=True,
+                      help='The asset bundle directory to pack.')
+  parser.add_argument('--output', type=str,
+                      help='Where to write the archive. Defaults to '
+                      'io.flutter.assets.pack in the bundle directory.')
+  parser.add_argument('--prefetch', type=str, action='append', default=[],
+                      help='An asset to page in when the archive is opened. '
+                      'May be repeated.')
+  args = parser.parse_args()
+
+  names = ListAssets(args.bundle)
+  encoded_names = [name.encode('utf-8') for name in names]
+  names_size = sum(len(name) for name in encoded_names)
+
+  entries = []
+  offset = AlignUp(HEADER_SIZE + len(names) * ENTRY_SIZE + names_size)
+  name_offset = 0
+  for name, encoded_name in zip(names, encoded_names):
+    size = os.path.getsize(os.path.join(args.bundle, name))
+    flags = FLAG_PREFETCH if name in args.prefetch else 0
+    entries.append(struct.pack('<QQIIII', offset, size, name_offset,
+                               len(encoded_name), flags, 0))
+    offset = AlignUp(offset + size)
+    name_offset += len(encoded_name)
+
+  output = args.output or os.path.join(args.bundle, ARCHIVE_FILE_NAME)
+  with open(output, 'wb') as archive:
+    archive.write(struct.pack('<IIII', MAGIC, VERSION, len(names), names_size))
+    for entry in entries:
+      archive.write(entry)
+    for encoded_name in encoded_names:
+      archive.write(encoded_name)
+    for name in names:
+      archive.write(b'\0' * (AlignUp(archive.tell()) - archive.tell()))
+      with open(os.path.join(args.bundle, name), 'rb') as asset:
+        archive.write(asset.read())
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())